@@ -39,6 +39,9 @@ namespace Forsyth
 	//-----------------------------------------------------------------------------
 	void OptimizeFaces(const uint16_t* indexList, uint32_t indexCount, uint32_t vertexCount, uint16_t* newIndexList, uint16_t lruCacheSize);
 
+	// Same as above but 32bit indices.
+	void OptimizeFaces(const uint32_t* indexList, uint32_t indexCount, uint32_t vertexCount, uint32_t* newIndexList, uint16_t lruCacheSize);
+
 } // namespace Forsyth
 
 #endif // __FORSYTH_TRIANGLE_REORDER__
@@ -22,6 +22,8 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+// bgfx local modification, see README.md and bgfx-local.patch.
+
 #include "indexbufferdecompression.h"
 #include "readbitstream.h"
 #include "indexcompressionconstants.h"
@@ -42,13 +44,17 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
     // iterate through the triangles
     for ( Ty* triangle = triangles; triangle < triangleEnd; triangle += 3 )
     {
-        IndexBufferTriangleCodes code      = static_cast< IndexBufferTriangleCodes >( input.Read( IB_TRIANGLE_CODE_BITS ) );
+        // Code and up to 3 cached vertex/edge indices fit in a single refill, only variable length free vertices
+        // have to go back to memory.
+        input.Refill();
+
+        IndexBufferTriangleCodes code      = static_cast< IndexBufferTriangleCodes >( input.ReadCached( IB_TRIANGLE_CODE_BITS ) );
 
         switch ( code )
         {
         case IB_EDGE_NEW:
         {
-            uint32_t    edgeFifoIndex = input.Read( CACHED_EDGE_BITS );
+            uint32_t    edgeFifoIndex = input.ReadCached( CACHED_EDGE_BITS );
 
             const Edge& edge          = edgeFifo[ ( ( edgesRead - 1 ) - edgeFifoIndex ) & EDGE_FIFO_MASK ];
 
@@ -66,8 +72,8 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
 
         case IB_EDGE_CACHED:
         {
-            uint32_t    edgeFifoIndex   = input.Read( CACHED_EDGE_BITS );
-            uint32_t    vertexFifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t    edgeFifoIndex   = input.ReadCached( CACHED_EDGE_BITS );
+            uint32_t    vertexFifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
 
             const Edge& edge            = edgeFifo[ ( ( edgesRead - 1 ) - edgeFifoIndex ) & EDGE_FIFO_MASK ];
 
@@ -79,7 +85,7 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_EDGE_FREE:
         {
-            uint32_t    edgeFifoIndex   = input.Read( CACHED_EDGE_BITS );
+            uint32_t    edgeFifoIndex   = input.ReadCached( CACHED_EDGE_BITS );
             uint32_t    relativeVertex  = input.ReadVInt();
 
             const Edge& edge            = edgeFifo[ ( ( edgesRead - 1 ) - edgeFifoIndex ) & EDGE_FIFO_MASK ];
@@ -112,7 +118,7 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_NEW_NEW_CACHED:
         {
-            uint32_t vertexFifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertexFifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
 
             triangle[ 2 ]                                         = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertexFifoIndex ) & VERTEX_FIFO_MASK ] );
             vertexFifo[ verticesRead & VERTEX_FIFO_MASK ]         =
@@ -149,8 +155,8 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_NEW_CACHED_CACHED:
         {
-            uint32_t vertex1FifoIndex = input.Read( CACHED_VERTEX_BITS );
-            uint32_t vertex2FifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertex1FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
+            uint32_t vertex2FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
 
             triangle[ 1 ]                                 = static_cast< Ty >(  vertexFifo[ ( ( verticesRead - 1 ) - vertex1FifoIndex ) & VERTEX_FIFO_MASK ] );
             triangle[ 2 ]                                 = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertex2FifoIndex ) & VERTEX_FIFO_MASK ] );
@@ -167,7 +173,7 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_NEW_CACHED_FREE:
         {
-            uint32_t vertexFifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertexFifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
             uint32_t relativeVertex  = input.ReadVInt();
 
             triangle[ 1 ]                                         = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertexFifoIndex ) & VERTEX_FIFO_MASK ] );
@@ -226,9 +232,9 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_CACHED_CACHED_CACHED:
         {
-            uint32_t vertex0FifoIndex = input.Read( CACHED_VERTEX_BITS );
-            uint32_t vertex1FifoIndex = input.Read( CACHED_VERTEX_BITS );
-            uint32_t vertex2FifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertex0FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
+            uint32_t vertex1FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
+            uint32_t vertex2FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
 
             triangle[ 0 ] = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertex0FifoIndex ) & VERTEX_FIFO_MASK ] );
             triangle[ 1 ] = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertex1FifoIndex ) & VERTEX_FIFO_MASK ] );
@@ -241,8 +247,8 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_CACHED_CACHED_FREE:
         {
-            uint32_t vertex0FifoIndex = input.Read( CACHED_VERTEX_BITS );
-            uint32_t vertex1FifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertex0FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
+            uint32_t vertex1FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
             uint32_t relativeVertex2  = input.ReadVInt();
 
             triangle[ 0 ]                                 = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - vertex0FifoIndex ) & VERTEX_FIFO_MASK ] );
@@ -261,7 +267,7 @@ void DecompressTriangleCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstr
         }
         case IB_CACHED_FREE_FREE:
         {
-            uint32_t vertex0FifoIndex = input.Read( CACHED_VERTEX_BITS );
+            uint32_t vertex0FifoIndex = input.ReadCached( CACHED_VERTEX_BITS );
             uint32_t relativeVertex1  = input.ReadVInt();
             uint32_t relativeVertex2  = input.ReadVInt();
 
@@ -360,7 +366,9 @@ void DecompressIndiceCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstrea
 
         while ( readVertex < 3 )
         {
-            IndexBufferCodes code = static_cast< IndexBufferCodes >( input.Read( IB_VERTEX_CODE_BITS ) );
+            input.Refill();
+
+            IndexBufferCodes code = static_cast< IndexBufferCodes >( input.ReadCached( IB_VERTEX_CODE_BITS ) );
 
             switch ( code )
             {
@@ -380,7 +388,7 @@ void DecompressIndiceCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstrea
             {
                 assert( readVertex == 0 );
 
-                uint32_t    fifoIndex = input.Read( CACHED_EDGE_BITS );
+                uint32_t    fifoIndex = input.ReadCached( CACHED_EDGE_BITS );
                 const Edge& edge      = edgeFifo[ ( ( edgesRead - 1 ) - fifoIndex ) & EDGE_FIFO_MASK ];
 
                 triangle[ 0 ] = static_cast< Ty >( edge.second );
@@ -395,7 +403,7 @@ void DecompressIndiceCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstrea
             case IB_CACHED_VERTEX:
 
             {
-                uint32_t fifoIndex     = input.Read( CACHED_VERTEX_BITS );
+                uint32_t fifoIndex     = input.ReadCached( CACHED_VERTEX_BITS );
                 
                 triangle[ readVertex ] = static_cast< Ty >( vertexFifo[ ( ( verticesRead - 1 ) - fifoIndex ) & VERTEX_FIFO_MASK ] );
 
@@ -451,23 +459,29 @@ void DecompressIndiceCodes1( Ty* triangles, uint32_t triangleCount, ReadBitstrea
 template < typename Ty >
 void DecompressIndexBuffer( Ty* triangles, uint32_t triangleCount, ReadBitstream& input )
 {
-    IndexBufferCompressionFormat format = static_cast< IndexBufferCompressionFormat >( input.ReadVInt() );
+    // Decode from a local copy of the bitstream, so the bit position can stay in a register instead of being
+    // reloaded after every store to the output triangles.
+    ReadBitstream stream = input;
+
+    IndexBufferCompressionFormat format = static_cast< IndexBufferCompressionFormat >( stream.ReadVInt() );
 
     switch ( format )
     {
     case IBCF_PER_INDICE_1:
 
-        DecompressIndiceCodes1<Ty>( triangles, triangleCount, input );
+        DecompressIndiceCodes1<Ty>( triangles, triangleCount, stream );
         break;
 
     case IBCF_PER_TRIANGLE_1:
 
-        DecompressTriangleCodes1<Ty>( triangles, triangleCount, input );
+        DecompressTriangleCodes1<Ty>( triangles, triangleCount, stream );
         break;
 
     default: // IBCF_AUTO:
         break;
     }
+
+    input = stream;
 }
 
 void DecompressIndexBuffer( uint32_t* triangles, uint32_t triangleCount, ReadBitstream& input )
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef _MSC_VER
 
@@ -39,105 +40,149 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #endif 
 
+// bgfx local modification, see README.md and bgfx-local.patch.
+
 // Very simple reader bitstream, note it does not do any overflow checking, etc.
+//
+// Bits are consumed LSB first, which makes the stream written as little endian 64 bit words by WriteBitstream
+// identical to a continuous little endian byte stream. Reads peek an unaligned 64 bit word at the current byte
+// and shift/mask it, so there is no refill branch per read. The last 8 bytes of the buffer are read byte by byte,
+// so the buffer doesn't need to be padded and can point directly into a memory mapped file.
 class ReadBitstream
 {
 public:
 
-    // Construct the bitstream with a fixed byte buffer (which should be padded out to multiples of 8 bytes, as we read in 8 byte chunks).
+    // Construct the bitstream with a fixed byte buffer.
     ReadBitstream( const uint8_t* buffer, size_t bufferSize );
 
     ~ReadBitstream() {}
 
-    // Read a number of bits
+    // Read a number of bits (up to 32).
     uint32_t Read( uint32_t bitcount );
 
+    // Load at least 57 bits into the cache, which can then be consumed with ReadCached without touching memory.
+    void Refill();
+
+    // Read a number of bits from the cache, the total read since the last Refill must not exceed 57 bits.
+    uint32_t ReadCached( uint32_t bitcount );
+
     // Get the buffer size of this in bytes
     size_t Size() const { return m_bufferSize; }
 
+    // Get the number of bytes consumed so far.
+    size_t BytesRead() const { return ( m_bitPosition + 7 ) >> 3; }
+
     uint32_t ReadVInt();
 
 private:
 
-    uint64_t m_bitBuffer;
+    // Returns at least 57 valid bits starting at the current bit position.
+    uint64_t Peek() const;
+
+    uint64_t m_cache;
 
     const uint8_t* m_buffer;
-    const uint8_t* m_cursor;
 
     size_t m_bufferSize;
-    uint32_t m_bitsLeft;
+    size_t m_bitPosition;
 
 };
 
 inline ReadBitstream::ReadBitstream( const uint8_t* buffer, size_t bufferSize )
 {
-    m_cursor     =
-    m_buffer     = buffer;
-    m_bufferSize = bufferSize;
+    m_cache       = 0;
+    m_buffer      = buffer;
+    m_bufferSize  = bufferSize;
+    m_bitPosition = 0;
+}
+
+RBS_INLINE uint64_t ReadBitstream::Peek() const
+{
+    const size_t bytePosition = m_bitPosition >> 3;
+    uint64_t     bits;
 
-    if ( bufferSize >= 8 )
+    if ( bytePosition + 8 <= m_bufferSize )
     {
-        m_bitBuffer = m_cursor[ 0 ];
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 1 ] ) << 8;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 2 ] ) << 16;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 3 ] ) << 24;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 4 ] ) << 32;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 5 ] ) << 40;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 6 ] ) << 48;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 7 ] ) << 56;
-
-        m_cursor += 8;
-        m_bitsLeft = 64;
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        const uint8_t* cursor = m_buffer + bytePosition;
+
+        bits = cursor[ 0 ];
+        bits |= static_cast< uint64_t >( cursor[ 1 ] ) << 8;
+        bits |= static_cast< uint64_t >( cursor[ 2 ] ) << 16;
+        bits |= static_cast< uint64_t >( cursor[ 3 ] ) << 24;
+        bits |= static_cast< uint64_t >( cursor[ 4 ] ) << 32;
+        bits |= static_cast< uint64_t >( cursor[ 5 ] ) << 40;
+        bits |= static_cast< uint64_t >( cursor[ 6 ] ) << 48;
+        bits |= static_cast< uint64_t >( cursor[ 7 ] ) << 56;
+#else
+        ::memcpy( &bits, m_buffer + bytePosition, sizeof( bits ) );
+#endif
     }
     else
     {
-        m_bitsLeft = 0;
+        bits = 0;
+
+        for ( size_t i = bytePosition, shift = 0; i < m_bufferSize; ++i, shift += 8 )
+        {
+            bits |= static_cast< uint64_t >( m_buffer[ i ] ) << shift;
+        }
     }
+
+    return bits >> ( m_bitPosition & 7 );
 }
 
 RBS_INLINE uint32_t ReadBitstream::Read( uint32_t bitCount )
 {
-    uint64_t mask   = ( uint64_t( 1 ) << bitCount ) - 1;
-    uint32_t result = static_cast< uint32_t >( ( m_bitBuffer >> ( 64 - m_bitsLeft ) & ( m_bitsLeft == 0 ? 0 : UINT64_C(0xFFFFFFFFFFFFFFFF) ) ) & mask );
+    const uint64_t mask   = ( uint64_t( 1 ) << bitCount ) - 1;
+    const uint32_t result = static_cast< uint32_t >( Peek() & mask );
 
-    if ( m_bitsLeft < bitCount )
-    {
-        m_bitBuffer = m_cursor[ 0 ];
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 1 ] ) << 8;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 2 ] ) << 16;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 3 ] ) << 24;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 4 ] ) << 32;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 5 ] ) << 40;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 6 ] ) << 48;
-        m_bitBuffer |= static_cast< uint64_t >( m_cursor[ 7 ] ) << 56;
-
-        m_cursor += 8;
-
-        result     |= static_cast< uint32_t >( m_bitBuffer << m_bitsLeft ) & mask;
-        m_bitsLeft  = 64 - ( bitCount - m_bitsLeft );
-    }
-    else
-    {
-        m_bitsLeft -= bitCount;
-    }
+    m_bitPosition += bitCount;
+
+    return result;
+}
+
+RBS_INLINE void ReadBitstream::Refill()
+{
+    m_cache = Peek();
+}
+
+RBS_INLINE uint32_t ReadBitstream::ReadCached( uint32_t bitCount )
+{
+    const uint64_t mask   = ( uint64_t( 1 ) << bitCount ) - 1;
+    const uint32_t result = static_cast< uint32_t >( m_cache & mask );
+
+    m_cache      >>= bitCount;
+    m_bitPosition += bitCount;
 
     return result;
 }
 
 RBS_INLINE uint32_t ReadBitstream::ReadVInt()
 {
-    uint32_t bitsToShift = 0;
-    uint32_t result      = 0;
-    uint32_t readByte;
+    uint64_t bits   = Peek();
+    uint32_t result = static_cast< uint32_t >( bits & 0x7F );
 
-    do
+    m_bitPosition += 8;
+
+    // Most relative vertices fit in a single byte.
+    if ( ( bits & 0x80 ) == 0 )
     {
-        readByte = Read( 8 );
+        return result;
+    }
 
-        result |= ( readByte & 0x7F ) << bitsToShift;
-        bitsToShift += 7;
+    // 32 bit value is at most 5 bytes, which is within the peeked bits.
+    for ( uint32_t bitsToShift = 7; bitsToShift < 35; bitsToShift += 7 )
+    {
+        bits >>= 8;
+
+        result |= static_cast< uint32_t >( bits & 0x7F ) << bitsToShift;
+        m_bitPosition += 8;
 
-    } while ( readByte & 0x80 );
+        if ( ( bits & 0x80 ) == 0 )
+        {
+            break;
+        }
+    }
 
     return result;
 }
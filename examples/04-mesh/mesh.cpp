@@ -36,7 +36,14 @@ class ExampleMesh : public entry::AppI
 		// Create program from shaders.
 		m_program = loadProgram("vs_mesh", "fs_mesh");
 
-		m_mesh = meshLoad("meshes/bunny.bin");
+		// Load time includes mapping file and creating buffers, but not
+		// renderer side upload.
+		int64_t loadTime = -bx::getHPCounter();
+		m_mesh = meshLoad("meshes/bunny.bin", false, true);
+		loadTime += bx::getHPCounter();
+		m_loadTime = double(loadTime)*1000.0/double(bx::getHPFrequency() );
+
+		m_numMeshlets = meshGetNumMeshlets(m_mesh);
 
 		m_timeOffset = bx::getHPCounter();
 	}
@@ -80,17 +87,20 @@ class ExampleMesh : public entry::AppI
 			bgfx::dbgTextClear();
 			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/04-mesh");
 			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Loading meshes.");
-			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms], mesh load: %.3f[ms]", double(frameTime)*toMs, m_loadTime);
 
 			float at[3]  = { 0.0f, 1.0f,  0.0f };
 			float eye[3] = { 0.0f, 1.0f, -2.5f };
 
+			float view[16];
+			float proj[16];
+
 			// Set view and projection matrix for view 0.
 			const bgfx::HMD* hmd = bgfx::getHMD();
 			if (NULL != hmd && 0 != (hmd->flags & BGFX_HMD_RENDERING) )
 			{
-				float view[16];
 				bx::mtxQuatTranslationHMD(view, hmd->eye[0].rotation, eye);
+				bx::memCopy(proj, hmd->eye[0].projection, sizeof(proj) );
 				bgfx::setViewTransform(0, view, hmd->eye[0].projection, BGFX_VIEW_STEREO, hmd->eye[1].projection);
 
 				// Set view 0 default viewport.
@@ -101,10 +111,8 @@ class ExampleMesh : public entry::AppI
 			}
 			else
 			{
-				float view[16];
 				bx::mtxLookAt(view, eye, at);
 
-				float proj[16];
 				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
 				bgfx::setViewTransform(0, view, proj);
 
@@ -118,7 +126,20 @@ class ExampleMesh : public entry::AppI
 				, time*0.37f
 				);
 
-			meshSubmit(m_mesh, 0, m_program, mtx);
+			// Mesh groups and clusters outside of view frustum, or facing away
+			// from the camera, are not submitted. Without clusters only whole
+			// groups are culled.
+			const uint32_t numDraws = meshSubmitCulled(m_mesh, 0, m_program, mtx, view, proj);
+			bgfx::dbgTextPrintf(0, 4, 0x0f, "Draw calls: %d", numDraws);
+
+			if (0 == m_numMeshlets)
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Mesh has no clusters, rebuild it with geometryc --meshlets for cluster culling.");
+			}
+			else
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Clusters: %d", m_numMeshlets);
+			}
 
 			// Advance to next frame. Rendering thread will be kicked to
 			// process submitted rendering primitives.
@@ -136,7 +157,9 @@ class ExampleMesh : public entry::AppI
 	uint32_t m_reset;
 
 	int64_t m_timeOffset;
+	double m_loadTime;
 	Mesh* m_mesh;
+	uint32_t m_numMeshlets;
 	bgfx::ProgramHandle m_program;
 	bgfx::UniformHandle u_time;
 };
@@ -7,17 +7,18 @@ $output v_pos, v_view, v_normal, v_color0
  */
 
 #include "../common/common.sh"
+#include "../common/mesh.sh"
 
 uniform vec4 u_time;
 
 void main()
 {
-	vec3 pos = a_position;
+	vec3 pos = meshDequantPosition(a_position);
 
 	float sx = sin(pos.x*32.0+u_time.x*4.0)*0.5+0.5;
 	float cy = cos(pos.y*32.0+u_time.x*4.0)*0.5+0.5;
 	vec3 displacement = vec3(sx, cy, sx*cy);
-	vec3 normal = a_normal.xyz*2.0 - 1.0;
+	vec3 normal = meshDecodeNormal(a_normal);
 
 	pos = pos + normal*displacement*vec3(0.06, 0.06, 0.06);
 
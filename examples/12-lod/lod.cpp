@@ -82,8 +82,15 @@ class ExampleLod : public entry::AppI
 		// Imgui.
 		imguiCreate();
 
+		// Meshes built with geometryc --lod contain simplified LODs, and
+		// LOD is selected by projected simplification error. Otherwise
+		// separate mesh per LOD is used.
+		m_numGeneratedLods = bx::uint32_min(meshGetNumLods(m_meshTop[0]), meshGetNumLods(m_meshTrunk[0]) );
+
 		m_scrollArea  = 0;
 		m_transitions = true;
+		m_generated   = 0 < m_numGeneratedLods;
+		m_maxPixelError = 1.0f;
 
 		m_transitionFrame = 0;
 		m_currLod         = 0;
@@ -131,7 +138,7 @@ class ExampleLod : public entry::AppI
 				, uint16_t(m_height)
 			);
 
-			imguiBeginScrollArea("Toggle transitions", m_width - m_width / 5 - 10, 10, m_width / 5, m_height / 6, &m_scrollArea);
+			imguiBeginScrollArea("Toggle transitions", m_width - m_width / 5 - 10, 10, m_width / 5, m_height / 4, &m_scrollArea);
 			imguiSeparatorLine();
 
 			if (imguiButton(m_transitions ? "ON" : "OFF") )
@@ -139,6 +146,19 @@ class ExampleLod : public entry::AppI
 				m_transitions = !m_transitions;
 			}
 
+			if (imguiCheck("Generated LODs", m_generated, 0 < m_numGeneratedLods) )
+			{
+				m_generated = !m_generated;
+				m_currLod   = 0;
+				m_targetLod = 0;
+				m_transitionFrame = 0;
+			}
+
+			if (m_generated)
+			{
+				imguiSlider("Max pixel error", m_maxPixelError, 0.25f, 8.0f, 0.25f);
+			}
+
 			static float distance = 2.0f;
 			imguiSlider("Distance", distance, 2.0f, 6.0f, 0.01f);
 
@@ -165,6 +185,11 @@ class ExampleLod : public entry::AppI
 			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Mesh LOD transitions.");
 			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
 
+			if (0 == m_numGeneratedLods)
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Meshes have no generated LODs, rebuild them with geometryc --lod to enable.");
+			}
+
 			float at[3]  = { 0.0f, 1.0f,      0.0f };
 			float eye[3] = { 0.0f, 2.0f, -distance };
 
@@ -195,8 +220,9 @@ class ExampleLod : public entry::AppI
 				bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
 			}
 
+			const float scale = 0.1f;
 			float mtx[16];
-			bx::mtxScale(mtx, 0.1f, 0.1f, 0.1f);
+			bx::mtxScale(mtx, scale, scale, scale);
 
 			float stipple[3];
 			float stippleInv[3];
@@ -226,12 +252,12 @@ class ExampleLod : public entry::AppI
 			bgfx::setTexture(0, s_texColor, m_textureBark);
 			bgfx::setTexture(1, s_texStipple, m_textureStipple);
 			bgfx::setUniform(u_stipple, stipple);
-			meshSubmit(m_meshTrunk[mainLOD], 0, m_program, mtx, stateOpaque);
+			submitLod(m_meshTrunk, mainLOD, mtx, stateOpaque);
 
 			bgfx::setTexture(0, s_texColor, m_textureLeafs);
 			bgfx::setTexture(1, s_texStipple, m_textureStipple);
 			bgfx::setUniform(u_stipple, stipple);
-			meshSubmit(m_meshTop[mainLOD], 0, m_program, mtx, stateTransparent);
+			submitLod(m_meshTop, mainLOD, mtx, stateTransparent);
 
 			if (m_transitions
 			&& (m_transitionFrame != 0) )
@@ -239,23 +265,42 @@ class ExampleLod : public entry::AppI
 				bgfx::setTexture(0, s_texColor, m_textureBark);
 				bgfx::setTexture(1, s_texStipple, m_textureStipple);
 				bgfx::setUniform(u_stipple, stippleInv);
-				meshSubmit(m_meshTrunk[m_targetLod], 0, m_program, mtx, stateOpaque);
+				submitLod(m_meshTrunk, m_targetLod, mtx, stateOpaque);
 
 				bgfx::setTexture(0, s_texColor, m_textureLeafs);
 				bgfx::setTexture(1, s_texStipple, m_textureStipple);
 				bgfx::setUniform(u_stipple, stippleInv);
-				meshSubmit(m_meshTop[m_targetLod], 0, m_program, mtx, stateTransparent);
+				submitLod(m_meshTop, m_targetLod, mtx, stateTransparent);
 			}
 
 			int lod = 0;
-			if (eye[2] < -2.5f)
+			if (m_generated)
 			{
-				lod = 1;
-			}
+				// LOD error is in mesh space, distance is scaled into mesh
+				// space too.
+				const float pixelScale = float(m_height) / (2.0f*bx::ftan(bx::toRad(60.0f)*0.5f) );
+				const float meshDistance = bx::vec3Length(eye) / scale;
+
+				lod = bx::uint32_min(
+					  meshSelectLod(m_meshTrunk[0], meshDistance, pixelScale, m_maxPixelError)
+					, meshSelectLod(m_meshTop[0],   meshDistance, pixelScale, m_maxPixelError)
+					);
 
-			if (eye[2] < -5.0f)
+				bgfx::dbgTextPrintf(0, 4, 0x0f, "LOD: %d (generated, selected by projected error)", m_currLod);
+			}
+			else
 			{
-				lod = 2;
+				if (eye[2] < -2.5f)
+				{
+					lod = 1;
+				}
+
+				if (eye[2] < -5.0f)
+				{
+					lod = 2;
+				}
+
+				bgfx::dbgTextPrintf(0, 4, 0x0f, "LOD: %d (separate meshes)", m_currLod);
 			}
 
 			if (m_targetLod != lod)
@@ -287,6 +332,18 @@ class ExampleLod : public entry::AppI
 		return false;
 	}
 
+	void submitLod(Mesh** _meshes, int32_t _lod, const float* _mtx, uint64_t _state)
+	{
+		if (m_generated)
+		{
+			meshSubmit(_meshes[0], 0, m_program, _mtx, _state, uint8_t(_lod) );
+		}
+		else
+		{
+			meshSubmit(_meshes[_lod], 0, m_program, _mtx, _state);
+		}
+	}
+
 	entry::MouseState m_mouseState;
 	uint32_t m_width;
 	uint32_t m_height;
@@ -309,7 +366,10 @@ class ExampleLod : public entry::AppI
 	int32_t m_transitionFrame;
 	int32_t m_currLod;
 	int32_t m_targetLod;
+	uint32_t m_numGeneratedLods;
+	float   m_maxPixelError;
 	bool    m_transitions;
+	bool    m_generated;
 };
 
 ENTRY_IMPLEMENT_MAIN(ExampleLod);
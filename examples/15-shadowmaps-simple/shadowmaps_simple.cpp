@@ -82,9 +82,10 @@ int _main_(int _argc, char** _argv)
 		.end();
 
 	// Meshes.
-	Mesh* bunny      = meshLoad("meshes/bunny.bin");
-	Mesh* cube       = meshLoad("meshes/cube.bin");
-	Mesh* hollowcube = meshLoad("meshes/hollowcube.bin");
+	// Shaders dequantize vertex data, see examples/common/mesh.sh.
+	Mesh* bunny      = meshLoad("meshes/bunny.bin",      false, true);
+	Mesh* cube       = meshLoad("meshes/cube.bin",       false, true);
+	Mesh* hollowcube = meshLoad("meshes/hollowcube.bin", false, true);
 
 	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(
 			  bgfx::makeRef(s_hplaneVertices, sizeof(s_hplaneVertices) )
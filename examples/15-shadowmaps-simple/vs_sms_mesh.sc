@@ -7,18 +7,20 @@ $output v_view, v_normal, v_shadowcoord
  */
 
 #include "../common/common.sh"
+#include "../common/mesh.sh"
 
 uniform mat4 u_lightMtx;
 
 void main()
 {
-	gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0) );
+	vec3 pos = meshDequantPosition(a_position);
+	gl_Position = mul(u_modelViewProj, vec4(pos, 1.0) );
 
-	vec4 normal = a_normal * 2.0 - 1.0;
-	v_normal = normalize(mul(u_modelView, vec4(normal.xyz, 0.0) ).xyz);
-	v_view = mul(u_modelView, vec4(a_position, 1.0)).xyz;
+	vec3 normal = meshDecodeNormal(a_normal.xyz);
+	v_normal = normalize(mul(u_modelView, vec4(normal, 0.0) ).xyz);
+	v_view = mul(u_modelView, vec4(pos, 1.0)).xyz;
 
 	const float shadowMapOffset = 0.001;
-	vec3 posOffset = a_position + normal.xyz * shadowMapOffset;
+	vec3 posOffset = pos + normal * shadowMapOffset;
 	v_shadowcoord = mul(u_lightMtx, vec4(posOffset, 1.0) );
 }
@@ -7,9 +7,11 @@ $output v_position
  */
 
 #include "../common/common.sh"
+#include "../common/mesh.sh"
 
 void main()
 {
-	gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0) );
+	vec3 pos = meshDequantPosition(a_position);
+	gl_Position = mul(u_modelViewProj, vec4(pos, 1.0) );
 	v_position = gl_Position;
 }
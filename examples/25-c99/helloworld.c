@@ -27,6 +27,7 @@ int _main_(int _argc, char** _argv)
 			, 0
 			, NULL
 			, NULL
+			, NULL
 			);
 	bgfx_reset(width, height, reset);
 
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "bounds.h"
+#include "camera.h"
+#include "cull/occlusionbuffer.h"
+
+#include <bx/timer.h>
+
+#define OCCLUDERS_DIM 8
+#define CUBES_DIM     64
+#define NUM_CUBES     (CUBES_DIM*CUBES_DIM)
+#define NUM_THREADS   3
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2, // 0
+	1, 3, 2,
+	4, 6, 5, // 2
+	5, 6, 7,
+	0, 2, 4, // 4
+	4, 2, 6,
+	1, 5, 3, // 6
+	5, 7, 3,
+	0, 4, 1, // 8
+	4, 5, 1,
+	2, 3, 6, // 10
+	6, 3, 7,
+};
+
+// Accumulates time spent in benchmarked section, and reports rate once per
+// second.
+struct Rate
+{
+	Rate()
+		: m_time(0)
+		, m_count(0)
+		, m_rate(0.0)
+	{
+	}
+
+	void add(int64_t _time, uint32_t _count)
+	{
+		m_time  += _time;
+		m_count += _count;
+
+		const int64_t freq = bx::getHPFrequency();
+		if (m_time >= freq)
+		{
+			m_rate  = double(m_count)*double(freq)/double(m_time);
+			m_time  = 0;
+			m_count = 0;
+		}
+	}
+
+	int64_t  m_time;
+	uint64_t m_count;
+	double   m_rate;
+};
+
+class ExampleSwOcclusion : public entry::AppI
+{
+	void init(int _argc, char** _argv) BX_OVERRIDE
+	{
+		Args args(_argc, _argv);
+
+		m_width  = 1280;
+		m_height = 720;
+		m_debug  = BGFX_DEBUG_TEXT;
+		m_reset  = BGFX_RESET_VSYNC;
+
+		bgfx::init(args.m_type, args.m_pciId);
+		bgfx::reset(m_width, m_height, m_reset);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+				, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+				, 0x303030ff
+				, 1.0f
+				, 0
+				);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		// Create static vertex buffer.
+		m_vbh = bgfx::createVertexBuffer(
+				// Static data can be passed with bgfx::makeRef
+				bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_decl
+				);
+
+		// Create static index buffer.
+		m_ibh = bgfx::createIndexBuffer(
+				// Static data can be passed with bgfx::makeRef
+				bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) )
+				);
+
+		// Create program from shaders.
+		m_program     = loadProgram("vs_cubes", "fs_cubes");
+		m_meshProgram = loadProgram("vs_mesh",  "fs_mesh");
+
+		u_time = bgfx::createUniform("u_time", bgfx::UniformType::Vec4);
+
+		// Occluder mesh is kept in RAM, so that it can be rasterized on CPU.
+		m_occluder = meshLoad("meshes/column.bin", true);
+
+		m_occlusion = new OcclusionBuffer(256, 128, NUM_THREADS);
+
+		const float offset = -(OCCLUDERS_DIM-1) * 8.0f / 2.0f;
+		for (uint32_t yy = 0; yy < OCCLUDERS_DIM; ++yy)
+		{
+			for (uint32_t xx = 0; xx < OCCLUDERS_DIM; ++xx)
+			{
+				bx::mtxSRT(m_occluderMtx[yy*OCCLUDERS_DIM+xx]
+					, 1.0f, 1.0f, 1.0f
+					, 0.0f, 0.0f, 0.0f
+					, offset + float(xx)*8.0f
+					, 0.0f
+					, offset + float(yy)*8.0f
+					);
+			}
+		}
+
+		const float cubeOffset = -(CUBES_DIM-1) * 1.0f / 2.0f;
+		for (uint32_t yy = 0; yy < CUBES_DIM; ++yy)
+		{
+			for (uint32_t xx = 0; xx < CUBES_DIM; ++xx)
+			{
+				const float pos[3] =
+				{
+					cubeOffset + float(xx),
+					0.25f + float( (xx^yy)&3)*0.5f,
+					cubeOffset + float(yy),
+				};
+
+				Aabb& aabb = m_aabbs[yy*CUBES_DIM+xx];
+				aabb.m_min[0] = pos[0] - 0.25f;
+				aabb.m_min[1] = pos[1] - 0.25f;
+				aabb.m_min[2] = pos[2] - 0.25f;
+				aabb.m_max[0] = pos[0] + 0.25f;
+				aabb.m_max[1] = pos[1] + 0.25f;
+				aabb.m_max[2] = pos[2] + 0.25f;
+			}
+		}
+
+		cameraCreate();
+
+		const float initialPos[3] = { 0.0f, 2.0f, -40.0f };
+		cameraSetPosition(initialPos);
+
+		m_numVisible = 0;
+	}
+
+	virtual int shutdown() BX_OVERRIDE
+	{
+		// Cleanup.
+		cameraDestroy();
+
+		delete m_occlusion;
+		meshUnload(m_occluder);
+
+		bgfx::destroyIndexBuffer(m_ibh);
+		bgfx::destroyVertexBuffer(m_vbh);
+		bgfx::destroyProgram(m_program);
+		bgfx::destroyProgram(m_meshProgram);
+		bgfx::destroyUniform(u_time);
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	bool update() BX_OVERRIDE
+	{
+		if (!entry::processWindowEvents(m_state, m_debug, m_reset) )
+		{
+			int64_t now = bx::getHPCounter();
+			static int64_t last = now;
+			const int64_t frameTime = now - last;
+			last = now;
+			const double freq = double(bx::getHPFrequency() );
+			const double toMs = 1000.0/freq;
+			const float deltaTime = float(frameTime/freq);
+
+			m_width  = m_state.m_width;
+			m_height = m_state.m_height;
+
+			// Update camera.
+			float view[16];
+			cameraUpdate(deltaTime, m_state.m_mouse);
+			cameraGetViewMtx(view);
+
+			const bgfx::Caps* caps = bgfx::getCaps();
+
+			float proj[16];
+			bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 1000.0f, caps->homogeneousDepth);
+
+			bgfx::setViewTransform(0, view, proj);
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			float viewProj[16];
+			bx::mtxMul(viewProj, view, proj);
+
+			// Rasterize occluders.
+			int64_t rasterizeTime = -bx::getHPCounter();
+
+			m_occlusion->begin(viewProj, caps->homogeneousDepth);
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_occluderMtx); ++ii)
+			{
+				m_occlusion->rasterize(m_occluder, m_occluderMtx[ii]);
+			}
+			m_occlusion->end();
+
+			rasterizeTime += bx::getHPCounter();
+			m_occluderRate.add(rasterizeTime, m_occlusion->getNumOccluders() );
+			m_triangleRate.add(rasterizeTime, m_occlusion->getNumTriangles() );
+
+			// Test all cubes.
+			int64_t queryTime = -bx::getHPCounter();
+			m_numVisible = m_occlusion->testAabbs(m_visible, m_aabbs, NUM_CUBES);
+			queryTime += bx::getHPCounter();
+			m_queryRate.add(queryTime, NUM_CUBES);
+
+			// Use debug font to print information about this example.
+			bgfx::dbgTextClear();
+			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/34-swocclusion");
+			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: CPU occlusion culling with SIMD software rasterizer.");
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+			bgfx::dbgTextPrintf(0, 5, 0x0f, "Occlusion buffer: %dx%d, %d worker threads."
+				, m_occlusion->getPyramid().getWidth()
+				, m_occlusion->getPyramid().getHeight()
+				, m_occlusion->getNumThreads()
+				);
+			bgfx::dbgTextPrintf(0, 6, 0x0f, "Rasterize: % 7.3f[ms], %d occluders, %d triangles."
+				, double(rasterizeTime)*toMs
+				, m_occlusion->getNumOccluders()
+				, m_occlusion->getNumTriangles()
+				);
+			bgfx::dbgTextPrintf(0, 7, 0x0f, "    Query: % 7.3f[ms], %d/%d visible."
+				, double(queryTime)*toMs
+				, m_numVisible
+				, NUM_CUBES
+				);
+			bgfx::dbgTextPrintf(0, 8, 0x0f, "Occluders/s: %12.0f", m_occluderRate.m_rate);
+			bgfx::dbgTextPrintf(0, 9, 0x0f, "Triangles/s: %12.0f", m_triangleRate.m_rate);
+			bgfx::dbgTextPrintf(0,10, 0x0f, "  Queries/s: %12.0f", m_queryRate.m_rate);
+
+			// Submit occluders.
+			const float time[4] = {};
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_occluderMtx); ++ii)
+			{
+				bgfx::setUniform(u_time, time);
+				meshSubmit(m_occluder, 0, m_meshProgram, m_occluderMtx[ii]);
+			}
+
+			// Submit only cubes that passed occlusion test.
+			for (uint32_t ii = 0; ii < m_numVisible; ++ii)
+			{
+				const Aabb& aabb = m_aabbs[m_visible[ii] ];
+
+				float mtx[16];
+				bx::mtxSRT(mtx
+					, 0.25f, 0.25f, 0.25f
+					, 0.0f, 0.0f, 0.0f
+					, (aabb.m_min[0] + aabb.m_max[0])*0.5f
+					, (aabb.m_min[1] + aabb.m_max[1])*0.5f
+					, (aabb.m_min[2] + aabb.m_max[2])*0.5f
+					);
+
+				bgfx::setTransform(mtx);
+				bgfx::setVertexBuffer(0, m_vbh);
+				bgfx::setIndexBuffer(m_ibh);
+				bgfx::setState(BGFX_STATE_DEFAULT);
+				bgfx::submit(0, m_program);
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+	bgfx::ProgramHandle m_meshProgram;
+	bgfx::UniformHandle u_time;
+
+	Mesh* m_occluder;
+	OcclusionBuffer* m_occlusion;
+
+	float m_occluderMtx[OCCLUDERS_DIM*OCCLUDERS_DIM][16];
+	Aabb m_aabbs[NUM_CUBES];
+	uint32_t m_visible[NUM_CUBES];
+	uint32_t m_numVisible;
+
+	Rate m_occluderRate;
+	Rate m_triangleRate;
+	Rate m_queryRate;
+
+	entry::WindowState m_state;
+};
+
+ENTRY_IMPLEMENT_MAIN(ExampleSwOcclusion);
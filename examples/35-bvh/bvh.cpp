@@ -0,0 +1,422 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "bounds.h"
+#include "bvh.h"
+#include "camera.h"
+#include <debugdraw/debugdraw.h>
+
+#include <bx/rng.h>
+#include <bx/timer.h>
+
+#define NUM_BOXES      32768
+#define NUM_RAYS       1024
+#define REBUILD_FRAMES 256
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2, // 0
+	1, 3, 2,
+	4, 6, 5, // 2
+	5, 6, 7,
+	0, 2, 4, // 4
+	4, 2, 6,
+	1, 5, 3, // 6
+	5, 7, 3,
+	0, 4, 1, // 8
+	4, 5, 1,
+	2, 3, 6, // 10
+	6, 3, 7,
+};
+
+// Accumulates time spent in benchmarked section, and reports rate once per
+// second.
+struct Rate
+{
+	Rate()
+		: m_time(0)
+		, m_count(0)
+		, m_rate(0.0)
+	{
+	}
+
+	void add(int64_t _time, uint32_t _count)
+	{
+		m_time  += _time;
+		m_count += _count;
+
+		const int64_t freq = bx::getHPFrequency();
+		if (m_time >= freq)
+		{
+			m_rate  = double(m_count)*double(freq)/double(m_time);
+			m_time  = 0;
+			m_count = 0;
+		}
+	}
+
+	int64_t  m_time;
+	uint64_t m_count;
+	double   m_rate;
+};
+
+class ExampleBvh : public entry::AppI
+{
+	void init(int _argc, char** _argv) BX_OVERRIDE
+	{
+		Args args(_argc, _argv);
+
+		m_width  = 1280;
+		m_height = 720;
+		m_debug  = BGFX_DEBUG_TEXT;
+		m_reset  = BGFX_RESET_VSYNC;
+
+		bgfx::init(args.m_type, args.m_pciId);
+		bgfx::reset(m_width, m_height, m_reset);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+				, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+				, 0x303030ff
+				, 1.0f
+				, 0
+				);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		// Create static vertex buffer.
+		m_vbh = bgfx::createVertexBuffer(
+				// Static data can be passed with bgfx::makeRef
+				bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_decl
+				);
+
+		// Create static index buffer.
+		m_ibh = bgfx::createIndexBuffer(
+				// Static data can be passed with bgfx::makeRef
+				bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) )
+				);
+
+		// Create program from shaders.
+		m_program = loadProgram("vs_cubes", "fs_cubes");
+
+		ddInit();
+
+		bx::RngMwc rng;
+		for (uint32_t ii = 0; ii < NUM_BOXES; ++ii)
+		{
+			float* pos = m_pos[ii];
+			pos[0] = bx::frndh(&rng)*100.0f;
+			pos[1] = bx::frndh(&rng)*20.0f;
+			pos[2] = bx::frndh(&rng)*100.0f;
+
+			float* size = m_size[ii];
+			size[0] = 0.1f + bx::frnd(&rng)*0.4f;
+			size[1] = 0.1f + bx::frnd(&rng)*0.4f;
+			size[2] = 0.1f + bx::frnd(&rng)*0.4f;
+
+			m_phase[ii] = bx::frnd(&rng)*bx::pi*2.0f;
+		}
+
+		updateAabbs(0.0f);
+
+		m_buildTime = -bx::getHPCounter();
+		m_bvh.build(m_aabbs, NUM_BOXES);
+		m_buildTime += bx::getHPCounter();
+
+		cameraCreate();
+
+		const float initialPos[3] = { 0.0f, 10.0f, -60.0f };
+		cameraSetPosition(initialPos);
+
+		m_numVisible = 0;
+		m_frame      = 0;
+		m_timeOffset = bx::getHPCounter();
+	}
+
+	virtual int shutdown() BX_OVERRIDE
+	{
+		// Cleanup.
+		cameraDestroy();
+
+		ddShutdown();
+
+		bgfx::destroyIndexBuffer(m_ibh);
+		bgfx::destroyVertexBuffer(m_vbh);
+		bgfx::destroyProgram(m_program);
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	void updateAabbs(float _time)
+	{
+		for (uint32_t ii = 0; ii < NUM_BOXES; ++ii)
+		{
+			const float* pos  = m_pos[ii];
+			const float* size = m_size[ii];
+			const float  yy   = pos[1] + bx::fsin(_time + m_phase[ii]);
+
+			Aabb& aabb = m_aabbs[ii];
+			aabb.m_min[0] = pos[0] - size[0];
+			aabb.m_min[1] = yy     - size[1];
+			aabb.m_min[2] = pos[2] - size[2];
+			aabb.m_max[0] = pos[0] + size[0];
+			aabb.m_max[1] = yy     + size[1];
+			aabb.m_max[2] = pos[2] + size[2];
+		}
+	}
+
+	bool update() BX_OVERRIDE
+	{
+		if (!entry::processWindowEvents(m_state, m_debug, m_reset) )
+		{
+			int64_t now = bx::getHPCounter();
+			static int64_t last = now;
+			const int64_t frameTime = now - last;
+			last = now;
+			const double freq = double(bx::getHPFrequency() );
+			const double toMs = 1000.0/freq;
+			const float deltaTime = float(frameTime/freq);
+			const float time = float( (now - m_timeOffset)/freq);
+
+			m_width  = m_state.m_width;
+			m_height = m_state.m_height;
+
+			// Update camera.
+			float view[16];
+			cameraUpdate(deltaTime, m_state.m_mouse);
+			cameraGetViewMtx(view);
+
+			const bgfx::Caps* caps = bgfx::getCaps();
+
+			float proj[16];
+			bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 1000.0f, caps->homogeneousDepth);
+
+			bgfx::setViewTransform(0, view, proj);
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			float viewProj[16];
+			bx::mtxMul(viewProj, view, proj);
+
+			float invViewProj[16];
+			bx::mtxInverse(invViewProj, viewProj);
+
+			// Animate boxes, and refit tree. Refitted tree gets worse over
+			// time, so it's periodically rebuilt.
+			updateAabbs(time);
+
+			int64_t refitTime = 0;
+			if (0 == ++m_frame % REBUILD_FRAMES)
+			{
+				m_buildTime = -bx::getHPCounter();
+				m_bvh.build(m_aabbs, NUM_BOXES);
+				m_buildTime += bx::getHPCounter();
+			}
+			else
+			{
+				refitTime = -bx::getHPCounter();
+				m_bvh.refit(m_aabbs);
+				refitTime += bx::getHPCounter();
+				m_refitRate.add(refitTime, NUM_BOXES);
+			}
+
+			// Frustum query with BVH.
+			Plane planes[6];
+			buildFrustumPlanes(planes, viewProj);
+
+			int64_t queryTime = -bx::getHPCounter();
+			m_numVisible = m_bvh.query(m_visible, planes);
+			queryTime += bx::getHPCounter();
+			m_queryRate.add(queryTime, 1);
+
+			// Same query by testing all boxes, for comparison.
+			int64_t linearTime = -bx::getHPCounter();
+			uint32_t numLinear = 0;
+			for (uint32_t ii = 0; ii < NUM_BOXES; ++ii)
+			{
+				numLinear += aabbFrustumTest(m_aabbs[ii], planes);
+			}
+			linearTime += bx::getHPCounter();
+			m_linearRate.add(linearTime, 1);
+
+			// Cast batch of random rays through view frustum.
+			for (uint32_t ii = 0; ii < NUM_RAYS; ++ii)
+			{
+				m_rays[ii] = makeRay(bx::frndh(&m_rng), bx::frndh(&m_rng), invViewProj);
+			}
+
+			int64_t rayTime = -bx::getHPCounter();
+			const uint32_t numHits = m_bvh.intersect(m_hits, NULL, m_rays, NUM_RAYS);
+			rayTime += bx::getHPCounter();
+			m_rayRate.add(rayTime, NUM_RAYS);
+
+			// Pick box under mouse cursor.
+			const Ray ray = makeRay(
+				  (float(m_state.m_mouse.m_mx)/float(m_width)  * 2.0f - 1.0f)
+				, -(float(m_state.m_mouse.m_my)/float(m_height) * 2.0f - 1.0f)
+				, invViewProj
+				);
+
+			Intersection intersection;
+			const uint32_t picked = m_bvh.intersect(ray, &intersection);
+
+			// Use debug font to print information about this example.
+			bgfx::dbgTextClear();
+			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/35-bvh");
+			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Bounding volume hierarchy for frustum culling and ray picking.");
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+			bgfx::dbgTextPrintf(0, 5, 0x0f, "   BVH: %d boxes, %d nodes.", m_bvh.getNumPrimitives(), m_bvh.getNumNodes() );
+			bgfx::dbgTextPrintf(0, 6, 0x0f, " Build: % 7.3f[ms]", double(m_buildTime)*toMs);
+			bgfx::dbgTextPrintf(0, 7, 0x0f, " Refit: % 7.3f[ms], %12.0f boxes/s", double(refitTime)*toMs, m_refitRate.m_rate);
+			bgfx::dbgTextPrintf(0, 8, 0x0f, " Query: % 7.3f[ms], %8.0f queries/s, %d/%d visible."
+				, double(queryTime)*toMs
+				, m_queryRate.m_rate
+				, m_numVisible
+				, NUM_BOXES
+				);
+			bgfx::dbgTextPrintf(0, 9, 0x0f, "Linear: % 7.3f[ms], %8.0f queries/s, %d/%d visible."
+				, double(linearTime)*toMs
+				, m_linearRate.m_rate
+				, numLinear
+				, NUM_BOXES
+				);
+			bgfx::dbgTextPrintf(0,10, 0x0f, "  Rays: % 7.3f[ms], %12.0f rays/s, %d/%d hits."
+				, double(rayTime)*toMs
+				, m_rayRate.m_rate
+				, numHits
+				, NUM_RAYS
+				);
+
+			if (UINT32_MAX != picked)
+			{
+				bgfx::dbgTextPrintf(0, 11, 0x0f, "Picked: %d at %.2f distance.", picked, intersection.m_dist);
+			}
+
+			// Submit only boxes that are inside view frustum.
+			for (uint32_t ii = 0; ii < m_numVisible; ++ii)
+			{
+				const uint32_t idx = m_visible[ii];
+				const Aabb& aabb = m_aabbs[idx];
+				const float* size = m_size[idx];
+
+				float mtx[16];
+				bx::mtxSRT(mtx
+					, size[0], size[1], size[2]
+					, 0.0f, 0.0f, 0.0f
+					, (aabb.m_min[0] + aabb.m_max[0])*0.5f
+					, (aabb.m_min[1] + aabb.m_max[1])*0.5f
+					, (aabb.m_min[2] + aabb.m_max[2])*0.5f
+					);
+
+				bgfx::setTransform(mtx);
+				bgfx::setVertexBuffer(0, m_vbh);
+				bgfx::setIndexBuffer(m_ibh);
+				bgfx::setState(BGFX_STATE_DEFAULT);
+				bgfx::submit(0, m_program);
+			}
+
+			if (UINT32_MAX != picked)
+			{
+				Aabb aabb = m_aabbs[picked];
+				aabb.m_min[0] -= 0.05f;
+				aabb.m_min[1] -= 0.05f;
+				aabb.m_min[2] -= 0.05f;
+				aabb.m_max[0] += 0.05f;
+				aabb.m_max[1] += 0.05f;
+				aabb.m_max[2] += 0.05f;
+
+				ddBegin(0);
+				ddSetColor(0xff00ffff);
+				ddSetWireframe(true);
+				ddDraw(aabb);
+				ddEnd();
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+
+	Bvh m_bvh;
+	bx::RngMwc m_rng;
+
+	float m_pos[NUM_BOXES][3];
+	float m_size[NUM_BOXES][3];
+	float m_phase[NUM_BOXES];
+	Aabb m_aabbs[NUM_BOXES];
+	uint32_t m_visible[NUM_BOXES];
+	uint32_t m_numVisible;
+
+	Ray m_rays[NUM_RAYS];
+	uint32_t m_hits[NUM_RAYS];
+
+	int64_t m_timeOffset;
+	int64_t m_buildTime;
+	uint32_t m_frame;
+
+	Rate m_refitRate;
+	Rate m_queryRate;
+	Rate m_linearRate;
+	Rate m_rayRate;
+
+	entry::WindowState m_state;
+};
+
+ENTRY_IMPLEMENT_MAIN(ExampleBvh);
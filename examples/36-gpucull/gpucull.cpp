@@ -0,0 +1,306 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "bounds.h"
+#include "camera.h"
+#include "cull/gpucull.h"
+
+#include <bx/rng.h>
+#include <bx/timer.h>
+
+#define GRID_SIZE       32
+#define NUM_INSTANCES   (GRID_SIZE*GRID_SIZE*GRID_SIZE)
+#define INSTANCE_STRIDE 5
+
+#define VIEW_CULL 0
+#define VIEW_DRAW 1
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2, // 0
+	1, 3, 2,
+	4, 6, 5, // 2
+	5, 6, 7,
+	0, 2, 4, // 4
+	4, 2, 6,
+	1, 5, 3, // 6
+	5, 7, 3,
+	0, 4, 1, // 8
+	4, 5, 1,
+	2, 3, 6, // 10
+	6, 3, 7,
+};
+
+class ExampleGpuCull : public entry::AppI
+{
+	void init(int _argc, char** _argv) BX_OVERRIDE
+	{
+		Args args(_argc, _argv);
+
+		m_width  = 1280;
+		m_height = 720;
+		m_debug  = BGFX_DEBUG_TEXT;
+		m_reset  = BGFX_RESET_VSYNC;
+
+		bgfx::init(args.m_type, args.m_pciId);
+		bgfx::reset(m_width, m_height, m_reset);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set draw view clear state.
+		bgfx::setViewClear(VIEW_DRAW
+				, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+				, 0x303030ff
+				, 1.0f
+				, 0
+				);
+
+		m_cull = NULL;
+		m_vbh.idx = bgfx::invalidHandle;
+		m_ibh.idx = bgfx::invalidHandle;
+		m_program.idx = bgfx::invalidHandle;
+
+		m_supported = GpuCull::isSupported();
+		if (m_supported)
+		{
+			// Create vertex stream declaration.
+			PosColorVertex::init();
+
+			// Create static vertex buffer.
+			m_vbh = bgfx::createVertexBuffer(
+					  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+					, PosColorVertex::ms_decl
+					);
+
+			// Create static index buffer.
+			m_ibh = bgfx::createIndexBuffer(
+					bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) )
+					);
+
+			// Instance data layout matches vs_instancing: model matrix
+			// followed by color.
+			m_program = loadProgram("vs_instancing", "fs_instancing");
+
+			m_cull = new GpuCull(NUM_INSTANCES, INSTANCE_STRIDE);
+			createInstances();
+		}
+
+		cameraCreate();
+
+		const float initialPos[3] = { 0.0f, 0.0f, -80.0f };
+		cameraSetPosition(initialPos);
+
+		m_timeOffset = bx::getHPCounter();
+	}
+
+	virtual int shutdown() BX_OVERRIDE
+	{
+		// Cleanup.
+		cameraDestroy();
+
+		if (m_supported)
+		{
+			delete m_cull;
+
+			bgfx::destroyIndexBuffer(m_ibh);
+			bgfx::destroyVertexBuffer(m_vbh);
+
+			if (bgfx::isValid(m_program) )
+			{
+				bgfx::destroyProgram(m_program);
+			}
+		}
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	// Instances are static, so bounds and instance data are uploaded only
+	// once.
+	void createInstances()
+	{
+		Aabb* bounds = new Aabb[NUM_INSTANCES];
+		float* data  = new float[NUM_INSTANCES*INSTANCE_STRIDE*4];
+
+		bx::RngMwc rng;
+		const float offset = -float(GRID_SIZE-1)*1.5f;
+
+		for (uint32_t ii = 0; ii < NUM_INSTANCES; ++ii)
+		{
+			const uint32_t xx = ii % GRID_SIZE;
+			const uint32_t yy = (ii / GRID_SIZE) % GRID_SIZE;
+			const uint32_t zz = ii / (GRID_SIZE*GRID_SIZE);
+
+			const float scale = 0.25f + bx::frnd(&rng)*0.5f;
+			const float pos[3] =
+			{
+				offset + float(xx)*3.0f,
+				offset + float(yy)*3.0f,
+				offset + float(zz)*3.0f,
+			};
+
+			float* mtx = &data[ii*INSTANCE_STRIDE*4];
+			bx::mtxSRT(mtx
+				, scale, scale, scale
+				, bx::frnd(&rng)*bx::pi, bx::frnd(&rng)*bx::pi, 0.0f
+				, pos[0], pos[1], pos[2]
+				);
+
+			float* color = &mtx[16];
+			color[0] = float(xx)/float(GRID_SIZE-1);
+			color[1] = float(yy)/float(GRID_SIZE-1);
+			color[2] = float(zz)/float(GRID_SIZE-1);
+			color[3] = 1.0f;
+
+			// Rotated unit cube fits into sphere with radius sqrt(3).
+			const float radius = scale*1.7320508f;
+			Aabb& aabb = bounds[ii];
+			aabb.m_min[0] = pos[0] - radius;
+			aabb.m_min[1] = pos[1] - radius;
+			aabb.m_min[2] = pos[2] - radius;
+			aabb.m_max[0] = pos[0] + radius;
+			aabb.m_max[1] = pos[1] + radius;
+			aabb.m_max[2] = pos[2] + radius;
+		}
+
+		m_cull->update(bounds, data, NUM_INSTANCES);
+
+		delete [] bounds;
+		delete [] data;
+	}
+
+	bool update() BX_OVERRIDE
+	{
+		if (!entry::processWindowEvents(m_state, m_debug, m_reset) )
+		{
+			int64_t now = bx::getHPCounter();
+			static int64_t last = now;
+			const int64_t frameTime = now - last;
+			last = now;
+			const double freq = double(bx::getHPFrequency() );
+			const double toMs = 1000.0/freq;
+			const float deltaTime = float(frameTime/freq);
+			const float time = float( (now - m_timeOffset)/freq);
+
+			m_width  = m_state.m_width;
+			m_height = m_state.m_height;
+
+			// Use debug font to print information about this example.
+			bgfx::dbgTextClear();
+			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/36-gpucull");
+			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: GPU driven instance culling with indirect draw.");
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+
+			bgfx::setViewRect(VIEW_DRAW, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			// This dummy draw call is here to make sure that draw view is
+			// cleared if no other draw calls are submitted to it.
+			bgfx::touch(VIEW_DRAW);
+
+			if (!m_supported)
+			{
+				bool blink = uint32_t(time*3.0f)&1;
+				bgfx::dbgTextPrintf(0, 5, blink ? 0x1f : 0x01, " Compute, draw indirect or instancing is not supported by GPU. ");
+			}
+			else if (!m_cull->isValid()
+				 ||  !bgfx::isValid(m_program) )
+			{
+				bool blink = uint32_t(time*3.0f)&1;
+				bgfx::dbgTextPrintf(0, 5, blink ? 0x1f : 0x01, " Shader binaries are missing, build them with examples/common/cull/makefile. ");
+			}
+			else
+			{
+				// Update camera.
+				float view[16];
+				cameraUpdate(deltaTime, m_state.m_mouse);
+				cameraGetViewMtx(view);
+
+				float proj[16];
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 500.0f, bgfx::getCaps()->homogeneousDepth);
+
+				bgfx::setViewTransform(VIEW_DRAW, view, proj);
+
+				float viewProj[16];
+				bx::mtxMul(viewProj, view, proj);
+
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Instances: %d, visible count stays on GPU.", NUM_INSTANCES);
+
+				// Cull view is processed before draw view, so that compacted
+				// instance data and indirect arguments are ready for draw.
+				m_cull->dispatch(VIEW_CULL, viewProj, BX_COUNTOF(s_cubeIndices) );
+
+				bgfx::setVertexBuffer(0, m_vbh);
+				bgfx::setIndexBuffer(m_ibh);
+				m_cull->setInstanceDataBuffer();
+				bgfx::setState(BGFX_STATE_DEFAULT);
+				bgfx::submit(VIEW_DRAW, m_program, m_cull->getIndirectBuffer(), 0);
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+
+	GpuCull* m_cull;
+	bool m_supported;
+
+	int64_t m_timeOffset;
+
+	entry::WindowState m_state;
+};
+
+ENTRY_IMPLEMENT_MAIN(ExampleGpuCull);
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#define GRID_SIZE 32
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xffffffff },
+	{ 1.0f,  1.0f,  1.0f, 0xffcccccc },
+	{-1.0f, -1.0f,  1.0f, 0xff999999 },
+	{ 1.0f, -1.0f,  1.0f, 0xff666666 },
+	{-1.0f,  1.0f, -1.0f, 0xffffffff },
+	{ 1.0f,  1.0f, -1.0f, 0xffcccccc },
+	{-1.0f, -1.0f, -1.0f, 0xff999999 },
+	{ 1.0f, -1.0f, -1.0f, 0xff666666 },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2, // 0
+	1, 3, 2,
+	4, 6, 5, // 2
+	5, 6, 7,
+	0, 2, 4, // 4
+	4, 2, 6,
+	1, 5, 3, // 6
+	5, 7, 3,
+	0, 4, 1, // 8
+	4, 5, 1,
+	2, 3, 6, // 10
+	6, 3, 7,
+};
+
+class ExampleMultiDraw : public entry::AppI
+{
+	void init(int _argc, char** _argv) BX_OVERRIDE
+	{
+		Args args(_argc, _argv);
+
+		m_width  = 1280;
+		m_height = 720;
+		m_debug  = BGFX_DEBUG_TEXT;
+		m_reset  = BGFX_RESET_VSYNC|BGFX_RESET_MULTI_DRAW_BATCH;
+
+		bgfx::init(args.m_type, args.m_pciId);
+		bgfx::reset(m_width, m_height, m_reset);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+				, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+				, 0x303030ff
+				, 1.0f
+				, 0
+				);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		// Create static vertex buffer.
+		m_vbh = bgfx::createVertexBuffer(
+				  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_decl
+				);
+
+		// Create static index buffer.
+		m_ibh = bgfx::createIndexBuffer(
+				bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) )
+				);
+
+		// Per-draw tint. With draw data it's passed per draw, and doesn't
+		// break multi-draw run.
+		u_drawParams = bgfx::createUniform("u_drawParams", bgfx::UniformType::Vec4);
+
+		// Vertex shader reads transform and tint through DRAW_DATA_BUFFER.
+		// GLSL version of it requires BGFX_CAPS_DRAW_DATA.
+		const bgfx::Caps* caps = bgfx::getCaps();
+		m_supported = false
+			|| 0 != (caps->supported & BGFX_CAPS_DRAW_DATA)
+			|| (bgfx::RendererType::OpenGL   != caps->rendererType
+			&&  bgfx::RendererType::OpenGLES != caps->rendererType)
+			;
+
+		m_program.idx = bgfx::invalidHandle;
+		if (m_supported)
+		{
+			// Program is invalid when shader binaries are not built, see
+			// examples/37-multidraw/makefile.
+			m_program = loadProgram("vs_multidraw", "fs_multidraw");
+		}
+
+		imguiCreate();
+
+		m_scrollArea = 0;
+		m_timeOffset = bx::getHPCounter();
+	}
+
+	virtual int shutdown() BX_OVERRIDE
+	{
+		imguiDestroy();
+
+		// Cleanup.
+		bgfx::destroyIndexBuffer(m_ibh);
+		bgfx::destroyVertexBuffer(m_vbh);
+		bgfx::destroyUniform(u_drawParams);
+
+		if (bgfx::isValid(m_program) )
+		{
+			bgfx::destroyProgram(m_program);
+		}
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	bool update() BX_OVERRIDE
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			int64_t now = bx::getHPCounter();
+			static int64_t last = now;
+			const int64_t frameTime = now - last;
+			last = now;
+			const double freq = double(bx::getHPFrequency() );
+			const double toMs = 1000.0/freq;
+			const float time = float( (now-m_timeOffset)/freq);
+
+			const bgfx::Stats* stats = bgfx::getStats();
+
+			imguiBeginFrame(m_mouseState.m_mx
+				, m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				, m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			imguiBeginScrollArea("Settings", m_width - m_width / 4 - 10, 10, m_width / 4, m_height / 3, &m_scrollArea);
+
+			bool batch = 0 != (m_reset & BGFX_RESET_MULTI_DRAW_BATCH);
+			if (imguiCheck("Multi-draw batch", batch) )
+			{
+				m_reset ^= BGFX_RESET_MULTI_DRAW_BATCH;
+			}
+
+			imguiSeparatorLine();
+			imguiLabel("Draw calls: %d", GRID_SIZE*GRID_SIZE);
+			imguiLabel("GPU %0.6f [ms]", double(stats->gpuTimeEnd - stats->gpuTimeBegin)*1000.0/stats->gpuTimerFreq);
+			imguiLabel("CPU %0.6f [ms]", double(stats->cpuTimeEnd - stats->cpuTimeBegin)*1000.0/stats->cpuTimerFreq);
+
+			imguiEndScrollArea();
+			imguiEndFrame();
+
+			// Set view 0 default viewport.
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			// This dummy draw call is here to make sure that view 0 is cleared
+			// if no other draw calls are submitted to view 0.
+			bgfx::touch(0);
+
+			// Use debug font to print information about this example.
+			bgfx::dbgTextClear();
+			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/37-multidraw");
+			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Per-draw transform and tint in multi-draw batch.");
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+
+			if (!m_supported)
+			{
+				bool blink = uint32_t(time*3.0f)&1;
+				bgfx::dbgTextPrintf(0, 5, blink ? 0x1f : 0x01, " Per-draw data is not supported by GPU. ");
+			}
+			else if (!bgfx::isValid(m_program) )
+			{
+				bool blink = uint32_t(time*3.0f)&1;
+				bgfx::dbgTextPrintf(0, 5, blink ? 0x1f : 0x01, " Shader binaries are missing, build them with makefile in this example directory. ");
+			}
+			else
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Toggle stats (F1) to see multi-draw count on OpenGL.");
+
+				float at[3]  = { 0.0f, 0.0f,   0.0f };
+				float eye[3] = { 0.0f, 0.0f, -90.0f };
+
+				float view[16];
+				bx::mtxLookAt(view, eye, at);
+
+				float proj[16];
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 200.0f, bgfx::getCaps()->homogeneousDepth);
+				bgfx::setViewTransform(0, view, proj);
+
+				const float offset = -float(GRID_SIZE-1)*1.5f;
+
+				// Every cube has own transform and tint. Everything else
+				// matches, so sorted draws form multi-draw runs.
+				for (uint32_t yy = 0; yy < GRID_SIZE; ++yy)
+				{
+					for (uint32_t xx = 0; xx < GRID_SIZE; ++xx)
+					{
+						float mtx[16];
+						bx::mtxRotateXY(mtx, time + xx*0.21f, time + yy*0.37f);
+						mtx[12] = offset + float(xx)*3.0f;
+						mtx[13] = offset + float(yy)*3.0f;
+						mtx[14] = 0.0f;
+
+						const float tint[4] =
+						{
+							float(xx)/float(GRID_SIZE-1),
+							float(yy)/float(GRID_SIZE-1),
+							0.5f,
+							1.0f,
+						};
+
+						bgfx::setTransform(mtx);
+						bgfx::setUniform(u_drawParams, tint);
+						bgfx::setVertexBuffer(0, m_vbh);
+						bgfx::setIndexBuffer(m_ibh);
+						bgfx::setState(BGFX_STATE_DEFAULT);
+						bgfx::submit(0, m_program);
+					}
+				}
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+	bgfx::UniformHandle u_drawParams;
+	bool m_supported;
+
+	int64_t m_timeOffset;
+	int32_t m_scrollArea;
+	entry::MouseState m_mouseState;
+};
+
+ENTRY_IMPLEMENT_MAIN(ExampleMultiDraw);
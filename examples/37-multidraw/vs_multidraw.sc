@@ -0,0 +1,18 @@
+$input a_position, a_color0
+$output v_color0
+
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "../common/common.sh"
+
+DRAW_DATA_BUFFER;
+
+void main()
+{
+	vec4 wpos = mul(drawModel(), vec4(a_position, 1.0) );
+	gl_Position = mul(u_viewProj, wpos);
+	v_color0 = a_color0 * drawParams();
+}
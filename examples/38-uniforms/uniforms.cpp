@@ -0,0 +1,307 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#define GRID_SIZE  32
+#define NUM_PARAMS 16
+#define NUM_FRAMES 128
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xffffffff },
+	{ 1.0f,  1.0f,  1.0f, 0xffcccccc },
+	{-1.0f, -1.0f,  1.0f, 0xff999999 },
+	{ 1.0f, -1.0f,  1.0f, 0xff666666 },
+	{-1.0f,  1.0f, -1.0f, 0xffffffff },
+	{ 1.0f,  1.0f, -1.0f, 0xffcccccc },
+	{-1.0f, -1.0f, -1.0f, 0xff999999 },
+	{ 1.0f, -1.0f, -1.0f, 0xff666666 },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2, // 0
+	1, 3, 2,
+	4, 6, 5, // 2
+	5, 6, 7,
+	0, 2, 4, // 4
+	4, 2, 6,
+	1, 5, 3, // 6
+	5, 7, 3,
+	0, 4, 1, // 8
+	4, 5, 1,
+	2, 3, 6, // 10
+	6, 3, 7,
+};
+
+class ExampleUniforms : public entry::AppI
+{
+	void init(int _argc, char** _argv) BX_OVERRIDE
+	{
+		Args args(_argc, _argv);
+
+		m_width  = 1280;
+		m_height = 720;
+		m_debug  = BGFX_DEBUG_TEXT;
+		m_reset  = BGFX_RESET_NONE;
+
+		bgfx::init(args.m_type, args.m_pciId);
+		bgfx::reset(m_width, m_height, m_reset);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+				, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+				, 0x303030ff
+				, 1.0f
+				, 0
+				);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		// Create static vertex buffer.
+		m_vbh = bgfx::createVertexBuffer(
+				  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_decl
+				);
+
+		// Create static index buffer.
+		m_ibh = bgfx::createIndexBuffer(
+				bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) )
+				);
+
+		u_params = bgfx::createUniform("u_params", bgfx::UniformType::Vec4, NUM_PARAMS);
+
+		// Program is invalid when shader binaries are not built, see
+		// examples/38-uniforms/makefile.
+		m_program = loadProgram("vs_uniforms", "fs_uniforms");
+
+		m_numParams = NUM_PARAMS;
+		resetTiming();
+
+		imguiCreate();
+
+		m_scrollArea = 0;
+		m_timeOffset = bx::getHPCounter();
+	}
+
+	virtual int shutdown() BX_OVERRIDE
+	{
+		imguiDestroy();
+
+		// Cleanup.
+		bgfx::destroyIndexBuffer(m_ibh);
+		bgfx::destroyVertexBuffer(m_vbh);
+		bgfx::destroyUniform(u_params);
+
+		if (bgfx::isValid(m_program) )
+		{
+			bgfx::destroyProgram(m_program);
+		}
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	void resetTiming()
+	{
+		m_numFrames = 0;
+		m_cpuTime   = 0.0;
+		m_gpuTime   = 0.0;
+		m_cpuAvg    = 0.0;
+		m_gpuAvg    = 0.0;
+	}
+
+	// Render thread time is averaged over NUM_FRAMES frames, so that builds
+	// with different uniform upload paths can be compared.
+	void updateTiming(const bgfx::Stats* _stats)
+	{
+		m_cpuTime += double(_stats->cpuTimeEnd - _stats->cpuTimeBegin)*1000.0/_stats->cpuTimerFreq;
+		m_gpuTime += 0 != _stats->gpuTimerFreq
+			? double(_stats->gpuTimeEnd - _stats->gpuTimeBegin)*1000.0/_stats->gpuTimerFreq
+			: 0.0
+			;
+
+		if (++m_numFrames == NUM_FRAMES)
+		{
+			m_cpuAvg    = m_cpuTime/NUM_FRAMES;
+			m_gpuAvg    = m_gpuTime/NUM_FRAMES;
+			m_numFrames = 0;
+			m_cpuTime   = 0.0;
+			m_gpuTime   = 0.0;
+		}
+	}
+
+	bool update() BX_OVERRIDE
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			int64_t now = bx::getHPCounter();
+			static int64_t last = now;
+			const int64_t frameTime = now - last;
+			last = now;
+			const double freq = double(bx::getHPFrequency() );
+			const double toMs = 1000.0/freq;
+			const float time = float( (now-m_timeOffset)/freq);
+
+			const bgfx::Stats* stats = bgfx::getStats();
+			updateTiming(stats);
+
+			imguiBeginFrame(m_mouseState.m_mx
+				, m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				, m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			imguiBeginScrollArea("Settings", m_width - m_width / 4 - 10, 10, m_width / 4, m_height / 3, &m_scrollArea);
+
+			if (imguiSlider("Vec4 per draw", m_numParams, 1, NUM_PARAMS) )
+			{
+				resetTiming();
+			}
+
+			imguiSeparatorLine();
+			imguiLabel("Draw calls: %d", GRID_SIZE*GRID_SIZE);
+			imguiLabel("Avg. of %d frames:", NUM_FRAMES);
+			imguiLabel("GPU %0.6f [ms]", m_gpuAvg);
+			imguiLabel("CPU %0.6f [ms]", m_cpuAvg);
+
+			imguiEndScrollArea();
+			imguiEndFrame();
+
+			// Set view 0 default viewport.
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			// This dummy draw call is here to make sure that view 0 is cleared
+			// if no other draw calls are submitted to view 0.
+			bgfx::touch(0);
+
+			// Use debug font to print information about this example.
+			bgfx::dbgTextClear();
+			bgfx::dbgTextPrintf(0, 1, 0x4f, "bgfx/examples/38-uniforms");
+			bgfx::dbgTextPrintf(0, 2, 0x6f, "Description: Uniform upload cost, many draws with different uniform values.");
+			bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: % 7.3f[ms]", double(frameTime)*toMs);
+
+			if (!bgfx::isValid(m_program) )
+			{
+				bool blink = uint32_t(time*3.0f)&1;
+				bgfx::dbgTextPrintf(0, 5, blink ? 0x1f : 0x01, " Shader binaries are missing, build them with makefile in this example directory. ");
+			}
+			else
+			{
+				bgfx::dbgTextPrintf(0, 5, 0x0f, "Compare render thread CPU time between builds, e.g. on OpenGL with");
+				bgfx::dbgTextPrintf(0, 6, 0x0f, "BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE=0 to disable uniform buffers.");
+
+				float at[3]  = { 0.0f, 0.0f,   0.0f };
+				float eye[3] = { 0.0f, 0.0f, -90.0f };
+
+				float view[16];
+				bx::mtxLookAt(view, eye, at);
+
+				float proj[16];
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 200.0f, bgfx::getCaps()->homogeneousDepth);
+				bgfx::setViewTransform(0, view, proj);
+
+				const float offset = -float(GRID_SIZE-1)*1.5f;
+				const float scale  = 1.0f/float(m_numParams);
+
+				// Every draw sets different values, so no uniform upload can
+				// be skipped as redundant.
+				for (uint32_t yy = 0; yy < GRID_SIZE; ++yy)
+				{
+					for (uint32_t xx = 0; xx < GRID_SIZE; ++xx)
+					{
+						float mtx[16];
+						bx::mtxRotateXY(mtx, time + xx*0.21f, time + yy*0.37f);
+						mtx[12] = offset + float(xx)*3.0f;
+						mtx[13] = offset + float(yy)*3.0f;
+						mtx[14] = 0.0f;
+
+						float params[NUM_PARAMS][4];
+						bx::memSet(params, 0, sizeof(params) );
+						for (int32_t ii = 0; ii < m_numParams; ++ii)
+						{
+							params[ii][0] = scale*float(xx)/float(GRID_SIZE-1);
+							params[ii][1] = scale*float(yy)/float(GRID_SIZE-1);
+							params[ii][2] = scale*(0.5f + 0.5f*bx::fsin(time + float(ii) ) );
+							params[ii][3] = scale;
+						}
+
+						bgfx::setTransform(mtx);
+						bgfx::setUniform(u_params, params, uint16_t(m_numParams) );
+						bgfx::setVertexBuffer(0, m_vbh);
+						bgfx::setIndexBuffer(m_ibh);
+						bgfx::setState(BGFX_STATE_DEFAULT);
+						bgfx::submit(0, m_program);
+					}
+				}
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+	bgfx::UniformHandle u_params;
+
+	int32_t  m_numParams;
+	uint32_t m_numFrames;
+	double   m_cpuTime;
+	double   m_gpuTime;
+	double   m_cpuAvg;
+	double   m_gpuAvg;
+
+	int64_t m_timeOffset;
+	int32_t m_scrollArea;
+	entry::MouseState m_mouseState;
+};
+
+ENTRY_IMPLEMENT_MAIN(ExampleUniforms);
@@ -0,0 +1,25 @@
+$input a_position, a_color0
+$output v_color0
+
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "../common/common.sh"
+
+#define NUM_PARAMS 16
+
+uniform vec4 u_params[NUM_PARAMS];
+
+void main()
+{
+	vec4 params = vec4_splat(0.0);
+	for (int ii = 0; ii < NUM_PARAMS; ++ii)
+	{
+		params += u_params[ii];
+	}
+
+	gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0) );
+	v_color0 = a_color0 * params;
+}
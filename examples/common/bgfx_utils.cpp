@@ -12,6 +12,7 @@ namespace stl = tinystl;
 
 #include <bgfx/bgfx.h>
 #include <bx/commandline.h>
+#include <bx/cpu.h>
 #include <bx/endian.h>
 #include <bx/fpumath.h>
 #include <bx/readerwriter.h>
@@ -19,7 +20,17 @@ namespace stl = tinystl;
 #include "entry/entry.h"
 #include <ib-compress/indexbufferdecompression.h>
 
+#if BX_PLATFORM_WINDOWS
+#	include <windows.h>
+#elif BX_PLATFORM_POSIX
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BX_PLATFORM_
+
 #include "bgfx_utils.h"
+#include "bounds.h"
 
 #include <bimg/decode.h>
 
@@ -96,10 +107,8 @@ static void* loadMem(bx::FileReaderI* _reader, bx::AllocatorI* _allocator, const
 	return NULL;
 }
 
-static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name)
+static const char* getShaderPath()
 {
-	char filePath[512];
-
 	const char* shaderPath = "???";
 
 	switch (bgfx::getRendererType() )
@@ -119,11 +128,24 @@ static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name
 		break;
 	}
 
-	bx::strCopy(filePath, BX_COUNTOF(filePath), shaderPath);
+	return shaderPath;
+}
+
+static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name)
+{
+	char filePath[512];
+	bx::strCopy(filePath, BX_COUNTOF(filePath), getShaderPath() );
 	bx::strCat(filePath, BX_COUNTOF(filePath), _name);
 	bx::strCat(filePath, BX_COUNTOF(filePath), ".bin");
 
-	return bgfx::createShader(loadMem(_reader, filePath) );
+	const bgfx::Memory* mem = loadMem(_reader, filePath);
+	if (NULL == mem)
+	{
+		bgfx::ShaderHandle invalid = BGFX_INVALID_HANDLE;
+		return invalid;
+	}
+
+	return bgfx::createShader(mem);
 }
 
 bgfx::ShaderHandle loadShader(const char* _name)
@@ -140,6 +162,24 @@ bgfx::ProgramHandle loadProgram(bx::FileReaderI* _reader, const char* _vsName, c
 		fsh = loadShader(_reader, _fsName);
 	}
 
+	if (!bgfx::isValid(vsh)
+	|| (NULL != _fsName && !bgfx::isValid(fsh) ) )
+	{
+		// Shader binary is missing.
+		if (bgfx::isValid(vsh) )
+		{
+			bgfx::destroyShader(vsh);
+		}
+
+		if (bgfx::isValid(fsh) )
+		{
+			bgfx::destroyShader(fsh);
+		}
+
+		bgfx::ProgramHandle invalid = BGFX_INVALID_HANDLE;
+		return invalid;
+	}
+
 	return bgfx::createProgram(vsh, fsh, true /* destroy shaders when program is destroyed */);
 }
 
@@ -148,6 +188,125 @@ bgfx::ProgramHandle loadProgram(const char* _vsName, const char* _fsName)
 	return loadProgram(entry::getFileReader(), _vsName, _fsName);
 }
 
+#define BGFX_CHUNK_MAGIC_SPA BX_MAKEFOURCC('S', 'P', 'A', 0x0)
+
+struct ShaderPermutations
+{
+	stl::vector<stl::string> m_defines;
+	stl::vector<uint16_t> m_index;
+	stl::vector<bgfx::ShaderHandle> m_shaders;
+};
+
+ShaderPermutations* shaderPermutationsLoad(bx::FileReaderI* _reader, const char* _name)
+{
+	char filePath[512];
+	bx::strCopy(filePath, BX_COUNTOF(filePath), getShaderPath() );
+	bx::strCat(filePath, BX_COUNTOF(filePath), _name);
+	bx::strCat(filePath, BX_COUNTOF(filePath), ".bin");
+
+	uint32_t size;
+	void* data = load(_reader, entry::getAllocator(), filePath, &size);
+	if (NULL == data)
+	{
+		return NULL;
+	}
+
+	bx::MemoryReader reader(data, size);
+
+	uint32_t magic;
+	bx::read(&reader, magic);
+
+	if (BGFX_CHUNK_MAGIC_SPA != magic)
+	{
+		DBG("Invalid shader permutation archive %s.", filePath);
+		unload(data);
+		return NULL;
+	}
+
+	ShaderPermutations* permutations = new ShaderPermutations;
+
+	uint16_t numDefines;
+	bx::read(&reader, numDefines);
+	permutations->m_defines.resize(numDefines);
+
+	for (uint32_t ii = 0; ii < numDefines; ++ii)
+	{
+		uint16_t len;
+		bx::read(&reader, len);
+
+		stl::string& define = permutations->m_defines[ii];
+		define.resize(len);
+		bx::read(&reader, const_cast<char*>(define.c_str() ), len);
+	}
+
+	uint32_t numPermutations;
+	bx::read(&reader, numPermutations);
+
+	uint32_t numShaders;
+	bx::read(&reader, numShaders);
+
+	permutations->m_index.resize(numPermutations);
+	bx::read(&reader, &permutations->m_index[0], int32_t(numPermutations*sizeof(uint16_t) ) );
+
+	const uint8_t* table = (const uint8_t*)data + bx::skip(&reader, 0);
+	const uint8_t* shaderData = table + numShaders*2*sizeof(uint32_t);
+
+	permutations->m_shaders.resize(numShaders);
+
+	for (uint32_t ii = 0; ii < numShaders; ++ii)
+	{
+		uint32_t offset;
+		uint32_t shaderSize;
+		bx::memCopy(&offset,     &table[ii*8+0], sizeof(uint32_t) );
+		bx::memCopy(&shaderSize, &table[ii*8+4], sizeof(uint32_t) );
+
+		permutations->m_shaders[ii] = bgfx::createShader(bgfx::copy(&shaderData[offset], shaderSize) );
+	}
+
+	unload(data);
+
+	return permutations;
+}
+
+ShaderPermutations* shaderPermutationsLoad(const char* _name)
+{
+	return shaderPermutationsLoad(entry::getFileReader(), _name);
+}
+
+void shaderPermutationsUnload(ShaderPermutations* _permutations)
+{
+	for (uint32_t ii = 0, num = uint32_t(_permutations->m_shaders.size() ); ii < num; ++ii)
+	{
+		bgfx::destroyShader(_permutations->m_shaders[ii]);
+	}
+
+	delete _permutations;
+}
+
+uint32_t shaderPermutationsGetBit(const ShaderPermutations* _permutations, const char* _define)
+{
+	for (uint32_t ii = 0, num = uint32_t(_permutations->m_defines.size() ); ii < num; ++ii)
+	{
+		if (0 == bx::strCmp(_permutations->m_defines[ii].c_str(), _define) )
+		{
+			return UINT32_C(1) << ii;
+		}
+	}
+
+	return 0;
+}
+
+bgfx::ShaderHandle shaderPermutationsGet(const ShaderPermutations* _permutations, uint32_t _bits)
+{
+	if (_bits < _permutations->m_index.size() )
+	{
+		return _permutations->m_shaders[_permutations->m_index[_bits] ];
+	}
+
+	bgfx::ShaderHandle invalid = BGFX_INVALID_HANDLE;
+	return invalid;
+}
+
 static void imageReleaseCb(void* _ptr, void* _userData)
 {
 	BX_UNUSED(_ptr);
@@ -333,23 +492,6 @@ void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexDecl _decl
 	delete [] tangents;
 }
 
-struct Aabb
-{
-	float m_min[3];
-	float m_max[3];
-};
-
-struct Obb
-{
-	float m_mtx[16];
-};
-
-struct Sphere
-{
-	float m_center[3];
-	float m_radius;
-};
-
 struct Primitive
 {
 	uint32_t m_startIndex;
@@ -364,6 +506,26 @@ struct Primitive
 
 typedef stl::vector<Primitive> PrimitiveArray;
 
+#define MESH_MAX_LODS 8
+
+struct MeshLod
+{
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+	float    m_error;
+};
+
+struct Meshlet
+{
+	Sphere   m_sphere;
+	float    m_coneAxis[3];
+	float    m_coneCutoff;
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+};
+
+typedef stl::vector<Meshlet> MeshletArray;
+
 struct Group
 {
 	Group()
@@ -376,6 +538,79 @@ struct Group
 		m_vbh.idx = bgfx::invalidHandle;
 		m_ibh.idx = bgfx::invalidHandle;
 		m_prims.clear();
+		m_meshlets.clear();
+		m_dequant[0] = 1.0f;
+		m_dequant[1] = 1.0f;
+		m_dequant[2] = 1.0f;
+		m_dequant[3] = 0.0f;
+		m_dequant[4] = 0.0f;
+		m_dequant[5] = 0.0f;
+		m_dequant[6] = 0.0f;
+		m_dequant[7] = 0.0f;
+		m_numLods = 0;
+		bx::memSet(m_lods, 0, sizeof(m_lods) );
+		m_positions = NULL;
+		m_indices = NULL;
+		m_numVertices = 0;
+		m_numIndices = 0;
+	}
+
+	void addLod(const Primitive& _prim, uint8_t _lod, float _error)
+	{
+		if (MESH_MAX_LODS <= _lod)
+		{
+			return;
+		}
+
+		MeshLod& lod = m_lods[_lod];
+		if (0 == lod.m_numIndices)
+		{
+			lod.m_startIndex = _prim.m_startIndex;
+			lod.m_numIndices = _prim.m_numIndices;
+		}
+		else
+		{
+			const uint32_t end = bx::uint32_max(lod.m_startIndex + lod.m_numIndices, _prim.m_startIndex + _prim.m_numIndices);
+			lod.m_startIndex = bx::uint32_min(lod.m_startIndex, _prim.m_startIndex);
+			lod.m_numIndices = end - lod.m_startIndex;
+		}
+
+		lod.m_error = bx::fmax(lod.m_error, _error);
+		m_numLods   = bx::uint32_max(m_numLods, _lod+1);
+	}
+
+	void setDequant(const float _dequant[6])
+	{
+		m_dequant[0] = _dequant[0];
+		m_dequant[1] = _dequant[1];
+		m_dequant[2] = _dequant[2];
+		m_dequant[4] = _dequant[3];
+		m_dequant[5] = _dequant[4];
+		m_dequant[6] = _dequant[5];
+	}
+
+	// Normal encoding is passed in dequant w, see examples/common/mesh.sh.
+	void setNormalEncoding(const bgfx::VertexDecl& _decl)
+	{
+		m_dequant[3] = 0.0f;
+
+		if (_decl.has(bgfx::Attrib::Normal) )
+		{
+			uint8_t num;
+			bgfx::AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_decl.decode(bgfx::Attrib::Normal, num, type, normalized, asInt);
+
+			if (2 == num)
+			{
+				m_dequant[3] = 2.0f;
+			}
+			else if (bgfx::AttribType::Uint8 == type)
+			{
+				m_dequant[3] = 1.0f;
+			}
+		}
 	}
 
 	bgfx::VertexBufferHandle m_vbh;
@@ -384,6 +619,15 @@ struct Group
 	Aabb m_aabb;
 	Obb m_obb;
 	PrimitiveArray m_prims;
+	MeshletArray m_meshlets;
+	float m_dequant[8]; //!< Position scale and normal encoding, position offset.
+	MeshLod m_lods[MESH_MAX_LODS];
+	uint8_t m_numLods;
+
+	float* m_positions;
+	uint32_t* m_indices;
+	uint32_t m_numVertices;
+	uint32_t m_numIndices;
 };
 
 namespace bgfx
@@ -391,143 +635,804 @@ namespace bgfx
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexDecl& _decl, bx::Error* _err = NULL);
 }
 
-struct Mesh
-{
-	void load(bx::ReaderSeekerI* _reader)
-	{
 #define BGFX_CHUNK_MAGIC_VB  BX_MAKEFOURCC('V', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_VB32 BX_MAKEFOURCC('V', 'B', ' ', 0x2)
+#define BGFX_CHUNK_MAGIC_VBQ BX_MAKEFOURCC('V', 'B', ' ', 0x3)
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
+#define BGFX_CHUNK_MAGIC_IB32 BX_MAKEFOURCC('I', 'B', ' ', 0x1)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x0)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_PRIL BX_MAKEFOURCC('P', 'R', 'I', 0x1)
+#define BGFX_CHUNK_MAGIC_MLT BX_MAKEFOURCC('M', 'L', 'T', 0x0)
+
+// Memory mappable mesh container. File starts with magic, number of chunks
+// and table of contents. VBD and IBD payloads are aligned and passed to
+// bgfx by reference, without copying.
+#define BGFX_CHUNK_MAGIC_MSH BX_MAKEFOURCC('M', 'S', 'H', 0x1)
+#define BGFX_CHUNK_MAGIC_VBM BX_MAKEFOURCC('V', 'B', 'M', 0x0)
+#define BGFX_CHUNK_MAGIC_VBMQ BX_MAKEFOURCC('V', 'B', 'M', 0x1)
+#define BGFX_CHUNK_MAGIC_VBD BX_MAKEFOURCC('V', 'B', 'D', 0x0)
+#define BGFX_CHUNK_MAGIC_IBD BX_MAKEFOURCC('I', 'B', 'D', 0x0)
+
+struct MeshChunk
+{
+	uint32_t m_chunk;
+	uint32_t m_offset;
+	uint32_t m_size;
+	uint32_t m_flags;
+};
 
-		using namespace bx;
-		using namespace bgfx;
-
-		Group group;
+struct MappedFile
+{
+	uint8_t* m_data;
+	uint32_t m_size;
+	int32_t  m_refCount;
+	bool     m_mapped;
+#if BX_PLATFORM_WINDOWS
+	HANDLE   m_file;
+	HANDLE   m_mapping;
+#endif // BX_PLATFORM_WINDOWS
+};
 
-		bx::AllocatorI* allocator = entry::getAllocator();
+static MappedFile* mapFile(const char* _filePath)
+{
+	MappedFile* file = new MappedFile;
+	file->m_data     = NULL;
+	file->m_size     = 0;
+	file->m_refCount = 1;
+	file->m_mapped   = false;
+
+	char filePath[1024];
+	bx::snprintf(filePath, BX_COUNTOF(filePath), "%s%s", entry::getCurrentDir(), _filePath);
+
+#if BX_PLATFORM_WINDOWS
+	file->m_file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	file->m_mapping = NULL;
+	if (INVALID_HANDLE_VALUE != file->m_file)
+	{
+		file->m_size    = GetFileSize(file->m_file, NULL);
+		file->m_mapping = 0 != file->m_size
+			? CreateFileMappingA(file->m_file, NULL, PAGE_READONLY, 0, 0, NULL)
+			: NULL
+			;
+		if (NULL != file->m_mapping)
+		{
+			file->m_data   = (uint8_t*)MapViewOfFile(file->m_mapping, FILE_MAP_READ, 0, 0, 0);
+			file->m_mapped = NULL != file->m_data;
+		}
 
-		uint32_t chunk;
-		bx::Error err;
-		while (4 == bx::read(_reader, chunk, &err)
-		&&     err.isOk() )
+		if (!file->m_mapped)
 		{
-			switch (chunk)
+			if (NULL != file->m_mapping)
 			{
-			case BGFX_CHUNK_MAGIC_VB:
-				{
-					read(_reader, group.m_sphere);
-					read(_reader, group.m_aabb);
-					read(_reader, group.m_obb);
-
-					read(_reader, m_decl);
-
-					uint16_t stride = m_decl.getStride();
+				CloseHandle(file->m_mapping);
+			}
 
-					uint16_t numVertices;
-					read(_reader, numVertices);
-					const bgfx::Memory* mem = bgfx::alloc(numVertices*stride);
-					read(_reader, mem->data, mem->size);
+			CloseHandle(file->m_file);
+			file->m_size = 0;
+		}
+	}
+#elif BX_PLATFORM_POSIX
+	int fd = open(filePath, O_RDONLY);
+	if (-1 != fd)
+	{
+		struct stat st;
+		if (0 == fstat(fd, &st)
+		&&  0 != st.st_size)
+		{
+			void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (MAP_FAILED != data)
+			{
+				file->m_data   = (uint8_t*)data;
+				file->m_size   = uint32_t(st.st_size);
+				file->m_mapped = true;
+			}
+		}
 
-					group.m_vbh = bgfx::createVertexBuffer(mem, m_decl);
-				}
-				break;
+		close(fd);
+	}
+#endif // BX_PLATFORM_
 
-			case BGFX_CHUNK_MAGIC_IB:
-				{
-					uint32_t numIndices;
-					read(_reader, numIndices);
-					const bgfx::Memory* mem = bgfx::alloc(numIndices*2);
-					read(_reader, mem->data, mem->size);
-					group.m_ibh = bgfx::createIndexBuffer(mem);
-				}
-				break;
+	if (!file->m_mapped)
+	{
+		file->m_data = (uint8_t*)load(_filePath, &file->m_size);
+	}
 
-			case BGFX_CHUNK_MAGIC_IBC:
-				{
-					uint32_t numIndices;
-					bx::read(_reader, numIndices);
+	if (NULL == file->m_data)
+	{
+		delete file;
+		return NULL;
+	}
 
-					const bgfx::Memory* mem = bgfx::alloc(numIndices*2);
+	return file;
+}
 
-					uint32_t compressedSize;
-					bx::read(_reader, compressedSize);
+static void unmapFile(MappedFile* _file)
+{
+	if (0 != bx::atomicDec(&_file->m_refCount) )
+	{
+		return;
+	}
 
-					void* compressedIndices = BX_ALLOC(allocator, compressedSize);
+	if (_file->m_mapped)
+	{
+#if BX_PLATFORM_WINDOWS
+		UnmapViewOfFile(_file->m_data);
+		CloseHandle(_file->m_mapping);
+		CloseHandle(_file->m_file);
+#elif BX_PLATFORM_POSIX
+		munmap(_file->m_data, _file->m_size);
+#endif // BX_PLATFORM_
+	}
+	else
+	{
+		unload(_file->m_data);
+	}
 
-					bx::read(_reader, compressedIndices, compressedSize);
+	delete _file;
+}
 
-					ReadBitstream rbs( (const uint8_t*)compressedIndices, compressedSize);
-					DecompressIndexBuffer( (uint16_t*)mem->data, numIndices / 3, rbs);
+static void mappedFileRelease(void* /*_ptr*/, void* _userData)
+{
+	unmapFile( (MappedFile*)_userData);
+}
 
-					BX_FREE(allocator, compressedIndices);
+static const bgfx::Memory* mappedFileRef(MappedFile* _file, const void* _data, uint32_t _size)
+{
+	bx::atomicInc(&_file->m_refCount);
+	return bgfx::makeRef(_data, _size, mappedFileRelease, _file);
+}
 
-					group.m_ibh = bgfx::createIndexBuffer(mem);
-				}
-				break;
+// Matches decodeNormalOctahedronSnorm in examples/common/shaderlib.sh.
+static void decodeNormalOctahedron(float _result[3], float _x, float _y)
+{
+	float normal[3] = { _x, _y, 1.0f - bx::fabsolute(_x) - bx::fabsolute(_y) };
+	if (normal[2] < 0.0f)
+	{
+		normal[0] = (1.0f - bx::fabsolute(_y) ) * (_x >= 0.0f ? 1.0f : -1.0f);
+		normal[1] = (1.0f - bx::fabsolute(_x) ) * (_y >= 0.0f ? 1.0f : -1.0f);
+	}
 
-			case BGFX_CHUNK_MAGIC_PRI:
-				{
-					uint16_t len;
-					read(_reader, len);
+	bx::vec3Norm(_result, normal);
+}
 
-					stl::string material;
-					material.resize(len);
-					read(_reader, const_cast<char*>(material.c_str() ), len);
+struct Mesh
+{
+	Mesh(bool _ramcopy, bool _quantized)
+		: m_ramcopy(_ramcopy)
+		, m_quantized(_quantized)
+	{
+		m_dequantUniform = bgfx::createUniform("u_meshDequant", bgfx::UniformType::Vec4, 2);
+	}
 
-					uint16_t num;
-					read(_reader, num);
+	// Positions are dequantized, so that RAM copy is always in object space.
+	void copyVertices(Group& _group, const void* _data, uint32_t _numVertices)
+	{
+		if (!m_ramcopy)
+		{
+			return;
+		}
 
-					for (uint32_t ii = 0; ii < num; ++ii)
-					{
-						read(_reader, len);
-
-						stl::string name;
-						name.resize(len);
-						read(_reader, const_cast<char*>(name.c_str() ), len);
-
-						Primitive prim;
-						read(_reader, prim.m_startIndex);
-						read(_reader, prim.m_numIndices);
-						read(_reader, prim.m_startVertex);
-						read(_reader, prim.m_numVertices);
-						read(_reader, prim.m_sphere);
-						read(_reader, prim.m_aabb);
-						read(_reader, prim.m_obb);
-
-						group.m_prims.push_back(prim);
-					}
+		_group.m_numVertices = _numVertices;
+		_group.m_positions   = (float*)BX_ALLOC(entry::getAllocator(), _numVertices*3*sizeof(float) );
 
-					m_groups.push_back(group);
-					group.reset();
-				}
-				break;
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, m_decl, _data, ii);
 
-			default:
-				DBG("%08x at %d", chunk, bx::skip(_reader, 0) );
-				break;
-			}
+			float* dst = &_group.m_positions[ii*3];
+			dst[0] = pos[0]*_group.m_dequant[0] + _group.m_dequant[4];
+			dst[1] = pos[1]*_group.m_dequant[1] + _group.m_dequant[5];
+			dst[2] = pos[2]*_group.m_dequant[2] + _group.m_dequant[6];
 		}
 	}
 
-	void unload()
+	bool needsExpand(const Group& _group, bool _packedPos) const
 	{
-		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		return !m_quantized
+			&& (_packedPos || 2.0f == _group.m_dequant[3])
+			;
+	}
+
+	// Expands quantized positions into floats and octahedral normals and
+	// tangents into 8-bit normals, which is layout shaders that don't
+	// include examples/common/mesh.sh expect. Other attributes are copied
+	// as is.
+	const bgfx::Memory* expandVertices(Group& _group, const void* _data, uint32_t _numVertices)
+	{
+		using namespace bgfx;
+
+		const bool octahedral = 2.0f == _group.m_dequant[3];
+
+		VertexDecl decl;
+		decl.begin();
+		for (uint32_t attr = 0; attr < Attrib::Count; ++attr)
 		{
-			const Group& group = *it;
-			bgfx::destroyVertexBuffer(group.m_vbh);
+			const Attrib::Enum attrib = Attrib::Enum(attr);
+			if (!m_decl.has(attrib) )
+			{
+				continue;
+			}
 
-			if (bgfx::isValid(group.m_ibh) )
+			uint8_t num;
+			AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			m_decl.decode(attrib, num, type, normalized, asInt);
+
+			if (Attrib::Position == attrib)
 			{
-				bgfx::destroyIndexBuffer(group.m_ibh);
+				decl.add(attrib, 3, AttribType::Float);
+			}
+			else if (octahedral
+				 && (Attrib::Normal == attrib || Attrib::Tangent == attrib) )
+			{
+				decl.add(attrib, 4, AttribType::Uint8, true, true);
+			}
+			else
+			{
+				decl.add(attrib, num, type, normalized, asInt);
 			}
 		}
-		m_groups.clear();
-	}
+		decl.end();
 
-	void submit(uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state) const
-	{
-		if (BGFX_STATE_MASK == _state)
+		const Memory* mem = alloc(_numVertices*decl.getStride() );
+		vertexConvert(decl, mem->data, m_decl, _data, _numVertices);
+
+		const bool hasTangent = octahedral && m_decl.has(Attrib::Tangent);
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float pos[4];
+			vertexUnpack(pos, Attrib::Position, m_decl, _data, ii);
+			pos[0] = pos[0]*_group.m_dequant[0] + _group.m_dequant[4];
+			pos[1] = pos[1]*_group.m_dequant[1] + _group.m_dequant[5];
+			pos[2] = pos[2]*_group.m_dequant[2] + _group.m_dequant[6];
+			vertexPack(pos, false, Attrib::Position, decl, mem->data, ii);
+
+			if (octahedral)
+			{
+				float normal[4];
+				vertexUnpack(normal, Attrib::Normal, m_decl, _data, ii);
+				decodeNormalOctahedron(normal, normal[0], normal[1]);
+				normal[3] = 0.0f;
+				vertexPack(normal, true, Attrib::Normal, decl, mem->data, ii);
+			}
+
+			if (hasTangent)
+			{
+				// Tangent z holds handedness, see geometryc --packnormal 2.
+				float tangent[4];
+				vertexUnpack(tangent, Attrib::Tangent, m_decl, _data, ii);
+				const float handedness = tangent[2];
+				decodeNormalOctahedron(tangent, tangent[0], tangent[1]);
+				tangent[3] = handedness;
+				vertexPack(tangent, true, Attrib::Tangent, decl, mem->data, ii);
+			}
+		}
+
+		const float identity[6] = { 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+		_group.setDequant(identity);
+
+		m_decl = decl;
+		_group.setNormalEncoding(m_decl);
+
+		return mem;
+	}
+
+	void copyIndices(Group& _group, const void* _data, uint32_t _numIndices, bool _index32)
+	{
+		if (!m_ramcopy)
+		{
+			return;
+		}
+
+		_group.m_numIndices = _numIndices;
+		_group.m_indices    = (uint32_t*)BX_ALLOC(entry::getAllocator(), _numIndices*sizeof(uint32_t) );
+
+		if (_index32)
+		{
+			bx::memCopy(_group.m_indices, _data, _numIndices*sizeof(uint32_t) );
+		}
+		else
+		{
+			const uint16_t* indices = (const uint16_t*)_data;
+			for (uint32_t ii = 0; ii < _numIndices; ++ii)
+			{
+				_group.m_indices[ii] = indices[ii];
+			}
+		}
+	}
+
+	// Meshlets are dropped if chunk is too small for their number, or if
+	// their index range is outside of _numIndices.
+	static void readMeshlets(bx::ReaderI* _reader, Group& _group, uint32_t _size, uint32_t _numIndices)
+	{
+		using namespace bx;
+
+		const uint32_t meshletSize = 0
+			+ sizeof(Sphere)
+			+ sizeof(float)*3
+			+ sizeof(float)
+			+ sizeof(uint32_t)*2
+			;
+
+		uint32_t num;
+		read(_reader, num);
+
+		if (_size < sizeof(uint32_t)
+		||  num > (_size - sizeof(uint32_t) )/meshletSize)
+		{
+			DBG("Invalid number of meshlets %d.", num);
+			return;
+		}
+
+		_group.m_meshlets.resize(num);
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			Meshlet& meshlet = _group.m_meshlets[ii];
+			read(_reader, meshlet.m_sphere);
+			read(_reader, meshlet.m_coneAxis, sizeof(meshlet.m_coneAxis) );
+			read(_reader, meshlet.m_coneCutoff);
+			read(_reader, meshlet.m_startIndex);
+			read(_reader, meshlet.m_numIndices);
+
+			if (meshlet.m_startIndex > _numIndices
+			||  meshlet.m_numIndices > _numIndices - meshlet.m_startIndex)
+			{
+				DBG("Meshlet %d index range is out of index buffer.", ii);
+				_group.m_meshlets.clear();
+				return;
+			}
+		}
+	}
+
+	static void readPrimitives(bx::ReaderI* _reader, Group& _group, bool _lod)
+	{
+		using namespace bx;
+
+		uint16_t len;
+		read(_reader, len);
+
+		stl::string material;
+		material.resize(len);
+		read(_reader, const_cast<char*>(material.c_str() ), len);
+
+		uint16_t num;
+		read(_reader, num);
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			read(_reader, len);
+
+			stl::string name;
+			name.resize(len);
+			read(_reader, const_cast<char*>(name.c_str() ), len);
+
+			Primitive prim;
+			read(_reader, prim.m_startIndex);
+			read(_reader, prim.m_numIndices);
+			read(_reader, prim.m_startVertex);
+			read(_reader, prim.m_numVertices);
+			read(_reader, prim.m_sphere);
+			read(_reader, prim.m_aabb);
+			read(_reader, prim.m_obb);
+
+			if (_lod)
+			{
+				uint8_t lod;
+				float error;
+				read(_reader, lod);
+				read(_reader, error);
+				_group.addLod(prim, lod, error);
+			}
+
+			_group.m_prims.push_back(prim);
+		}
+	}
+
+	// Returns false if file is not in container format. Container with
+	// invalid table of contents is rejected as whole, and leaves mesh empty.
+	bool load(MappedFile* _file)
+	{
+		using namespace bx;
+		using namespace bgfx;
+
+		const uint32_t tocOffset = sizeof(uint32_t)*2;
+		if (tocOffset > _file->m_size)
+		{
+			return false;
+		}
+
+		MemoryReader reader(_file->m_data, _file->m_size);
+
+		uint32_t magic;
+		read(&reader, magic);
+		if (BGFX_CHUNK_MAGIC_MSH != magic)
+		{
+			return false;
+		}
+
+		uint32_t numChunks;
+		read(&reader, numChunks);
+
+		if (numChunks > (_file->m_size - tocOffset)/sizeof(MeshChunk) )
+		{
+			DBG("Invalid number of chunks %d.", numChunks);
+			return true;
+		}
+
+		// Validate every chunk before creating any resource, so that
+		// truncated or corrupted file doesn't leave mesh half loaded.
+		stl::vector<MeshChunk> toc(numChunks);
+		for (uint32_t ii = 0; ii < numChunks; ++ii)
+		{
+			MeshChunk& chunk = toc[ii];
+			read(&reader, chunk);
+
+			if (chunk.m_offset > _file->m_size
+			||  chunk.m_size   > _file->m_size - chunk.m_offset)
+			{
+				DBG("Invalid chunk %08x at %d, size %d.", chunk.m_chunk, chunk.m_offset, chunk.m_size);
+				return true;
+			}
+		}
+
+		Group group;
+		uint32_t numIndices = 0;
+		bool packedPos = false;
+
+		for (uint32_t ii = 0; ii < numChunks; ++ii)
+		{
+			const MeshChunk& chunk = toc[ii];
+			const uint8_t* data = &_file->m_data[chunk.m_offset];
+			MemoryReader chunkReader(data, chunk.m_size);
+
+			switch (chunk.m_chunk)
+			{
+			case BGFX_CHUNK_MAGIC_VBM:
+			case BGFX_CHUNK_MAGIC_VBMQ:
+				read(&chunkReader, group.m_sphere);
+				read(&chunkReader, group.m_aabb);
+				read(&chunkReader, group.m_obb);
+				read(&chunkReader, m_decl);
+				group.setNormalEncoding(m_decl);
+
+				packedPos = BGFX_CHUNK_MAGIC_VBMQ == chunk.m_chunk;
+				if (packedPos)
+				{
+					uint32_t numVertices;
+					read(&chunkReader, numVertices);
+
+					float dequant[6];
+					read(&chunkReader, dequant, sizeof(dequant) );
+					group.setDequant(dequant);
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_VBD:
+				if (0 == m_decl.getStride() )
+				{
+					DBG("Vertex data without vertex declaration.");
+					break;
+				}
+
+				{
+					const uint32_t numVertices = chunk.m_size/m_decl.getStride();
+					copyVertices(group, data, numVertices);
+
+					if (needsExpand(group, packedPos) )
+					{
+						const Memory* mem = expandVertices(group, data, numVertices);
+						group.m_vbh = createVertexBuffer(mem, m_decl);
+					}
+					else
+					{
+						group.m_vbh = createVertexBuffer(mappedFileRef(_file, data, chunk.m_size), m_decl);
+					}
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_IBD:
+				{
+					const bool index32 = 0 != (chunk.m_flags & BGFX_BUFFER_INDEX32);
+					numIndices = chunk.m_size/(index32 ? 4 : 2);
+					copyIndices(group, data, numIndices, index32);
+					group.m_ibh = createIndexBuffer(mappedFileRef(_file, data, chunk.m_size), uint16_t(chunk.m_flags) );
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_MLT:
+				readMeshlets(&chunkReader, group, chunk.m_size, numIndices);
+				break;
+
+			case BGFX_CHUNK_MAGIC_PRI:
+			case BGFX_CHUNK_MAGIC_PRIL:
+				readPrimitives(&chunkReader, group, BGFX_CHUNK_MAGIC_PRIL == chunk.m_chunk);
+				m_groups.push_back(group);
+				group.reset();
+				numIndices = 0;
+				break;
+
+			default:
+				DBG("%08x at %d", chunk.m_chunk, chunk.m_offset);
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	static uint32_t getRemaining(bx::ReaderSeekerI* _reader)
+	{
+		const int64_t pos = bx::seek(_reader);
+		const int64_t end = bx::seek(_reader, 0, bx::Whence::End);
+		bx::seek(_reader, pos, bx::Whence::Begin);
+		return uint32_t(bx::int64_min(end - pos, UINT32_MAX) );
+	}
+
+	// When _data is not NULL, it must point to start of data read by
+	// _reader, so that compressed chunks can be decoded in place.
+	void load(bx::ReaderSeekerI* _reader, const uint8_t* _data = NULL)
+	{
+		using namespace bx;
+		using namespace bgfx;
+
+		Group group;
+		uint32_t numGroupIndices = 0;
+
+		bx::AllocatorI* allocator = entry::getAllocator();
+
+		uint32_t chunk;
+		bx::Error err;
+		while (4 == bx::read(_reader, chunk, &err)
+		&&     err.isOk() )
+		{
+			switch (chunk)
+			{
+			case BGFX_CHUNK_MAGIC_VB:
+			case BGFX_CHUNK_MAGIC_VB32:
+			case BGFX_CHUNK_MAGIC_VBQ:
+				{
+					read(_reader, group.m_sphere);
+					read(_reader, group.m_aabb);
+					read(_reader, group.m_obb);
+
+					read(_reader, m_decl);
+					group.setNormalEncoding(m_decl);
+
+					uint16_t stride = m_decl.getStride();
+
+					uint32_t numVertices = 0;
+					if (BGFX_CHUNK_MAGIC_VBQ == chunk)
+					{
+						float dequant[6];
+						read(_reader, dequant, sizeof(dequant) );
+						group.setDequant(dequant);
+
+						read(_reader, numVertices);
+					}
+					else if (BGFX_CHUNK_MAGIC_VB32 == chunk)
+					{
+						read(_reader, numVertices);
+					}
+					else
+					{
+						uint16_t num;
+						read(_reader, num);
+						numVertices = num;
+					}
+
+					const bgfx::Memory* mem;
+					if (needsExpand(group, BGFX_CHUNK_MAGIC_VBQ == chunk) )
+					{
+						void* data = BX_ALLOC(allocator, numVertices*stride);
+						read(_reader, data, numVertices*stride);
+						copyVertices(group, data, numVertices);
+						mem = expandVertices(group, data, numVertices);
+						BX_FREE(allocator, data);
+					}
+					else
+					{
+						mem = bgfx::alloc(numVertices*stride);
+						read(_reader, mem->data, mem->size);
+						copyVertices(group, mem->data, numVertices);
+					}
+
+					group.m_vbh = bgfx::createVertexBuffer(mem, m_decl);
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_IB:
+				{
+					uint32_t numIndices;
+					read(_reader, numIndices);
+					const bgfx::Memory* mem = bgfx::alloc(numIndices*2);
+					read(_reader, mem->data, mem->size);
+					copyIndices(group, mem->data, numIndices, false);
+					group.m_ibh = bgfx::createIndexBuffer(mem);
+					numGroupIndices = numIndices;
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_IB32:
+				{
+					uint32_t numIndices;
+					read(_reader, numIndices);
+					const bgfx::Memory* mem = bgfx::alloc(numIndices*4);
+					read(_reader, mem->data, mem->size);
+					copyIndices(group, mem->data, numIndices, true);
+					group.m_ibh = bgfx::createIndexBuffer(mem, BGFX_BUFFER_INDEX32);
+					numGroupIndices = numIndices;
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_IBC:
+				{
+					uint32_t numIndices;
+					bx::read(_reader, numIndices);
+
+					uint32_t compressedSize;
+					bx::read(_reader, compressedSize);
+
+					if (compressedSize > getRemaining(_reader) )
+					{
+						DBG("Compressed index buffer size %d is past end of file.", compressedSize);
+
+						// Keep already created buffers with mesh, so that they
+						// are released on unload.
+						m_groups.push_back(group);
+						return;
+					}
+
+					const bgfx::Memory* mem = bgfx::alloc(numIndices*2);
+
+					if (NULL != _data)
+					{
+						// Decode directly from file data into index buffer memory,
+						// without copying compressed stream first.
+						const int64_t offset = bx::skip(_reader, 0);
+
+						ReadBitstream rbs(_data + offset, compressedSize);
+						DecompressIndexBuffer( (uint16_t*)mem->data, numIndices / 3, rbs);
+
+						bx::skip(_reader, compressedSize);
+					}
+					else
+					{
+						void* compressedIndices = BX_ALLOC(allocator, compressedSize);
+
+						bx::read(_reader, compressedIndices, compressedSize);
+
+						ReadBitstream rbs( (const uint8_t*)compressedIndices, compressedSize);
+						DecompressIndexBuffer( (uint16_t*)mem->data, numIndices / 3, rbs);
+
+						BX_FREE(allocator, compressedIndices);
+					}
+
+					copyIndices(group, mem->data, numIndices, false);
+					group.m_ibh = bgfx::createIndexBuffer(mem);
+					numGroupIndices = numIndices;
+				}
+				break;
+
+			case BGFX_CHUNK_MAGIC_MLT:
+				readMeshlets(_reader, group, getRemaining(_reader), numGroupIndices);
+				break;
+
+			case BGFX_CHUNK_MAGIC_PRI:
+			case BGFX_CHUNK_MAGIC_PRIL:
+				readPrimitives(_reader, group, BGFX_CHUNK_MAGIC_PRIL == chunk);
+				m_groups.push_back(group);
+				group.reset();
+				numGroupIndices = 0;
+				break;
+
+			default:
+				DBG("%08x at %d", chunk, bx::skip(_reader, 0) );
+				break;
+			}
+		}
+	}
+
+	void unload()
+	{
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			const Group& group = *it;
+
+			if (bgfx::isValid(group.m_vbh) )
+			{
+				bgfx::destroyVertexBuffer(group.m_vbh);
+			}
+
+			if (bgfx::isValid(group.m_ibh) )
+			{
+				bgfx::destroyIndexBuffer(group.m_ibh);
+			}
+
+			if (NULL != group.m_positions)
+			{
+				BX_FREE(entry::getAllocator(), group.m_positions);
+			}
+
+			if (NULL != group.m_indices)
+			{
+				BX_FREE(entry::getAllocator(), group.m_indices);
+			}
+		}
+		m_groups.clear();
+
+		bgfx::destroyUniform(m_dequantUniform);
+	}
+
+	uint8_t getNumLods() const
+	{
+		uint8_t numLods = 0;
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			numLods = uint8_t(bx::uint32_max(numLods, it->m_numLods) );
+		}
+
+		return numLods;
+	}
+
+	// Picks the coarsest LOD whose object space error projected at given
+	// distance stays below _maxPixelError.
+	uint8_t selectLod(float _distance, float _pixelScale, float _maxPixelError) const
+	{
+		const float scale = _pixelScale / bx::fmax(_distance, 0.0001f);
+
+		for (uint8_t lod = getNumLods(); 0 < lod; --lod)
+		{
+			float error = 0.0f;
+			for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+			{
+				if (lod <= it->m_numLods)
+				{
+					error = bx::fmax(error, it->m_lods[lod-1].m_error);
+				}
+			}
+
+			if (error * scale <= _maxPixelError)
+			{
+				return lod-1;
+			}
+		}
+
+		return 0;
+	}
+
+	static void setIndexBuffer(const Group& _group, uint8_t _lod)
+	{
+		if (0 == _group.m_numLods)
+		{
+			bgfx::setIndexBuffer(_group.m_ibh);
+		}
+		else if (_lod < _group.m_numLods)
+		{
+			const MeshLod& lod = _group.m_lods[_lod];
+			bgfx::setIndexBuffer(_group.m_ibh, lod.m_startIndex, lod.m_numIndices);
+		}
+		else
+		{
+			// Group doesn't contain primitives of this LOD.
+			bgfx::setIndexBuffer(_group.m_ibh, 0, 0);
+		}
+	}
+
+	// Quantized positions are dequantized in vertex shader, see
+	// examples/common/mesh.sh. Dequantization is not folded into model
+	// transform, since non-uniform scale would skew normals.
+	void setDequant(const Group& _group) const
+	{
+		bgfx::setUniform(m_dequantUniform, _group.m_dequant, 2);
+	}
+
+	void submit(uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint8_t _lod) const
+	{
+		if (BGFX_STATE_MASK == _state)
 		{
 			_state = 0
 				| BGFX_STATE_RGB_WRITE
@@ -539,6 +1444,8 @@ struct Mesh
 				;
 		}
 
+		_lod = uint8_t(bx::uint32_min(_lod, bx::uint32_max(getNumLods(), 1) - 1) );
+
 		bgfx::setTransform(_mtx);
 		bgfx::setState(_state);
 
@@ -546,14 +1453,150 @@ struct Mesh
 		{
 			const Group& group = *it;
 
-			bgfx::setIndexBuffer(group.m_ibh);
+			setDequant(group);
+			setIndexBuffer(group, _lod);
 			bgfx::setVertexBuffer(0, group.m_vbh);
 			bgfx::submit(_id, _program, 0, it != itEnd-1);
 		}
 	}
 
-	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices) const
+	static bool isVisible(const Sphere& _sphere, const Plane* _planes)
+	{
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const Plane& plane = _planes[ii];
+			if (bx::vec3Dot(plane.m_normal, _sphere.m_center) + plane.m_dist < -_sphere.m_radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Cone axis is average of cross(p1-p0, p2-p0) triangle normals, which
+	// point away from the eye for counter-clockwise triangles. _cullSign is
+	// 1 when counter-clockwise triangles are culled, -1 when clockwise
+	// triangles are culled, and 0 when culling is disabled.
+	static bool isVisible(const Meshlet& _meshlet, const Plane* _planes, const float* _eye, float _cullSign)
+	{
+		if (!isVisible(_meshlet.m_sphere, _planes) )
+		{
+			return false;
+		}
+
+		if (0.0f == _cullSign)
+		{
+			return true;
+		}
+
+		// All triangles in cluster are culled.
+		float dir[3];
+		bx::vec3Sub(dir, _meshlet.m_sphere.m_center, _eye);
+		return _cullSign*bx::vec3Dot(dir, _meshlet.m_coneAxis) < _meshlet.m_coneCutoff * bx::vec3Length(dir) + _meshlet.m_sphere.m_radius;
+	}
+
+	static float getCullSign(uint64_t _state, const float* _mtx)
+	{
+		float cullSign;
+		switch (_state & BGFX_STATE_CULL_MASK)
+		{
+		case BGFX_STATE_CULL_CCW: cullSign =  1.0f; break;
+		case BGFX_STATE_CULL_CW:  cullSign = -1.0f; break;
+		default:                  return 0.0f;
+		}
+
+		// Mirroring transform flips winding.
+		const float det = 0.0f
+			+ _mtx[0] * (_mtx[5]*_mtx[10] - _mtx[6]*_mtx[9])
+			- _mtx[1] * (_mtx[4]*_mtx[10] - _mtx[6]*_mtx[8])
+			+ _mtx[2] * (_mtx[4]*_mtx[ 9] - _mtx[5]*_mtx[8])
+			;
+
+		return 0.0f > det ? -cullSign : cullSign;
+	}
+
+	// Culls groups and clusters in object space against frustum of model
+	// view projection matrix, and submits only visible clusters.
+	uint32_t submit(uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state, uint8_t _lod) const
+	{
+		if (BGFX_STATE_MASK == _state)
+		{
+			_state = 0
+				| BGFX_STATE_RGB_WRITE
+				| BGFX_STATE_ALPHA_WRITE
+				| BGFX_STATE_DEPTH_WRITE
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_CULL_CCW
+				| BGFX_STATE_MSAA
+				;
+		}
+
+		_lod = uint8_t(bx::uint32_min(_lod, bx::uint32_max(getNumLods(), 1) - 1) );
+
+		float modelView[16];
+		bx::mtxMul(modelView, _mtx, _view);
+
+		float modelViewProj[16];
+		bx::mtxMul(modelViewProj, modelView, _proj);
+
+		Plane planes[6];
+		buildFrustumPlanes(planes, modelViewProj);
+
+		float invModelView[16];
+		bx::mtxInverse(invModelView, modelView);
+		const float* eye = &invModelView[12];
+
+		const float cullSign = getCullSign(_state, _mtx);
+
+		uint32_t numDraws = 0;
+
+		bgfx::setTransform(_mtx);
+		bgfx::setState(_state);
+
+		for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
+		{
+			const Group& group = *it;
+
+			if (!isVisible(group.m_sphere, planes) )
+			{
+				continue;
+			}
+
+			setDequant(group);
+
+			if (0 != _lod
+			||  group.m_meshlets.empty() )
+			{
+				setIndexBuffer(group, _lod);
+				bgfx::setVertexBuffer(0, group.m_vbh);
+				bgfx::submit(_id, _program, 0, true);
+				++numDraws;
+				continue;
+			}
+
+			for (MeshletArray::const_iterator meshletIt = group.m_meshlets.begin(), meshletItEnd = group.m_meshlets.end(); meshletIt != meshletItEnd; ++meshletIt)
+			{
+				const Meshlet& meshlet = *meshletIt;
+				if (isVisible(meshlet, planes, eye, cullSign) )
+				{
+					bgfx::setIndexBuffer(group.m_ibh, meshlet.m_startIndex, meshlet.m_numIndices);
+					bgfx::setVertexBuffer(0, group.m_vbh);
+					bgfx::submit(_id, _program, 0, true);
+					++numDraws;
+				}
+			}
+		}
+
+		bgfx::discard();
+
+		return numDraws;
+	}
+
+	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices, uint8_t _lod) const
 	{
+		_lod = uint8_t(bx::uint32_min(_lod, bx::uint32_max(getNumLods(), 1) - 1) );
+
 		uint32_t cached = bgfx::setTransform(_mtx, _numMatrices);
 
 		for (uint32_t pass = 0; pass < _numPasses; ++pass)
@@ -577,36 +1620,78 @@ struct Mesh
 			{
 				const Group& group = *it;
 
-				bgfx::setIndexBuffer(group.m_ibh);
+				setDequant(group);
+				setIndexBuffer(group, _lod);
 				bgfx::setVertexBuffer(0, group.m_vbh);
 				bgfx::submit(state.m_viewId, state.m_program, 0, it != itEnd-1);
 			}
 		}
 	}
 
+	bool getGeometry(uint32_t _group, MeshGeometry& _geometry, uint8_t _lod) const
+	{
+		if (_group >= m_groups.size() )
+		{
+			return false;
+		}
+
+		const Group& group = m_groups[_group];
+		if (NULL == group.m_positions
+		||  NULL == group.m_indices)
+		{
+			return false;
+		}
+
+		_geometry.m_aabb        = &group.m_aabb;
+		_geometry.m_positions   = group.m_positions;
+		_geometry.m_indices     = group.m_indices;
+		_geometry.m_numVertices = group.m_numVertices;
+		_geometry.m_numIndices  = group.m_numIndices;
+
+		if (0 != group.m_numLods)
+		{
+			const MeshLod& lod = group.m_lods[bx::uint32_min(_lod, group.m_numLods-1)];
+			_geometry.m_indices    = &group.m_indices[lod.m_startIndex];
+			_geometry.m_numIndices = lod.m_numIndices;
+		}
+
+		return true;
+	}
+
 	bgfx::VertexDecl m_decl;
 	typedef stl::vector<Group> GroupArray;
 	GroupArray m_groups;
+	bgfx::UniformHandle m_dequantUniform;
+	bool m_ramcopy;
+	bool m_quantized;
 };
 
-Mesh* meshLoad(bx::ReaderSeekerI* _reader)
+Mesh* meshLoad(bx::ReaderSeekerI* _reader, bool _ramcopy = false, bool _quantized = false)
 {
-	Mesh* mesh = new Mesh;
+	Mesh* mesh = new Mesh(_ramcopy, _quantized);
 	mesh->load(_reader);
 	return mesh;
 }
 
-Mesh* meshLoad(const char* _filePath)
+Mesh* meshLoad(const char* _filePath, bool _ramcopy, bool _quantized)
 {
-	bx::FileReaderI* reader = entry::getFileReader();
-	if (bx::open(reader, _filePath) )
+	MappedFile* file = mapFile(_filePath);
+	if (NULL == file)
 	{
-		Mesh* mesh = meshLoad(reader);
-		bx::close(reader);
-		return mesh;
+		return NULL;
 	}
 
-	return NULL;
+	Mesh* mesh = new Mesh(_ramcopy, _quantized);
+	bool mapped = mesh->load(file);
+	if (!mapped)
+	{
+		bx::MemoryReader reader(file->m_data, file->m_size);
+		mesh->load(&reader, file->m_data);
+	}
+
+	unmapFile(file);
+
+	return mesh;
 }
 
 void meshUnload(Mesh* _mesh)
@@ -626,14 +1711,50 @@ void meshStateDestroy(MeshState* _meshState)
 	BX_FREE(entry::getAllocator(), _meshState);
 }
 
-void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state)
+uint8_t meshGetNumLods(const Mesh* _mesh)
+{
+	return _mesh->getNumLods();
+}
+
+uint32_t meshGetNumGroups(const Mesh* _mesh)
+{
+	return uint32_t(_mesh->m_groups.size() );
+}
+
+uint32_t meshGetNumMeshlets(const Mesh* _mesh)
+{
+	uint32_t num = 0;
+	for (GroupArray::const_iterator it = _mesh->m_groups.begin(), itEnd = _mesh->m_groups.end(); it != itEnd; ++it)
+	{
+		num += uint32_t(it->m_meshlets.size() );
+	}
+
+	return num;
+}
+
+bool meshGetGeometry(const Mesh* _mesh, uint32_t _group, MeshGeometry& _geometry, uint8_t _lod)
+{
+	return _mesh->getGeometry(_group, _geometry, _lod);
+}
+
+uint8_t meshSelectLod(const Mesh* _mesh, float _distance, float _pixelScale, float _maxPixelError)
+{
+	return _mesh->selectLod(_distance, _pixelScale, _maxPixelError);
+}
+
+void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint8_t _lod)
+{
+	_mesh->submit(_id, _program, _mtx, _state, _lod);
+}
+
+uint32_t meshSubmitCulled(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state, uint8_t _lod)
 {
-	_mesh->submit(_id, _program, _mtx, _state);
+	return _mesh->submit(_id, _program, _mtx, _view, _proj, _state, _lod);
 }
 
-void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices)
+void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices, uint8_t _lod)
 {
-	_mesh->submit(_state, _numPasses, _mtx, _numMatrices);
+	_mesh->submit(_state, _numPasses, _mtx, _numMatrices, _lod);
 }
 
 Args::Args(int _argc, char** _argv)
@@ -22,6 +22,24 @@ bgfx::ShaderHandle loadShader(const char* _name);
 ///
 bgfx::ProgramHandle loadProgram(const char* _vsName, const char* _fsName);
 
+///
+struct ShaderPermutations;
+
+/// Loads shader permutation archive compiled with shaderc --permutations,
+/// with single file read. Shaders for all unique permutations are created.
+ShaderPermutations* shaderPermutationsLoad(const char* _name);
+
+///
+void shaderPermutationsUnload(ShaderPermutations* _permutations);
+
+/// Returns permutation bit for define, or 0 if define is not part of
+/// permutation archive.
+uint32_t shaderPermutationsGetBit(const ShaderPermutations* _permutations, const char* _define);
+
+/// Returns shader for combination of permutation bits. Shader handles are
+/// owned by permutation archive, and must not be destroyed by caller.
+bgfx::ShaderHandle shaderPermutationsGet(const ShaderPermutations* _permutations, uint32_t _bits);
+
 ///
 bgfx::TextureHandle loadTexture(const char* _name, uint32_t _flags = BGFX_TEXTURE_NONE, uint8_t _skip = 0, bgfx::TextureInfo* _info = NULL);
 
@@ -79,9 +97,25 @@ struct MeshState
 };
 
 struct Mesh;
+struct Aabb;
 
-///
-Mesh* meshLoad(const char* _filePath);
+/// Mesh group geometry kept in RAM, see `meshLoad`.
+struct MeshGeometry
+{
+	const Aabb*     m_aabb;        //!< Object space bounds.
+	const float*    m_positions;   //!< Object space positions, 3 floats per vertex.
+	const uint32_t* m_indices;     //!< Triangle list indices.
+	uint32_t        m_numVertices; //!< Number of vertices.
+	uint32_t        m_numIndices;  //!< Number of indices.
+};
+
+/// Load mesh. When `_ramcopy` is true positions and indices are also kept in
+/// RAM, so that mesh can be used for CPU side queries (e.g. as occluder).
+/// Vertex data quantized by geometryc (`--packpos 1`, `--packnormal 2`) is
+/// expanded on load, unless `_quantized` is true. In that case it's passed
+/// to GPU as is, and vertex shader must dequantize it with functions from
+/// examples/common/mesh.sh.
+Mesh* meshLoad(const char* _filePath, bool _ramcopy = false, bool _quantized = false);
 
 ///
 void meshUnload(Mesh* _mesh);
@@ -92,11 +126,36 @@ MeshState* meshStateCreate();
 ///
 void meshStateDestroy(MeshState* _meshState);
 
+/// Returns number of LODs generated by geometryc (0 if mesh has no LODs).
+uint8_t meshGetNumLods(const Mesh* _mesh);
+
 ///
-void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK);
+uint32_t meshGetNumGroups(const Mesh* _mesh);
+
+/// Returns number of clusters generated by geometryc --meshlets (0 if mesh
+/// has no clusters).
+uint32_t meshGetNumMeshlets(const Mesh* _mesh);
+
+/// Returns false if mesh was not loaded with `_ramcopy`. Indices of `_lod`
+/// are returned when group has LODs.
+bool meshGetGeometry(const Mesh* _mesh, uint32_t _group, MeshGeometry& _geometry, uint8_t _lod = 0);
+
+/// Returns the coarsest LOD whose error, projected on screen at _distance,
+/// is below _maxPixelError. _pixelScale is viewport height in pixels divided
+/// by 2*tan(fovy/2).
+uint8_t meshSelectLod(const Mesh* _mesh, float _distance, float _pixelScale, float _maxPixelError = 1.0f);
+
+///
+void meshSubmit(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK, uint8_t _lod = 0);
+
+/// Culls mesh groups and clusters (see geometryc --meshlets) against view
+/// frustum, and clusters whose triangles would all be culled by cull mode in
+/// _state. Submits only visible clusters, and returns number of draw calls
+/// submitted.
+uint32_t meshSubmitCulled(const Mesh* _mesh, uint8_t _id, bgfx::ProgramHandle _program, const float* _mtx, const float* _view, const float* _proj, uint64_t _state = BGFX_STATE_MASK, uint8_t _lod = 0);
 
 ///
-void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1);
+void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1, uint8_t _lod = 0);
 
 ///
 struct Args
@@ -416,6 +416,29 @@ void buildFrustumPlanes(Plane* _result, const float* _viewProj)
 	}
 }
 
+bool aabbFrustumTest(const Aabb& _aabb, const Plane* _planes, uint32_t _numPlanes)
+{
+	for (uint32_t ii = 0; ii < _numPlanes; ++ii)
+	{
+		const Plane& plane = _planes[ii];
+
+		// Corner farthest along plane normal.
+		const float pos[3] =
+		{
+			0.0f < plane.m_normal[0] ? _aabb.m_max[0] : _aabb.m_min[0],
+			0.0f < plane.m_normal[1] ? _aabb.m_max[1] : _aabb.m_min[1],
+			0.0f < plane.m_normal[2] ? _aabb.m_max[2] : _aabb.m_min[2],
+		};
+
+		if (bx::vec3Dot(plane.m_normal, pos) + plane.m_dist < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void intersectPlanes(float _result[3], const Plane& _pa, const Plane& _pb, const Plane& _pc)
 {
 	float axb[3];
@@ -106,6 +106,9 @@ void calcMinBoundingSphere(Sphere& _sphere, const void* _vertices, uint32_t _num
 /// Returns 6 (near, far, left, right, top, bottom) planes representing frustum planes.
 void buildFrustumPlanes(Plane* _planes, const float* _viewProj);
 
+/// Returns false if AABB is completely outside of any of planes.
+bool aabbFrustumTest(const Aabb& _aabb, const Plane* _planes, uint32_t _numPlanes = 6);
+
 /// Returns point from 3 intersecting planes.
 void intersectPlanes(float _result[3], const Plane& _pa, const Plane& _pb, const Plane& _pc);
 
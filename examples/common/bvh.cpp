@@ -0,0 +1,758 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/fpumath.h>
+#include <bx/simd_t.h>
+#include <float.h>
+#include "entry/entry.h"
+#include "bvh.h"
+
+#define BVH_NUM_BINS   16
+#define BVH_STACK_SIZE 256
+#define BVH_LEAF       UINT32_C(0xfffffffe)
+#define BVH_EMPTY      UINT32_MAX
+
+// Bounds of 4 children in SoA layout, so that all children can be tested at
+// once with SIMD. Size is multiple of 16, and nodes are allocated aligned,
+// so bounds can be loaded aligned.
+struct Bvh::Node
+{
+	float m_minX[4];
+	float m_minY[4];
+	float m_minZ[4];
+	float m_maxX[4];
+	float m_maxY[4];
+	float m_maxZ[4];
+
+	uint32_t m_child[4]; // Child node index, BVH_LEAF, or BVH_EMPTY.
+	uint32_t m_first[4]; // First primitive of child subtree in m_indices.
+	uint32_t m_num[4];   // Number of primitives in child subtree.
+};
+
+BX_STATIC_ASSERT(0 == sizeof(Bvh::Node)%16);
+
+struct Bvh::Range
+{
+	uint32_t m_begin;
+	uint32_t m_end;
+	Aabb m_aabb;
+};
+
+static void aabbEmpty(Aabb& _aabb)
+{
+	_aabb.m_min[0] = _aabb.m_min[1] = _aabb.m_min[2] =  FLT_MAX;
+	_aabb.m_max[0] = _aabb.m_max[1] = _aabb.m_max[2] = -FLT_MAX;
+}
+
+static void aabbUnion(Aabb& _aabb, const Aabb& _other)
+{
+	bx::vec3Min(_aabb.m_min, _aabb.m_min, _other.m_min);
+	bx::vec3Max(_aabb.m_max, _aabb.m_max, _other.m_max);
+}
+
+static void getBounds(Aabb& _aabb, const Bvh::Node& _node, uint32_t _slot)
+{
+	_aabb.m_min[0] = _node.m_minX[_slot];
+	_aabb.m_min[1] = _node.m_minY[_slot];
+	_aabb.m_min[2] = _node.m_minZ[_slot];
+	_aabb.m_max[0] = _node.m_maxX[_slot];
+	_aabb.m_max[1] = _node.m_maxY[_slot];
+	_aabb.m_max[2] = _node.m_maxZ[_slot];
+}
+
+static void setBounds(Bvh::Node& _node, uint32_t _slot, const Aabb& _aabb)
+{
+	_node.m_minX[_slot] = _aabb.m_min[0];
+	_node.m_minY[_slot] = _aabb.m_min[1];
+	_node.m_minZ[_slot] = _aabb.m_min[2];
+	_node.m_maxX[_slot] = _aabb.m_max[0];
+	_node.m_maxY[_slot] = _aabb.m_max[1];
+	_node.m_maxZ[_slot] = _aabb.m_max[2];
+}
+
+Bvh::Bvh()
+	: m_nodes(NULL)
+	, m_aabbs(NULL)
+	, m_tris(NULL)
+	, m_centroids(NULL)
+	, m_indices(NULL)
+	, m_numNodes(0)
+	, m_maxNodes(0)
+	, m_numPrims(0)
+{
+}
+
+Bvh::~Bvh()
+{
+	reset();
+}
+
+void Bvh::build(const Aabb* _aabbs, uint32_t _num)
+{
+	alloc(_num, false);
+	bx::memCopy(m_aabbs, _aabbs, _num*sizeof(Aabb) );
+	buildTree();
+}
+
+void Bvh::build(const Tris* _tris, uint32_t _num)
+{
+	alloc(_num, true);
+	bx::memCopy(m_tris, _tris, _num*sizeof(Tris) );
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		toAabb(m_aabbs[ii], &m_tris[ii], 3, 3*sizeof(float) );
+	}
+
+	buildTree();
+}
+
+void Bvh::refit(const Aabb* _aabbs)
+{
+	bx::memCopy(m_aabbs, _aabbs, m_numPrims*sizeof(Aabb) );
+	refitNodes();
+}
+
+void Bvh::refit(const Tris* _tris)
+{
+	BX_CHECK(NULL != m_tris, "BVH is not built over triangles.");
+	bx::memCopy(m_tris, _tris, m_numPrims*sizeof(Tris) );
+
+	for (uint32_t ii = 0; ii < m_numPrims; ++ii)
+	{
+		toAabb(m_aabbs[ii], &m_tris[ii], 3, 3*sizeof(float) );
+	}
+
+	refitNodes();
+}
+
+uint32_t Bvh::query(uint32_t* _visible, const Plane* _planes, uint32_t _numPlanes) const
+{
+	using namespace bx;
+
+	BX_CHECK(_numPlanes <= 16, "Too many planes %d (max: 16).", _numPlanes);
+
+	if (0 == m_numNodes)
+	{
+		return 0;
+	}
+
+	simd128_t nx[16];
+	simd128_t ny[16];
+	simd128_t nz[16];
+	simd128_t nd[16];
+	uint32_t  sign[16];
+
+	for (uint32_t ii = 0; ii < _numPlanes; ++ii)
+	{
+		const Plane& plane = _planes[ii];
+		nx[ii] = simd_splat(plane.m_normal[0]);
+		ny[ii] = simd_splat(plane.m_normal[1]);
+		nz[ii] = simd_splat(plane.m_normal[2]);
+		nd[ii] = simd_splat(plane.m_dist);
+		sign[ii] = 0
+			| (0.0f < plane.m_normal[0] ? 1 : 0)
+			| (0.0f < plane.m_normal[1] ? 2 : 0)
+			| (0.0f < plane.m_normal[2] ? 4 : 0)
+			;
+	}
+
+	const simd128_t zero = simd_zero();
+	const simd128_t ones = simd_isplat(UINT32_MAX);
+
+	uint32_t numVisible = 0;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	uint32_t depth = 0;
+	stack[depth++] = 0;
+
+	while (0 < depth)
+	{
+		const Node& node = m_nodes[stack[--depth] ];
+
+		const simd128_t minX = simd_ld(node.m_minX);
+		const simd128_t minY = simd_ld(node.m_minY);
+		const simd128_t minZ = simd_ld(node.m_minZ);
+		const simd128_t maxX = simd_ld(node.m_maxX);
+		const simd128_t maxY = simd_ld(node.m_maxY);
+		const simd128_t maxZ = simd_ld(node.m_maxZ);
+
+		simd128_t outside = zero;
+		simd128_t inside  = ones;
+
+		for (uint32_t ii = 0; ii < _numPlanes; ++ii)
+		{
+			// Box is outside if corner farthest along plane normal is behind
+			// plane, and it's completely inside if nearest corner is in front.
+			const uint32_t ss = sign[ii];
+			const simd128_t farDist = simd_madd(nx[ii], ss&1 ? maxX : minX
+				, simd_madd(ny[ii], ss&2 ? maxY : minY
+				, simd_madd(nz[ii], ss&4 ? maxZ : minZ
+				, nd[ii]
+				) ) );
+			const simd128_t nearDist = simd_madd(nx[ii], ss&1 ? minX : maxX
+				, simd_madd(ny[ii], ss&2 ? minY : maxY
+				, simd_madd(nz[ii], ss&4 ? minZ : maxZ
+				, nd[ii]
+				) ) );
+
+			outside = simd_or(outside, simd_cmplt(farDist, zero) );
+			inside  = simd_and(inside, simd_cmpge(nearDist, zero) );
+		}
+
+		BX_ALIGN_DECL_16(uint32_t out[4]);
+		BX_ALIGN_DECL_16(uint32_t in[4]);
+		simd_st(out, outside);
+		simd_st(in, inside);
+
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			const uint32_t child = node.m_child[ii];
+			if (BVH_EMPTY == child
+			||  0 != out[ii])
+			{
+				continue;
+			}
+
+			const uint32_t first = node.m_first[ii];
+			const uint32_t num   = node.m_num[ii];
+
+			if (0 != in[ii])
+			{
+				// Whole subtree is visible.
+				memCopy(&_visible[numVisible], &m_indices[first], num*sizeof(uint32_t) );
+				numVisible += num;
+			}
+			else if (BVH_LEAF == child)
+			{
+				for (uint32_t jj = first, end = first + num; jj < end; ++jj)
+				{
+					const uint32_t prim = m_indices[jj];
+					if (aabbFrustumTest(m_aabbs[prim], _planes, _numPlanes) )
+					{
+						_visible[numVisible++] = prim;
+					}
+				}
+			}
+			else
+			{
+				BX_CHECK(depth < BVH_STACK_SIZE, "BVH stack overflow.");
+				stack[depth++] = child;
+			}
+		}
+	}
+
+	return numVisible;
+}
+
+uint32_t Bvh::intersect(const Ray& _ray, Intersection* _intersection) const
+{
+	using namespace bx;
+
+	if (0 == m_numNodes)
+	{
+		return UINT32_MAX;
+	}
+
+	float invDir[3];
+	vec3Rcp(invDir, _ray.m_dir);
+
+	const simd128_t posX = simd_splat(_ray.m_pos[0]);
+	const simd128_t posY = simd_splat(_ray.m_pos[1]);
+	const simd128_t posZ = simd_splat(_ray.m_pos[2]);
+	const simd128_t invX = simd_splat(invDir[0]);
+	const simd128_t invY = simd_splat(invDir[1]);
+	const simd128_t invZ = simd_splat(invDir[2]);
+	const simd128_t zero = simd_zero();
+
+	Intersection best;
+	best.m_dist = FLT_MAX;
+	uint32_t hit = UINT32_MAX;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	float    stackDist[BVH_STACK_SIZE];
+	uint32_t depth = 0;
+	stack[depth]     = 0;
+	stackDist[depth] = -FLT_MAX;
+	++depth;
+
+	while (0 < depth)
+	{
+		--depth;
+
+		// Nearer primitive was found since node was pushed.
+		if (stackDist[depth] > best.m_dist)
+		{
+			continue;
+		}
+
+		const Node& node = m_nodes[stack[depth] ];
+
+		const simd128_t t0x = simd_mul(simd_sub(simd_ld(node.m_minX), posX), invX);
+		const simd128_t t0y = simd_mul(simd_sub(simd_ld(node.m_minY), posY), invY);
+		const simd128_t t0z = simd_mul(simd_sub(simd_ld(node.m_minZ), posZ), invZ);
+		const simd128_t t1x = simd_mul(simd_sub(simd_ld(node.m_maxX), posX), invX);
+		const simd128_t t1y = simd_mul(simd_sub(simd_ld(node.m_maxY), posY), invY);
+		const simd128_t t1z = simd_mul(simd_sub(simd_ld(node.m_maxZ), posZ), invZ);
+
+		const simd128_t tmin = simd_max(simd_max(simd_min(t0x, t1x), simd_min(t0y, t1y) ), simd_min(t0z, t1z) );
+		const simd128_t tmax = simd_min(simd_min(simd_max(t0x, t1x), simd_max(t0y, t1y) ), simd_max(t0z, t1z) );
+
+		const simd128_t mask = simd_and(
+			  simd_cmpge(tmax, simd_max(tmin, zero) )
+			, simd_cmple(tmin, simd_splat(best.m_dist) )
+			);
+
+		BX_ALIGN_DECL_16(float dist[4]);
+		BX_ALIGN_DECL_16(uint32_t hits[4]);
+		simd_st(dist, tmin);
+		simd_st(hits, mask);
+
+		// Children are pushed farthest first, so that nearest child is
+		// traversed first.
+		uint32_t order[4];
+		uint32_t num = 0;
+
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			const uint32_t child = node.m_child[ii];
+			if (BVH_EMPTY == child
+			||  0 == hits[ii])
+			{
+				continue;
+			}
+
+			if (BVH_LEAF == child)
+			{
+				for (uint32_t jj = node.m_first[ii], end = jj + node.m_num[ii]; jj < end; ++jj)
+				{
+					const uint32_t prim = m_indices[jj];
+
+					Intersection intersection;
+					if (intersectPrim(prim, _ray, intersection)
+					&&  intersection.m_dist < best.m_dist)
+					{
+						best = intersection;
+						hit  = prim;
+					}
+				}
+
+				continue;
+			}
+
+			uint32_t pos = num++;
+			for (; 0 < pos && dist[order[pos-1] ] < dist[ii]; --pos)
+			{
+				order[pos] = order[pos-1];
+			}
+			order[pos] = ii;
+		}
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			BX_CHECK(depth < BVH_STACK_SIZE, "BVH stack overflow.");
+			stack[depth]     = node.m_child[order[ii] ];
+			stackDist[depth] = dist[order[ii] ];
+			++depth;
+		}
+	}
+
+	if (UINT32_MAX != hit
+	&&  NULL != _intersection)
+	{
+		*_intersection = best;
+	}
+
+	return hit;
+}
+
+uint32_t Bvh::intersect(uint32_t* _hits, Intersection* _intersections, const Ray* _rays, uint32_t _num) const
+{
+	uint32_t numHits = 0;
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		_hits[ii] = intersect(_rays[ii], NULL != _intersections ? &_intersections[ii] : NULL);
+		numHits += UINT32_MAX != _hits[ii];
+	}
+
+	return numHits;
+}
+
+void Bvh::reset()
+{
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	if (NULL != m_nodes)
+	{
+		BX_ALIGNED_FREE(allocator, m_nodes, 16);
+	}
+
+	BX_FREE(allocator, m_aabbs);
+	BX_FREE(allocator, m_tris);
+	BX_FREE(allocator, m_centroids);
+	BX_FREE(allocator, m_indices);
+
+	m_nodes     = NULL;
+	m_aabbs     = NULL;
+	m_tris      = NULL;
+	m_centroids = NULL;
+	m_indices   = NULL;
+	m_numNodes  = 0;
+	m_maxNodes  = 0;
+	m_numPrims  = 0;
+}
+
+void Bvh::alloc(uint32_t _num, bool _tris)
+{
+	reset();
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	// Every inner node has at least 2 children, so there are never more
+	// nodes than primitives (plus root).
+	m_numPrims = _num;
+	m_maxNodes = _num + 1;
+	m_nodes    = (Node*)BX_ALIGNED_ALLOC(allocator, m_maxNodes*sizeof(Node), 16);
+	m_aabbs    = (Aabb*)BX_ALLOC(allocator, _num*sizeof(Aabb) );
+	m_tris     = _tris ? (Tris*)BX_ALLOC(allocator, _num*sizeof(Tris) ) : NULL;
+	m_indices  = (uint32_t*)BX_ALLOC(allocator, _num*sizeof(uint32_t) );
+}
+
+void Bvh::buildTree()
+{
+	m_numNodes = 0;
+
+	if (0 == m_numPrims)
+	{
+		return;
+	}
+
+	// Centroids are needed only during build.
+	bx::AllocatorI* allocator = entry::getAllocator();
+	m_centroids = (float*)BX_ALLOC(allocator, m_numPrims*3*sizeof(float) );
+
+	for (uint32_t ii = 0; ii < m_numPrims; ++ii)
+	{
+		const Aabb& aabb = m_aabbs[ii];
+		float* centroid = &m_centroids[ii*3];
+		centroid[0] = (aabb.m_min[0] + aabb.m_max[0])*0.5f;
+		centroid[1] = (aabb.m_min[1] + aabb.m_max[1])*0.5f;
+		centroid[2] = (aabb.m_min[2] + aabb.m_max[2])*0.5f;
+
+		m_indices[ii] = ii;
+	}
+
+	Range range;
+	range.m_begin = 0;
+	range.m_end   = m_numPrims;
+	calcBounds(range);
+
+	m_numNodes = 1;
+	buildNode(0, range, 0);
+
+	BX_FREE(allocator, m_centroids);
+	m_centroids = NULL;
+}
+
+void Bvh::buildNode(uint32_t _node, const Range& _range, uint32_t _depth)
+{
+	Range ranges[4];
+	bool  leaf[4];
+	uint32_t numRanges = 1;
+	ranges[0] = _range;
+	leaf[0]   = false;
+
+	// Keep splitting range with largest surface area, until there are 4
+	// children, or SAH says that remaining ranges are better as leaves.
+	while (numRanges < 4)
+	{
+		uint32_t best = UINT32_MAX;
+		float bestArea = -1.0f;
+
+		for (uint32_t ii = 0; ii < numRanges; ++ii)
+		{
+			const float area = calcAreaAabb(ranges[ii].m_aabb);
+			if (!leaf[ii]
+			&&  1 < ranges[ii].m_end - ranges[ii].m_begin
+			&&  area > bestArea)
+			{
+				best     = ii;
+				bestArea = area;
+			}
+		}
+
+		if (UINT32_MAX == best)
+		{
+			break;
+		}
+
+		Range left;
+		Range right;
+		if (!split(left, right, ranges[best], BVH_MAX_DEPTH <= _depth) )
+		{
+			leaf[best] = true;
+			continue;
+		}
+
+		ranges[best]    = left;
+		ranges[numRanges] = right;
+		leaf[numRanges] = false;
+		++numRanges;
+	}
+
+	for (uint32_t ii = 0; ii < 4; ++ii)
+	{
+		Node& node = m_nodes[_node];
+
+		if (ii >= numRanges)
+		{
+			Aabb aabb;
+			bx::memSet(&aabb, 0, sizeof(aabb) );
+			setBounds(node, ii, aabb);
+			node.m_child[ii] = BVH_EMPTY;
+			node.m_first[ii] = 0;
+			node.m_num[ii]   = 0;
+			continue;
+		}
+
+		const Range& range = ranges[ii];
+		const uint32_t num = range.m_end - range.m_begin;
+
+		setBounds(node, ii, range.m_aabb);
+		node.m_first[ii] = range.m_begin;
+		node.m_num[ii]   = num;
+
+		if (num <= BVH_MAX_LEAF_SIZE)
+		{
+			node.m_child[ii] = BVH_LEAF;
+		}
+		else
+		{
+			BX_CHECK(m_numNodes < m_maxNodes, "Too many BVH nodes.");
+			const uint32_t child = m_numNodes++;
+			node.m_child[ii] = child;
+			buildNode(child, range, _depth+1);
+		}
+	}
+}
+
+bool Bvh::split(Range& _left, Range& _right, const Range& _range, bool _force)
+{
+	const uint32_t num = _range.m_end - _range.m_begin;
+	if (2 > num)
+	{
+		return false;
+	}
+
+	float cmin[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+	float cmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (uint32_t ii = _range.m_begin; ii < _range.m_end; ++ii)
+	{
+		const float* centroid = &m_centroids[m_indices[ii]*3];
+		bx::vec3Min(cmin, cmin, centroid);
+		bx::vec3Max(cmax, cmax, centroid);
+	}
+
+	struct Bin
+	{
+		Aabb m_aabb;
+		uint32_t m_num;
+	};
+
+	uint32_t bestAxis = UINT32_MAX;
+	uint32_t bestBin  = 0;
+	float    bestCost = FLT_MAX;
+
+	for (uint32_t axis = 0; axis < 3 && !_force; ++axis)
+	{
+		const float extent = cmax[axis] - cmin[axis];
+		if (0.0f >= extent)
+		{
+			continue;
+		}
+
+		const float scale = float(BVH_NUM_BINS)/extent;
+
+		Bin bins[BVH_NUM_BINS];
+		for (uint32_t ii = 0; ii < BVH_NUM_BINS; ++ii)
+		{
+			aabbEmpty(bins[ii].m_aabb);
+			bins[ii].m_num = 0;
+		}
+
+		for (uint32_t ii = _range.m_begin; ii < _range.m_end; ++ii)
+		{
+			const uint32_t prim = m_indices[ii];
+			const uint32_t bin  = bx::uint32_min(uint32_t( (m_centroids[prim*3+axis] - cmin[axis])*scale), BVH_NUM_BINS-1);
+			aabbUnion(bins[bin].m_aabb, m_aabbs[prim]);
+			++bins[bin].m_num;
+		}
+
+		// Sweep from right to accumulate right side, then from left to
+		// evaluate cost of each split plane between bins.
+		float    rightArea[BVH_NUM_BINS];
+		uint32_t rightNum[BVH_NUM_BINS];
+
+		Aabb aabb;
+		aabbEmpty(aabb);
+		uint32_t count = 0;
+		for (uint32_t ii = BVH_NUM_BINS-1; 0 < ii; --ii)
+		{
+			aabbUnion(aabb, bins[ii].m_aabb);
+			count += bins[ii].m_num;
+			rightArea[ii] = 0 != count ? calcAreaAabb(aabb) : 0.0f;
+			rightNum[ii]  = count;
+		}
+
+		aabbEmpty(aabb);
+		count = 0;
+		for (uint32_t ii = 0; ii < BVH_NUM_BINS-1; ++ii)
+		{
+			aabbUnion(aabb, bins[ii].m_aabb);
+			count += bins[ii].m_num;
+
+			if (0 == count
+			||  0 == rightNum[ii+1])
+			{
+				continue;
+			}
+
+			const float cost = calcAreaAabb(aabb)*float(count) + rightArea[ii+1]*float(rightNum[ii+1]);
+			if (cost < bestCost)
+			{
+				bestAxis = axis;
+				bestBin  = ii+1;
+				bestCost = cost;
+			}
+		}
+	}
+
+	uint32_t mid;
+
+	if (UINT32_MAX == bestAxis)
+	{
+		// All centroids are the same, or maximum depth is reached, just
+		// split in the middle.
+		if (num <= BVH_MAX_LEAF_SIZE)
+		{
+			return false;
+		}
+
+		mid = _range.m_begin + num/2;
+	}
+	else
+	{
+		// Traversal cost is relative to primitive test cost, ranges with
+		// too many primitives for leaf are always split.
+		const float area = calcAreaAabb(_range.m_aabb);
+		if (num <= BVH_MAX_LEAF_SIZE
+		&&  area + bestCost >= float(num)*area)
+		{
+			return false;
+		}
+
+		const float scale = float(BVH_NUM_BINS)/(cmax[bestAxis] - cmin[bestAxis]);
+
+		uint32_t ii = _range.m_begin;
+		uint32_t jj = _range.m_end;
+		while (ii < jj)
+		{
+			const uint32_t prim = m_indices[ii];
+			const uint32_t bin  = bx::uint32_min(uint32_t( (m_centroids[prim*3+bestAxis] - cmin[bestAxis])*scale), BVH_NUM_BINS-1);
+
+			if (bin < bestBin)
+			{
+				++ii;
+			}
+			else
+			{
+				--jj;
+				m_indices[ii] = m_indices[jj];
+				m_indices[jj] = prim;
+			}
+		}
+
+		mid = ii;
+	}
+
+	_left.m_begin  = _range.m_begin;
+	_left.m_end    = mid;
+	_right.m_begin = mid;
+	_right.m_end   = _range.m_end;
+	calcBounds(_left);
+	calcBounds(_right);
+
+	return true;
+}
+
+void Bvh::calcBounds(Range& _range) const
+{
+	aabbEmpty(_range.m_aabb);
+
+	for (uint32_t ii = _range.m_begin; ii < _range.m_end; ++ii)
+	{
+		aabbUnion(_range.m_aabb, m_aabbs[m_indices[ii] ]);
+	}
+}
+
+void Bvh::refitNodes()
+{
+	// Children are always allocated after parent, so walking nodes backward
+	// refits children before their parents.
+	for (uint32_t nn = m_numNodes; 0 < nn--;)
+	{
+		Node& node = m_nodes[nn];
+
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			const uint32_t child = node.m_child[ii];
+			if (BVH_EMPTY == child)
+			{
+				continue;
+			}
+
+			Aabb aabb;
+			aabbEmpty(aabb);
+
+			if (BVH_LEAF == child)
+			{
+				for (uint32_t jj = node.m_first[ii], end = jj + node.m_num[ii]; jj < end; ++jj)
+				{
+					aabbUnion(aabb, m_aabbs[m_indices[jj] ]);
+				}
+			}
+			else
+			{
+				const Node& childNode = m_nodes[child];
+				for (uint32_t jj = 0; jj < 4; ++jj)
+				{
+					if (BVH_EMPTY != childNode.m_child[jj])
+					{
+						Aabb childAabb;
+						getBounds(childAabb, childNode, jj);
+						aabbUnion(aabb, childAabb);
+					}
+				}
+			}
+
+			setBounds(node, ii, aabb);
+		}
+	}
+}
+
+bool Bvh::intersectPrim(uint32_t _prim, const Ray& _ray, Intersection& _intersection) const
+{
+	if (NULL != m_tris)
+	{
+		// Triangle test doesn't reject hits behind ray origin.
+		return ::intersect(_ray, m_tris[_prim], &_intersection)
+			&& 0.0f <= _intersection.m_dist
+			;
+	}
+
+	return ::intersect(_ray, m_aabbs[_prim], &_intersection);
+}
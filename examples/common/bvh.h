@@ -0,0 +1,108 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BVH_H_HEADER_GUARD
+#define BVH_H_HEADER_GUARD
+
+#include "bounds.h"
+
+#define BVH_MAX_LEAF_SIZE 4
+#define BVH_MAX_DEPTH     48
+
+/// Bounding volume hierarchy.
+///
+/// Built with binned surface area heuristic (SAH) over AABBs or triangles.
+/// Each node has up to 4 children, and stores their bounds, so that all 4
+/// children are tested at once with SIMD. Leaves store up to
+/// BVH_MAX_LEAF_SIZE primitives.
+///
+/// For dynamic objects, tree can be refitted with new primitive bounds
+/// without rebuilding. Query quality degrades when primitives move far from
+/// their original place, in that case tree should be rebuilt.
+///
+class Bvh
+{
+public:
+	///
+	Bvh();
+
+	///
+	~Bvh();
+
+	/// Build BVH over AABBs.
+	void build(const Aabb* _aabbs, uint32_t _num);
+
+	/// Build BVH over triangles.
+	void build(const Tris* _tris, uint32_t _num);
+
+	/// Refit BVH with new AABBs. Number of AABBs must be the same as used
+	/// for build.
+	void refit(const Aabb* _aabbs);
+
+	/// Refit BVH with new triangles. Number of triangles must be the same as
+	/// used for build.
+	void refit(const Tris* _tris);
+
+	/// Find primitives which are not completely outside of any of planes.
+	///
+	/// @param[out] _visible Indices of visible primitives. Must be large
+	///   enough to hold `getNumPrimitives()` indices.
+	/// @param[in] _planes Planes, see `buildFrustumPlanes`.
+	/// @param[in] _numPlanes Number of planes.
+	/// @returns Number of visible primitives.
+	uint32_t query(uint32_t* _visible, const Plane* _planes, uint32_t _numPlanes = 6) const;
+
+	/// Find nearest primitive hit by ray.
+	///
+	/// @returns Primitive index, or UINT32_MAX if ray didn't hit anything.
+	uint32_t intersect(const Ray& _ray, Intersection* _intersection = NULL) const;
+
+	/// Find nearest primitives hit by multiple rays.
+	///
+	/// @param[out] _hits Primitive index for each ray, or UINT32_MAX if ray
+	///   didn't hit anything.
+	/// @param[out] _intersections Intersection for each ray, can be NULL.
+	/// @param[in] _rays Rays.
+	/// @param[in] _num Number of rays.
+	/// @returns Number of rays that hit primitive.
+	uint32_t intersect(uint32_t* _hits, Intersection* _intersections, const Ray* _rays, uint32_t _num) const;
+
+	///
+	uint32_t getNumPrimitives() const
+	{
+		return m_numPrims;
+	}
+
+	///
+	uint32_t getNumNodes() const
+	{
+		return m_numNodes;
+	}
+
+	/// Internal node, and build range.
+	struct Node;
+	struct Range;
+
+private:
+	void reset();
+	void alloc(uint32_t _num, bool _tris);
+	void buildTree();
+	void buildNode(uint32_t _node, const Range& _range, uint32_t _depth);
+	bool split(Range& _left, Range& _right, const Range& _range, bool _force);
+	void calcBounds(Range& _range) const;
+	void refitNodes();
+	bool intersectPrim(uint32_t _prim, const Ray& _ray, Intersection& _intersection) const;
+
+	Node* m_nodes;
+	Aabb* m_aabbs;
+	Tris* m_tris;
+	float* m_centroids;
+	uint32_t* m_indices;
+	uint32_t m_numNodes;
+	uint32_t m_maxNodes;
+	uint32_t m_numPrims;
+};
+
+#endif // BVH_H_HEADER_GUARD
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "cull.sh"
+
+BUFFER_RO(instanceBounds, vec4, 0);
+BUFFER_RO(instanceData,   vec4, 1);
+BUFFER_WR(visibleData,    vec4, 2);
+BUFFER_RW(visibleCount,   uint, 3);
+IMAGE2D_RO(s_hiz, r32f, 4);
+
+float hizLoad(ivec2 _offset, ivec2 _xy)
+{
+	return imageLoad(s_hiz, _offset + _xy).x;
+}
+
+// Returns false only if bounding box is completely behind Hi-Z depth.
+bool hizTest(vec3 _min, vec3 _max)
+{
+	vec2  rectMin  = vec2_splat( 1.0);
+	vec2  rectMax  = vec2_splat(-1.0);
+	float minDepth = 1.0;
+
+	for (int ii = 0; ii < 8; ++ii)
+	{
+		vec3 corner = mix(_min, _max, vec3(
+			  float( (ii   ) & 1)
+			, float( (ii>>1) & 1)
+			, float( (ii>>2) & 1)
+			) );
+
+		vec4 clip = mul(u_cullViewProj, vec4(corner, 1.0) );
+
+		// Box crosses near plane.
+		if (clip.w <= 0.0)
+		{
+			return true;
+		}
+
+		vec3 ndc = clip.xyz / clip.w;
+		rectMin  = min(rectMin, ndc.xy);
+		rectMax  = max(rectMax, ndc.xy);
+		minDepth = min(minDepth, ndc.z);
+	}
+
+	if (0.0 != u_homogeneousDepth)
+	{
+		minDepth = minDepth*0.5 + 0.5;
+	}
+
+	vec2 uvMin = clamp(rectMin*0.5 + 0.5, 0.0, 1.0);
+	vec2 uvMax = clamp(rectMax*0.5 + 0.5, 0.0, 1.0);
+
+	if (0.0 == u_originBottomLeft)
+	{
+		float tmp = uvMin.y;
+		uvMin.y = 1.0 - uvMax.y;
+		uvMax.y = 1.0 - tmp;
+	}
+
+	// Pick mip where rectangle covers at most 2x2 texels. When mip is
+	// clamped rectangle might cover more texels.
+	vec2  extent = (uvMax - uvMin) * u_hizSize;
+	float level  = ceil(log2(max(max(extent.x, extent.y), 1.0) ) );
+	int   mip    = int(clamp(level, 0.0, u_hizNumMips - 1.0) );
+
+	ivec2 size   = hizMipSize(mip);
+	ivec2 offset = hizMipOffset(mip);
+	ivec2 xy0    = min(ivec2(uvMin * vec2(size) ), size - 1);
+	ivec2 xy1    = min(ivec2(uvMax * vec2(size) ), size - 1);
+
+	for (int yy = xy0.y; yy <= xy1.y; ++yy)
+	{
+		for (int xx = xy0.x; xx <= xy1.x; ++xx)
+		{
+			if (minDepth <= hizLoad(offset, ivec2(xx, yy) ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+NUM_THREADS(CULL_THREADS, 1, 1)
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+
+	if (index >= u_numInstances)
+	{
+		return;
+	}
+
+	vec3 bmin = instanceBounds[index*2u+0u].xyz;
+	vec3 bmax = instanceBounds[index*2u+1u].xyz;
+
+	if (!frustumTest(bmin, bmax) )
+	{
+		return;
+	}
+
+	if (0.0 < u_hizNumMips
+	&&  !hizTest(bmin, bmax) )
+	{
+		return;
+	}
+
+	uint slot;
+	atomicFetchAndAdd(visibleCount[0], 1u, slot);
+
+	uint stride = u_instanceStride;
+	for (uint ii = 0u; ii < stride; ++ii)
+	{
+		visibleData[slot*stride + ii] = instanceData[index*stride + ii];
+	}
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "cull.sh"
+
+BUFFER_RO(visibleCount,   uint,  0);
+BUFFER_WR(indirectBuffer, uvec4, 1);
+
+NUM_THREADS(1, 1, 1)
+void main()
+{
+	drawIndexedIndirect(indirectBuffer, 0, u_numIndices, visibleCount[0], u_startIndex, 0, 0);
+}
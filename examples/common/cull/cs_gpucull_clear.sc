@@ -0,0 +1,14 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+
+BUFFER_WR(visibleCount, uint, 0);
+
+NUM_THREADS(1, 1, 1)
+void main()
+{
+	visibleCount[0] = 0u;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_compute.sh"
+#include "cull.sh"
+
+IMAGE2D_RW(s_hiz, r32f, 0);
+
+float hizLoad(ivec2 _offset, ivec2 _xy)
+{
+	return imageLoad(s_hiz, _offset + _xy).x;
+}
+
+// Writes mip u_hizMip from mip u_hizMip-1, keeping farthest depth.
+NUM_THREADS(8, 8, 1)
+void main()
+{
+	int   mip     = int(u_hizMip);
+	ivec2 dstSize = hizMipSize(mip);
+	ivec2 xy      = ivec2(gl_GlobalInvocationID.xy);
+
+	if (xy.x >= dstSize.x
+	||  xy.y >= dstSize.y)
+	{
+		return;
+	}
+
+	ivec2 srcSize   = hizMipSize(mip-1);
+	ivec2 srcOffset = hizMipOffset(mip-1);
+	ivec2 src0      = xy*2;
+	ivec2 src1      = min(src0 + 1, srcSize - 1);
+
+	float depth = max(
+		  max(hizLoad(srcOffset, src0), hizLoad(srcOffset, ivec2(src1.x, src0.y) ) )
+		, max(hizLoad(srcOffset, ivec2(src0.x, src1.y) ), hizLoad(srcOffset, src1) )
+		);
+
+	imageStore(s_hiz, hizMipOffset(mip) + xy, vec4(depth, 0.0, 0.0, 0.0) );
+}
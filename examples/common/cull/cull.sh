@@ -0,0 +1,71 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef CULL_SH_HEADER_GUARD
+#define CULL_SH_HEADER_GUARD
+
+uniform vec4 u_cullParams[3];
+uniform vec4 u_cullPlanes[6];
+uniform mat4 u_cullViewProj;
+
+// Counts are passed as floats, and they are exact as long as they are
+// below 2^24. GpuCull checks limits on CPU side.
+#define u_numInstances     uint(u_cullParams[0].x)
+#define u_instanceStride   uint(u_cullParams[0].y)
+#define u_numIndices       uint(u_cullParams[0].z)
+#define u_startIndex       uint(u_cullParams[0].w)
+#define u_hizSize          u_cullParams[1].xy
+#define u_hizNumMips       u_cullParams[1].z
+#define u_homogeneousDepth u_cullParams[1].w
+#define u_originBottomLeft u_cullParams[2].x
+#define u_hizMip           uint(u_cullParams[2].y)
+
+#define CULL_THREADS 64
+
+// Hi-Z pyramid is stored in single r32f texture, so that all mips can be
+// accessed thru one image binding. Mip 0 is power of two size, and it's
+// placed at (0, 0). Coarser mips are stacked in column right of mip 0,
+// mip N (N > 0) is placed at (width, height - height/2^(N-1) ).
+//
+//   +-------+---+
+//   |       | 1 |
+//   |   0   +-+-+
+//   |       |2|
+//   +-------+-+
+//
+ivec2 hizMipSize(int _mip)
+{
+	ivec2 size = ivec2(u_hizSize);
+	return max(ivec2(size.x >> _mip, size.y >> _mip), ivec2(1, 1) );
+}
+
+ivec2 hizMipOffset(int _mip)
+{
+	ivec2 size = ivec2(u_hizSize);
+	return 0 == _mip
+		? ivec2(0, 0)
+		: ivec2(size.x, size.y - (size.y >> (_mip-1) ) )
+		;
+}
+
+// Planes are in the same form as `buildFrustumPlanes` returns, point is
+// inside when dot(normal, point) + dist >= 0.
+bool frustumTest(vec3 _min, vec3 _max)
+{
+	for (int ii = 0; ii < 6; ++ii)
+	{
+		vec4 plane = u_cullPlanes[ii];
+		vec3 pv = mix(_min, _max, step(vec3_splat(0.0), plane.xyz) );
+
+		if (dot(plane.xyz, pv) + plane.w < 0.0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#endif // CULL_SH_HEADER_GUARD
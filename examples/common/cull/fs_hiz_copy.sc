@@ -0,0 +1,29 @@
+$input v_texcoord0
+
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "../common.sh"
+
+SAMPLER2D(s_depth, 0);
+
+uniform vec4 u_hizTexel;
+
+void main()
+{
+	// Hi-Z mip 0 is at most 2x smaller than depth buffer, take farthest
+	// depth of 2x2 samples inside Hi-Z texel.
+	vec2 offset = u_hizTexel.xy;
+	float depth = max(
+		  max(texture2D(s_depth, v_texcoord0 + vec2(-offset.x, -offset.y) ).x
+		    , texture2D(s_depth, v_texcoord0 + vec2( offset.x, -offset.y) ).x
+		    )
+		, max(texture2D(s_depth, v_texcoord0 + vec2(-offset.x,  offset.y) ).x
+		    , texture2D(s_depth, v_texcoord0 + vec2( offset.x,  offset.y) ).x
+		    )
+		);
+
+	gl_FragColor = vec4(depth, 0.0, 0.0, 0.0);
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/fpumath.h>
+#include "../bgfx_utils.h"
+#include "gpucull.h"
+
+// Must match CULL_THREADS in cull.sh.
+#define GPUCULL_THREADS 64
+
+// Counts passed thru u_cullParams must be exactly representable as float.
+#define GPUCULL_MAX_COUNT (1<<24)
+
+// Maximum number of instances that can be culled with single dispatch.
+#define GPUCULL_MAX_INSTANCES (UINT16_MAX*GPUCULL_THREADS)
+
+// Layout of u_cullParams uniform, must match cull.sh.
+struct CullParams
+{
+	float m_numInstances;
+	float m_instanceStride;
+	float m_numIndices;
+	float m_startIndex;
+
+	float m_hizWidth;
+	float m_hizHeight;
+	float m_hizNumMips;
+	float m_homogeneousDepth;
+
+	float m_originBottomLeft;
+	float m_unused[3];
+};
+
+BX_STATIC_ASSERT(sizeof(CullParams) == 3*4*sizeof(float) );
+
+bool GpuCull::isSupported()
+{
+	const uint64_t required = 0
+		| BGFX_CAPS_COMPUTE
+		| BGFX_CAPS_DRAW_INDIRECT
+		| BGFX_CAPS_INSTANCING
+		;
+	return required == (bgfx::getCaps()->supported & required);
+}
+
+GpuCull::GpuCull(uint32_t _maxInstances, uint16_t _instanceStride)
+	: m_maxInstances(bx::uint32_min(_maxInstances, GPUCULL_MAX_INSTANCES) )
+	, m_numInstances(0)
+	, m_instanceStride(_instanceStride)
+{
+	BX_CHECK(0 < _instanceStride && 5 >= _instanceStride, "Invalid instance stride %d.", _instanceStride);
+	BX_CHECK(_maxInstances <= GPUCULL_MAX_INSTANCES, "Too many instances %d (max: %d).", _maxInstances, GPUCULL_MAX_INSTANCES);
+
+	// Programs are invalid when shader binaries are missing, loadShader
+	// returns invalid handle then.
+	m_clearProgram = bgfx::createProgram(loadShader("cs_gpucull_clear"), true);
+	m_cullProgram  = bgfx::createProgram(loadShader("cs_gpucull"), true);
+	m_argsProgram  = bgfx::createProgram(loadShader("cs_gpucull_args"), true);
+	BX_WARN(isValid(), "Culling shader binaries are missing, build them with examples/common/cull/makefile.");
+
+	u_cullParams   = bgfx::createUniform("u_cullParams",   bgfx::UniformType::Vec4, 3);
+	u_cullPlanes   = bgfx::createUniform("u_cullPlanes",   bgfx::UniformType::Vec4, 6);
+	u_cullViewProj = bgfx::createUniform("u_cullViewProj", bgfx::UniformType::Mat4);
+	s_hiz          = bgfx::createUniform("s_hiz",          bgfx::UniformType::Int1);
+
+	bgfx::VertexDecl vec4Decl;
+	vec4Decl.begin()
+		.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Float)
+		.end();
+
+	// Instance data decl stride must match instance stride, because it's
+	// used as instance data buffer.
+	bgfx::VertexDecl instanceDecl;
+	instanceDecl.begin();
+	for (uint16_t ii = 0; ii < _instanceStride; ++ii)
+	{
+		instanceDecl.add(bgfx::Attrib::Enum(bgfx::Attrib::TexCoord0+ii), 4, bgfx::AttribType::Float);
+	}
+	instanceDecl.end();
+
+	m_instanceBounds = bgfx::createDynamicVertexBuffer(m_maxInstances*2, vec4Decl, BGFX_BUFFER_COMPUTE_READ);
+	m_instanceData   = bgfx::createDynamicVertexBuffer(m_maxInstances*_instanceStride, vec4Decl, BGFX_BUFFER_COMPUTE_READ);
+	m_visibleData    = bgfx::createDynamicVertexBuffer(m_maxInstances, instanceDecl, BGFX_BUFFER_COMPUTE_WRITE);
+	m_visibleCount   = bgfx::createDynamicIndexBuffer(1, BGFX_BUFFER_COMPUTE_READ_WRITE|BGFX_BUFFER_INDEX32);
+	m_indirectBuffer = bgfx::createIndirectBuffer(1);
+
+	m_hiz.idx    = bgfx::invalidHandle;
+	m_hizWidth   = 0;
+	m_hizHeight  = 0;
+	m_hizNumMips = 0;
+	bx::mtxIdentity(m_hizViewProj);
+}
+
+GpuCull::~GpuCull()
+{
+	const bgfx::ProgramHandle programs[] = { m_clearProgram, m_cullProgram, m_argsProgram };
+	for (uint32_t ii = 0; ii < BX_COUNTOF(programs); ++ii)
+	{
+		if (bgfx::isValid(programs[ii]) )
+		{
+			bgfx::destroyProgram(programs[ii]);
+		}
+	}
+
+	bgfx::destroyUniform(u_cullParams);
+	bgfx::destroyUniform(u_cullPlanes);
+	bgfx::destroyUniform(u_cullViewProj);
+	bgfx::destroyUniform(s_hiz);
+
+	bgfx::destroyDynamicVertexBuffer(m_instanceBounds);
+	bgfx::destroyDynamicVertexBuffer(m_instanceData);
+	bgfx::destroyDynamicVertexBuffer(m_visibleData);
+	bgfx::destroyDynamicIndexBuffer(m_visibleCount);
+	bgfx::destroyIndirectBuffer(m_indirectBuffer);
+}
+
+void GpuCull::update(const Aabb* _bounds, const float* _data, uint32_t _num, uint32_t _start)
+{
+	BX_CHECK(_start + _num <= m_maxInstances, "Too many instances %d (max: %d).", _start + _num, m_maxInstances);
+
+	const bgfx::Memory* bounds = bgfx::alloc(_num*2*4*sizeof(float) );
+	float* dst = (float*)bounds->data;
+	for (uint32_t ii = 0; ii < _num; ++ii, dst += 8)
+	{
+		const Aabb& aabb = _bounds[ii];
+		dst[0] = aabb.m_min[0];
+		dst[1] = aabb.m_min[1];
+		dst[2] = aabb.m_min[2];
+		dst[3] = 0.0f;
+		dst[4] = aabb.m_max[0];
+		dst[5] = aabb.m_max[1];
+		dst[6] = aabb.m_max[2];
+		dst[7] = 0.0f;
+	}
+
+	bgfx::updateDynamicVertexBuffer(m_instanceBounds, _start*2, bounds);
+	bgfx::updateDynamicVertexBuffer(m_instanceData
+		, _start*m_instanceStride
+		, bgfx::copy(_data, _num*m_instanceStride*4*sizeof(float) )
+		);
+
+	m_numInstances = bx::uint32_min(bx::uint32_max(m_numInstances, _start + _num), m_maxInstances);
+}
+
+void GpuCull::setNumInstances(uint32_t _num)
+{
+	m_numInstances = bx::uint32_min(_num, m_maxInstances);
+}
+
+void GpuCull::setHiZ(bgfx::TextureHandle _hiz, uint16_t _width, uint16_t _height, uint8_t _numMips, const float* _viewProj)
+{
+	m_hiz        = _hiz;
+	m_hizWidth   = _width;
+	m_hizHeight  = _height;
+	m_hizNumMips = bgfx::isValid(_hiz) ? _numMips : 0;
+
+	if (NULL != _viewProj)
+	{
+		bx::memCopy(m_hizViewProj, _viewProj, sizeof(m_hizViewProj) );
+	}
+}
+
+void GpuCull::dispatch(uint8_t _view, const float* _viewProj, uint32_t _numIndices, uint32_t _startIndex)
+{
+	BX_CHECK(_startIndex + _numIndices <= GPUCULL_MAX_COUNT, "Index range %d-%d is not exactly representable (max: %d)."
+		, _startIndex
+		, _startIndex + _numIndices
+		, GPUCULL_MAX_COUNT
+		);
+
+	if (!isValid() )
+	{
+		return;
+	}
+
+	const bgfx::Caps* caps = bgfx::getCaps();
+
+	CullParams params;
+	bx::memSet(&params, 0, sizeof(params) );
+	params.m_numInstances     = float(m_numInstances);
+	params.m_instanceStride   = float(m_instanceStride);
+	params.m_numIndices       = float(_numIndices);
+	params.m_startIndex       = float(_startIndex);
+	params.m_hizWidth         = float(m_hizWidth);
+	params.m_hizHeight        = float(m_hizHeight);
+	params.m_hizNumMips       = float(m_hizNumMips);
+	params.m_homogeneousDepth = caps->homogeneousDepth ? 1.0f : 0.0f;
+	params.m_originBottomLeft = caps->originBottomLeft ? 1.0f : 0.0f;
+
+	Plane planes[6];
+	buildFrustumPlanes(planes, _viewProj);
+
+	bgfx::setBuffer(0, m_visibleCount, bgfx::Access::Write);
+	bgfx::dispatch(_view, m_clearProgram);
+
+	if (0 < m_numInstances)
+	{
+		bgfx::setUniform(u_cullParams, &params, 3);
+		bgfx::setUniform(u_cullPlanes, planes, 6);
+		bgfx::setUniform(u_cullViewProj, m_hizViewProj);
+		bgfx::setBuffer(0, m_instanceBounds, bgfx::Access::Read);
+		bgfx::setBuffer(1, m_instanceData,   bgfx::Access::Read);
+		bgfx::setBuffer(2, m_visibleData,    bgfx::Access::Write);
+		bgfx::setBuffer(3, m_visibleCount,   bgfx::Access::ReadWrite);
+
+		if (0 < m_hizNumMips)
+		{
+			bgfx::setImage(4, s_hiz, m_hiz, 0, bgfx::Access::Read, bgfx::TextureFormat::R32F);
+		}
+
+		const uint32_t numGroups = (m_numInstances + GPUCULL_THREADS - 1)/GPUCULL_THREADS;
+		BX_CHECK(numGroups <= UINT16_MAX, "Too many thread groups %d.", numGroups);
+		bgfx::dispatch(_view, m_cullProgram, uint16_t(bx::uint32_min(numGroups, UINT16_MAX) ), 1, 1);
+	}
+
+	bgfx::setUniform(u_cullParams, &params, 3);
+	bgfx::setBuffer(0, m_visibleCount,   bgfx::Access::Read);
+	bgfx::setBuffer(1, m_indirectBuffer, bgfx::Access::Write);
+	bgfx::dispatch(_view, m_argsProgram);
+}
+
+void GpuCull::setInstanceDataBuffer() const
+{
+	bgfx::setInstanceDataBuffer(m_visibleData, 0, m_numInstances);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef GPUCULL_H_HEADER_GUARD
+#define GPUCULL_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include "../bounds.h"
+
+/// GPU driven instance culling.
+///
+/// Instance bounds and per instance data are uploaded once (or when they
+/// change). Every frame compute pass tests instance bounds against view
+/// frustum and optionally against Hi-Z depth pyramid, compacts visible
+/// instance data into instance data buffer, and writes indirect draw
+/// arguments. Number of visible instances is never read back to CPU.
+///
+/// Usage:
+///
+///   GpuCull cull(maxInstances, 4);
+///   cull.update(bounds, mtx, numInstances);
+///   ...
+///   cull.dispatch(cullView, viewProj, numIndices);
+///   bgfx::setVertexBuffer(0, vbh);
+///   bgfx::setIndexBuffer(ibh);
+///   cull.setInstanceDataBuffer();
+///   bgfx::submit(drawView, program, cull.getIndirectBuffer(), 0);
+///
+/// Draw view must be processed after cull view.
+///
+class GpuCull
+{
+public:
+	/// Returns true if compute, draw indirect and instancing are supported.
+	static bool isSupported();
+
+	/// @param _maxInstances Maximum number of instances, up to 65535*64
+	///   (single dispatch limit).
+	/// @param _instanceStride Per instance data size in number of vec4,
+	///   1 to 5 (i_data0 - i_data4).
+	GpuCull(uint32_t _maxInstances, uint16_t _instanceStride);
+
+	///
+	~GpuCull();
+
+	/// Returns false if culling shader binaries are not built (see
+	/// examples/common/cull/makefile). Dispatch does nothing then, and
+	/// indirect buffer must not be used for draw.
+	bool isValid() const
+	{
+		return bgfx::isValid(m_clearProgram)
+			&& bgfx::isValid(m_cullProgram)
+			&& bgfx::isValid(m_argsProgram)
+			;
+	}
+
+	/// Upload world space instance bounds, and per instance data.
+	///
+	/// @param _bounds Instance bounds.
+	/// @param _data Instance data, `_instanceStride` vec4 per instance.
+	/// @param _num Number of instances.
+	/// @param _start First instance to update.
+	void update(const Aabb* _bounds, const float* _data, uint32_t _num, uint32_t _start = 0);
+
+	/// Set number of instances to cull. Instances must be uploaded with
+	/// `update` first.
+	void setNumInstances(uint32_t _num);
+
+	/// Enable Hi-Z occlusion test. Pass invalid handle to disable it.
+	///
+	/// @param _hiz R32F Hi-Z pyramid in layout described in cull.sh,
+	///   storing farthest depth.
+	/// @param _width Mip 0 width, power of two.
+	/// @param _height Mip 0 height, power of two.
+	/// @param _numMips Number of mips in pyramid.
+	/// @param _viewProj View projection matrix used to render Hi-Z depth.
+	void setHiZ(bgfx::TextureHandle _hiz, uint16_t _width, uint16_t _height, uint8_t _numMips, const float* _viewProj);
+
+	/// Cull instances, and write indirect draw arguments for mesh with
+	/// `_numIndices` indices starting at `_startIndex`.
+	void dispatch(uint8_t _view, const float* _viewProj, uint32_t _numIndices, uint32_t _startIndex = 0);
+
+	/// Set compacted visible instances as instance data buffer for next
+	/// draw.
+	void setInstanceDataBuffer() const;
+
+	///
+	bgfx::IndirectBufferHandle getIndirectBuffer() const
+	{
+		return m_indirectBuffer;
+	}
+
+private:
+	bgfx::ProgramHandle m_clearProgram;
+	bgfx::ProgramHandle m_cullProgram;
+	bgfx::ProgramHandle m_argsProgram;
+
+	bgfx::UniformHandle u_cullParams;
+	bgfx::UniformHandle u_cullPlanes;
+	bgfx::UniformHandle u_cullViewProj;
+	bgfx::UniformHandle s_hiz;
+
+	bgfx::DynamicVertexBufferHandle m_instanceBounds;
+	bgfx::DynamicVertexBufferHandle m_instanceData;
+	bgfx::DynamicVertexBufferHandle m_visibleData;
+	bgfx::DynamicIndexBufferHandle  m_visibleCount;
+	bgfx::IndirectBufferHandle      m_indirectBuffer;
+
+	bgfx::TextureHandle m_hiz;
+	float m_hizViewProj[16];
+	uint16_t m_hizWidth;
+	uint16_t m_hizHeight;
+	uint8_t  m_hizNumMips;
+
+	uint32_t m_maxInstances;
+	uint32_t m_numInstances;
+	uint16_t m_instanceStride;
+};
+
+#endif // GPUCULL_H_HEADER_GUARD
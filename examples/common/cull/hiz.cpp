@@ -0,0 +1,506 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/fpumath.h>
+#include "../bgfx_utils.h"
+#include "../entry/entry.h"
+#include "hiz.h"
+
+// Must match u_cullParams layout in cull.sh.
+struct HiZParams
+{
+	float m_unused0[4];
+
+	float m_hizWidth;
+	float m_hizHeight;
+	float m_unused1[2];
+
+	float m_unused2;
+	float m_mip;
+	float m_unused3[2];
+};
+
+BX_STATIC_ASSERT(sizeof(HiZParams) == 3*4*sizeof(float) );
+
+struct HiZVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	float m_u;
+	float m_v;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position,  3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+			.end();
+	}
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl HiZVertex::ms_decl;
+
+// Mips are built until smaller dimension reaches 1, so that mip offsets in
+// Hi-Z texture stay inside texture.
+static uint8_t calcNumMips(uint16_t _width, uint16_t _height)
+{
+	uint8_t numMips = 1;
+	for (uint32_t size = bx::uint32_min(_width, _height); 1 < size; size >>= 1)
+	{
+		++numMips;
+	}
+
+	return numMips;
+}
+
+static void hizMipRect(uint16_t* _rect, uint16_t _width, uint16_t _height, uint8_t _mip)
+{
+	_rect[0] = 0 == _mip ? 0 : _width;
+	_rect[1] = 0 == _mip ? 0 : uint16_t(_height - (_height >> (_mip-1) ) );
+	_rect[2] = uint16_t(bx::uint32_max(_width  >> _mip, 1) );
+	_rect[3] = uint16_t(bx::uint32_max(_height >> _mip, 1) );
+}
+
+DepthPyramid::DepthPyramid()
+	: m_data(NULL)
+	, m_width(0)
+	, m_height(0)
+	, m_numMips(0)
+	, m_homogeneousDepth(false)
+{
+	bx::memSet(m_mip, 0, sizeof(m_mip) );
+	bx::mtxIdentity(m_viewProj);
+}
+
+DepthPyramid::~DepthPyramid()
+{
+	if (NULL != m_data)
+	{
+		BX_ALIGNED_FREE(entry::getAllocator(), m_data, 16);
+	}
+}
+
+void DepthPyramid::resize(uint16_t _width, uint16_t _height)
+{
+	if (_width  == m_width
+	&&  _height == m_height)
+	{
+		return;
+	}
+
+	m_width   = _width;
+	m_height  = _height;
+	m_numMips = calcNumMips(_width, _height);
+
+	uint32_t size = 0;
+	for (uint8_t mip = 0; mip < m_numMips; ++mip)
+	{
+		size += bx::uint32_max(_width >> mip, 1) * bx::uint32_max(_height >> mip, 1);
+	}
+
+	// Mip 0 is aligned, so that it can be accessed with SIMD.
+	bx::AllocatorI* allocator = entry::getAllocator();
+	if (NULL != m_data)
+	{
+		BX_ALIGNED_FREE(allocator, m_data, 16);
+	}
+
+	m_data = (float*)BX_ALIGNED_ALLOC(allocator, size*sizeof(float), 16);
+
+	float* data = m_data;
+	for (uint8_t mip = 0; mip < m_numMips; ++mip)
+	{
+		m_mip[mip] = data;
+		data += bx::uint32_max(_width >> mip, 1) * bx::uint32_max(_height >> mip, 1);
+	}
+}
+
+void DepthPyramid::setViewProj(const float* _viewProj, bool _homogeneousDepth)
+{
+	bx::memCopy(m_viewProj, _viewProj, sizeof(m_viewProj) );
+	m_homogeneousDepth = _homogeneousDepth;
+}
+
+void DepthPyramid::build()
+{
+	for (uint8_t mip = 1; mip < m_numMips; ++mip)
+	{
+		const uint32_t srcWidth  = bx::uint32_max(m_width  >> (mip-1), 1);
+		const uint32_t srcHeight = bx::uint32_max(m_height >> (mip-1), 1);
+		const uint32_t dstWidth  = bx::uint32_max(m_width  >> mip, 1);
+		const uint32_t dstHeight = bx::uint32_max(m_height >> mip, 1);
+
+		const float* src = m_mip[mip-1];
+		float* dst = m_mip[mip];
+
+		for (uint32_t yy = 0; yy < dstHeight; ++yy)
+		{
+			const uint32_t y0 = bx::uint32_min(yy*2,   srcHeight-1);
+			const uint32_t y1 = bx::uint32_min(yy*2+1, srcHeight-1);
+
+			for (uint32_t xx = 0; xx < dstWidth; ++xx)
+			{
+				const uint32_t x0 = bx::uint32_min(xx*2,   srcWidth-1);
+				const uint32_t x1 = bx::uint32_min(xx*2+1, srcWidth-1);
+
+				dst[yy*dstWidth + xx] = bx::fmax(
+					  bx::fmax(src[y0*srcWidth + x0], src[y0*srcWidth + x1])
+					, bx::fmax(src[y1*srcWidth + x0], src[y1*srcWidth + x1])
+					);
+			}
+		}
+	}
+}
+
+bool DepthPyramid::testAabb(const Aabb& _aabb) const
+{
+	if (0 == m_numMips)
+	{
+		return true;
+	}
+
+	float minX =  1.0f;
+	float minY =  1.0f;
+	float maxX = -1.0f;
+	float maxY = -1.0f;
+	float minZ =  1.0f;
+
+	for (uint32_t ii = 0; ii < 8; ++ii)
+	{
+		const float corner[4] =
+		{
+			ii&1 ? _aabb.m_max[0] : _aabb.m_min[0],
+			ii&2 ? _aabb.m_max[1] : _aabb.m_min[1],
+			ii&4 ? _aabb.m_max[2] : _aabb.m_min[2],
+			1.0f,
+		};
+
+		float clip[4];
+		bx::vec4MulMtx(clip, corner, m_viewProj);
+
+		// Box crosses near plane.
+		if (clip[3] <= 0.0f)
+		{
+			return true;
+		}
+
+		const float invW = 1.0f/clip[3];
+		const float xx = clip[0]*invW;
+		const float yy = clip[1]*invW;
+		const float zz = clip[2]*invW;
+
+		minX = bx::fmin(minX, xx);
+		minY = bx::fmin(minY, yy);
+		maxX = bx::fmax(maxX, xx);
+		maxY = bx::fmax(maxY, yy);
+		minZ = bx::fmin(minZ, zz);
+	}
+
+	// There is no depth information outside of screen.
+	if (maxX < -1.0f || minX > 1.0f
+	||  maxY < -1.0f || minY > 1.0f)
+	{
+		return true;
+	}
+
+	if (m_homogeneousDepth)
+	{
+		minZ = minZ*0.5f + 0.5f;
+	}
+
+	// Row 0 is at the top.
+	const float width  = float(m_width);
+	const float height = float(m_height);
+	const float x0 = bx::fsaturate(minX*0.5f + 0.5f) * width;
+	const float x1 = bx::fsaturate(maxX*0.5f + 0.5f) * width;
+	const float y0 = bx::fsaturate(0.5f - maxY*0.5f) * height;
+	const float y1 = bx::fsaturate(0.5f - minY*0.5f) * height;
+
+	// Pick mip where rectangle covers at most 2x2 texels. When mip is
+	// clamped rectangle might cover more texels.
+	const float extent = bx::fmax(bx::fmax(x1 - x0, y1 - y0), 1.0f);
+	const uint8_t mip  = uint8_t(bx::uint32_min(uint32_t(bx::fceil(bx::flog2(extent) ) ), m_numMips-1) );
+
+	const uint32_t mipWidth  = bx::uint32_max(m_width  >> mip, 1);
+	const uint32_t mipHeight = bx::uint32_max(m_height >> mip, 1);
+	const float scale = 1.0f/float(1<<mip);
+
+	const uint32_t tx0 = bx::uint32_min(uint32_t(x0*scale), mipWidth -1);
+	const uint32_t tx1 = bx::uint32_min(uint32_t(x1*scale), mipWidth -1);
+	const uint32_t ty0 = bx::uint32_min(uint32_t(y0*scale), mipHeight-1);
+	const uint32_t ty1 = bx::uint32_min(uint32_t(y1*scale), mipHeight-1);
+
+	const float* depth = m_mip[mip];
+	for (uint32_t yy = ty0; yy <= ty1; ++yy)
+	{
+		for (uint32_t xx = tx0; xx <= tx1; ++xx)
+		{
+			if (minZ <= depth[yy*mipWidth + xx])
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+uint32_t DepthPyramid::testAabbs(uint32_t* _visible, const Aabb* _aabbs, uint32_t _num) const
+{
+	uint32_t numVisible = 0;
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		if (testAabb(_aabbs[ii]) )
+		{
+			_visible[numVisible++] = ii;
+		}
+	}
+
+	return numVisible;
+}
+
+bool HiZ::isSupported()
+{
+	const bgfx::Caps* caps = bgfx::getCaps();
+	const uint16_t formatRequired = 0
+		| BGFX_CAPS_FORMAT_TEXTURE_IMAGE
+		| BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER
+		;
+
+	return 0 != (caps->supported & BGFX_CAPS_COMPUTE)
+		&& formatRequired == (caps->formats[bgfx::TextureFormat::R32F] & formatRequired)
+		;
+}
+
+HiZ::HiZ(uint16_t _width, uint16_t _height)
+	: m_readbackData(NULL)
+	, m_readbackFrame(UINT32_MAX)
+	, m_width(_width)
+	, m_height(_height)
+	, m_readbackWidth(0)
+	, m_readbackHeight(0)
+	, m_numMips(calcNumMips(_width, _height) )
+	, m_readbackMip(0)
+{
+	BX_CHECK(0 == (_width & (_width-1) ) && 0 == (_height & (_height-1) ) && 1 < _width && 1 < _height
+		, "Hi-Z size must be power of two (width %d, height %d)."
+		, _width
+		, _height
+		);
+
+	if (0 == HiZVertex::ms_decl.getStride() )
+	{
+		HiZVertex::init();
+	}
+
+	// Programs are invalid when shader binaries are missing, loadShader
+	// and loadProgram return invalid handle then.
+	m_copyProgram       = loadProgram("vs_hiz_copy", "fs_hiz_copy");
+	m_downsampleProgram = bgfx::createProgram(loadShader("cs_hiz_downsample"), true);
+	BX_WARN(isValid(), "Hi-Z shader binaries are missing, build them with examples/common/cull/makefile.");
+
+	s_depth      = bgfx::createUniform("s_depth",      bgfx::UniformType::Int1);
+	s_hiz        = bgfx::createUniform("s_hiz",        bgfx::UniformType::Int1);
+	u_hizTexel   = bgfx::createUniform("u_hizTexel",   bgfx::UniformType::Vec4);
+	u_cullParams = bgfx::createUniform("u_cullParams", bgfx::UniformType::Vec4, 3);
+
+	m_texture = bgfx::createTexture2D(
+		  uint16_t(_width + _width/2)
+		, _height
+		, false
+		, 1
+		, bgfx::TextureFormat::R32F
+		, BGFX_TEXTURE_RT
+		| BGFX_TEXTURE_COMPUTE_WRITE
+		| BGFX_TEXTURE_MIN_POINT
+		| BGFX_TEXTURE_MAG_POINT
+		| BGFX_TEXTURE_MIP_POINT
+		| BGFX_TEXTURE_U_CLAMP
+		| BGFX_TEXTURE_V_CLAMP
+		);
+	m_frameBuffer = bgfx::createFrameBuffer(1, &m_texture, false);
+
+	m_readback.idx = bgfx::invalidHandle;
+
+	bx::mtxIdentity(m_viewProj);
+	bx::mtxIdentity(m_readbackViewProj);
+}
+
+HiZ::~HiZ()
+{
+	if (bgfx::isValid(m_copyProgram) )
+	{
+		bgfx::destroyProgram(m_copyProgram);
+	}
+
+	if (bgfx::isValid(m_downsampleProgram) )
+	{
+		bgfx::destroyProgram(m_downsampleProgram);
+	}
+
+	bgfx::destroyUniform(s_depth);
+	bgfx::destroyUniform(s_hiz);
+	bgfx::destroyUniform(u_hizTexel);
+	bgfx::destroyUniform(u_cullParams);
+
+	bgfx::destroyFrameBuffer(m_frameBuffer);
+	bgfx::destroyTexture(m_texture);
+
+	if (bgfx::isValid(m_readback) )
+	{
+		bgfx::destroyTexture(m_readback);
+	}
+
+	delete [] m_readbackData;
+}
+
+void HiZ::build(uint8_t _view, bgfx::TextureHandle _depth, const float* _viewProj)
+{
+	if (!isValid() )
+	{
+		return;
+	}
+
+	const bgfx::Caps* caps = bgfx::getCaps();
+
+	bx::memCopy(m_viewProj, _viewProj, sizeof(m_viewProj) );
+
+	// Copy depth into mip 0 with full screen triangle.
+	bgfx::setViewFrameBuffer(_view, m_frameBuffer);
+	bgfx::setViewRect(_view, 0, 0, m_width, m_height);
+	bgfx::setViewTransform(_view, NULL, NULL);
+
+	if (3 == bgfx::getAvailTransientVertexBuffer(3, HiZVertex::ms_decl) )
+	{
+		bgfx::TransientVertexBuffer tvb;
+		bgfx::allocTransientVertexBuffer(&tvb, 3, HiZVertex::ms_decl);
+		HiZVertex* vertex = (HiZVertex*)tvb.data;
+
+		const float pos[3][2] = { { -1.0f, -1.0f }, { 3.0f, -1.0f }, { -1.0f, 3.0f } };
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			vertex[ii].m_x = pos[ii][0];
+			vertex[ii].m_y = pos[ii][1];
+			vertex[ii].m_z = 0.0f;
+			vertex[ii].m_u = pos[ii][0]*0.5f + 0.5f;
+			vertex[ii].m_v = caps->originBottomLeft
+				? pos[ii][1]*0.5f + 0.5f
+				: 0.5f - pos[ii][1]*0.5f
+				;
+		}
+
+		const float texel[4] = { 0.25f/float(m_width), 0.25f/float(m_height), 0.0f, 0.0f };
+		bgfx::setUniform(u_hizTexel, texel);
+		bgfx::setTexture(0, s_depth, _depth
+			, BGFX_TEXTURE_MIN_POINT
+			| BGFX_TEXTURE_MAG_POINT
+			| BGFX_TEXTURE_MIP_POINT
+			| BGFX_TEXTURE_U_CLAMP
+			| BGFX_TEXTURE_V_CLAMP
+			);
+		bgfx::setVertexBuffer(0, &tvb);
+		bgfx::setState(BGFX_STATE_RGB_WRITE|BGFX_STATE_ALPHA_WRITE);
+		bgfx::submit(_view, m_copyProgram);
+	}
+
+	// Downsample one mip per dispatch.
+	HiZParams params;
+	bx::memSet(&params, 0, sizeof(params) );
+	params.m_hizWidth  = float(m_width);
+	params.m_hizHeight = float(m_height);
+
+	for (uint8_t mip = 1; mip < m_numMips; ++mip)
+	{
+		params.m_mip = float(mip);
+
+		const uint32_t width  = bx::uint32_max(m_width  >> mip, 1);
+		const uint32_t height = bx::uint32_max(m_height >> mip, 1);
+
+		bgfx::setUniform(u_cullParams, &params, 3);
+		bgfx::setImage(0, s_hiz, m_texture, 0, bgfx::Access::ReadWrite, bgfx::TextureFormat::R32F);
+		bgfx::dispatch(_view+1, m_downsampleProgram, uint16_t( (width+7)/8), uint16_t( (height+7)/8), 1);
+	}
+}
+
+void HiZ::readback(uint8_t _view, uint8_t _mip)
+{
+	const bgfx::Caps* caps = bgfx::getCaps();
+	const uint64_t required = BGFX_CAPS_TEXTURE_BLIT|BGFX_CAPS_TEXTURE_READ_BACK;
+	BX_WARN(required == (caps->supported & required), "Hi-Z read back is not supported.");
+	if (required != (caps->supported & required)
+	||  !isValid()
+	||  UINT32_MAX != m_readbackFrame)
+	{
+		return;
+	}
+
+	_mip = uint8_t(bx::uint32_min(_mip, m_numMips-1) );
+
+	uint16_t rect[4];
+	hizMipRect(rect, m_width, m_height, _mip);
+
+	if (rect[2] != m_readbackWidth
+	||  rect[3] != m_readbackHeight)
+	{
+		if (bgfx::isValid(m_readback) )
+		{
+			bgfx::destroyTexture(m_readback);
+		}
+
+		m_readbackWidth  = rect[2];
+		m_readbackHeight = rect[3];
+		m_readback = bgfx::createTexture2D(
+			  m_readbackWidth
+			, m_readbackHeight
+			, false
+			, 1
+			, bgfx::TextureFormat::R32F
+			, BGFX_TEXTURE_BLIT_DST
+			| BGFX_TEXTURE_READ_BACK
+			);
+
+		delete [] m_readbackData;
+		m_readbackData = new float[m_readbackWidth*m_readbackHeight];
+	}
+
+	bgfx::blit(_view, m_readback, 0, 0, m_texture, rect[0], rect[1], rect[2], rect[3]);
+	m_readbackFrame = bgfx::readTexture(m_readback, m_readbackData);
+	m_readbackMip   = _mip;
+	bx::memCopy(m_readbackViewProj, m_viewProj, sizeof(m_readbackViewProj) );
+}
+
+bool HiZ::update(uint32_t _frame)
+{
+	if (UINT32_MAX == m_readbackFrame
+	||  _frame < m_readbackFrame)
+	{
+		return false;
+	}
+
+	m_readbackFrame = UINT32_MAX;
+
+	const bgfx::Caps* caps = bgfx::getCaps();
+
+	m_pyramid.resize(m_readbackWidth, m_readbackHeight);
+	m_pyramid.setViewProj(m_readbackViewProj, caps->homogeneousDepth);
+
+	// Pyramid row 0 is at the top.
+	const uint32_t pitch = m_readbackWidth*sizeof(float);
+	float* depth = m_pyramid.getDepth();
+	for (uint32_t yy = 0; yy < m_readbackHeight; ++yy)
+	{
+		const uint32_t src = caps->originBottomLeft ? m_readbackHeight - 1 - yy : yy;
+		bx::memCopy(&depth[yy*m_readbackWidth], &m_readbackData[src*m_readbackWidth], pitch);
+	}
+
+	m_pyramid.build();
+
+	return true;
+}
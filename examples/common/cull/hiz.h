@@ -0,0 +1,195 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef HIZ_H_HEADER_GUARD
+#define HIZ_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include "../bounds.h"
+
+/// CPU depth pyramid for batch AABB occlusion tests.
+///
+/// Depth is window depth in [0, 1] range, with row 0 at the top of the
+/// screen. Each texel of mip N > 0 stores farthest depth of 2x2 texels of
+/// mip N-1.
+///
+class DepthPyramid
+{
+public:
+	///
+	DepthPyramid();
+
+	///
+	~DepthPyramid();
+
+	/// Resize mip 0. Mip 0 contents are undefined after resize.
+	void resize(uint16_t _width, uint16_t _height);
+
+	/// Set view projection matrix used to render depth.
+	void setViewProj(const float* _viewProj, bool _homogeneousDepth);
+
+	/// Returns mip 0 depth, `getWidth()*getHeight()` floats.
+	float* getDepth()
+	{
+		return m_mip[0];
+	}
+
+	/// Build coarser mips from mip 0.
+	void build();
+
+	/// Returns false if AABB is completely behind depth.
+	bool testAabb(const Aabb& _aabb) const;
+
+	/// Test multiple AABBs.
+	///
+	/// @param[out] _visible Indices of AABBs that are not occluded. Must be
+	///   large enough to hold `_num` indices.
+	/// @param[in] _aabbs World space AABBs.
+	/// @param[in] _num Number of AABBs.
+	/// @returns Number of visible AABBs.
+	uint32_t testAabbs(uint32_t* _visible, const Aabb* _aabbs, uint32_t _num) const;
+
+	///
+	uint16_t getWidth() const
+	{
+		return m_width;
+	}
+
+	///
+	uint16_t getHeight() const
+	{
+		return m_height;
+	}
+
+	///
+	uint8_t getNumMips() const
+	{
+		return m_numMips;
+	}
+
+private:
+	float* m_data;
+	float* m_mip[16];
+	float m_viewProj[16];
+	uint16_t m_width;
+	uint16_t m_height;
+	uint8_t m_numMips;
+	bool m_homogeneousDepth;
+};
+
+/// GPU Hi-Z pyramid.
+///
+/// Depth buffer is copied into mip 0 with fragment shader, and coarser mips
+/// are built with compute shader. All mips are stored in single R32F
+/// texture, see cull.sh for layout. Texture can be used directly by
+/// `GpuCull::setHiZ`, or coarse mip can be read back to CPU for batch AABB
+/// tests with few frames of latency.
+///
+class HiZ
+{
+public:
+	/// Returns true if compute and R32F compute/render target textures are
+	/// supported.
+	static bool isSupported();
+
+	/// @param _width Mip 0 width, power of two.
+	/// @param _height Mip 0 height, power of two.
+	HiZ(uint16_t _width, uint16_t _height);
+
+	///
+	~HiZ();
+
+	/// Returns false if Hi-Z shader binaries are not built (see
+	/// examples/common/cull/makefile). Build and read back do nothing then,
+	/// and texture must not be passed to `GpuCull::setHiZ`.
+	bool isValid() const
+	{
+		return bgfx::isValid(m_copyProgram)
+			&& bgfx::isValid(m_downsampleProgram)
+			;
+	}
+
+	/// Build Hi-Z pyramid from depth texture.
+	///
+	/// @param _view View used for depth copy. View `_view+1` is used for
+	///   downsampling.
+	/// @param _depth Depth texture, up to 2x larger than mip 0.
+	/// @param _viewProj View projection matrix used to render depth.
+	void build(uint8_t _view, bgfx::TextureHandle _depth, const float* _viewProj);
+
+	/// Request CPU read back of Hi-Z mip. When read back completes,
+	/// `update` returns true and `getPyramid` contains read back mip as
+	/// mip 0.
+	///
+	/// @param _view View used for blit, must be after build views.
+	/// @param _mip Hi-Z mip to read back.
+	void readback(uint8_t _view, uint8_t _mip);
+
+	/// Call with `bgfx::frame` result. Returns true when read back completed.
+	bool update(uint32_t _frame);
+
+	///
+	bgfx::TextureHandle getTexture() const
+	{
+		return m_texture;
+	}
+
+	///
+	uint16_t getWidth() const
+	{
+		return m_width;
+	}
+
+	///
+	uint16_t getHeight() const
+	{
+		return m_height;
+	}
+
+	///
+	uint8_t getNumMips() const
+	{
+		return m_numMips;
+	}
+
+	/// Returns view projection matrix of last build.
+	const float* getViewProj() const
+	{
+		return m_viewProj;
+	}
+
+	/// Returns CPU pyramid from last completed read back.
+	const DepthPyramid& getPyramid() const
+	{
+		return m_pyramid;
+	}
+
+private:
+	bgfx::ProgramHandle m_copyProgram;
+	bgfx::ProgramHandle m_downsampleProgram;
+
+	bgfx::UniformHandle s_depth;
+	bgfx::UniformHandle s_hiz;
+	bgfx::UniformHandle u_hizTexel;
+	bgfx::UniformHandle u_cullParams;
+
+	bgfx::TextureHandle     m_texture;
+	bgfx::FrameBufferHandle m_frameBuffer;
+	bgfx::TextureHandle     m_readback;
+
+	DepthPyramid m_pyramid;
+	float* m_readbackData;
+	float m_viewProj[16];
+	float m_readbackViewProj[16];
+	uint32_t m_readbackFrame;
+	uint16_t m_width;
+	uint16_t m_height;
+	uint16_t m_readbackWidth;
+	uint16_t m_readbackHeight;
+	uint8_t m_numMips;
+	uint8_t m_readbackMip;
+};
+
+#endif // HIZ_H_HEADER_GUARD
@@ -0,0 +1,501 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/cpu.h>
+#include <bx/fpumath.h>
+#include <bx/simd_t.h>
+#include "../bgfx_utils.h"
+#include "../entry/entry.h"
+#include "occlusionbuffer.h"
+
+// Triangle in window space. Edge functions are positive inside triangle, and
+// depth is plane equation, both evaluated at pixel center.
+struct OcclusionBuffer::Triangle
+{
+	float m_edge[3][3];
+	float m_depth[3];
+	uint16_t m_rect[4];
+};
+
+// Rasterizer and clear load and store 4 pixels at the time, and tiles
+// never cross row end, so tile width keeps SIMD access inside of row.
+BX_STATIC_ASSERT(0 == OCCLUSION_TILE_WIDTH%4);
+
+static uint16_t alignUp(uint16_t _size, uint16_t _align)
+{
+	return uint16_t( (bx::uint32_max(_size, 1) + _align - 1) / _align * _align);
+}
+
+template<typename Ty>
+static Ty* grow(Ty* _ptr, uint32_t _num, uint32_t& _max)
+{
+	if (_num < _max)
+	{
+		return _ptr;
+	}
+
+	_max = bx::uint32_max(_max*2, 256);
+	return (Ty*)BX_REALLOC(entry::getAllocator(), _ptr, _max*sizeof(Ty) );
+}
+
+OcclusionBuffer::OcclusionBuffer(uint16_t _width, uint16_t _height, uint8_t _numThreads)
+	: m_vertices(NULL)
+	, m_maxVertices(0)
+	, m_triangles(NULL)
+	, m_numTriangles(0)
+	, m_maxTriangles(0)
+	, m_numTilesX(alignUp(_width,  OCCLUSION_TILE_WIDTH )/OCCLUSION_TILE_WIDTH)
+	, m_numTilesY(alignUp(_height, OCCLUSION_TILE_HEIGHT)/OCCLUSION_TILE_HEIGHT)
+	, m_nextTile(0)
+	, m_numOccluders(0)
+	, m_numThreads(0)
+	, m_homogeneousDepth(false)
+	, m_exit(false)
+{
+	BX_WARN(0 == _width%OCCLUSION_TILE_WIDTH && 0 == _height%OCCLUSION_TILE_HEIGHT
+		, "Occlusion buffer size is rounded up to multiple of tile size (width %d, height %d)."
+		, _width
+		, _height
+		);
+
+	m_pyramid.resize(
+		  uint16_t(m_numTilesX*OCCLUSION_TILE_WIDTH)
+		, uint16_t(m_numTilesY*OCCLUSION_TILE_HEIGHT)
+		);
+	bx::mtxIdentity(m_viewProj);
+	buildFrustumPlanes(m_planes, m_viewProj);
+
+	const uint32_t numTiles = m_numTilesX*m_numTilesY;
+	m_bins = (Bin*)BX_ALLOC(entry::getAllocator(), numTiles*sizeof(Bin) );
+	bx::memSet(m_bins, 0, numTiles*sizeof(Bin) );
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_numThreads = uint8_t(bx::uint32_min(_numThreads, OCCLUSION_MAX_THREADS) );
+	for (uint8_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].init(threadFunc, this, 0, "occlusion buffer");
+	}
+#else
+	BX_UNUSED(_numThreads);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_exit = true;
+	m_workSem.post(m_numThreads);
+
+	for (uint8_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].shutdown();
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	for (uint32_t ii = 0, num = m_numTilesX*m_numTilesY; ii < num; ++ii)
+	{
+		BX_FREE(allocator, m_bins[ii].m_triangles);
+	}
+
+	BX_FREE(allocator, m_bins);
+	BX_FREE(allocator, m_triangles);
+
+	if (NULL != m_vertices)
+	{
+		BX_ALIGNED_FREE(allocator, m_vertices, 16);
+	}
+}
+
+void OcclusionBuffer::begin(const float* _viewProj, bool _homogeneousDepth)
+{
+	bx::memCopy(m_viewProj, _viewProj, sizeof(m_viewProj) );
+	buildFrustumPlanes(m_planes, _viewProj);
+	m_homogeneousDepth = _homogeneousDepth;
+	m_pyramid.setViewProj(_viewProj, _homogeneousDepth);
+
+	m_numTriangles = 0;
+	m_numOccluders = 0;
+
+	for (uint32_t ii = 0, num = m_numTilesX*m_numTilesY; ii < num; ++ii)
+	{
+		m_bins[ii].m_num = 0;
+	}
+
+	const uint32_t size = m_pyramid.getWidth()*m_pyramid.getHeight();
+	const bx::simd128_t one = bx::simd_splat(1.0f);
+	float* depth = m_pyramid.getDepth();
+	for (uint32_t ii = 0; ii < size; ii += 4)
+	{
+		bx::simd_st(&depth[ii], one);
+	}
+}
+
+void OcclusionBuffer::rasterize(const float* _mtx, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	using namespace bx;
+
+	if (_numVertices > m_maxVertices)
+	{
+		AllocatorI* allocator = entry::getAllocator();
+		if (NULL != m_vertices)
+		{
+			BX_ALIGNED_FREE(allocator, m_vertices, 16);
+		}
+
+		m_maxVertices = _numVertices;
+		m_vertices = (float*)BX_ALIGNED_ALLOC(allocator, m_maxVertices*4*sizeof(float), 16);
+	}
+
+	float mtx[16];
+	if (NULL != _mtx)
+	{
+		mtxMul(mtx, _mtx, m_viewProj);
+	}
+	else
+	{
+		memCopy(mtx, m_viewProj, sizeof(mtx) );
+	}
+
+	// Transform vertices to window space: x, y in pixels with row 0 at the
+	// top, z window depth in [0, 1], and w clip w.
+	const float width  = float(m_pyramid.getWidth() );
+	const float height = float(m_pyramid.getHeight() );
+	const float zScale = m_homogeneousDepth ? 0.5f : 1.0f;
+	const float zBias  = m_homogeneousDepth ? 0.5f : 0.0f;
+
+	const simd128_t row0 = simd_ld(mtx[ 0], mtx[ 1], mtx[ 2], mtx[ 3]);
+	const simd128_t row1 = simd_ld(mtx[ 4], mtx[ 5], mtx[ 6], mtx[ 7]);
+	const simd128_t row2 = simd_ld(mtx[ 8], mtx[ 9], mtx[10], mtx[11]);
+	const simd128_t row3 = simd_ld(mtx[12], mtx[13], mtx[14], mtx[15]);
+	const simd128_t scale = simd_ld(width*0.5f, -height*0.5f, zScale, 0.0f);
+	const simd128_t bias  = simd_ld(width*0.5f,  height*0.5f, zBias,  0.0f);
+	const simd128_t maskW = simd_ild(0, 0, 0, UINT32_MAX);
+
+	const uint8_t* vertices = (const uint8_t*)_vertices;
+	for (uint32_t ii = 0; ii < _numVertices; ++ii, vertices += _stride)
+	{
+		const float* pos = (const float*)vertices;
+
+		const simd128_t clip = simd_madd(simd_splat(pos[0]), row0
+			, simd_madd(simd_splat(pos[1]), row1
+			, simd_madd(simd_splat(pos[2]), row2
+			, row3
+			) ) );
+
+		// Vertices behind eye are rejected below by w, so division by
+		// w here doesn't matter for them.
+		const simd128_t ww     = simd_swiz_wwww(clip);
+		const simd128_t ndc    = simd_div(clip, ww);
+		const simd128_t window = simd_madd(ndc, scale, bias);
+
+		simd_st(&m_vertices[ii*4], simd_selb(maskW, clip, window) );
+	}
+
+	const uint16_t* indices16 = (const uint16_t*)_indices;
+	const uint32_t* indices32 = (const uint32_t*)_indices;
+
+	for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+	{
+		const uint32_t i0 = _index32 ? indices32[ii+0] : indices16[ii+0];
+		const uint32_t i1 = _index32 ? indices32[ii+1] : indices16[ii+1];
+		const uint32_t i2 = _index32 ? indices32[ii+2] : indices16[ii+2];
+
+		const float* v0 = &m_vertices[i0*4];
+		const float* v1 = &m_vertices[i1*4];
+		const float* v2 = &m_vertices[i2*4];
+
+		// Triangles crossing near plane are skipped. Skipping occluder is
+		// always conservative.
+		if (0.0f >= v0[3] || 0.0f > v0[2]
+		||  0.0f >= v1[3] || 0.0f > v1[2]
+		||  0.0f >= v2[3] || 0.0f > v2[2])
+		{
+			continue;
+		}
+
+		setupTriangle(v0, v1, v2);
+	}
+
+	++m_numOccluders;
+}
+
+void OcclusionBuffer::rasterize(const Mesh* _mesh, const float* _mtx, uint8_t _lod)
+{
+	float mtx[16];
+	if (NULL != _mtx)
+	{
+		bx::mtxMul(mtx, _mtx, m_viewProj);
+	}
+	else
+	{
+		bx::memCopy(mtx, m_viewProj, sizeof(mtx) );
+	}
+
+	// Object space planes.
+	Plane planes[6];
+	buildFrustumPlanes(planes, mtx);
+
+	for (uint32_t ii = 0, num = meshGetNumGroups(_mesh); ii < num; ++ii)
+	{
+		MeshGeometry geometry;
+		if (!meshGetGeometry(_mesh, ii, geometry, _lod) )
+		{
+			BX_WARN(false, "Mesh must be loaded with RAM copy to be used as occluder.");
+			return;
+		}
+
+		if (aabbFrustumTest(*geometry.m_aabb, planes) )
+		{
+			rasterize(_mtx
+				, geometry.m_positions
+				, geometry.m_numVertices
+				, 3*sizeof(float)
+				, geometry.m_indices
+				, geometry.m_numIndices
+				, true
+				);
+		}
+	}
+}
+
+void OcclusionBuffer::end()
+{
+	m_nextTile = 0;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_workSem.post(m_numThreads);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	rasterizeTiles();
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	for (uint8_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_doneSem.wait();
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	m_pyramid.build();
+}
+
+bool OcclusionBuffer::testAabb(const Aabb& _aabb) const
+{
+	return aabbFrustumTest(_aabb, m_planes)
+		&& m_pyramid.testAabb(_aabb)
+		;
+}
+
+uint32_t OcclusionBuffer::testAabbs(uint32_t* _visible, const Aabb* _aabbs, uint32_t _num) const
+{
+	uint32_t numVisible = 0;
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		if (testAabb(_aabbs[ii]) )
+		{
+			_visible[numVisible++] = ii;
+		}
+	}
+
+	return numVisible;
+}
+
+int32_t OcclusionBuffer::threadFunc(void* _userData)
+{
+#if BX_CONFIG_SUPPORTS_THREADING
+	OcclusionBuffer* occlusion = (OcclusionBuffer*)_userData;
+
+	for (;;)
+	{
+		occlusion->m_workSem.wait();
+
+		if (occlusion->m_exit)
+		{
+			break;
+		}
+
+		occlusion->rasterizeTiles();
+		occlusion->m_doneSem.post();
+	}
+#else
+	BX_UNUSED(_userData);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	return 0;
+}
+
+void OcclusionBuffer::setupTriangle(const float* _v0, const float* _v1, const float* _v2)
+{
+	float area = (_v1[0] - _v0[0])*(_v2[1] - _v0[1]) - (_v1[1] - _v0[1])*(_v2[0] - _v0[0]);
+	if (0.0f == area)
+	{
+		return;
+	}
+
+	// Occluders are rasterized regardless of winding.
+	if (0.0f > area)
+	{
+		const float* tmp = _v1;
+		_v1 = _v2;
+		_v2 = tmp;
+		area = -area;
+	}
+
+	const int32_t width  = m_pyramid.getWidth();
+	const int32_t height = m_pyramid.getHeight();
+
+	const int32_t minX = bx::uint32_imax(int32_t(bx::ffloor(bx::fmin3(_v0[0], _v1[0], _v2[0]) ) ), 0);
+	const int32_t minY = bx::uint32_imax(int32_t(bx::ffloor(bx::fmin3(_v0[1], _v1[1], _v2[1]) ) ), 0);
+	const int32_t maxX = bx::uint32_imin(int32_t(bx::fceil(bx::fmax3(_v0[0], _v1[0], _v2[0]) ) ), width);
+	const int32_t maxY = bx::uint32_imin(int32_t(bx::fceil(bx::fmax3(_v0[1], _v1[1], _v2[1]) ) ), height);
+
+	if (minX >= maxX
+	||  minY >= maxY)
+	{
+		return;
+	}
+
+	m_triangles = grow(m_triangles, m_numTriangles, m_maxTriangles);
+	Triangle& tri = m_triangles[m_numTriangles];
+
+	const float* vertex[3] = { _v0, _v1, _v2 };
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		const float* va = vertex[(ii+1)%3];
+		const float* vb = vertex[(ii+2)%3];
+		const float aa = va[1] - vb[1];
+		const float bb = vb[0] - va[0];
+
+		tri.m_edge[ii][0] = aa;
+		tri.m_edge[ii][1] = bb;
+		tri.m_edge[ii][2] = -(aa*va[0] + bb*va[1]);
+	}
+
+	// Depth is interpolated linearly in screen space.
+	const float invArea = 1.0f/area;
+	const float z0  = _v0[2];
+	const float dz1 = (_v1[2] - z0)*invArea;
+	const float dz2 = (_v2[2] - z0)*invArea;
+	tri.m_depth[0] = dz1*tri.m_edge[1][0] + dz2*tri.m_edge[2][0];
+	tri.m_depth[1] = dz1*tri.m_edge[1][1] + dz2*tri.m_edge[2][1];
+	tri.m_depth[2] = dz1*tri.m_edge[1][2] + dz2*tri.m_edge[2][2] + z0;
+
+	tri.m_rect[0] = uint16_t(minX);
+	tri.m_rect[1] = uint16_t(minY);
+	tri.m_rect[2] = uint16_t(maxX);
+	tri.m_rect[3] = uint16_t(maxY);
+
+	const uint32_t tx0 =  minX   /OCCLUSION_TILE_WIDTH;
+	const uint32_t ty0 =  minY   /OCCLUSION_TILE_HEIGHT;
+	const uint32_t tx1 = (maxX-1)/OCCLUSION_TILE_WIDTH;
+	const uint32_t ty1 = (maxY-1)/OCCLUSION_TILE_HEIGHT;
+
+	for (uint32_t yy = ty0; yy <= ty1; ++yy)
+	{
+		for (uint32_t xx = tx0; xx <= tx1; ++xx)
+		{
+			Bin& bin = m_bins[yy*m_numTilesX + xx];
+			bin.m_triangles = grow(bin.m_triangles, bin.m_num, bin.m_max);
+			bin.m_triangles[bin.m_num++] = m_numTriangles;
+		}
+	}
+
+	++m_numTriangles;
+}
+
+void OcclusionBuffer::rasterizeTiles()
+{
+	const uint32_t numTiles = m_numTilesX*m_numTilesY;
+
+	for (;;)
+	{
+		const uint32_t tile = uint32_t(bx::atomicInc(&m_nextTile) - 1);
+		if (tile >= numTiles)
+		{
+			break;
+		}
+
+		rasterizeTile(tile);
+	}
+}
+
+void OcclusionBuffer::rasterizeTile(uint32_t _tile)
+{
+	using namespace bx;
+
+	const Bin& bin = m_bins[_tile];
+	if (0 == bin.m_num)
+	{
+		return;
+	}
+
+	const int32_t tileX0 = (_tile%m_numTilesX)*OCCLUSION_TILE_WIDTH;
+	const int32_t tileY0 = (_tile/m_numTilesX)*OCCLUSION_TILE_HEIGHT;
+	const int32_t tileX1 = tileX0 + OCCLUSION_TILE_WIDTH;
+	const int32_t tileY1 = tileY0 + OCCLUSION_TILE_HEIGHT;
+
+	const uint32_t width = m_pyramid.getWidth();
+	float* depth = m_pyramid.getDepth();
+
+	const simd128_t zero   = simd_zero();
+	const simd128_t offset = simd_ld(0.5f, 1.5f, 2.5f, 3.5f);
+
+	for (uint32_t ii = 0; ii < bin.m_num; ++ii)
+	{
+		const Triangle& tri = m_triangles[bin.m_triangles[ii] ];
+
+		// Start at 4 pixel aligned column, so that depth can be loaded and
+		// stored aligned.
+		const int32_t minX = uint32_imax(tri.m_rect[0], tileX0) & ~3;
+		const int32_t minY = uint32_imax(tri.m_rect[1], tileY0);
+		const int32_t maxX = uint32_imin(tri.m_rect[2], tileX1);
+		const int32_t maxY = uint32_imin(tri.m_rect[3], tileY1);
+
+		const simd128_t a0 = simd_splat(tri.m_edge[0][0]);
+		const simd128_t a1 = simd_splat(tri.m_edge[1][0]);
+		const simd128_t a2 = simd_splat(tri.m_edge[2][0]);
+		const simd128_t az = simd_splat(tri.m_depth[0]);
+
+		const simd128_t step0 = simd_splat(tri.m_edge[0][0]*4.0f);
+		const simd128_t step1 = simd_splat(tri.m_edge[1][0]*4.0f);
+		const simd128_t step2 = simd_splat(tri.m_edge[2][0]*4.0f);
+		const simd128_t stepz = simd_splat(tri.m_depth[0]*4.0f);
+
+		const simd128_t px = simd_add(simd_splat(float(minX) ), offset);
+
+		for (int32_t yy = minY; yy < maxY; ++yy)
+		{
+			const float py = float(yy) + 0.5f;
+
+			simd128_t e0 = simd_madd(a0, px, simd_splat(tri.m_edge[0][1]*py + tri.m_edge[0][2]) );
+			simd128_t e1 = simd_madd(a1, px, simd_splat(tri.m_edge[1][1]*py + tri.m_edge[1][2]) );
+			simd128_t e2 = simd_madd(a2, px, simd_splat(tri.m_edge[2][1]*py + tri.m_edge[2][2]) );
+			simd128_t zz = simd_madd(az, px, simd_splat(tri.m_depth[1]*py + tri.m_depth[2]) );
+
+			float* row = &depth[yy*width];
+
+			for (int32_t xx = minX; xx < maxX; xx += 4)
+			{
+				const simd128_t inside = simd_and(
+					  simd_and(simd_cmpge(e0, zero), simd_cmpge(e1, zero) )
+					, simd_cmpge(e2, zero)
+					);
+
+				if (simd_test_any(inside) )
+				{
+					const simd128_t dst = simd_ld(&row[xx]);
+					simd_st(&row[xx], simd_selb(inside, simd_min(dst, zz), dst) );
+				}
+
+				e0 = simd_add(e0, step0);
+				e1 = simd_add(e1, step1);
+				e2 = simd_add(e2, step2);
+				zz = simd_add(zz, stepz);
+			}
+		}
+	}
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef OCCLUSIONBUFFER_H_HEADER_GUARD
+#define OCCLUSIONBUFFER_H_HEADER_GUARD
+
+#include <bx/sem.h>
+#include <bx/thread.h>
+#include "hiz.h"
+
+#define OCCLUSION_TILE_WIDTH  32
+#define OCCLUSION_TILE_HEIGHT 16
+#define OCCLUSION_MAX_THREADS 8
+
+struct Mesh;
+
+/// CPU occlusion buffer.
+///
+/// Fallback for platforms where GPU Hi-Z is not available. Occluders are
+/// rasterized into low resolution depth buffer, which is then used to build
+/// depth pyramid for batch AABB tests.
+///
+/// Occluder triangles are transformed and binned into screen tiles on
+/// calling thread. Tiles are rasterized with SIMD (4 pixels at the time) by
+/// calling thread and worker threads in `end`.
+///
+/// Usage:
+///
+///   occlusion.begin(viewProj, caps->homogeneousDepth);
+///   occlusion.rasterize(mesh, mtx);
+///   ...
+///   occlusion.end();
+///   numVisible = occlusion.testAabbs(visible, aabbs, num);
+///
+class OcclusionBuffer
+{
+public:
+	/// @param _width Width, rounded up to multiple of OCCLUSION_TILE_WIDTH.
+	/// @param _height Height, rounded up to multiple of OCCLUSION_TILE_HEIGHT.
+	/// @param _numThreads Number of worker threads. When 0 all tiles are
+	///   rasterized on calling thread.
+	OcclusionBuffer(uint16_t _width = 256, uint16_t _height = 128, uint8_t _numThreads = 0);
+
+	///
+	~OcclusionBuffer();
+
+	/// Clear depth, and set view projection matrix.
+	void begin(const float* _viewProj, bool _homogeneousDepth);
+
+	/// Rasterize occluder.
+	///
+	/// @param _mtx Model matrix, can be NULL.
+	/// @param _vertices Vertices, position must be first 3 floats.
+	/// @param _numVertices Number of vertices.
+	/// @param _stride Vertex stride.
+	/// @param _indices Triangle list indices.
+	/// @param _numIndices Number of indices.
+	/// @param _index32 Indices are 32-bit.
+	void rasterize(const float* _mtx, const void* _vertices, uint32_t _numVertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32 = false);
+
+	/// Rasterize mesh loaded with `meshLoad(_filePath, true)`. Mesh groups
+	/// outside of view frustum are skipped.
+	///
+	/// @param _mesh Mesh.
+	/// @param _mtx Model matrix, can be NULL.
+	/// @param _lod Mesh LOD used as occluder.
+	void rasterize(const Mesh* _mesh, const float* _mtx, uint8_t _lod = 0);
+
+	/// Rasterize binned occluders, and build depth pyramid.
+	void end();
+
+	/// Returns false if AABB is outside of view frustum, or it's completely
+	/// occluded.
+	bool testAabb(const Aabb& _aabb) const;
+
+	/// Test multiple AABBs, see `DepthPyramid::testAabbs`.
+	uint32_t testAabbs(uint32_t* _visible, const Aabb* _aabbs, uint32_t _num) const;
+
+	///
+	const DepthPyramid& getPyramid() const
+	{
+		return m_pyramid;
+	}
+
+	/// Returns number of occluders rasterized since `begin`.
+	uint32_t getNumOccluders() const
+	{
+		return m_numOccluders;
+	}
+
+	/// Returns number of triangles binned since `begin`.
+	uint32_t getNumTriangles() const
+	{
+		return m_numTriangles;
+	}
+
+	///
+	uint8_t getNumThreads() const
+	{
+		return m_numThreads;
+	}
+
+private:
+	struct Triangle;
+
+	struct Bin
+	{
+		uint32_t* m_triangles;
+		uint32_t m_num;
+		uint32_t m_max;
+	};
+
+	static int32_t threadFunc(void* _userData);
+
+	void setupTriangle(const float* _v0, const float* _v1, const float* _v2);
+	void rasterizeTiles();
+	void rasterizeTile(uint32_t _tile);
+
+	DepthPyramid m_pyramid;
+	Plane m_planes[6];
+	float m_viewProj[16];
+
+	float* m_vertices;
+	uint32_t m_maxVertices;
+
+	Triangle* m_triangles;
+	uint32_t m_numTriangles;
+	uint32_t m_maxTriangles;
+
+	Bin* m_bins;
+	uint16_t m_numTilesX;
+	uint16_t m_numTilesY;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	bx::Thread m_thread[OCCLUSION_MAX_THREADS];
+	bx::Semaphore m_workSem;
+	bx::Semaphore m_doneSem;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	int32_t m_nextTile;
+
+	uint32_t m_numOccluders;
+	uint8_t m_numThreads;
+	bool m_homogeneousDepth;
+	bool m_exit;
+};
+
+#endif // OCCLUSIONBUFFER_H_HEADER_GUARD
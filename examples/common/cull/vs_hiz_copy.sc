@@ -0,0 +1,15 @@
+$input a_position, a_texcoord0
+$output v_texcoord0
+
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "../common.sh"
+
+void main()
+{
+	gl_Position = vec4(a_position.xy, 0.0, 1.0);
+	v_texcoord0 = a_texcoord0;
+}
@@ -89,6 +89,11 @@ namespace entry
 		s_currentDir.set(_dir);
 	}
 
+	const char* getCurrentDir()
+	{
+		return s_currentDir.getPtr();
+	}
+
 #if ENTRY_CONFIG_IMPLEMENT_DEFAULT_ALLOCATOR
 	bx::AllocatorI* getDefaultAllocator()
 	{
@@ -298,6 +303,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 			||  setOrToggle(s_reset, "flip",        BGFX_RESET_FLIP_AFTER_RENDER,  1, _argc, _argv)
 			||  setOrToggle(s_reset, "hidpi",       BGFX_RESET_HIDPI,              1, _argc, _argv)
 			||  setOrToggle(s_reset, "depthclamp",  BGFX_RESET_DEPTH_CLAMP,        1, _argc, _argv)
+			||  setOrToggle(s_reset, "multidraw",   BGFX_RESET_MULTI_DRAW_BATCH,   1, _argc, _argv)
 			   )
 			{
 				return 0;
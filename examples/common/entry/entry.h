@@ -247,6 +247,7 @@ namespace entry
 	void toggleFullscreen(WindowHandle _handle);
 	void setMouseLock(WindowHandle _handle, bool _lock);
 	void setCurrentDir(const char* _dir);
+	const char* getCurrentDir();
 
 	struct WindowState
 	{
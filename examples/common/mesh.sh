@@ -0,0 +1,37 @@
+/*
+ * Copyright 2011-2017 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef __MESH_SH__
+#define __MESH_SH__
+
+// Set per group by meshSubmit, see examples/common/bgfx_utils.cpp. Vertex
+// data reaches shader quantized only when mesh is loaded with meshLoad
+// _quantized set, otherwise scale is 1 and offset is 0.
+//   [0].xyz - position scale,
+//   [0].w   - normal encoding: 0 - signed, 1 - unsigned, 2 - octahedral,
+//   [1].xyz - position offset.
+uniform vec4 u_meshDequant[2];
+
+vec3 meshDequantPosition(vec3 _position)
+{
+	return _position * u_meshDequant[0].xyz + u_meshDequant[1].xyz;
+}
+
+vec3 meshDecodeNormal(vec3 _normal)
+{
+	if (u_meshDequant[0].w > 1.5)
+	{
+		return decodeNormalOctahedronSnorm(_normal.xy);
+	}
+
+	if (u_meshDequant[0].w > 0.5)
+	{
+		return _normal * 2.0 - 1.0;
+	}
+
+	return _normal;
+}
+
+#endif // __MESH_SH__
@@ -77,16 +77,19 @@ vec2 encodeNormalOctahedron(vec3 _normal)
 	return _normal.xy;
 }
 
-vec3 decodeNormalOctahedron(vec2 _encodedNormal)
+vec3 decodeNormalOctahedronSnorm(vec2 _encodedNormal)
 {
-	_encodedNormal = _encodedNormal * 2.0 - 1.0;
-
 	vec3 normal;
 	normal.z  = 1.0 - abs(_encodedNormal.x) - abs(_encodedNormal.y);
 	normal.xy = normal.z >= 0.0 ? _encodedNormal.xy : octahedronWrap(_encodedNormal.xy);
 	return normalize(normal);
 }
 
+vec3 decodeNormalOctahedron(vec2 _encodedNormal)
+{
+	return decodeNormalOctahedronSnorm(_encodedNormal * 2.0 - 1.0);
+}
+
 vec3 convertRGB2XYZ(vec3 _rgb)
 {
 	// Reference:
@@ -725,12 +725,99 @@ namespace bgfx
 		uint32_t numCompute;    //!< Number of compute calls submitted.
 		uint32_t maxGpuLatency; //!< GPU driver latency.
 
+		uint32_t numFilteredProgram; //!< Number of redundant program binds filtered by backend.
+		uint32_t numFilteredTexture; //!< Number of redundant texture, sampler and buffer slot binds filtered by backend.
+		uint32_t numFilteredBuffer;  //!< Number of redundant index buffer binds filtered by backend.
+		uint32_t numFilteredState;   //!< Number of render state changes skipped because state was identical to previous draw.
+
+		uint32_t numVaoCacheHit;       //!< Number of vertex array object cache hits (OpenGL only).
+		uint32_t numVaoCacheMiss;      //!< Number of vertex array object cache misses (OpenGL only).
+		uint32_t numVaoCacheEvict;     //!< Number of least recently used vertex array objects evicted (OpenGL only).
+		uint32_t numSamplerCacheHit;   //!< Number of sampler object cache hits (OpenGL only).
+		uint32_t numSamplerCacheMiss;  //!< Number of sampler object cache misses (OpenGL only).
+		uint32_t numSamplerCacheEvict; //!< Number of least recently used sampler objects evicted (OpenGL only).
+
+		uint32_t numTextureStreamed;     //!< Number of streaming texture residency changes issued last frame.
+		uint64_t textureResidentMemory;  //!< Memory allocated for resident mips of streaming textures, included in textureMemoryUsed.
+		uint64_t textureStreamingBudget; //!< Memory budget for streaming textures.
+
+		int64_t textureMemoryUsed;             //!< Estimate of texture memory used.
+		int64_t rtMemoryUsed;                  //!< Estimate of render target memory used.
+		int64_t indexBufferMemoryUsed;         //!< Memory used by static index buffers.
+		int64_t vertexBufferMemoryUsed;        //!< Memory used by static vertex buffers.
+		int64_t dynamicIndexBufferMemoryUsed;  //!< Memory used by dynamic index buffers.
+		int64_t dynamicVertexBufferMemoryUsed; //!< Memory used by dynamic vertex buffers.
+		int64_t transientMemoryUsed;           //!< Memory used by transient index and vertex buffers.
+		int64_t uniformMemoryUsed;             //!< CPU memory used by uniform buffers and matrix caches.
+		int64_t gpuMemoryUsed;                 //!< Estimate of total GPU memory used by resources.
+
+		uint32_t transientVbUsed; //!< Transient vertex buffer used last frame in bytes.
+		uint32_t transientIbUsed; //!< Transient index buffer used last frame in bytes.
+
+		uint32_t numDynamicBufferUpdates;       //!< Number of dynamic index and vertex buffer updates last frame.
+		uint32_t numDynamicBufferUpdatesMerged; //!< Number of dynamic buffer updates merged into adjacent update last frame.
+
+		uint16_t numDynamicIndexBuffers;  //!< Number of used dynamic index buffers.
+		uint16_t numDynamicVertexBuffers; //!< Number of used dynamic vertex buffers.
+		uint16_t numFrameBuffers;         //!< Number of used frame buffers.
+		uint16_t numIndexBuffers;         //!< Number of used index buffers.
+		uint16_t numOcclusionQueries;     //!< Number of used occlusion queries.
+		uint16_t numPrograms;             //!< Number of used programs.
+		uint16_t numShaders;              //!< Number of used shaders.
+		uint16_t numTextures;             //!< Number of used textures.
+		uint16_t numUniforms;             //!< Number of used uniforms.
+		uint16_t numVertexBuffers;        //!< Number of used vertex buffers.
+		uint16_t numVertexDecls;          //!< Number of used vertex declarations.
+
 		uint16_t width;         //!< Backbuffer width in pixels.
 		uint16_t height;        //!< Backbuffer height in pixels.
 		uint16_t textWidth;     //!< Debug text width in characters.
 		uint16_t textHeight;    //!< Debug text height in characters.
 	};
 
+	/// Resource limits, applied by `bgfx::init`.
+	///
+	/// @remarks
+	///   Default constructor sets library defaults. Zero means library default.
+	///   Handle tables are allocated from these limits at init time, handle
+	///   limits are clamped to 16-bit handle range, and number of programs is
+	///   clamped to `BGFX_CONFIG_MAX_PROGRAMS` (sort key program bits). Actual
+	///   limits are reported in `Caps::Limits`.
+	///
+	/// @attention C99 equivalent is `bgfx_init_limits_t`.
+	///
+	struct InitLimits
+	{
+		InitLimits();
+
+		uint32_t transientVbSize;         //!< Transient vertex buffer size in bytes.
+		uint32_t transientIbSize;         //!< Transient index buffer size in bytes.
+
+		uint16_t maxDynamicIndexBuffers;  //!< Maximum number of dynamic index buffer handles.
+		uint16_t maxDynamicVertexBuffers; //!< Maximum number of dynamic vertex buffer handles.
+		uint16_t maxFrameBuffers;         //!< Maximum number of frame buffer handles.
+		uint16_t maxIndexBuffers;         //!< Maximum number of index buffer handles.
+		uint16_t maxOcclusionQueries;     //!< Maximum number of occlusion query handles.
+		uint16_t maxPrograms;             //!< Maximum number of program handles.
+		uint16_t maxShaders;              //!< Maximum number of shader handles.
+		uint16_t maxTextures;             //!< Maximum number of texture handles.
+		uint16_t maxUniforms;             //!< Maximum number of uniform handles.
+		uint16_t maxVertexBuffers;        //!< Maximum number of vertex buffer handles.
+		uint16_t maxVertexDecls;          //!< Maximum number of vertex format declarations.
+	};
+
+	/// Resource descriptor for bulk resource creation.
+	///
+	/// @attention C99 equivalent is `bgfx_resource_desc_t`.
+	///
+	struct ResourceDesc
+	{
+		const VertexDecl* decl; //!< Vertex declaration, used only by `bgfx::createVertexBuffers`.
+		uint32_t offset;        //!< Offset of resource data in memory block.
+		uint32_t size;          //!< Size of resource data.
+		uint32_t flags;         //!< Creation flags, `BGFX_BUFFER_*` for buffers, `BGFX_TEXTURE_*` for textures.
+	};
+
 	/// Vertex declaration.
 	///
 	/// @attention C99 equivalent is `bgfx_vertex_decl_t`.
@@ -974,6 +1061,9 @@ namespace bgfx
 	///   specified, library uses default CRT allocator. The library assumes
 	///   custom allocator is thread safe.
 	///
+	/// @param[in] _limits Resource limits. When not specified library
+	///   defaults are used. See: `bgfx::InitLimits`
+	///
 	/// @returns `true` if initialization was successful.
 	///
 	/// @attention C99 equivalent is `bgfx_init`.
@@ -984,6 +1074,7 @@ namespace bgfx
 		, uint16_t _deviceId = 0
 		, CallbackI* _callback = NULL
 		, bx::AllocatorI* _allocator = NULL
+		, const InitLimits* _limits = NULL
 		);
 
 	/// Shutdown bgfx library.
@@ -1183,6 +1274,19 @@ namespace bgfx
 	///
 	void destroyIndexBuffer(IndexBufferHandle _handle);
 
+	/// Destroy multiple static index buffers.
+	///
+	/// @param[in] _handles Static index buffer handles.
+	/// @param[in] _num Number of handles.
+	///
+	/// @remarks
+	///   Handles that are already destroyed are skipped. All static index buffers
+	///   are destroyed with single renderer command.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_index_buffers`.
+	///
+	void destroyIndexBuffers(const IndexBufferHandle* _handles, uint16_t _num);
+
 	/// Create static vertex buffer.
 	///
 	/// @param[in] _mem Vertex buffer data.
@@ -1217,6 +1321,60 @@ namespace bgfx
 	///
 	void destroyVertexBuffer(VertexBufferHandle _handle);
 
+	/// Destroy multiple static vertex buffers.
+	///
+	/// @param[in] _handles Static vertex buffer handles.
+	/// @param[in] _num Number of handles.
+	///
+	/// @remarks
+	///   Handles that are already destroyed are skipped. All static vertex buffers
+	///   are destroyed with single renderer command.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_vertex_buffers`.
+	///
+	void destroyVertexBuffers(const VertexBufferHandle* _handles, uint16_t _num);
+
+	/// Create multiple static index buffers from one memory block.
+	///
+	/// @param[out] _handles Index buffer handles. Handles of buffers that
+	///   couldn't be created are invalid.
+	/// @param[in] _desc Index buffer descriptors, offset and size of each
+	///   buffer data inside `_mem`, and buffer creation flags.
+	/// @param[in] _num Number of index buffers.
+	/// @param[in] _mem Data of all index buffers.
+	///
+	/// @remarks
+	///   All buffers are created with single command, which is cheaper than
+	///   calling `bgfx::createIndexBuffer` for each buffer.
+	///
+	/// @attention C99 equivalent is `bgfx_create_index_buffers`.
+	///
+	void createIndexBuffers(
+		  IndexBufferHandle* _handles
+		, const ResourceDesc* _desc
+		, uint16_t _num
+		, const Memory* _mem
+		);
+
+	/// Create multiple static vertex buffers from one memory block.
+	///
+	/// @param[out] _handles Vertex buffer handles. Handles of buffers that
+	///   couldn't be created are invalid.
+	/// @param[in] _desc Vertex buffer descriptors, offset and size of each
+	///   buffer data inside `_mem`, vertex declaration and buffer creation
+	///   flags.
+	/// @param[in] _num Number of vertex buffers.
+	/// @param[in] _mem Data of all vertex buffers.
+	///
+	/// @attention C99 equivalent is `bgfx_create_vertex_buffers`.
+	///
+	void createVertexBuffers(
+		  VertexBufferHandle* _handles
+		, const ResourceDesc* _desc
+		, uint16_t _num
+		, const Memory* _mem
+		);
+
 	/// Create empty dynamic index buffer.
 	///
 	/// @param[in] _num Number of indices.
@@ -1599,6 +1757,84 @@ namespace bgfx
 		, TextureInfo* _info = NULL
 		);
 
+	/// Create multiple textures from one memory block.
+	///
+	/// @param[out] _handles Texture handles. Handles of textures that
+	///   couldn't be created are invalid.
+	/// @param[in] _desc Texture descriptors, offset and size of each DDS, KTX
+	///   or PVR texture data inside `_mem`, and texture flags.
+	/// @param[in] _num Number of textures.
+	/// @param[in] _mem Data of all textures.
+	///
+	/// @attention C99 equivalent is `bgfx_create_textures`.
+	///
+	void createTextures(
+		  TextureHandle* _handles
+		, const ResourceDesc* _desc
+		, uint16_t _num
+		, const Memory* _mem
+		);
+
+	/// Create streaming texture from memory buffer.
+	///
+	/// Only mips starting from `_residentMip` are uploaded on creation, finer
+	/// mips are streamed in one level per frame while resident memory of all
+	/// streaming textures fits into budget set by `bgfx::setTextureStreamingBudget`.
+	///
+	/// @param[in] _mem DDS, KTX or PVR texture data with mip chain. Texture
+	///   without mips is created as regular texture.
+	/// @param[in] _residentMip First resident mip on creation.
+	/// @param[in] _flags Texture sampling flags. See: `bgfx::createTexture`.
+	/// @param[out] _info When non-`NULL` is specified it returns parsed texture information.
+	/// @returns Texture handle.
+	///
+	/// @remarks
+	///   Texture data is copied and kept in system memory until texture is
+	///   destroyed. Only resident mips are allocated, on residency change
+	///   renderer texture is recreated and resident mips are uploaded again.
+	///   Handle stays the same, but native texture set or returned with
+	///   `bgfx::overrideInternal` doesn't survive residency change.
+	///
+	/// @attention C99 equivalent is `bgfx_create_texture_streaming`.
+	///
+	TextureHandle createTextureStreaming(
+		  const Memory* _mem
+		, uint8_t _residentMip
+		, uint32_t _flags = BGFX_TEXTURE_NONE
+		, TextureInfo* _info = NULL
+		);
+
+	/// Set finest mip streaming texture should have resident.
+	///
+	/// @param[in] _handle Streaming texture handle.
+	/// @param[in] _mip Target mip, 0 requests full mip chain. Dropping mips
+	///   takes effect on next frame, raising is done incrementally under budget.
+	///
+	/// @attention C99 equivalent is `bgfx_set_texture_resident_mip`.
+	///
+	void setTextureResidentMip(
+		  TextureHandle _handle
+		, uint8_t _mip
+		);
+
+	/// Returns finest mip currently resident for streaming texture.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @returns Resident mip, 0 for regular textures.
+	///
+	/// @attention C99 equivalent is `bgfx_get_texture_resident_mip`.
+	///
+	uint8_t getTextureResidentMip(TextureHandle _handle);
+
+	/// Set memory budget for resident mips of all streaming textures. When
+	/// over budget, streaming textures drop their finest resident mip.
+	///
+	/// @param[in] _size Budget in bytes.
+	///
+	/// @attention C99 equivalent is `bgfx_set_texture_streaming_budget`.
+	///
+	void setTextureStreamingBudget(uint64_t _size);
+
 	/// Create 2D texture.
 	///
 	/// @param[in] _width Width.
@@ -1837,6 +2073,19 @@ namespace bgfx
 	///
 	void destroyTexture(TextureHandle _handle);
 
+	/// Destroy multiple textures.
+	///
+	/// @param[in] _handles Texture handles.
+	/// @param[in] _num Number of handles.
+	///
+	/// @remarks
+	///   Handles that are already destroyed are skipped. All textures
+	///   are destroyed with single renderer command.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_textures`.
+	///
+	void destroyTextures(const TextureHandle* _handles, uint16_t _num);
+
 	/// Create frame buffer (simple).
 	///
 	/// @param[in] _width Texture width.
@@ -334,6 +334,50 @@ typedef struct bgfx_stats
     uint32_t numCompute;
     uint32_t maxGpuLatency;
 
+    uint32_t numFilteredProgram;
+    uint32_t numFilteredTexture;
+    uint32_t numFilteredBuffer;
+    uint32_t numFilteredState;
+
+    uint32_t numVaoCacheHit;
+    uint32_t numVaoCacheMiss;
+    uint32_t numVaoCacheEvict;
+    uint32_t numSamplerCacheHit;
+    uint32_t numSamplerCacheMiss;
+    uint32_t numSamplerCacheEvict;
+
+    uint32_t numTextureStreamed;
+    uint64_t textureResidentMemory;
+    uint64_t textureStreamingBudget;
+
+    int64_t textureMemoryUsed;
+    int64_t rtMemoryUsed;
+    int64_t indexBufferMemoryUsed;
+    int64_t vertexBufferMemoryUsed;
+    int64_t dynamicIndexBufferMemoryUsed;
+    int64_t dynamicVertexBufferMemoryUsed;
+    int64_t transientMemoryUsed;
+    int64_t uniformMemoryUsed;
+    int64_t gpuMemoryUsed;
+
+    uint32_t transientVbUsed;
+    uint32_t transientIbUsed;
+
+    uint32_t numDynamicBufferUpdates;
+    uint32_t numDynamicBufferUpdatesMerged;
+
+    uint16_t numDynamicIndexBuffers;
+    uint16_t numDynamicVertexBuffers;
+    uint16_t numFrameBuffers;
+    uint16_t numIndexBuffers;
+    uint16_t numOcclusionQueries;
+    uint16_t numPrograms;
+    uint16_t numShaders;
+    uint16_t numTextures;
+    uint16_t numUniforms;
+    uint16_t numVertexBuffers;
+    uint16_t numVertexDecls;
+
     uint16_t width;
     uint16_t height;
     uint16_t textWidth;
@@ -341,6 +385,36 @@ typedef struct bgfx_stats
 
 } bgfx_stats_t;
 
+/**/
+typedef struct bgfx_init_limits
+{
+    uint32_t transientVbSize;
+    uint32_t transientIbSize;
+
+    uint16_t maxDynamicIndexBuffers;
+    uint16_t maxDynamicVertexBuffers;
+    uint16_t maxFrameBuffers;
+    uint16_t maxIndexBuffers;
+    uint16_t maxOcclusionQueries;
+    uint16_t maxPrograms;
+    uint16_t maxShaders;
+    uint16_t maxTextures;
+    uint16_t maxUniforms;
+    uint16_t maxVertexBuffers;
+    uint16_t maxVertexDecls;
+
+} bgfx_init_limits_t;
+
+/**/
+typedef struct bgfx_resource_desc
+{
+    const bgfx_vertex_decl_t* decl;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t flags;
+
+} bgfx_resource_desc_t;
+
 /**/
 typedef struct bgfx_vertex_decl
 {
@@ -555,7 +629,7 @@ BGFX_C_API uint8_t bgfx_get_supported_renderers(uint8_t _max, bgfx_renderer_type
 BGFX_C_API const char* bgfx_get_renderer_name(bgfx_renderer_type_t _type);
 
 /**/
-BGFX_C_API bool bgfx_init(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator);
+BGFX_C_API bool bgfx_init(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator, const bgfx_init_limits_t* _limits);
 
 /**/
 BGFX_C_API void bgfx_shutdown();
@@ -617,6 +691,24 @@ BGFX_C_API bgfx_vertex_buffer_handle_t bgfx_create_vertex_buffer(const bgfx_memo
 /**/
 BGFX_C_API void bgfx_destroy_vertex_buffer(bgfx_vertex_buffer_handle_t _handle);
 
+/**/
+BGFX_C_API void bgfx_create_index_buffers(bgfx_index_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+
+/**/
+BGFX_C_API void bgfx_create_vertex_buffers(bgfx_vertex_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+
+/**/
+BGFX_C_API void bgfx_create_textures(bgfx_texture_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+
+/**/
+BGFX_C_API void bgfx_destroy_index_buffers(const bgfx_index_buffer_handle_t* _handles, uint16_t _num);
+
+/**/
+BGFX_C_API void bgfx_destroy_vertex_buffers(const bgfx_vertex_buffer_handle_t* _handles, uint16_t _num);
+
+/**/
+BGFX_C_API void bgfx_destroy_textures(const bgfx_texture_handle_t* _handles, uint16_t _num);
+
 /**/
 BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer(uint32_t _num, uint16_t _flags);
 
@@ -698,6 +790,18 @@ BGFX_C_API void bgfx_calc_texture_size(bgfx_texture_info_t* _info, uint16_t _wid
 /**/
 BGFX_C_API bgfx_texture_handle_t bgfx_create_texture(const bgfx_memory_t* _mem, uint32_t _flags, uint8_t _skip, bgfx_texture_info_t* _info);
 
+/**/
+BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_streaming(const bgfx_memory_t* _mem, uint8_t _residentMip, uint32_t _flags, bgfx_texture_info_t* _info);
+
+/**/
+BGFX_C_API void bgfx_set_texture_resident_mip(bgfx_texture_handle_t _handle, uint8_t _mip);
+
+/**/
+BGFX_C_API uint8_t bgfx_get_texture_resident_mip(bgfx_texture_handle_t _handle);
+
+/**/
+BGFX_C_API void bgfx_set_texture_streaming_budget(uint64_t _size);
+
 /**/
 BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_2d(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint32_t _flags, const bgfx_memory_t* _mem);
 
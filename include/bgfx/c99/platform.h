@@ -83,7 +83,7 @@ typedef struct bgfx_interface_vtbl
     void (*topology_sort_tri_list)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
     uint8_t (*get_supported_renderers)(uint8_t _max, bgfx_renderer_type_t* _enum);
     const char* (*get_renderer_name)(bgfx_renderer_type_t _type);
-    bool (*init)(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator);
+    bool (*init)(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator, const bgfx_init_limits_t* _limits);
     void (*shutdown)();
     void (*reset)(uint32_t _width, uint32_t _height, uint32_t _flags);
     uint32_t (*frame)(bool _capture);
@@ -104,6 +104,12 @@ typedef struct bgfx_interface_vtbl
     void (*destroy_index_buffer)(bgfx_index_buffer_handle_t _handle);
     bgfx_vertex_buffer_handle_t (*create_vertex_buffer)(const bgfx_memory_t* _mem, const bgfx_vertex_decl_t* _decl, uint16_t _flags);
     void (*destroy_vertex_buffer)(bgfx_vertex_buffer_handle_t _handle);
+    void (*create_index_buffers)(bgfx_index_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+    void (*create_vertex_buffers)(bgfx_vertex_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+    void (*create_textures)(bgfx_texture_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem);
+    void (*destroy_index_buffers)(const bgfx_index_buffer_handle_t* _handles, uint16_t _num);
+    void (*destroy_vertex_buffers)(const bgfx_vertex_buffer_handle_t* _handles, uint16_t _num);
+    void (*destroy_textures)(const bgfx_texture_handle_t* _handles, uint16_t _num);
     bgfx_dynamic_index_buffer_handle_t (*create_dynamic_index_buffer)(uint32_t _num, uint16_t _flags);
     bgfx_dynamic_index_buffer_handle_t (*create_dynamic_index_buffer_mem)(const bgfx_memory_t* _mem, uint16_t _flags);
     void (*update_dynamic_index_buffer)(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem);
@@ -130,6 +136,10 @@ typedef struct bgfx_interface_vtbl
     bool (*is_texture_valid)(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint32_t _flags);
     void (*calc_texture_size)(bgfx_texture_info_t* _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format);
     bgfx_texture_handle_t (*create_texture)(const bgfx_memory_t* _mem, uint32_t _flags, uint8_t _skip, bgfx_texture_info_t* _info);
+    bgfx_texture_handle_t (*create_texture_streaming)(const bgfx_memory_t* _mem, uint8_t _residentMip, uint32_t _flags, bgfx_texture_info_t* _info);
+    void (*set_texture_resident_mip)(bgfx_texture_handle_t _handle, uint8_t _mip);
+    uint8_t (*get_texture_resident_mip)(bgfx_texture_handle_t _handle);
+    void (*set_texture_streaming_budget)(uint64_t _size);
     bgfx_texture_handle_t (*create_texture_2d)(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint32_t _flags, const bgfx_memory_t* _mem);
     bgfx_texture_handle_t (*create_texture_2d_scaled)(bgfx_backbuffer_ratio_t _ratio, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint32_t _flags);
     bgfx_texture_handle_t (*create_texture_3d)(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, bgfx_texture_format_t _format, uint32_t _flags, const bgfx_memory_t* _mem);
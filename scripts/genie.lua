@@ -416,6 +416,11 @@ if _OPTIONS["with-examples"] then
 	exampleProject("31-rsm")
 	exampleProject("32-particles")
 	exampleProject("33-pom")
+	exampleProject("34-swocclusion")
+	exampleProject("35-bvh")
+	exampleProject("36-gpucull")
+	exampleProject("37-multidraw")
+	exampleProject("38-uniforms")
 
 	-- C99 source doesn't compile under WinRT settings
 	if not premake.vstudio.iswinrt() then
@@ -32,6 +32,11 @@ project "geometryc"
 	configuration { "mingw-*" }
 		targetextension ".exe"
 
+	configuration { "linux-*" }
+		links {
+			"pthread",
+		}
+
 	configuration { "osx" }
 		links {
 			"Cocoa.framework",
@@ -22,6 +22,8 @@
 #include <bx/crtimpl.h>
 #include <bx/mutex.h>
 
+#include <stddef.h> // offsetof
+
 #include "topology.h"
 
 BX_ERROR_RESULT(BGFX_ERROR_TEXTURE_VALIDATION,  BX_MAKEFOURCC('b', 'g', 0, 1) );
@@ -293,6 +295,41 @@ namespace bgfx
 	PlatformData g_platformData;
 	bool g_platformDataChangedSinceReset = false;
 
+	// With BGFX_CONFIG_DEBUG_HANDLE_SERIAL handles given to user carry
+	// allocation serial above handle index (see HandleAllocLimit). Every API
+	// entry point that takes handle checks range and liveness (and serial when
+	// enabled) in all builds, and passes only handle index to context and
+	// renderer.
+	template<typename Ty>
+	static Ty handleEncode(const HandleAllocLimit& _handleAlloc, Ty _handle)
+	{
+		_handle.idx = _handleAlloc.encode(_handle.idx);
+		return _handle;
+	}
+
+	template<typename Ty>
+	static bool handleDecode(const char* _desc, const HandleAllocLimit& _handleAlloc, Ty& _handle, bool _invalidOk = false)
+	{
+		BX_UNUSED(_desc);
+
+		if (!isValid(_handle) )
+		{
+			BX_WARN(_invalidOk, "%s: invalid handle.", _desc);
+			return _invalidOk;
+		}
+
+		const uint16_t idx = _handleAlloc.decode(_handle.idx);
+		BX_WARN(invalidHandle != idx
+			, "%s: handle %d is out of range, destroyed or stale (max %d)."
+			, _desc
+			, _handle.idx
+			, _handleAlloc.getMaxHandles()
+			);
+		_handle.idx = idx;
+
+		return invalidHandle != idx;
+	}
+
 	void AllocatorStub::checkLeaks()
 	{
 #if BGFX_CONFIG_MEMORY_TRACKING
@@ -330,6 +367,11 @@ namespace bgfx
 	uintptr_t overrideInternal(TextureHandle _handle, uintptr_t _ptr)
 	{
 		BGFX_CHECK_RENDER_THREAD();
+		if (!handleDecode("overrideInternal", s_ctx->m_textureHandle, _handle) )
+		{
+			return 0;
+		}
+
 		RendererContextI* rci = s_ctx->m_renderCtx;
 		if (0 == rci->getInternal(_handle) )
 		{
@@ -344,6 +386,11 @@ namespace bgfx
 	uintptr_t overrideInternal(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, TextureFormat::Enum _format, uint32_t _flags)
 	{
 		BGFX_CHECK_RENDER_THREAD();
+		if (!handleDecode("overrideInternal", s_ctx->m_textureHandle, _handle) )
+		{
+			return 0;
+		}
+
 		RendererContextI* rci = s_ctx->m_renderCtx;
 		if (0 == rci->getInternal(_handle) )
 		{
@@ -616,6 +663,10 @@ namespace bgfx
 
 		m_program = createProgram(vsh, fsh, true);
 
+		// Blitter resources are used by renderer directly.
+		m_texture.idx = s_ctx->m_textureHandle.decode(m_texture.idx);
+		m_program.idx = s_ctx->m_programHandle.decode(m_program.idx);
+
 		m_vb = s_ctx->createTransientVertexBuffer(numBatchVertices*m_decl.m_stride, &m_decl);
 		m_ib = s_ctx->createTransientIndexBuffer(numBatchIndices*2);
 	}
@@ -626,10 +677,10 @@ namespace bgfx
 
 		if (isValid(m_program) )
 		{
-			destroyProgram(m_program);
+			s_ctx->destroyProgram(m_program);
 		}
 
-		destroyTexture(m_texture);
+		s_ctx->destroyTexture(m_texture);
 		s_ctx->destroyTransientVertexBuffer(m_vb);
 		s_ctx->destroyTransientIndexBuffer(m_ib);
 	}
@@ -762,6 +813,9 @@ namespace bgfx
 				m_program[ii] = createProgram(vsh, fsh);
 				BX_CHECK(isValid(m_program[ii]), "Failed to create clear quad program.");
 				destroyShader(fsh);
+
+				// Clear quad programs are used by renderer directly.
+				m_program[ii].idx = s_ctx->m_programHandle.decode(m_program[ii].idx);
 			}
 
 			destroyShader(vsh);
@@ -780,7 +834,7 @@ namespace bgfx
 			{
 				if (isValid(m_program[ii]) )
 				{
-					destroyProgram(m_program[ii]);
+					s_ctx->destroyProgram(m_program[ii]);
 					m_program[ii].idx = invalidHandle;
 				}
 			}
@@ -1117,6 +1171,7 @@ namespace bgfx
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_READ_BACK),
 		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_HALF),
 		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_UINT10),
+		CAPS_FLAGS(BGFX_CAPS_DRAW_DATA),
 #undef CAPS_FLAGS
 	};
 
@@ -1308,10 +1363,62 @@ namespace bgfx
 		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
 	};
 
-	bool Context::init(RendererType::Enum _type)
+	static uint32_t initLimit(uint16_t _limit, uint32_t _default)
+	{
+		return 0 == _limit ? _default : _limit;
+	}
+
+	bool Context::init(RendererType::Enum _type, const InitLimits& _limits)
 	{
 		BX_CHECK(!m_rendererInitialized, "Already initialized?");
 
+		// Frontend and renderer resource tables are sized from init limits. Handle
+		// allocator clamps them to 16-bit handle range, program index is further
+		// limited by number of program bits in sort key.
+		m_dynamicIndexBufferHandle.init(initLimit(_limits.maxDynamicIndexBuffers, BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS) );
+		m_dynamicVertexBufferHandle.init(initLimit(_limits.maxDynamicVertexBuffers, BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS) );
+		m_frameBufferHandle.init(initLimit(_limits.maxFrameBuffers, BGFX_CONFIG_MAX_FRAME_BUFFERS) );
+		m_indexBufferHandle.init(initLimit(_limits.maxIndexBuffers, BGFX_CONFIG_MAX_INDEX_BUFFERS) );
+		m_occlusionQueryHandle.init(initLimit(_limits.maxOcclusionQueries, BGFX_CONFIG_MAX_OCCLUSION_QUERIES) );
+		m_programHandle.init(bx::uint32_min(initLimit(_limits.maxPrograms, BGFX_CONFIG_MAX_PROGRAMS), BGFX_CONFIG_MAX_PROGRAMS) );
+		m_shaderHandle.init(initLimit(_limits.maxShaders, BGFX_CONFIG_MAX_SHADERS) );
+		m_textureHandle.init(initLimit(_limits.maxTextures, BGFX_CONFIG_MAX_TEXTURES) );
+		m_uniformHandle.init(initLimit(_limits.maxUniforms, BGFX_CONFIG_MAX_UNIFORMS) );
+		m_vertexBufferHandle.init(initLimit(_limits.maxVertexBuffers, BGFX_CONFIG_MAX_VERTEX_BUFFERS) );
+		m_vertexDeclHandle.init(initLimit(_limits.maxVertexDecls, BGFX_CONFIG_MAX_VERTEX_DECLS) );
+
+		g_caps.limits.maxDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getMaxHandles();
+		g_caps.limits.maxDynamicVertexBuffers = m_dynamicVertexBufferHandle.getMaxHandles();
+		g_caps.limits.maxFrameBuffers         = m_frameBufferHandle.getMaxHandles();
+		g_caps.limits.maxIndexBuffers         = m_indexBufferHandle.getMaxHandles();
+		g_caps.limits.maxOcclusionQueries     = m_occlusionQueryHandle.getMaxHandles();
+		g_caps.limits.maxPrograms             = m_programHandle.getMaxHandles();
+		g_caps.limits.maxShaders              = m_shaderHandle.getMaxHandles();
+		g_caps.limits.maxTextures             = m_textureHandle.getMaxHandles();
+		g_caps.limits.maxUniforms             = m_uniformHandle.getMaxHandles();
+		g_caps.limits.maxVertexBuffers        = m_vertexBufferHandle.getMaxHandles();
+		g_caps.limits.maxVertexDecls          = m_vertexDeclHandle.getMaxHandles();
+
+		m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+		m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+		m_dynamicIndexBuffers.create(g_caps.limits.maxDynamicIndexBuffers);
+		m_dynamicVertexBuffers.create(g_caps.limits.maxDynamicVertexBuffers);
+		m_freeDynamicIndexBufferHandle.create(g_caps.limits.maxDynamicIndexBuffers);
+		m_freeDynamicVertexBufferHandle.create(g_caps.limits.maxDynamicVertexBuffers);
+		m_freeOcclusionQueryHandle.create(g_caps.limits.maxOcclusionQueries);
+
+		m_uniformHashMap.create(g_caps.limits.maxUniforms*2, g_caps.limits.maxUniforms);
+		m_uniformRef.create(g_caps.limits.maxUniforms);
+		m_shaderHashMap.create(g_caps.limits.maxShaders*2, g_caps.limits.maxShaders);
+		m_shaderRef.create(g_caps.limits.maxShaders);
+		m_programHashMap.create(g_caps.limits.maxPrograms*2, g_caps.limits.maxPrograms);
+		m_programRef.create(g_caps.limits.maxPrograms);
+		m_textureRef.create(g_caps.limits.maxTextures);
+		m_frameBufferRef.create(g_caps.limits.maxFrameBuffers);
+
+		const uint32_t transientVbSize = 0 != _limits.transientVbSize ? _limits.transientVbSize : BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE;
+		const uint32_t transientIbSize = 0 != _limits.transientIbSize ? _limits.transientIbSize : BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE;
+
 		m_exit    = false;
 		m_flipped = true;
 		m_frames  = 0;
@@ -1364,7 +1471,10 @@ namespace bgfx
 			m_clearColor[ii][3] = 1.0f;
 		}
 
-		m_declRef.init();
+		m_declRef.init(g_caps.limits.maxVertexDecls
+			, g_caps.limits.maxVertexBuffers
+			, g_caps.limits.maxDynamicVertexBuffers
+			);
 
 		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
 		cmdbuf.write(_type);
@@ -1417,14 +1527,14 @@ namespace bgfx
 		m_textVideoMemBlitter.init();
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
-		m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+		m_submit->m_transientVb = createTransientVertexBuffer(transientVbSize);
+		m_submit->m_transientIb = createTransientIndexBuffer(transientIbSize);
 		frame();
 
 		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
 		{
-			m_submit->m_transientVb = createTransientVertexBuffer(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
-			m_submit->m_transientIb = createTransientIndexBuffer(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+			m_submit->m_transientVb = createTransientVertexBuffer(transientVbSize);
+			m_submit->m_transientIb = createTransientIndexBuffer(transientIbSize);
 			frame();
 		}
 
@@ -1467,6 +1577,14 @@ namespace bgfx
 
 		m_declRef.shutdown(m_vertexDeclHandle);
 
+		for (HandleSet::const_iterator it = m_textureStreamSet.begin(), itEnd = m_textureStreamSet.end(); it != itEnd; ++it)
+		{
+			TextureRef& ref = m_textureRef[*it];
+			textureStreamRelease(NULL, ref.m_stream);
+			ref.m_stream = NULL;
+		}
+		m_textureStreamSet.clear();
+
 #if BGFX_CONFIG_MULTITHREADED
 		// Render thread shutdown sequence.
 		renderSemWait(); // Wait for previous frame.
@@ -1513,6 +1631,109 @@ namespace bgfx
 		}
 	}
 
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES <= UINT16_MAX);
+
+	void Context::flushDynamicBufferUpdates()
+	{
+		const uint32_t num = m_numDynamicBufferUpdatesQueued;
+		if (0 == num)
+		{
+			return;
+		}
+
+		uint64_t* keys   = m_dynamicBufferUpdateKeys;
+		uint16_t* values = m_dynamicBufferUpdateValues;
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const DynamicBufferUpdate& update = m_dynamicBufferUpdate[ii];
+			keys[ii] = 0
+				| (uint64_t(update.m_vertex)<<48)
+				| (uint64_t(update.m_handle)<<32)
+				| update.m_offset
+				;
+			values[ii] = uint16_t(ii);
+		}
+
+		// Radix sort is stable, updates with the same offset stay in
+		// submission order.
+		uint64_t* tempKeys   = (uint64_t*)alloca(num*sizeof(uint64_t) );
+		uint16_t* tempValues = (uint16_t*)alloca(num*sizeof(uint16_t) );
+		bx::radixSort(keys, tempKeys, values, tempValues, num);
+
+		// Group adjacent or overlapping updates of the same buffer into runs.
+		// Run's m_run is number of updates in run.
+		uint32_t numRuns = 0;
+		for (uint32_t ii = 0; ii < num;)
+		{
+			DynamicBufferUpdate& run = m_dynamicBufferUpdateRun[numRuns];
+			run = m_dynamicBufferUpdate[values[ii] ];
+			m_dynamicBufferUpdate[values[ii] ].m_run = uint16_t(numRuns);
+
+			uint32_t end = run.m_offset + run.m_size;
+
+			uint32_t jj = ii + 1;
+			for (; jj < num; ++jj)
+			{
+				DynamicBufferUpdate& update = m_dynamicBufferUpdate[values[jj] ];
+				if (update.m_vertex != run.m_vertex
+				||  update.m_handle != run.m_handle
+				||  update.m_offset >  end)
+				{
+					break;
+				}
+
+				end = bx::uint32_max(end, update.m_offset + update.m_size);
+				update.m_run = uint16_t(numRuns);
+			}
+
+			run.m_size = end - run.m_offset;
+			run.m_run  = uint16_t(jj - ii);
+
+			if (1 < run.m_run)
+			{
+				run.m_mem = alloc(run.m_size);
+				m_dynamicBufferMergeCount += run.m_run - 1;
+			}
+
+			++numRuns;
+			ii = jj;
+		}
+
+		// Copy merged updates in submission order, so that later update
+		// overwrites earlier one where ranges overlap.
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const DynamicBufferUpdate& update = m_dynamicBufferUpdate[ii];
+			const DynamicBufferUpdate& run    = m_dynamicBufferUpdateRun[update.m_run];
+
+			if (1 < run.m_run)
+			{
+				bx::memCopy(&run.m_mem->data[update.m_offset - run.m_offset]
+					, update.m_mem->data
+					, bx::uint32_min(update.m_size, update.m_mem->size)
+					);
+				release(update.m_mem);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < numRuns; ++ii)
+		{
+			const DynamicBufferUpdate& run = m_dynamicBufferUpdateRun[ii];
+
+			CommandBuffer& cmdbuf = getCommandBuffer(run.m_vertex
+				? CommandBuffer::UpdateDynamicVertexBuffer
+				: CommandBuffer::UpdateDynamicIndexBuffer
+				);
+			cmdbuf.write(run.m_handle);
+			cmdbuf.write(run.m_offset);
+			cmdbuf.write(run.m_size);
+			cmdbuf.write(run.m_mem);
+		}
+
+		m_numDynamicBufferUpdatesQueued = 0;
+	}
+
 	void Context::freeDynamicBuffers()
 	{
 		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
@@ -1611,11 +1832,21 @@ namespace bgfx
 
 	void Context::swap()
 	{
+		flushDynamicBufferUpdates();
 		freeDynamicBuffers();
+		textureStreamUpdate();
 		m_submit->m_resolution = m_resolution;
 		m_resolution.m_flags &= ~BGFX_RESET_INTERNAL_FORCE;
 		m_submit->m_debug = m_debug;
 
+		m_transientVbUsed = m_submit->m_vboffset;
+		m_transientIbUsed = m_submit->m_iboffset;
+
+		m_numDynamicBufferUpdates       = m_dynamicBufferUpdateCount;
+		m_numDynamicBufferUpdatesMerged = m_dynamicBufferMergeCount;
+		m_dynamicBufferUpdateCount = 0;
+		m_dynamicBufferMergeCount  = 0;
+
 		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
 		bx::memCopy(m_submit->m_fb, m_fb, sizeof(m_fb) );
 		bx::memCopy(m_submit->m_clear, m_clear, sizeof(m_clear) );
@@ -1633,7 +1864,7 @@ namespace bgfx
 
 		bx::xchg(m_render, m_submit);
 
-		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+		bx::memCopy(&m_render->m_occlusion[0], &m_submit->m_occlusion[0], m_submit->m_occlusion.getNum()*sizeof(int32_t) );
 
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
@@ -2330,6 +2561,60 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::CreateResources:
+				{
+					uint8_t type;
+					_cmdbuf.read(type);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					Memory* items;
+					_cmdbuf.read(items);
+
+					Memory* mem;
+					_cmdbuf.read(mem);
+
+					const ResourceItem* item = (const ResourceItem*)items->data;
+					for (uint16_t ii = 0; ii < num; ++ii, ++item)
+					{
+						Memory data;
+						data.data = &mem->data[item->m_offset];
+						data.size = item->m_size;
+
+						switch (type)
+						{
+						case CommandBuffer::CreateIndexBuffer:
+							{
+								IndexBufferHandle handle = { item->m_handle };
+								m_renderCtx->createIndexBuffer(handle, &data, uint16_t(item->m_flags) );
+							}
+							break;
+
+						case CommandBuffer::CreateVertexBuffer:
+							{
+								VertexBufferHandle handle = { item->m_handle };
+								m_renderCtx->createVertexBuffer(handle, &data, item->m_decl, uint16_t(item->m_flags) );
+							}
+							break;
+
+						case CommandBuffer::CreateTexture:
+							{
+								TextureHandle handle = { item->m_handle };
+								m_renderCtx->createTexture(handle, &data, item->m_flags, 0);
+							}
+							break;
+
+						default:
+							break;
+						}
+					}
+
+					release(items);
+					release(mem);
+				}
+				break;
+
 			case CommandBuffer::UpdateTexture:
 				{
 					if (m_textureUpdateBatch.isFull() )
@@ -2396,6 +2681,27 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::StreamTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint32_t flags;
+					_cmdbuf.read(flags);
+
+					uint8_t skip;
+					_cmdbuf.read(skip);
+
+					m_renderCtx->destroyTexture(handle);
+					m_renderCtx->createTexture(handle, mem, flags, skip);
+
+					release(mem);
+				}
+				break;
+
 			case CommandBuffer::DestroyTexture:
 				{
 					TextureHandle handle;
@@ -2480,6 +2786,53 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::DestroyResources:
+				{
+					uint8_t type;
+					_cmdbuf.read(type);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					Memory* items;
+					_cmdbuf.read(items);
+
+					const uint16_t* item = (const uint16_t*)items->data;
+
+					for (uint16_t ii = 0; ii < num; ++ii)
+					{
+						switch (type)
+						{
+						case CommandBuffer::DestroyIndexBuffer:
+							{
+								IndexBufferHandle handle = { item[ii] };
+								m_renderCtx->destroyIndexBuffer(handle);
+							}
+							break;
+
+						case CommandBuffer::DestroyVertexBuffer:
+							{
+								VertexBufferHandle handle = { item[ii] };
+								m_renderCtx->destroyVertexBuffer(handle);
+							}
+							break;
+
+						case CommandBuffer::DestroyTexture:
+							{
+								TextureHandle handle = { item[ii] };
+								m_renderCtx->destroyTexture(handle);
+							}
+							break;
+
+						default:
+							break;
+						}
+					}
+
+					release(items);
+				}
+				break;
+
 			case CommandBuffer::RequestScreenShot:
 				{
 					FrameBufferHandle handle;
@@ -2572,7 +2925,24 @@ namespace bgfx
 		return s_rendererCreator[_type].name;
 	}
 
-	bool init(RendererType::Enum _type, uint16_t _vendorId, uint16_t _deviceId, CallbackI* _callback, bx::AllocatorI* _allocator)
+	InitLimits::InitLimits()
+		: transientVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE)
+		, transientIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+		, maxDynamicIndexBuffers(BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS)
+		, maxDynamicVertexBuffers(BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS)
+		, maxFrameBuffers(BGFX_CONFIG_MAX_FRAME_BUFFERS)
+		, maxIndexBuffers(BGFX_CONFIG_MAX_INDEX_BUFFERS)
+		, maxOcclusionQueries(BGFX_CONFIG_MAX_OCCLUSION_QUERIES)
+		, maxPrograms(BGFX_CONFIG_MAX_PROGRAMS)
+		, maxShaders(BGFX_CONFIG_MAX_SHADERS)
+		, maxTextures(BGFX_CONFIG_MAX_TEXTURES)
+		, maxUniforms(BGFX_CONFIG_MAX_UNIFORMS)
+		, maxVertexBuffers(BGFX_CONFIG_MAX_VERTEX_BUFFERS)
+		, maxVertexDecls(BGFX_CONFIG_MAX_VERTEX_DECLS)
+	{
+	}
+
+	bool init(RendererType::Enum _type, uint16_t _vendorId, uint16_t _deviceId, CallbackI* _callback, bx::AllocatorI* _allocator, const InitLimits* _limits)
 	{
 		if (NULL != s_ctx)
 		{
@@ -2653,7 +3023,7 @@ namespace bgfx
 		errorState = ErrorState::ContextAllocated;
 
 		s_ctx = BX_ALIGNED_NEW(g_allocator, Context, 64);
-		if (s_ctx->init(_type) )
+		if (s_ctx->init(_type, NULL != _limits ? *_limits : InitLimits() ) )
 		{
 			BX_TRACE("Init complete.");
 			return true;
@@ -2850,12 +3220,17 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createIndexBuffer(_mem, _flags);
+		return handleEncode(s_ctx->m_indexBufferHandle, s_ctx->createIndexBuffer(_mem, _flags) );
 	}
 
 	void destroyIndexBuffer(IndexBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyIndexBuffer", s_ctx->m_indexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyIndexBuffer(_handle);
 	}
 
@@ -2864,38 +3239,109 @@ error:
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
 		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createVertexBuffer(_mem, _decl, _flags);
+		return handleEncode(s_ctx->m_vertexBufferHandle, s_ctx->createVertexBuffer(_mem, _decl, _flags) );
 	}
 
 	void destroyVertexBuffer(VertexBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyVertexBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyVertexBuffer(_handle);
 	}
 
+	static void checkResourceDesc(const ResourceDesc* _desc, uint16_t _num, const Memory* _mem)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		BX_CHECK(NULL != _desc, "_desc can't be NULL");
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			BX_CHECK(_desc[ii].offset + _desc[ii].size <= _mem->size
+				, "Resource %d data is out of memory block bounds (offset %d, size %d, mem size %d)."
+				, ii
+				, _desc[ii].offset
+				, _desc[ii].size
+				, _mem->size
+				);
+		}
+		BX_UNUSED(_desc, _num, _mem);
+	}
+
+	void createIndexBuffers(IndexBufferHandle* _handles, const ResourceDesc* _desc, uint16_t _num, const Memory* _mem)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		checkResourceDesc(_desc, _num, _mem);
+		s_ctx->createResources(CommandBuffer::CreateIndexBuffer, (uint16_t*)_handles, _desc, _num, _mem);
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			_handles[ii] = handleEncode(s_ctx->m_indexBufferHandle, _handles[ii]);
+		}
+	}
+
+	void createVertexBuffers(VertexBufferHandle* _handles, const ResourceDesc* _desc, uint16_t _num, const Memory* _mem)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		checkResourceDesc(_desc, _num, _mem);
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			BX_CHECK(NULL != _desc[ii].decl && 0 != _desc[ii].decl->m_stride, "Invalid VertexDecl for vertex buffer %d.", ii);
+		}
+		s_ctx->createResources(CommandBuffer::CreateVertexBuffer, (uint16_t*)_handles, _desc, _num, _mem);
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			_handles[ii] = handleEncode(s_ctx->m_vertexBufferHandle, _handles[ii]);
+		}
+	}
+
+	void destroyIndexBuffers(const IndexBufferHandle* _handles, uint16_t _num)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyResources(CommandBuffer::DestroyIndexBuffer, (const uint16_t*)_handles, _num);
+	}
+
+	void destroyVertexBuffers(const VertexBufferHandle* _handles, uint16_t _num)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyResources(CommandBuffer::DestroyVertexBuffer, (const uint16_t*)_handles, _num);
+	}
+
 	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createDynamicIndexBuffer(_num, _flags);
+		return handleEncode(s_ctx->m_dynamicIndexBufferHandle, s_ctx->createDynamicIndexBuffer(_num, _flags) );
 	}
 
 	DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createDynamicIndexBuffer(_mem, _flags);
+		return handleEncode(s_ctx->m_dynamicIndexBufferHandle, s_ctx->createDynamicIndexBuffer(_mem, _flags) );
 	}
 
 	void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (!handleDecode("updateDynamicIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle) )
+		{
+			release(_mem);
+			return;
+		}
+
 		s_ctx->updateDynamicIndexBuffer(_handle, _startIndex, _mem);
 	}
 
 	void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyDynamicIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyDynamicIndexBuffer(_handle);
 	}
 
@@ -2903,7 +3349,7 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createDynamicVertexBuffer(_num, _decl, _flags);
+		return handleEncode(s_ctx->m_dynamicVertexBufferHandle, s_ctx->createDynamicVertexBuffer(_num, _decl, _flags) );
 	}
 
 	DynamicVertexBufferHandle createDynamicVertexBuffer(const Memory* _mem, const VertexDecl& _decl, uint16_t _flags)
@@ -2911,19 +3357,30 @@ error:
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
 		BX_CHECK(0 != _decl.m_stride, "Invalid VertexDecl.");
-		return s_ctx->createDynamicVertexBuffer(_mem, _decl, _flags);
+		return handleEncode(s_ctx->m_dynamicVertexBufferHandle, s_ctx->createDynamicVertexBuffer(_mem, _decl, _flags) );
 	}
 
 	void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (!handleDecode("updateDynamicVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle) )
+		{
+			release(_mem);
+			return;
+		}
+
 		s_ctx->updateDynamicVertexBuffer(_handle, _startVertex, _mem);
 	}
 
 	void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyDynamicVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyDynamicVertexBuffer(_handle);
 	}
 
@@ -3004,12 +3461,17 @@ error:
 	IndirectBufferHandle createIndirectBuffer(uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createIndirectBuffer(_num);
+		return handleEncode(s_ctx->m_vertexBufferHandle, s_ctx->createIndirectBuffer(_num) );
 	}
 
 	void destroyIndirectBuffer(IndirectBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyIndirectBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyIndirectBuffer(_handle);
 	}
 
@@ -3017,18 +3479,38 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createShader(_mem);
+		return handleEncode(s_ctx->m_shaderHandle, s_ctx->createShader(_mem) );
 	}
 
 	uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->getShaderUniforms(_handle, _uniforms, _max);
+		if (!handleDecode("getShaderUniforms", s_ctx->m_shaderHandle, _handle) )
+		{
+			return 0;
+		}
+
+		const uint16_t num = s_ctx->getShaderUniforms(_handle, _uniforms, _max);
+
+		if (NULL != _uniforms)
+		{
+			for (uint16_t ii = 0, end = bx::uint16_min(_max, num); ii < end; ++ii)
+			{
+				_uniforms[ii] = handleEncode(s_ctx->m_uniformHandle, _uniforms[ii]);
+			}
+		}
+
+		return num;
 	}
 
 	void destroyShader(ShaderHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyShader", s_ctx->m_shaderHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyShader(_handle);
 	}
 
@@ -3040,18 +3522,36 @@ error:
 			return createProgram(_vsh, _destroyShaders);
 		}
 
-		return s_ctx->createProgram(_vsh, _fsh, _destroyShaders);
+		ProgramHandle invalid = BGFX_INVALID_HANDLE;
+		if (!handleDecode("createProgram", s_ctx->m_shaderHandle, _vsh)
+		||  !handleDecode("createProgram", s_ctx->m_shaderHandle, _fsh) )
+		{
+			return invalid;
+		}
+
+		return handleEncode(s_ctx->m_programHandle, s_ctx->createProgram(_vsh, _fsh, _destroyShaders) );
 	}
 
 	ProgramHandle createProgram(ShaderHandle _csh, bool _destroyShader)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createProgram(_csh, _destroyShader);
+		ProgramHandle invalid = BGFX_INVALID_HANDLE;
+		if (!handleDecode("createProgram", s_ctx->m_shaderHandle, _csh) )
+		{
+			return invalid;
+		}
+
+		return handleEncode(s_ctx->m_programHandle, s_ctx->createProgram(_csh, _destroyShader) );
 	}
 
 	void destroyProgram(ProgramHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyProgram", s_ctx->m_programHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyProgram(_handle);
 	}
 
@@ -3172,7 +3672,59 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
-		return s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count);
+		return handleEncode(s_ctx->m_textureHandle, s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count) );
+	}
+
+	void createTextures(TextureHandle* _handles, const ResourceDesc* _desc, uint16_t _num, const Memory* _mem)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		checkResourceDesc(_desc, _num, _mem);
+		s_ctx->createResources(CommandBuffer::CreateTexture, (uint16_t*)_handles, _desc, _num, _mem);
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			_handles[ii] = handleEncode(s_ctx->m_textureHandle, _handles[ii]);
+		}
+	}
+
+	void destroyTextures(const TextureHandle* _handles, uint16_t _num)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->destroyResources(CommandBuffer::DestroyTexture, (const uint16_t*)_handles, _num);
+	}
+
+	TextureHandle createTextureStreaming(const Memory* _mem, uint8_t _residentMip, uint32_t _flags, TextureInfo* _info)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return handleEncode(s_ctx->m_textureHandle, s_ctx->createTextureStreaming(_mem, _residentMip, _flags, _info) );
+	}
+
+	void setTextureResidentMip(TextureHandle _handle, uint8_t _mip)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setTextureResidentMip", s_ctx->m_textureHandle, _handle) )
+		{
+			return;
+		}
+
+		s_ctx->setTextureResidentMip(_handle, _mip);
+	}
+
+	uint8_t getTextureResidentMip(TextureHandle _handle)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("getTextureResidentMip", s_ctx->m_textureHandle, _handle) )
+		{
+			return 0;
+		}
+
+		return s_ctx->getTextureResidentMip(_handle);
+	}
+
+	void setTextureStreamingBudget(uint64_t _size)
+	{
+		BGFX_CHECK_MAIN_THREAD();
+		s_ctx->setTextureStreamingBudget(_size);
 	}
 
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height)
@@ -3251,13 +3803,13 @@ error:
 	TextureHandle createTexture2D(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
 	{
 		BX_CHECK(_width > 0 && _height > 0, "Invalid texture size (width %d, height %d).", _width, _height);
-		return createTexture2D(BackbufferRatio::Count, _width, _height, _hasMips, _numLayers, _format, _flags, _mem);
+		return handleEncode(s_ctx->m_textureHandle, createTexture2D(BackbufferRatio::Count, _width, _height, _hasMips, _numLayers, _format, _flags, _mem) );
 	}
 
 	TextureHandle createTexture2D(BackbufferRatio::Enum _ratio, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags)
 	{
 		BX_CHECK(_ratio < BackbufferRatio::Count, "Invalid back buffer ratio.");
-		return createTexture2D(_ratio, 0, 0, _hasMips, _numLayers, _format, _flags, NULL);
+		return handleEncode(s_ctx->m_textureHandle, createTexture2D(_ratio, 0, 0, _hasMips, _numLayers, _format, _flags, NULL) );
 	}
 
 	TextureHandle createTexture3D(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
@@ -3300,7 +3852,7 @@ error:
 		tc.m_mem       = _mem;
 		bx::write(&writer, tc);
 
-		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
+		return handleEncode(s_ctx->m_textureHandle, s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count) );
 	}
 
 	TextureHandle createTextureCube(uint16_t _size, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint32_t _flags, const Memory* _mem)
@@ -3344,12 +3896,17 @@ error:
 		tc.m_mem       = _mem;
 		bx::write(&writer, tc);
 
-		return s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count);
+		return handleEncode(s_ctx->m_textureHandle, s_ctx->createTexture(mem, _flags, 0, NULL, BackbufferRatio::Count) );
 	}
 
 	void destroyTexture(TextureHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyTexture", s_ctx->m_textureHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyTexture(_handle);
 	}
 
@@ -3357,6 +3914,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (!handleDecode("updateTexture2D", s_ctx->m_textureHandle, _handle) )
+		{
+			release(_mem);
+			return;
+		}
+
 		if (_width  == 0
 		||  _height == 0)
 		{
@@ -3372,6 +3935,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (!handleDecode("updateTexture3D", s_ctx->m_textureHandle, _handle) )
+		{
+			release(_mem);
+			return;
+		}
+
 		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_3D, "Texture3D is not supported!");
 
 		if (0 == _width
@@ -3390,6 +3959,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (!handleDecode("updateTextureCube", s_ctx->m_textureHandle, _handle) )
+		{
+			release(_mem);
+			return;
+		}
+
 		BX_CHECK(_side <= 5, "Invalid side %d.", _side);
 		if (0 == _width
 		||  0 == _height)
@@ -3407,6 +3982,11 @@ error:
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(NULL != _data, "_data can't be NULL");
 		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_READ_BACK, "Texture read-back is not supported!");
+		if (!handleDecode("readTexture", s_ctx->m_textureHandle, _handle) )
+		{
+			return 0;
+		}
+
 		return s_ctx->readTexture(_handle, _data, _mip);
 	}
 
@@ -3448,7 +4028,19 @@ error:
 			, BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
 			);
 		BX_CHECK(NULL != _attachment, "_attachment can't be NULL");
-		return s_ctx->createFrameBuffer(_num, _attachment, _destroyTextures);
+
+		FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+		Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		for (uint8_t ii = 0; ii < _num; ++ii)
+		{
+			attachment[ii] = _attachment[ii];
+			if (!handleDecode("createFrameBuffer", s_ctx->m_textureHandle, attachment[ii].handle) )
+			{
+				return invalid;
+			}
+		}
+
+		return handleEncode(s_ctx->m_frameBufferHandle, s_ctx->createFrameBuffer(_num, attachment, _destroyTextures) );
 	}
 
 	FrameBufferHandle createFrameBuffer(void* _nwh, uint16_t _width, uint16_t _height, TextureFormat::Enum _depthFormat)
@@ -3459,41 +4051,62 @@ error:
 			, _width
 			, _height
 			);
-		return s_ctx->createFrameBuffer(
+		return handleEncode(s_ctx->m_frameBufferHandle, s_ctx->createFrameBuffer(
 			  _nwh
 			, bx::uint16_max(_width, 1)
 			, bx::uint16_max(_height, 1)
 			, _depthFormat
-			);
+			) );
 	}
 
 	TextureHandle getTexture(FrameBufferHandle _handle, uint8_t _attachment)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->getTexture(_handle, _attachment);
+		TextureHandle invalid = BGFX_INVALID_HANDLE;
+		if (!handleDecode("getTexture", s_ctx->m_frameBufferHandle, _handle) )
+		{
+			return invalid;
+		}
+
+		return handleEncode(s_ctx->m_textureHandle, s_ctx->getTexture(_handle, _attachment) );
 	}
 
 	void destroyFrameBuffer(FrameBufferHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyFrameBuffer", s_ctx->m_frameBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyFrameBuffer(_handle);
 	}
 
 	UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
-		return s_ctx->createUniform(_name, _type, _num);
+		return handleEncode(s_ctx->m_uniformHandle, s_ctx->createUniform(_name, _type, _num) );
 	}
 
 	void getUniformInfo(UniformHandle _handle, UniformInfo& _info)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("getUniformInfo", s_ctx->m_uniformHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->getUniformInfo(_handle, _info);
 	}
 
 	void destroyUniform(UniformHandle _handle)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("destroyUniform", s_ctx->m_uniformHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyUniform(_handle);
 	}
 
@@ -3501,13 +4114,18 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
-		return s_ctx->createOcclusionQuery();
+		return handleEncode(s_ctx->m_occlusionQueryHandle, s_ctx->createOcclusionQuery() );
 	}
 
 	OcclusionQueryResult::Enum getResult(OcclusionQueryHandle _handle, int32_t* _result)
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		if (!handleDecode("getResult", s_ctx->m_occlusionQueryHandle, _handle) )
+		{
+			return OcclusionQueryResult::NoResult;
+		}
+
 		return s_ctx->getResult(_handle, _result);
 	}
 
@@ -3515,6 +4133,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		if (!handleDecode("destroyOcclusionQuery", s_ctx->m_occlusionQueryHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
@@ -3614,6 +4237,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		if (!handleDecode("setViewFrameBuffer", s_ctx->m_frameBufferHandle, _handle, true) )
+		{
+			return;
+		}
+
 		s_ctx->setViewFrameBuffer(_id, _handle);
 	}
 
@@ -3655,6 +4283,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
+		if (!handleDecode("setCondition", s_ctx->m_occlusionQueryHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setCondition(_handle, _visible);
 	}
 
@@ -3697,6 +4330,11 @@ error:
 	void setUniform(UniformHandle _handle, const void* _value, uint16_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setUniform", s_ctx->m_uniformHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setUniform(_handle, _value, _num);
 	}
 
@@ -3708,6 +4346,11 @@ error:
 	void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setIndexBuffer", s_ctx->m_indexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setIndexBuffer(_handle, _firstIndex, _numIndices);
 	}
 
@@ -3719,6 +4362,11 @@ error:
 	void setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setIndexBuffer(_handle, _firstIndex, _numIndices);
 	}
 
@@ -3738,6 +4386,11 @@ error:
 	void setVertexBuffer(uint8_t _stream, VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setVertexBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setVertexBuffer(_stream, _handle, _startVertex, _numVertices);
 	}
 
@@ -3749,6 +4402,11 @@ error:
 	void setVertexBuffer(uint8_t _stream, DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setVertexBuffer(_stream, _handle, _startVertex, _numVertices);
 	}
 
@@ -3779,12 +4437,22 @@ error:
 	void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setInstanceDataBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setInstanceDataBuffer(_handle, _startVertex, _num);
 	}
 
 	void setInstanceDataBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setInstanceDataBuffer(_handle, _startVertex, _num);
 	}
 
@@ -3792,6 +4460,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setTexture", s_ctx->m_uniformHandle, _sampler)
+		||  !handleDecode("setTexture", s_ctx->m_textureHandle, _handle, true) )
+		{
+			return;
+		}
+
 		s_ctx->setTexture(_stage, _sampler, _handle, _flags);
 	}
 
@@ -3815,6 +4489,13 @@ error:
 			|| 0 != (g_caps.supported & BGFX_CAPS_OCCLUSION_QUERY)
 			, "Occlusion query is not supported! Use bgfx::getCaps to check BGFX_CAPS_OCCLUSION_QUERY backend renderer capabilities."
 			);
+		if (!handleDecode("submit", s_ctx->m_programHandle, _program, true)
+		||  !handleDecode("submit", s_ctx->m_occlusionQueryHandle, _occlusionQuery, true) )
+		{
+			s_ctx->discard();
+			return 0;
+		}
+
 		return s_ctx->submit(_id, _program, _occlusionQuery, _depth, _preserveState);
 	}
 
@@ -3822,6 +4503,13 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
+		if (!handleDecode("submit", s_ctx->m_programHandle, _program, true)
+		||  !handleDecode("submit", s_ctx->m_vertexBufferHandle, _indirectHandle) )
+		{
+			s_ctx->discard();
+			return 0;
+		}
+
 		return s_ctx->submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState);
 	}
 
@@ -3829,6 +4517,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setBuffer", s_ctx->m_indexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setBuffer(_stage, _handle, _access);
 	}
 
@@ -3836,6 +4529,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setBuffer(_stage, _handle, _access);
 	}
 
@@ -3843,6 +4541,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setBuffer(_stage, _handle, _access);
 	}
 
@@ -3850,6 +4553,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setBuffer(_stage, _handle, _access);
 	}
 
@@ -3857,6 +4565,11 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setBuffer", s_ctx->m_vertexBufferHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setBuffer(_stage, _handle, _access);
 	}
 
@@ -3864,6 +4577,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BX_CHECK(_stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, "Invalid stage %d (max %d).", _stage, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS);
+		if (!handleDecode("setImage", s_ctx->m_uniformHandle, _sampler)
+		||  !handleDecode("setImage", s_ctx->m_textureHandle, _handle) )
+		{
+			return;
+		}
+
 		s_ctx->setImage(_stage, _sampler, _handle, _mip, _access, _format);
 	}
 
@@ -3871,6 +4590,12 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
+		if (!handleDecode("dispatch", s_ctx->m_programHandle, _handle) )
+		{
+			s_ctx->discard();
+			return 0;
+		}
+
 		return s_ctx->dispatch(_id, _handle, _numX, _numY, _numZ, _flags);
 	}
 
@@ -3879,6 +4604,13 @@ error:
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Dispatch indirect is not supported! Use bgfx::getCaps to check BGFX_CAPS_DRAW_INDIRECT backend renderer capabilities.");
 		BGFX_CHECK_CAPS(BGFX_CAPS_COMPUTE, "Compute is not supported! Use bgfx::getCaps to check BGFX_CAPS_COMPUTE backend renderer capabilities.");
+		if (!handleDecode("dispatch", s_ctx->m_programHandle, _handle)
+		||  !handleDecode("dispatch", s_ctx->m_vertexBufferHandle, _indirectHandle) )
+		{
+			s_ctx->discard();
+			return 0;
+		}
+
 		return s_ctx->dispatch(_id, _handle, _indirectHandle, _start, _num, _flags);
 	}
 
@@ -3897,12 +4629,23 @@ error:
 	{
 		BGFX_CHECK_MAIN_THREAD();
 		BGFX_CHECK_CAPS(BGFX_CAPS_TEXTURE_BLIT, "Texture blit is not supported!");
+		if (!handleDecode("blit", s_ctx->m_textureHandle, _dst)
+		||  !handleDecode("blit", s_ctx->m_textureHandle, _src) )
+		{
+			return;
+		}
+
 		s_ctx->blit(_id, _dst, _dstMip, _dstX, _dstY, _dstZ, _src, _srcMip, _srcX, _srcY, _srcZ, _width, _height, _depth);
 	}
 
 	void requestScreenShot(FrameBufferHandle _handle, const char* _filePath)
 	{
 		BGFX_CHECK_MAIN_THREAD();
+		if (!handleDecode("requestScreenShot", s_ctx->m_frameBufferHandle, _handle, true) )
+		{
+			return;
+		}
+
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
 } // namespace bgfx
@@ -4056,6 +4799,8 @@ BGFX_C99_STRUCT_SIZE_CHECK(bgfx::Transform,             bgfx_transform_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::HMD::Eye,              bgfx_hmd_eye_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::HMD,                   bgfx_hmd_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::Stats,                 bgfx_stats_t);
+BGFX_C99_STRUCT_SIZE_CHECK(bgfx::InitLimits,            bgfx_init_limits_t);
+BGFX_C99_STRUCT_SIZE_CHECK(bgfx::ResourceDesc,          bgfx_resource_desc_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::VertexDecl,            bgfx_vertex_decl_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::TransientIndexBuffer,  bgfx_transient_index_buffer_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::TransientVertexBuffer, bgfx_transient_vertex_buffer_t);
@@ -4070,6 +4815,22 @@ BGFX_C99_STRUCT_SIZE_CHECK(bgfx::PlatformData,          bgfx_platform_data_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::InternalData,          bgfx_internal_data_t);
 #undef BGFX_C99_STRUCT_SIZE_CHECK
 
+// Stats grows often, size alone doesn't catch reordered members.
+#define BGFX_C99_STATS_MEMBER_CHECK(_member) \
+			BX_STATIC_ASSERT(offsetof(bgfx::Stats, _member) == offsetof(bgfx_stats_t, _member) )
+
+BGFX_C99_STATS_MEMBER_CHECK(numFilteredProgram);
+BGFX_C99_STATS_MEMBER_CHECK(numVaoCacheHit);
+BGFX_C99_STATS_MEMBER_CHECK(numSamplerCacheEvict);
+BGFX_C99_STATS_MEMBER_CHECK(numTextureStreamed);
+BGFX_C99_STATS_MEMBER_CHECK(textureResidentMemory);
+BGFX_C99_STATS_MEMBER_CHECK(textureMemoryUsed);
+BGFX_C99_STATS_MEMBER_CHECK(gpuMemoryUsed);
+BGFX_C99_STATS_MEMBER_CHECK(numDynamicBufferUpdates);
+BGFX_C99_STATS_MEMBER_CHECK(numDynamicIndexBuffers);
+BGFX_C99_STATS_MEMBER_CHECK(width);
+#undef BGFX_C99_STATS_MEMBER_CHECK
+
 namespace bgfx
 {
 	struct CallbackC99 : public CallbackI
@@ -4217,7 +4978,7 @@ BGFX_C_API const char* bgfx_get_renderer_name(bgfx_renderer_type_t _type)
 	return bgfx::getRendererName(bgfx::RendererType::Enum(_type) );
 }
 
-BGFX_C_API bool bgfx_init(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator)
+BGFX_C_API bool bgfx_init(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16_t _deviceId, bgfx_callback_interface_t* _callback, bgfx_allocator_interface_t* _allocator, const bgfx_init_limits_t* _limits)
 {
 	static bgfx::CallbackC99 s_callback;
 	s_callback.m_interface = _callback;
@@ -4230,6 +4991,7 @@ BGFX_C_API bool bgfx_init(bgfx_renderer_type_t _type, uint16_t _vendorId, uint16
 		, _deviceId
 		, NULL == _callback  ? NULL : &s_callback
 		, NULL == _allocator ? NULL : &s_allocator
+		, (const bgfx::InitLimits*)_limits
 		);
 }
 
@@ -4343,6 +5105,36 @@ BGFX_C_API void bgfx_destroy_vertex_buffer(bgfx_vertex_buffer_handle_t _handle)
 	bgfx::destroyVertexBuffer(handle.cpp);
 }
 
+BGFX_C_API void bgfx_create_index_buffers(bgfx_index_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem)
+{
+	bgfx::createIndexBuffers( (bgfx::IndexBufferHandle*)_handles, (const bgfx::ResourceDesc*)_desc, _num, (const bgfx::Memory*)_mem);
+}
+
+BGFX_C_API void bgfx_create_vertex_buffers(bgfx_vertex_buffer_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem)
+{
+	bgfx::createVertexBuffers( (bgfx::VertexBufferHandle*)_handles, (const bgfx::ResourceDesc*)_desc, _num, (const bgfx::Memory*)_mem);
+}
+
+BGFX_C_API void bgfx_create_textures(bgfx_texture_handle_t* _handles, const bgfx_resource_desc_t* _desc, uint16_t _num, const bgfx_memory_t* _mem)
+{
+	bgfx::createTextures( (bgfx::TextureHandle*)_handles, (const bgfx::ResourceDesc*)_desc, _num, (const bgfx::Memory*)_mem);
+}
+
+BGFX_C_API void bgfx_destroy_index_buffers(const bgfx_index_buffer_handle_t* _handles, uint16_t _num)
+{
+	bgfx::destroyIndexBuffers( (const bgfx::IndexBufferHandle*)_handles, _num);
+}
+
+BGFX_C_API void bgfx_destroy_vertex_buffers(const bgfx_vertex_buffer_handle_t* _handles, uint16_t _num)
+{
+	bgfx::destroyVertexBuffers( (const bgfx::VertexBufferHandle*)_handles, _num);
+}
+
+BGFX_C_API void bgfx_destroy_textures(const bgfx_texture_handle_t* _handles, uint16_t _num)
+{
+	bgfx::destroyTextures( (const bgfx::TextureHandle*)_handles, _num);
+}
+
 BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer(uint32_t _num, uint16_t _flags)
 {
 	union { bgfx_dynamic_index_buffer_handle_t c; bgfx::DynamicIndexBufferHandle cpp; } handle;
@@ -4509,6 +5301,31 @@ BGFX_C_API bgfx_texture_handle_t bgfx_create_texture(const bgfx_memory_t* _mem,
 	return handle.c;
 }
 
+BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_streaming(const bgfx_memory_t* _mem, uint8_t _residentMip, uint32_t _flags, bgfx_texture_info_t* _info)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle;
+	bgfx::TextureInfo* info = (bgfx::TextureInfo*)_info;
+	handle.cpp = bgfx::createTextureStreaming( (const bgfx::Memory*)_mem, _residentMip, _flags, info);
+	return handle.c;
+}
+
+BGFX_C_API void bgfx_set_texture_resident_mip(bgfx_texture_handle_t _handle, uint8_t _mip)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	bgfx::setTextureResidentMip(handle.cpp, _mip);
+}
+
+BGFX_C_API uint8_t bgfx_get_texture_resident_mip(bgfx_texture_handle_t _handle)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::getTextureResidentMip(handle.cpp);
+}
+
+BGFX_C_API void bgfx_set_texture_streaming_budget(uint64_t _size)
+{
+	bgfx::setTextureStreamingBudget(_size);
+}
+
 BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_2d(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint32_t _flags, const bgfx_memory_t* _mem)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle;
@@ -4994,6 +5811,12 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(destroy_index_buffer) \
 	BGFX_IMPORT_FUNC(create_vertex_buffer) \
 	BGFX_IMPORT_FUNC(destroy_vertex_buffer) \
+	BGFX_IMPORT_FUNC(create_index_buffers) \
+	BGFX_IMPORT_FUNC(create_vertex_buffers) \
+	BGFX_IMPORT_FUNC(create_textures) \
+	BGFX_IMPORT_FUNC(destroy_index_buffers) \
+	BGFX_IMPORT_FUNC(destroy_vertex_buffers) \
+	BGFX_IMPORT_FUNC(destroy_textures) \
 	BGFX_IMPORT_FUNC(create_dynamic_index_buffer) \
 	BGFX_IMPORT_FUNC(create_dynamic_index_buffer_mem) \
 	BGFX_IMPORT_FUNC(update_dynamic_index_buffer) \
@@ -5020,6 +5843,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(is_texture_valid) \
 	BGFX_IMPORT_FUNC(calc_texture_size) \
 	BGFX_IMPORT_FUNC(create_texture) \
+	BGFX_IMPORT_FUNC(create_texture_streaming) \
+	BGFX_IMPORT_FUNC(set_texture_resident_mip) \
+	BGFX_IMPORT_FUNC(get_texture_resident_mip) \
+	BGFX_IMPORT_FUNC(set_texture_streaming_budget) \
 	BGFX_IMPORT_FUNC(create_texture_2d) \
 	BGFX_IMPORT_FUNC(create_texture_2d_scaled) \
 	BGFX_IMPORT_FUNC(create_texture_3d) \
@@ -51,6 +51,14 @@
 
 #define NUM_THREADS(_x, _y, _z) layout (local_size_x = _x, local_size_y = _y, local_size_z = _z) in;
 
+#define atomicFetchAndAdd(_mem, _data, _original)      _original = atomicAdd(_mem, _data)
+#define atomicFetchAndAnd(_mem, _data, _original)      _original = atomicAnd(_mem, _data)
+#define atomicFetchAndMax(_mem, _data, _original)      _original = atomicMax(_mem, _data)
+#define atomicFetchAndMin(_mem, _data, _original)      _original = atomicMin(_mem, _data)
+#define atomicFetchAndOr(_mem, _data, _original)       _original = atomicOr(_mem, _data)
+#define atomicFetchAndXor(_mem, _data, _original)      _original = atomicXor(_mem, _data)
+#define atomicFetchAndExchange(_mem, _data, _original) _original = atomicExchange(_mem, _data)
+
 #else
 
 #define SHARED groupshared
@@ -155,6 +163,16 @@ uint atomicCompSwap(uint _mem, uint _compare, uint _data)
 
 // InterlockedCompareStore
 
+// Atomic functions above operate on copy of _mem, and can't be used with
+// buffer or shared memory. Use atomicFetchAnd* to get original value.
+#define atomicFetchAndAdd(_mem, _data, _original)      InterlockedAdd(_mem, _data, _original)
+#define atomicFetchAndAnd(_mem, _data, _original)      InterlockedAnd(_mem, _data, _original)
+#define atomicFetchAndMax(_mem, _data, _original)      InterlockedMax(_mem, _data, _original)
+#define atomicFetchAndMin(_mem, _data, _original)      InterlockedMin(_mem, _data, _original)
+#define atomicFetchAndOr(_mem, _data, _original)       InterlockedOr(_mem, _data, _original)
+#define atomicFetchAndXor(_mem, _data, _original)      InterlockedXor(_mem, _data, _original)
+#define atomicFetchAndExchange(_mem, _data, _original) InterlockedExchange(_mem, _data, _original)
+
 #define barrier()                    GroupMemoryBarrierWithGroupSync()
 #define memoryBarrier()              GroupMemoryBarrierWithGroupSync()
 #define memoryBarrierAtomicCounter() GroupMemoryBarrierWithGroupSync()
@@ -348,6 +348,15 @@ namespace bgfx
 		const Memory* m_mem;
 	};
 
+	struct ResourceItem
+	{
+		uint32_t m_offset;
+		uint32_t m_size;
+		uint32_t m_flags;
+		uint16_t m_handle;
+		VertexDeclHandle m_decl;
+	};
+
 	extern const uint32_t g_uniformTypeSize[UniformType::Count+1];
 	extern CallbackI* g_callback;
 	extern bx::AllocatorI* g_allocator;
@@ -370,6 +379,295 @@ namespace bgfx
 		return un.ui;
 	}
 
+	/// Handle index is 16-bit. UINT16_MAX is invalid handle, and UINT16_MAX-1
+	/// is never allocated, renderers use it as "nothing bound yet" marker.
+	static const uint16_t reservedHandle = UINT16_MAX-1;
+
+	/// Resource table sized at init time from runtime limits.
+	template <typename Ty>
+	class ResourceArrayT
+	{
+	public:
+		ResourceArrayT()
+			: m_data(NULL)
+			, m_num(0)
+		{
+		}
+
+		~ResourceArrayT()
+		{
+			destroy();
+		}
+
+		void create(uint32_t _num)
+		{
+			BX_CHECK(_num <= reservedHandle, "Resource table size %d is over 16-bit handle range.", _num);
+			destroy();
+
+			m_data = (Ty*)BX_ALIGNED_ALLOC(g_allocator, bx::uint32_max(1, _num)*sizeof(Ty), 16);
+			m_num  = uint16_t(_num);
+
+			for (uint16_t ii = 0; ii < m_num; ++ii)
+			{
+				BX_PLACEMENT_NEW(&m_data[ii], Ty)();
+			}
+		}
+
+		void destroy()
+		{
+			if (NULL != m_data)
+			{
+				for (uint16_t ii = 0; ii < m_num; ++ii)
+				{
+					m_data[ii].~Ty();
+				}
+
+				BX_ALIGNED_FREE(g_allocator, m_data, 16);
+				m_data = NULL;
+				m_num  = 0;
+			}
+		}
+
+		void fill(const Ty& _value)
+		{
+			for (uint16_t ii = 0; ii < m_num; ++ii)
+			{
+				m_data[ii] = _value;
+			}
+		}
+
+		uint16_t getNum() const
+		{
+			return m_num;
+		}
+
+		Ty& operator[](uint16_t _idx)
+		{
+			BX_CHECK(_idx < m_num, "Resource index %d out of range (max %d).", _idx, m_num);
+			return m_data[_idx];
+		}
+
+		const Ty& operator[](uint16_t _idx) const
+		{
+			BX_CHECK(_idx < m_num, "Resource index %d out of range (max %d).", _idx, m_num);
+			return m_data[_idx];
+		}
+
+	private:
+		ResourceArrayT(const ResourceArrayT&);
+		void operator=(const ResourceArrayT&);
+
+		Ty*      m_data;
+		uint16_t m_num;
+	};
+
+	/// Same as bx::HandleHashMapT (open addressing, linear probing), but with
+	/// capacity set at init time from runtime limits. Every handle maps to
+	/// a single key, and slot of each handle is tracked, so that remove by
+	/// handle doesn't scan the whole table.
+	class HandleHashMap
+	{
+	public:
+		static const uint16_t invalid = UINT16_MAX;
+
+		HandleHashMap()
+			: m_key(NULL)
+			, m_handle(NULL)
+			, m_slot(NULL)
+			, m_capacity(0)
+			, m_maxHandles(0)
+			, m_numElements(0)
+		{
+		}
+
+		~HandleHashMap()
+		{
+			destroy();
+		}
+
+		void create(uint32_t _capacity, uint32_t _maxHandles)
+		{
+			destroy();
+
+			m_capacity   = bx::uint32_max(1, _capacity);
+			m_maxHandles = bx::uint32_max(1, _maxHandles);
+			m_key        = (uint32_t*)BX_ALLOC(g_allocator, m_capacity*sizeof(uint32_t) );
+			m_handle     = (uint16_t*)BX_ALLOC(g_allocator, m_capacity*sizeof(uint16_t) );
+			m_slot       = (uint32_t*)BX_ALLOC(g_allocator, m_maxHandles*sizeof(uint32_t) );
+			reset();
+		}
+
+		void destroy()
+		{
+			if (NULL != m_key)
+			{
+				BX_FREE(g_allocator, m_key);
+				BX_FREE(g_allocator, m_handle);
+				BX_FREE(g_allocator, m_slot);
+				m_key        = NULL;
+				m_handle     = NULL;
+				m_slot       = NULL;
+				m_capacity   = 0;
+				m_maxHandles = 0;
+			}
+		}
+
+		bool insert(uint32_t _key, uint16_t _handle)
+		{
+			if (invalid == _handle)
+			{
+				return false;
+			}
+
+			BX_CHECK(_handle < m_maxHandles, "Handle %d out of range (max %d).", _handle, m_maxHandles);
+
+			const uint32_t firstIdx = mix(_key) % m_capacity;
+			uint32_t idx = firstIdx;
+			do
+			{
+				if (m_handle[idx] == invalid)
+				{
+					m_key[idx]      = _key;
+					m_handle[idx]   = _handle;
+					m_slot[_handle] = idx;
+					++m_numElements;
+					return true;
+				}
+
+				if (m_key[idx] == _key)
+				{
+					return false;
+				}
+
+				idx = (idx + 1) % m_capacity;
+
+			} while (idx != firstIdx);
+
+			return false;
+		}
+
+		bool removeByKey(uint32_t _key)
+		{
+			const uint32_t idx = findIndex(_key);
+			if (UINT32_MAX != idx)
+			{
+				removeIndex(idx);
+				return true;
+			}
+
+			return false;
+		}
+
+		bool removeByHandle(uint16_t _handle)
+		{
+			if (_handle < m_maxHandles)
+			{
+				const uint32_t idx = m_slot[_handle];
+				if (UINT32_MAX != idx
+				&&  m_handle[idx] == _handle)
+				{
+					removeIndex(idx);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		uint16_t find(uint32_t _key) const
+		{
+			const uint32_t idx = findIndex(_key);
+			if (UINT32_MAX != idx)
+			{
+				return m_handle[idx];
+			}
+
+			return invalid;
+		}
+
+		void reset()
+		{
+			bx::memSet(m_handle, 0xff, m_capacity*sizeof(uint16_t) );
+			bx::memSet(m_slot,   0xff, m_maxHandles*sizeof(uint32_t) );
+			m_numElements = 0;
+		}
+
+		uint32_t getNumElements() const
+		{
+			return m_numElements;
+		}
+
+	private:
+		HandleHashMap(const HandleHashMap&);
+		void operator=(const HandleHashMap&);
+
+		uint32_t findIndex(uint32_t _key) const
+		{
+			const uint32_t firstIdx = mix(_key) % m_capacity;
+			uint32_t idx = firstIdx;
+			do
+			{
+				if (m_handle[idx] == invalid)
+				{
+					return UINT32_MAX;
+				}
+
+				if (m_key[idx] == _key)
+				{
+					return idx;
+				}
+
+				idx = (idx + 1) % m_capacity;
+
+			} while (idx != firstIdx);
+
+			return UINT32_MAX;
+		}
+
+		// Entries after removed one are reinserted with insert, which also
+		// updates their slots.
+		void removeIndex(uint32_t _idx)
+		{
+			m_slot[m_handle[_idx] ] = UINT32_MAX;
+			m_handle[_idx] = invalid;
+			--m_numElements;
+
+			for (uint32_t idx = (_idx + 1) % m_capacity
+				; m_handle[idx] != invalid
+				; idx = (idx + 1) % m_capacity
+				)
+			{
+				const uint32_t key = m_key[idx];
+				if (idx != findIndex(key) )
+				{
+					const uint16_t handle = m_handle[idx];
+					m_slot[handle] = UINT32_MAX;
+					m_handle[idx]  = invalid;
+					--m_numElements;
+					insert(key, handle);
+				}
+			}
+		}
+
+		static uint32_t mix(uint32_t _x)
+		{
+			// MurmurHash3 finalizer.
+			_x ^= _x >> 16;
+			_x *= UINT32_C(0x85ebca6b);
+			_x ^= _x >> 13;
+			_x *= UINT32_C(0xc2b2ae35);
+			_x ^= _x >> 16;
+			return _x;
+		}
+
+		uint32_t* m_key;
+		uint16_t* m_handle;
+		uint32_t* m_slot;        //!< Table slot of handle, UINT32_MAX if not in table.
+		uint32_t  m_capacity;
+		uint32_t  m_maxHandles;
+		uint32_t  m_numElements;
+	};
+
 	inline uint64_t packStencil(uint32_t _fstencil, uint32_t _bstencil)
 	{
 		return (uint64_t(_bstencil)<<32)|uint64_t(_fstencil);
@@ -628,8 +926,10 @@ namespace bgfx
 			CreateShader,
 			CreateProgram,
 			CreateTexture,
+			CreateResources,
 			UpdateTexture,
 			ResizeTexture,
+			StreamTexture,
 			CreateFrameBuffer,
 			CreateUniform,
 			UpdateViewName,
@@ -646,6 +946,7 @@ namespace bgfx
 			DestroyTexture,
 			DestroyFrameBuffer,
 			DestroyUniform,
+			DestroyResources,
 			ReadTexture,
 			RequestScreenShot,
 		};
@@ -1111,6 +1412,11 @@ namespace bgfx
 			m_pos = _pos;
 		}
 
+		uint32_t getSize() const
+		{
+			return m_size;
+		}
+
 		void finish()
 		{
 			write(UniformType::End);
@@ -1155,10 +1461,22 @@ namespace bgfx
 		{
 		}
 
+		void create(uint32_t _maxUniforms)
+		{
+			m_uniforms.create(_maxUniforms*2, _maxUniforms);
+			m_info.create(_maxUniforms);
+		}
+
+		void destroy()
+		{
+			m_uniforms.destroy();
+			m_info.destroy();
+		}
+
 		const UniformRegInfo* find(const char* _name) const
 		{
 			uint16_t handle = m_uniforms.find(bx::hashMurmur2A(_name) );
-			if (UniformHashMap::invalid != handle)
+			if (HandleHashMap::invalid != handle)
 			{
 				return &m_info[handle];
 			}
@@ -1186,9 +1504,8 @@ namespace bgfx
 		}
 
 	private:
-		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
-		UniformHashMap m_uniforms;
-		UniformRegInfo m_info[BGFX_CONFIG_MAX_UNIFORMS];
+		HandleHashMap m_uniforms;
+		ResourceArrayT<UniformRegInfo> m_info;
 	};
 
 	struct Binding
@@ -1386,9 +1703,33 @@ namespace bgfx
 		uint32_t m_flags;
 	};
 
+	struct ResourceMemory
+	{
+		enum Enum
+		{
+			Texture,
+			RenderTarget,
+			IndexBuffer,
+			VertexBuffer,
+			DynamicIndexBuffer,
+			DynamicVertexBuffer,
+			Transient,
+
+			Count
+		};
+	};
+
+	struct IndexBuffer
+	{
+		uint32_t m_size;
+		uint8_t  m_memory;
+	};
+
 	struct VertexBuffer
 	{
+		uint32_t m_size;
 		uint16_t m_stride;
+		uint8_t  m_memory;
 	};
 
 	struct DynamicIndexBuffer
@@ -1412,6 +1753,16 @@ namespace bgfx
 		uint16_t m_flags;
 	};
 
+	struct DynamicBufferUpdate
+	{
+		const Memory* m_mem;
+		uint32_t m_offset;
+		uint32_t m_size;
+		uint16_t m_handle;
+		uint16_t m_run;
+		bool m_vertex;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -1427,7 +1778,6 @@ namespace bgfx
 			term.m_program = invalidHandle;
 			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw();
 			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
-			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 		}
 
 		~Frame()
@@ -1436,6 +1786,18 @@ namespace bgfx
 
 		void create()
 		{
+			m_occlusion.create(g_caps.limits.maxOcclusionQueries);
+			m_occlusion.fill(-1);
+
+			m_freeIndexBuffer.create(g_caps.limits.maxIndexBuffers);
+			m_freeVertexDecl.create(g_caps.limits.maxVertexDecls);
+			m_freeVertexBuffer.create(g_caps.limits.maxVertexBuffers);
+			m_freeShader.create(g_caps.limits.maxShaders);
+			m_freeProgram.create(g_caps.limits.maxPrograms);
+			m_freeTexture.create(g_caps.limits.maxTextures);
+			m_freeFrameBuffer.create(g_caps.limits.maxFrameBuffers);
+			m_freeUniform.create(g_caps.limits.maxUniforms);
+
 			m_uniformBuffer = UniformBuffer::create();
 			reset();
 			start();
@@ -1446,6 +1808,17 @@ namespace bgfx
 		{
 			UniformBuffer::destroy(m_uniformBuffer);
 			BX_DELETE(g_allocator, m_textVideoMem);
+
+			m_occlusion.destroy();
+
+			m_freeIndexBuffer.destroy();
+			m_freeVertexDecl.destroy();
+			m_freeVertexBuffer.destroy();
+			m_freeShader.destroy();
+			m_freeProgram.destroy();
+			m_freeTexture.destroy();
+			m_freeFrameBuffer.destroy();
+			m_freeUniform.destroy();
 		}
 
 		void reset()
@@ -1732,7 +2105,7 @@ namespace bgfx
 		{
 			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
 			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::uint32_min(iboffset, BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
+			iboffset = bx::uint32_min(iboffset, m_transientIb->size);
 			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
 			return num;
 		}
@@ -1751,7 +2124,7 @@ namespace bgfx
 		{
 			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
 			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::uint32_min(vboffset, BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+			vboffset = bx::uint32_min(vboffset, m_transientVb->size);
 			uint32_t num = (vboffset-offset)/_stride;
 			return num;
 		}
@@ -1772,44 +2145,44 @@ namespace bgfx
 			m_uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
-		bool free(IndexBufferHandle _handle)
+		void free(IndexBufferHandle _handle)
 		{
-			return m_freeIndexBuffer.queue(_handle);
+			m_freeIndexBuffer.queue(_handle);
 		}
 
-		bool free(VertexDeclHandle _handle)
+		void free(VertexDeclHandle _handle)
 		{
-			return m_freeVertexDecl.queue(_handle);
+			m_freeVertexDecl.queue(_handle);
 		}
 
-		bool free(VertexBufferHandle _handle)
+		void free(VertexBufferHandle _handle)
 		{
-			return m_freeVertexBuffer.queue(_handle);
+			m_freeVertexBuffer.queue(_handle);
 		}
 
-		bool free(ShaderHandle _handle)
+		void free(ShaderHandle _handle)
 		{
-			return m_freeShader.queue(_handle);
+			m_freeShader.queue(_handle);
 		}
 
-		bool free(ProgramHandle _handle)
+		void free(ProgramHandle _handle)
 		{
-			return m_freeProgram.queue(_handle);
+			m_freeProgram.queue(_handle);
 		}
 
-		bool free(TextureHandle _handle)
+		void free(TextureHandle _handle)
 		{
-			return m_freeTexture.queue(_handle);
+			m_freeTexture.queue(_handle);
 		}
 
-		bool free(FrameBufferHandle _handle)
+		void free(FrameBufferHandle _handle)
 		{
-			return m_freeFrameBuffer.queue(_handle);
+			m_freeFrameBuffer.queue(_handle);
 		}
 
-		bool free(UniformHandle _handle)
+		void free(UniformHandle _handle)
 		{
-			return m_freeUniform.queue(_handle);
+			m_freeUniform.queue(_handle);
 		}
 
 		void resetFreeHandles()
@@ -1835,7 +2208,7 @@ namespace bgfx
 		Matrix4 m_view[BGFX_CONFIG_MAX_VIEWS];
 		Matrix4 m_proj[2][BGFX_CONFIG_MAX_VIEWS];
 		uint8_t m_viewFlags[BGFX_CONFIG_MAX_VIEWS];
-		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+		ResourceArrayT<int32_t> m_occlusion;
 
 		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
 		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
@@ -1875,7 +2248,7 @@ namespace bgfx
 		CommandBuffer m_cmdPre;
 		CommandBuffer m_cmdPost;
 
-		template<typename Ty, uint32_t Max>
+		template<typename Ty>
 		struct FreeHandle
 		{
 			FreeHandle()
@@ -1883,33 +2256,22 @@ namespace bgfx
 			{
 			}
 
-			bool isQueued(Ty _handle)
+			void create(uint32_t _max)
 			{
-				for (uint32_t ii = 0, num = m_num; ii < num; ++ii)
-				{
-					if (m_queue[ii].idx == _handle.idx)
-					{
-						return true;
-					}
-				}
-
-				return false;
+				m_queue.create(_max);
+				m_num = 0;
 			}
 
-			bool queue(Ty _handle)
+			void destroy()
 			{
-				if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
-				{
-					if (isQueued(_handle) )
-					{
-						return false;
-					}
-				}
+				m_queue.destroy();
+			}
 
+			void queue(Ty _handle)
+			{
+				BX_CHECK(m_num < m_queue.getNum(), "Free handle queue overflow.");
 				m_queue[m_num] = _handle;
 				++m_num;
-
-				return true;
 			}
 
 			void reset()
@@ -1927,18 +2289,18 @@ namespace bgfx
 				return m_num;
 			}
 
-			Ty m_queue[Max];
+			ResourceArrayT<Ty> m_queue;
 			uint16_t m_num;
 		};
 
-		FreeHandle<IndexBufferHandle,  BGFX_CONFIG_MAX_INDEX_BUFFERS>  m_freeIndexBuffer;
-		FreeHandle<VertexDeclHandle,   BGFX_CONFIG_MAX_VERTEX_DECLS>   m_freeVertexDecl;
-		FreeHandle<VertexBufferHandle, BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_freeVertexBuffer;
-		FreeHandle<ShaderHandle,       BGFX_CONFIG_MAX_SHADERS>        m_freeShader;
-		FreeHandle<ProgramHandle,      BGFX_CONFIG_MAX_PROGRAMS>       m_freeProgram;
-		FreeHandle<TextureHandle,      BGFX_CONFIG_MAX_TEXTURES>       m_freeTexture;
-		FreeHandle<FrameBufferHandle,  BGFX_CONFIG_MAX_FRAME_BUFFERS>  m_freeFrameBuffer;
-		FreeHandle<UniformHandle,      BGFX_CONFIG_MAX_UNIFORMS>       m_freeUniform;
+		FreeHandle<IndexBufferHandle>  m_freeIndexBuffer;
+		FreeHandle<VertexDeclHandle>   m_freeVertexDecl;
+		FreeHandle<VertexBufferHandle> m_freeVertexBuffer;
+		FreeHandle<ShaderHandle>       m_freeShader;
+		FreeHandle<ProgramHandle>      m_freeProgram;
+		FreeHandle<TextureHandle>      m_freeTexture;
+		FreeHandle<FrameBufferHandle>  m_freeFrameBuffer;
+		FreeHandle<UniformHandle>      m_freeUniform;
 
 		TextVideoMem* m_textVideoMem;
 		HMD m_hmd;
@@ -1952,21 +2314,234 @@ namespace bgfx
 		bool m_discard;
 	};
 
+	/// Handle allocator with capacity set at init time from runtime limits.
+	///
+	/// Freed handles are reused in FIFO order, so that handle index is not
+	/// reused until all other free handles are used. Destroyed handles are
+	/// marked in side table until they are freed at the end of frame, which
+	/// makes check for double destroy or use after destroy O(1).
+	///
+	/// Every index has 16-bit allocation serial, bumped when index is freed.
+	/// With BGFX_CONFIG_DEBUG_HANDLE_SERIAL handles given to user carry low
+	/// bits of serial above handle index (see `encode`/`decode`), so stale
+	/// handle whose index was reused doesn't pass validation. Otherwise
+	/// handle values are plain indices, and only range, liveness and destroyed
+	/// flag are checked.
+	class HandleAllocLimit
+	{
+	public:
+		HandleAllocLimit()
+			: m_numHandles(0)
+			, m_freeHead(0)
+			, m_maxHandles(0)
+			, m_indexMask(0)
+			, m_indexBits(0)
+		{
+		}
+
+		void init(uint32_t _maxHandles)
+		{
+			m_maxHandles = uint16_t(bx::uint32_min(bx::uint32_max(1, _maxHandles), reservedHandle) );
+
+			m_indexBits = 16;
+
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_HANDLE_SERIAL) )
+			{
+				// Index bits are selected so that largest index never has all
+				// bits set, which keeps encoded handle from ever being
+				// invalidHandle.
+				m_indexBits = 1;
+				while (m_indexBits < 16
+				&&    (1u<<m_indexBits) <= m_maxHandles)
+				{
+					++m_indexBits;
+				}
+
+				BX_WARN(16 - m_indexBits >= 4
+					, "Handle limit %d leaves only %d serial bits, stale handle detection is weak."
+					, m_maxHandles
+					, 16 - m_indexBits
+					);
+			}
+
+			m_indexMask = uint16_t( (1u<<m_indexBits)-1);
+
+			m_dense.create(m_maxHandles);
+			m_sparse.create(m_maxHandles);
+			m_free.create(m_maxHandles);
+			m_destroyed.create(m_maxHandles);
+			m_serial.create(m_maxHandles);
+			reset();
+		}
+
+		void shutdown()
+		{
+			m_dense.destroy();
+			m_sparse.destroy();
+			m_free.destroy();
+			m_destroyed.destroy();
+			m_serial.destroy();
+			m_maxHandles = 0;
+		}
+
+		uint16_t getMaxHandles() const
+		{
+			return m_maxHandles;
+		}
+
+		uint16_t getNumHandles() const
+		{
+			return m_numHandles;
+		}
+
+		uint16_t getHandleAt(uint16_t _at) const
+		{
+			return m_dense[_at];
+		}
+
+		uint16_t alloc()
+		{
+			if (m_numHandles < m_maxHandles)
+			{
+				const uint16_t handle = m_free[m_freeHead];
+				m_freeHead = m_freeHead+1 == m_maxHandles ? 0 : m_freeHead+1;
+
+				m_dense[m_numHandles] = handle;
+				m_sparse[handle]      = m_numHandles;
+				m_destroyed[handle]   = false;
+				++m_numHandles;
+
+				return handle;
+			}
+
+			return UINT16_MAX;
+		}
+
+		bool isValid(uint16_t _handle) const
+		{
+			if (_handle >= m_maxHandles)
+			{
+				return false;
+			}
+
+			const uint16_t index = m_sparse[_handle];
+			return index < m_numHandles
+				&& m_dense[index] == _handle
+				;
+		}
+
+		bool isAlive(uint16_t _handle) const
+		{
+			return isValid(_handle)
+				&& !m_destroyed[_handle]
+				;
+		}
+
+		/// Returns handle given to user for allocated handle index.
+		uint16_t encode(uint16_t _handle) const
+		{
+			if (invalidHandle == _handle)
+			{
+				return invalidHandle;
+			}
+
+			const uint32_t serialMask = 0xffffu>>m_indexBits;
+			return uint16_t(_handle | ( (m_serial[_handle] & serialMask)<<m_indexBits) );
+		}
+
+		/// Returns handle index for handle given to user, or invalidHandle if
+		/// handle is out of range, not allocated, destroyed, or stale (index
+		/// was freed and allocated again).
+		uint16_t decode(uint16_t _handle) const
+		{
+			const uint16_t idx = _handle & m_indexMask;
+			if (invalidHandle == _handle
+			||  !isAlive(idx)
+			||  _handle != encode(idx) )
+			{
+				return invalidHandle;
+			}
+
+			return idx;
+		}
+
+		/// Mark handle as destroyed. Returns false if handle is not alive.
+		bool destroy(uint16_t _handle)
+		{
+			if (!isAlive(_handle) )
+			{
+				return false;
+			}
+
+			m_destroyed[_handle] = true;
+			return true;
+		}
+
+		void free(uint16_t _handle)
+		{
+			BX_CHECK(isValid(_handle), "Freeing invalid handle %d.", _handle);
+
+			const uint16_t index = m_sparse[_handle];
+			--m_numHandles;
+			const uint16_t temp = m_dense[m_numHandles];
+			m_dense[m_numHandles] = _handle;
+			m_sparse[temp]        = index;
+			m_dense[index]        = temp;
+
+			uint32_t tail = m_freeHead + (m_maxHandles - m_numHandles - 1);
+			tail = tail >= m_maxHandles ? tail - m_maxHandles : tail;
+			m_free[uint16_t(tail)] = _handle;
+			m_destroyed[_handle] = true;
+			++m_serial[_handle];
+		}
+
+		void reset()
+		{
+			m_numHandles = 0;
+			m_freeHead   = 0;
+
+			for (uint16_t ii = 0; ii < m_maxHandles; ++ii)
+			{
+				m_dense[ii]     = ii;
+				m_sparse[ii]    = ii;
+				m_free[ii]      = ii;
+				m_destroyed[ii] = true;
+				m_serial[ii]    = 0;
+			}
+		}
+
+	private:
+		ResourceArrayT<uint16_t> m_dense;
+		ResourceArrayT<uint16_t> m_sparse;
+		ResourceArrayT<uint16_t> m_free;
+		ResourceArrayT<bool>     m_destroyed;
+		ResourceArrayT<uint16_t> m_serial;
+		uint16_t m_numHandles;
+		uint16_t m_freeHead;
+		uint16_t m_maxHandles;
+		uint16_t m_indexMask;
+		uint8_t  m_indexBits;
+	};
+
 	struct VertexDeclRef
 	{
 		VertexDeclRef()
 		{
 		}
 
-		void init()
+		void init(uint32_t _maxVertexDecls, uint32_t _maxVertexBuffers, uint32_t _maxDynamicVertexBuffers)
 		{
-			bx::memSet(m_vertexDeclRef,          0,    sizeof(m_vertexDeclRef)          );
-			bx::memSet(m_vertexBufferRef,        0xff, sizeof(m_vertexBufferRef)        );
-			bx::memSet(m_dynamicVertexBufferRef, 0xff, sizeof(m_dynamicVertexBufferRef) );
+			const VertexDeclHandle invalid = BGFX_INVALID_HANDLE;
+
+			m_vertexDeclMap.create(_maxVertexDecls*2, _maxVertexDecls);
+			m_vertexDeclRef.create(_maxVertexDecls);
+			m_vertexBufferRef.create(_maxVertexBuffers);
+			m_vertexBufferRef.fill(invalid);
+			m_dynamicVertexBufferRef.create(_maxDynamicVertexBuffers);
+			m_dynamicVertexBufferRef.fill(invalid);
 		}
 
-		template <uint16_t MaxHandlesT>
-		void shutdown(bx::HandleAllocT<MaxHandlesT>& _handleAlloc)
+		void shutdown(HandleAllocLimit& _handleAlloc)
 		{
 			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii)
 			{
@@ -1976,7 +2551,10 @@ namespace bgfx
 				_handleAlloc.free(handle.idx);
 			}
 
-			m_vertexDeclMap.reset();
+			m_vertexDeclMap.destroy();
+			m_vertexDeclRef.destroy();
+			m_vertexBufferRef.destroy();
+			m_dynamicVertexBufferRef.destroy();
 		}
 
 		VertexDeclHandle find(uint32_t _hash)
@@ -2042,12 +2620,11 @@ namespace bgfx
 			return declHandle;
 		}
 
-		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_VERTEX_DECLS*2> VertexDeclMap;
-		VertexDeclMap m_vertexDeclMap;
+		HandleHashMap m_vertexDeclMap;
 
-		uint16_t m_vertexDeclRef[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		VertexDeclHandle m_vertexBufferRef[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		VertexDeclHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
+		ResourceArrayT<uint16_t> m_vertexDeclRef;
+		ResourceArrayT<VertexDeclHandle> m_vertexBufferRef;
+		ResourceArrayT<VertexDeclHandle> m_dynamicVertexBufferRef;
 	};
 
 	// First-fit non-local allocator.
@@ -2240,6 +2817,11 @@ namespace bgfx
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
+			, m_numDynamicBufferUpdatesQueued(0)
+			, m_dynamicBufferUpdateCount(0)
+			, m_dynamicBufferMergeCount(0)
+			, m_numDynamicBufferUpdates(0)
+			, m_numDynamicBufferUpdatesMerged(0)
 			, m_colorPaletteDirty(0)
 			, m_instBufferCount(0)
 			, m_frames(0)
@@ -2251,7 +2833,14 @@ namespace bgfx
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_textureResidentMemory(0)
+			, m_textureStreamingBudget(BGFX_CONFIG_TEXTURE_STREAMING_BUDGET)
+			, m_numTextureStream(0)
+			, m_numTextureStreamed(0)
+			, m_transientVbUsed(0)
+			, m_transientIbUsed(0)
 		{
+			bx::memSet(m_memoryUsed, 0, sizeof(m_memoryUsed) );
 		}
 
 		~Context()
@@ -2268,7 +2857,7 @@ namespace bgfx
 		}
 
 		// game thread
-		bool init(RendererType::Enum _type);
+		bool init(RendererType::Enum _type, const InitLimits& _limits);
 		void shutdown();
 
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
@@ -2357,6 +2946,49 @@ namespace bgfx
 			const TextVideoMem* tvm = m_submit->m_textVideoMem;
 			stats.textWidth  = tvm->m_width;
 			stats.textHeight = tvm->m_height;
+			stats.numTextureStreamed     = m_numTextureStreamed;
+			stats.textureResidentMemory  = m_textureResidentMemory;
+			stats.textureStreamingBudget = m_textureStreamingBudget;
+
+			stats.textureMemoryUsed             = m_memoryUsed[ResourceMemory::Texture];
+			stats.rtMemoryUsed                  = m_memoryUsed[ResourceMemory::RenderTarget];
+			stats.indexBufferMemoryUsed         = m_memoryUsed[ResourceMemory::IndexBuffer];
+			stats.vertexBufferMemoryUsed        = m_memoryUsed[ResourceMemory::VertexBuffer];
+			stats.dynamicIndexBufferMemoryUsed  = m_memoryUsed[ResourceMemory::DynamicIndexBuffer];
+			stats.dynamicVertexBufferMemoryUsed = m_memoryUsed[ResourceMemory::DynamicVertexBuffer];
+			stats.transientMemoryUsed           = m_memoryUsed[ResourceMemory::Transient];
+
+			int64_t uniformMemoryUsed = 0;
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frame); ++ii)
+			{
+				uniformMemoryUsed += m_frame[ii].m_uniformBuffer->getSize() + sizeof(MatrixCache);
+			}
+			stats.uniformMemoryUsed = uniformMemoryUsed;
+
+			stats.gpuMemoryUsed = 0;
+			for (uint32_t ii = 0; ii < ResourceMemory::Count; ++ii)
+			{
+				stats.gpuMemoryUsed += m_memoryUsed[ii];
+			}
+
+			stats.transientVbUsed = m_transientVbUsed;
+			stats.transientIbUsed = m_transientIbUsed;
+
+			stats.numDynamicBufferUpdates       = m_numDynamicBufferUpdates;
+			stats.numDynamicBufferUpdatesMerged = m_numDynamicBufferUpdatesMerged;
+
+			stats.numDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getNumHandles();
+			stats.numDynamicVertexBuffers = m_dynamicVertexBufferHandle.getNumHandles();
+			stats.numFrameBuffers         = m_frameBufferHandle.getNumHandles();
+			stats.numIndexBuffers         = m_indexBufferHandle.getNumHandles();
+			stats.numOcclusionQueries     = m_occlusionQueryHandle.getNumHandles();
+			stats.numPrograms             = m_programHandle.getNumHandles();
+			stats.numShaders              = m_shaderHandle.getNumHandles();
+			stats.numTextures             = m_textureHandle.getNumHandles();
+			stats.numUniforms             = m_uniformHandle.getNumHandles();
+			stats.numVertexBuffers        = m_vertexBufferHandle.getNumHandles();
+			stats.numVertexDecls          = m_vertexDeclHandle.getNumHandles();
+
 			return &stats;
 		}
 
@@ -2367,6 +2999,8 @@ namespace bgfx
 			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
 			if (isValid(handle) )
 			{
+				memoryAlloc(handle, _mem->size, ResourceMemory::IndexBuffer);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
@@ -2383,13 +3017,74 @@ namespace bgfx
 		BGFX_API_FUNC(void destroyIndexBuffer(IndexBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
-			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-			BX_CHECK(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
+			if (!m_indexBufferHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Index buffer handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
+			m_submit->free(_handle);
+
+			memoryFree(_handle);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyIndexBuffer);
 			cmdbuf.write(_handle);
 		}
 
+		void memoryAlloc(IndexBufferHandle _handle, uint32_t _size, ResourceMemory::Enum _memory)
+		{
+			IndexBuffer& ib = m_indexBuffers[_handle.idx];
+			ib.m_size   = _size;
+			ib.m_memory = uint8_t(_memory);
+			m_memoryUsed[_memory] += _size;
+		}
+
+		void memoryFree(IndexBufferHandle _handle)
+		{
+			IndexBuffer& ib = m_indexBuffers[_handle.idx];
+			m_memoryUsed[ib.m_memory] -= ib.m_size;
+			ib.m_size = 0;
+		}
+
+		void memoryAlloc(VertexBufferHandle _handle, uint32_t _size, ResourceMemory::Enum _memory)
+		{
+			VertexBuffer& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size   = _size;
+			vb.m_memory = uint8_t(_memory);
+			m_memoryUsed[_memory] += _size;
+		}
+
+		void memoryFree(VertexBufferHandle _handle)
+		{
+			VertexBuffer& vb = m_vertexBuffers[_handle.idx];
+			m_memoryUsed[vb.m_memory] -= vb.m_size;
+			vb.m_size = 0;
+		}
+
+		void memoryAlloc(TextureHandle _handle, const TextureInfo& _info, uint32_t _flags)
+		{
+			TextureRef& ref = m_textureRef[_handle.idx];
+			ref.m_storageSize = _info.storageSize;
+			ref.m_memory      = uint8_t(ResourceMemory::Texture);
+
+			if (0 != (_flags & (BGFX_TEXTURE_RT|BGFX_TEXTURE_RT_WRITE_ONLY) ) )
+			{
+				// MSAA surface is estimated at storage size per sample.
+				const uint32_t msaa = (_flags&BGFX_TEXTURE_RT_MSAA_MASK)>>BGFX_TEXTURE_RT_MSAA_SHIFT;
+				ref.m_storageSize *= 1 < msaa ? 1<<(msaa-1) : 1;
+				ref.m_memory       = uint8_t(ResourceMemory::RenderTarget);
+			}
+
+			m_memoryUsed[ref.m_memory] += ref.m_storageSize;
+		}
+
+		void memoryFree(TextureHandle _handle)
+		{
+			TextureRef& ref = m_textureRef[_handle.idx];
+			m_memoryUsed[ref.m_memory] -= ref.m_storageSize;
+			ref.m_storageSize = 0;
+		}
+
 		VertexDeclHandle findVertexDecl(const VertexDecl& _decl)
 		{
 			VertexDeclHandle declHandle = m_declRef.find(_decl.m_hash);
@@ -2417,6 +3112,7 @@ namespace bgfx
 				m_declRef.add(handle, declHandle, _decl.m_hash);
 
 				m_vertexBuffers[handle.idx].m_stride = _decl.m_stride;
+				memoryAlloc(handle, _mem->size, ResourceMemory::VertexBuffer);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer);
 				cmdbuf.write(handle);
@@ -2435,8 +3131,15 @@ namespace bgfx
 		BGFX_API_FUNC(void destroyVertexBuffer(VertexBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
-			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-			BX_CHECK(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
+			if (!m_vertexBufferHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Vertex buffer handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
+			m_submit->free(_handle);
+
+			memoryFree(_handle);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexBuffer);
 			cmdbuf.write(_handle);
@@ -2468,6 +3171,7 @@ namespace bgfx
 				}
 
 				uint32_t allocSize = bx::uint32_max(BGFX_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, _size);
+				memoryAlloc(indexBufferHandle, allocSize, ResourceMemory::DynamicIndexBuffer);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(indexBufferHandle);
@@ -2496,6 +3200,8 @@ namespace bgfx
 					return handle;
 				}
 
+				memoryAlloc(indexBufferHandle, size, ResourceMemory::DynamicIndexBuffer);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(indexBufferHandle);
 				cmdbuf.write(size);
@@ -2577,16 +3283,17 @@ namespace bgfx
 				, size
 				, _mem->size
 				);
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
-			cmdbuf.write(dib.m_handle);
-			cmdbuf.write(offset);
-			cmdbuf.write(size);
-			cmdbuf.write(_mem);
+			queueDynamicBufferUpdate(false, dib.m_handle.idx, offset, size, _mem);
 		}
 
 		BGFX_API_FUNC(void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
+			if (!m_dynamicIndexBufferHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Dynamic index buffer handle %d is already destroyed!", _handle.idx);
+				return;
+			}
 
 			m_freeDynamicIndexBufferHandle[m_numFreeDynamicIndexBufferHandles++] = _handle;
 		}
@@ -2629,6 +3336,7 @@ namespace bgfx
 				}
 
 				uint32_t allocSize = bx::uint32_max(BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE, _size);
+				memoryAlloc(vertexBufferHandle, allocSize, ResourceMemory::DynamicVertexBuffer);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
 				cmdbuf.write(vertexBufferHandle);
@@ -2656,6 +3364,8 @@ namespace bgfx
 					return handle;
 				}
 
+				memoryAlloc(vertexBufferHandle, size, ResourceMemory::DynamicVertexBuffer);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
 				cmdbuf.write(vertexBufferHandle);
 				cmdbuf.write(size);
@@ -2737,16 +3447,39 @@ namespace bgfx
 				, _mem->size
 				);
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
-			cmdbuf.write(dvb.m_handle);
-			cmdbuf.write(offset);
-			cmdbuf.write(size);
-			cmdbuf.write(_mem);
+			queueDynamicBufferUpdate(true, dvb.m_handle.idx, offset, size, _mem);
+		}
+
+		// Dynamic buffer updates are not written into command buffer
+		// immediately. They are queued, and coalesced per buffer before
+		// swap, so that adjacent or overlapping updates to the same buffer
+		// result in single renderer update.
+		void queueDynamicBufferUpdate(bool _vertex, uint16_t _handle, uint32_t _offset, uint32_t _size, const Memory* _mem)
+		{
+			if (BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES == m_numDynamicBufferUpdatesQueued)
+			{
+				flushDynamicBufferUpdates();
+			}
+
+			DynamicBufferUpdate& update = m_dynamicBufferUpdate[m_numDynamicBufferUpdatesQueued++];
+			update.m_mem    = _mem;
+			update.m_offset = _offset;
+			update.m_size   = _size;
+			update.m_handle = _handle;
+			update.m_run    = 0;
+			update.m_vertex = _vertex;
+
+			++m_dynamicBufferUpdateCount;
 		}
 
 		BGFX_API_FUNC(void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
+			if (!m_dynamicVertexBufferHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Dynamic vertex buffer handle %d is already destroyed!", _handle.idx);
+				return;
+			}
 
 			m_freeDynamicVertexBufferHandle[m_numFreeDynamicVertexBufferHandles++] = _handle;
 		}
@@ -2803,6 +3536,8 @@ namespace bgfx
 			BX_WARN(isValid(handle), "Failed to allocate transient index buffer handle.");
 			if (isValid(handle) )
 			{
+				memoryAlloc(handle, _size, ResourceMemory::Transient);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
@@ -2821,6 +3556,8 @@ namespace bgfx
 
 		void destroyTransientIndexBuffer(TransientIndexBuffer* _tib)
 		{
+			memoryFree(_tib->handle);
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicIndexBuffer);
 			cmdbuf.write(_tib->handle);
 
@@ -2860,6 +3597,8 @@ namespace bgfx
 					stride = _decl->m_stride;
 				}
 
+				memoryAlloc(handle, _size, ResourceMemory::Transient);
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
@@ -2881,6 +3620,8 @@ namespace bgfx
 
 		void destroyTransientVertexBuffer(TransientVertexBuffer* _tvb)
 		{
+			memoryFree(_tvb->handle);
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(_tvb->handle);
 
@@ -2957,6 +3698,11 @@ namespace bgfx
 		{
 			VertexBufferHandle handle = { _handle.idx };
 			BGFX_CHECK_HANDLE("destroyDrawIndirectBuffer", m_vertexBufferHandle, handle);
+			if (!m_vertexBufferHandle.destroy(handle.idx) )
+			{
+				BX_WARN(false, "Indirect buffer handle %d is already destroyed!", handle.idx);
+				return;
+			}
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(handle);
@@ -2994,6 +3740,29 @@ namespace bgfx
 				return invalid;
 			}
 
+			// Identical shader binaries share handle and backend shader.
+			// Binaries are matched by 64-bit hash (map key, and second hash
+			// with different seed) and size, so no CPU copy of binary is kept.
+			const uint32_t shaderHash = bx::hashMurmur2A(_mem->data, _mem->size);
+
+			bx::HashMurmur2A murmur;
+			murmur.begin(UINT32_C(0x9e3779b9) );
+			murmur.add(_mem->data, _mem->size);
+			const uint32_t binaryHash = murmur.end();
+
+			uint16_t idx = m_shaderHashMap.find(shaderHash);
+			if (HandleHashMap::invalid != idx
+			&&  m_shaderRef[idx].m_size       == _mem->size
+			&&  m_shaderRef[idx].m_binaryHash == binaryHash)
+			{
+				ShaderHandle handle = { idx };
+				ShaderRef& sr = m_shaderRef[handle.idx];
+				++sr.m_refCount;
+				++sr.m_userRefCount;
+				release(_mem);
+				return handle;
+			}
+
 			ShaderHandle handle = { m_shaderHandle.alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate shader handle.");
@@ -3006,11 +3775,17 @@ namespace bgfx
 				bx::read(&reader, count);
 
 				ShaderRef& sr = m_shaderRef[handle.idx];
-				sr.m_refCount = 1;
-				sr.m_hash     = iohash;
-				sr.m_num      = 0;
-				sr.m_owned    = false;
-				sr.m_uniforms = NULL;
+				sr.m_refCount     = 1;
+				sr.m_userRefCount = 1;
+				sr.m_hash         = iohash;
+				sr.m_binaryHash   = binaryHash;
+				sr.m_size         = _mem->size;
+				sr.m_num          = 0;
+				sr.m_uniforms     = NULL;
+
+				// On map key collision with different binary, shader is
+				// created, but it's not deduplicated.
+				m_shaderHashMap.insert(shaderHash, handle.idx);
 
 				UniformHandle* uniforms = (UniformHandle*)alloca(count*sizeof(UniformHandle) );
 
@@ -3084,21 +3859,34 @@ namespace bgfx
 		{
 			BGFX_CHECK_HANDLE("destroyShader", m_shaderHandle, _handle);
 
-			if (!isValid(_handle) )
+			if (!isValid(_handle)
+			||  !m_shaderHandle.isAlive(_handle.idx) )
 			{
 				BX_WARN(false, "Passing invalid shader handle to bgfx::destroyShader.");
 				return;
 			}
 
+			// Programs keep shader alive, only references taken by
+			// createShader callers can be released here.
+			ShaderRef& sr = m_shaderRef[_handle.idx];
+			if (0 == sr.m_userRefCount)
+			{
+				BX_WARN(false, "Shader handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
+			--sr.m_userRefCount;
 			shaderDecRef(_handle);
 		}
 
+		// Releases reference held by createShader caller, once per
+		// createShader call, no matter how many programs use the shader.
 		void shaderTakeOwnership(ShaderHandle _handle)
 		{
 			ShaderRef& sr = m_shaderRef[_handle.idx];
-			if (!sr.m_owned)
+			if (0 < sr.m_userRefCount)
 			{
-				sr.m_owned = true;
+				--sr.m_userRefCount;
 				shaderDecRef(_handle);
 			}
 		}
@@ -3115,12 +3903,15 @@ namespace bgfx
 			int32_t refs = --sr.m_refCount;
 			if (0 == refs)
 			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+				bool ok = m_shaderHandle.destroy(_handle.idx); BX_UNUSED(ok);
 				BX_CHECK(ok, "Shader handle %d is already destroyed!", _handle.idx);
+				m_submit->free(_handle);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyShader);
 				cmdbuf.write(_handle);
 
+				m_shaderHashMap.removeByHandle(_handle.idx);
+
 				if (0 != sr.m_num)
 				{
 					for (uint32_t ii = 0, num = sr.m_num; ii < num; ++ii)
@@ -3146,11 +3937,18 @@ namespace bgfx
 			}
 
 			uint16_t idx = m_programHashMap.find(uint32_t(_fsh.idx<<16)|_vsh.idx);
-			if (ProgramHashMap::invalid != idx)
+			if (HandleHashMap::invalid != idx)
 			{
 				ProgramHandle handle = { idx };
 				ProgramRef& pr = m_programRef[handle.idx];
 				++pr.m_refCount;
+
+				if (_destroyShaders)
+				{
+					shaderTakeOwnership(_vsh);
+					shaderTakeOwnership(_fsh);
+				}
+
 				return handle;
 			}
 
@@ -3205,11 +4003,17 @@ namespace bgfx
 			}
 
 			uint16_t idx = m_programHashMap.find(_vsh.idx);
-			if (ProgramHashMap::invalid != idx)
+			if (HandleHashMap::invalid != idx)
 			{
 				ProgramHandle handle = { idx };
 				ProgramRef& pr = m_programRef[handle.idx];
 				++pr.m_refCount;
+
+				if (_destroyShader)
+				{
+					shaderTakeOwnership(_vsh);
+				}
+
 				return handle;
 			}
 
@@ -3248,12 +4052,18 @@ namespace bgfx
 		{
 			BGFX_CHECK_HANDLE("destroyProgram", m_programHandle, _handle);
 
+			if (!m_programHandle.isAlive(_handle.idx) )
+			{
+				BX_WARN(false, "Program handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
 			ProgramRef& pr = m_programRef[_handle.idx];
 			int32_t refs = --pr.m_refCount;
 			if (0 == refs)
 			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-				BX_CHECK(ok, "Program handle %d is already destroyed!", _handle.idx);
+				m_programHandle.destroy(_handle.idx);
+				m_submit->free(_handle);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyProgram);
 				cmdbuf.write(_handle);
@@ -3271,16 +4081,10 @@ namespace bgfx
 			}
 		}
 
-		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint32_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio) )
+		TextureHandle textureAlloc(const void* _data, uint32_t _size, uint32_t _flags, TextureInfo* _info, BackbufferRatio::Enum _ratio)
 		{
-			TextureInfo ti;
-			if (NULL == _info)
-			{
-				_info = &ti;
-			}
-
 			bimg::ImageContainer imageContainer;
-			if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+			if (bimg::imageParse(imageContainer, _data, _size) )
 			{
 				calcTextureSize(*_info
 					, (uint16_t)imageContainer.m_width
@@ -3314,7 +4118,117 @@ namespace bgfx
 				ref.m_format   = uint8_t(_info->format);
 				ref.m_numMips  = imageContainer.m_numMips;
 				ref.m_owned    = false;
+				ref.m_stream   = NULL;
+				memoryAlloc(handle, *_info, _flags);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void createResources(CommandBuffer::Enum _type, uint16_t* _handles, const ResourceDesc* _desc, uint16_t _num, const Memory* _mem) )
+		{
+			if (0 == _num)
+			{
+				release(_mem);
+				return;
+			}
+
+			// Handles are allocated and validated up front, and all resources
+			// are passed to renderer with single command, referencing data
+			// inside one memory block.
+			const Memory* items = alloc(_num*sizeof(ResourceItem) );
+			ResourceItem* item = (ResourceItem*)items->data;
+			uint16_t num = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				const ResourceDesc& desc = _desc[ii];
+				VertexDeclHandle declHandle = BGFX_INVALID_HANDLE;
+				uint16_t handle = UINT16_MAX;
+
+				switch (_type)
+				{
+				case CommandBuffer::CreateIndexBuffer:
+					{
+						IndexBufferHandle ibh = { m_indexBufferHandle.alloc() };
+						if (isValid(ibh) )
+						{
+							memoryAlloc(ibh, desc.size, ResourceMemory::IndexBuffer);
+						}
+
+						handle = ibh.idx;
+					}
+					break;
+
+				case CommandBuffer::CreateVertexBuffer:
+					{
+						VertexBufferHandle vbh = { m_vertexBufferHandle.alloc() };
+						if (isValid(vbh) )
+						{
+							declHandle = findVertexDecl(*desc.decl);
+							m_declRef.add(vbh, declHandle, desc.decl->m_hash);
+
+							m_vertexBuffers[vbh.idx].m_stride = desc.decl->m_stride;
+							memoryAlloc(vbh, desc.size, ResourceMemory::VertexBuffer);
+						}
+
+						handle = vbh.idx;
+					}
+					break;
+
+				case CommandBuffer::CreateTexture:
+					{
+						TextureInfo ti;
+						TextureHandle th = textureAlloc(&_mem->data[desc.offset], desc.size, desc.flags, &ti, BackbufferRatio::Count);
+						handle = th.idx;
+					}
+					break;
+
+				default:
+					BX_CHECK(false, "Invalid resource type %d.", _type);
+					break;
+				}
+
+				_handles[ii] = handle;
+
+				if (UINT16_MAX != handle)
+				{
+					item[num].m_offset = desc.offset;
+					item[num].m_size   = desc.size;
+					item[num].m_flags  = desc.flags;
+					item[num].m_handle = handle;
+					item[num].m_decl   = declHandle;
+					++num;
+				}
+			}
+
+			BX_WARN(num == _num, "Failed to allocate %d of %d resource handles.", _num-num, _num);
+
+			if (0 == num)
+			{
+				release(items);
+				release(_mem);
+				return;
+			}
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateResources);
+			cmdbuf.write(uint8_t(_type) );
+			cmdbuf.write(num);
+			cmdbuf.write(items);
+			cmdbuf.write(_mem);
+		}
+
+		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint32_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio) )
+		{
+			TextureInfo ti;
+			if (NULL == _info)
+			{
+				_info = &ti;
+			}
 
+			TextureHandle handle = textureAlloc(_mem->data, _mem->size, _flags, _info, _ratio);
+			if (isValid(handle) )
+			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
@@ -3333,13 +4247,213 @@ namespace bgfx
 		{
 			BGFX_CHECK_HANDLE("destroyTexture", m_textureHandle, _handle);
 
-			if (!isValid(_handle) )
+			if (!isValid(_handle)
+			||  !m_textureHandle.isAlive(_handle.idx) )
 			{
 				BX_WARN(false, "Passing invalid texture handle to bgfx::destroyTexture");
 				return;
 			}
 
-			textureDecRef(_handle);
+			// Texture stays alive while frame buffers reference it, user
+			// reference can be released only once.
+			if (m_textureRef[_handle.idx].m_owned)
+			{
+				BX_WARN(false, "Texture handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
+			textureTakeOwnership(_handle);
+		}
+
+		BGFX_API_FUNC(TextureHandle createTextureStreaming(const Memory* _mem, uint8_t _residentMip, uint32_t _flags, TextureInfo* _info) )
+		{
+			bimg::ImageContainer imageContainer;
+			if (!bimg::imageParse(imageContainer, _mem->data, _mem->size)
+			||  1 >= imageContainer.m_numMips)
+			{
+				BX_WARN(false, "Streaming texture requires mip chain, creating regular texture.");
+				return createTexture(_mem, _flags, 0, _info, BackbufferRatio::Count);
+			}
+
+			// Keep CPU copy of whole texture, renderer is fed with references
+			// to it, and skips mips above resident mip while parsing. Only
+			// resident mips are allocated.
+			TextureStream* ts = BX_NEW(g_allocator, TextureStream);
+			ts->m_data      = BX_ALLOC(g_allocator, _mem->size);
+			ts->m_size      = _mem->size;
+			ts->m_flags     = _flags;
+			ts->m_refCount  = 1;
+			ts->m_width     = uint16_t(imageContainer.m_width);
+			ts->m_height    = uint16_t(imageContainer.m_height);
+			ts->m_depth     = uint16_t(imageContainer.m_depth);
+			ts->m_numLayers = imageContainer.m_numLayers;
+			ts->m_cubeMap   = imageContainer.m_cubeMap;
+			ts->m_format    = uint8_t(imageContainer.m_format);
+			ts->m_numMips   = imageContainer.m_numMips;
+			ts->m_residentMip  = uint8_t(bx::uint32_min(_residentMip, ts->m_numMips-1) );
+			ts->m_targetMip    = 0;
+			ts->m_residentSize = 0;
+			bx::memCopy(ts->m_data, _mem->data, _mem->size);
+			release(_mem);
+
+			TextureHandle handle = createTexture(textureStreamRef(*ts), _flags, ts->m_residentMip, _info, BackbufferRatio::Count);
+			if (isValid(handle) )
+			{
+				m_textureRef[handle.idx].m_stream = ts;
+				m_textureStreamSet.insert(handle.idx);
+				textureStreamResize(handle, *ts, ts->m_residentMip);
+				++m_numTextureStream;
+			}
+			else
+			{
+				textureStreamRelease(NULL, ts);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) )
+		{
+			BGFX_CHECK_HANDLE("setTextureResidentMip", m_textureHandle, _handle);
+
+			TextureStream* ts = m_textureRef[_handle.idx].m_stream;
+			BX_CHECK(NULL != ts, "Texture %d is not streaming texture.", _handle.idx);
+			if (NULL == ts)
+			{
+				return;
+			}
+
+			ts->m_targetMip = uint8_t(bx::uint32_min(_mip, ts->m_numMips-1) );
+
+			// Dropping mips is applied immediately, raising is done
+			// incrementally by textureStreamUpdate under budget.
+			if (ts->m_targetMip > ts->m_residentMip)
+			{
+				textureStreamCommit(_handle, *ts, ts->m_targetMip);
+			}
+		}
+
+		BGFX_API_FUNC(uint8_t getTextureResidentMip(TextureHandle _handle) )
+		{
+			BGFX_CHECK_HANDLE("getTextureResidentMip", m_textureHandle, _handle);
+
+			const TextureStream* ts = m_textureRef[_handle.idx].m_stream;
+			return NULL != ts ? ts->m_residentMip : 0;
+		}
+
+		BGFX_API_FUNC(void setTextureStreamingBudget(uint64_t _size) )
+		{
+			m_textureStreamingBudget = _size;
+		}
+
+		static void textureStreamRelease(void* /*_ptr*/, void* _userData)
+		{
+			TextureStream* ts = (TextureStream*)_userData;
+			if (0 == bx::atomicDec(&ts->m_refCount) )
+			{
+				BX_FREE(g_allocator, ts->m_data);
+				BX_DELETE(g_allocator, ts);
+			}
+		}
+
+		const Memory* textureStreamRef(TextureStream& _ts)
+		{
+			bx::atomicInc(&_ts.m_refCount);
+			return makeRef(_ts.m_data, _ts.m_size, textureStreamRelease, &_ts);
+		}
+
+		static uint32_t textureStreamSize(const TextureStream& _ts, uint8_t _mip)
+		{
+			TextureInfo ti;
+			calcTextureSize(ti
+				, uint16_t(bx::uint32_max(1, _ts.m_width >>_mip) )
+				, uint16_t(bx::uint32_max(1, _ts.m_height>>_mip) )
+				, uint16_t(bx::uint32_max(1, _ts.m_depth >>_mip) )
+				, _ts.m_cubeMap
+				, _ts.m_numMips - _mip > 1
+				, _ts.m_numLayers
+				, TextureFormat::Enum(_ts.m_format)
+				);
+			return ti.storageSize;
+		}
+
+		// Accounts texture as allocated with mips from _mip down only.
+		void textureStreamResize(TextureHandle _handle, TextureStream& _ts, uint8_t _mip)
+		{
+			const uint32_t size = textureStreamSize(_ts, _mip);
+
+			TextureRef& ref = m_textureRef[_handle.idx];
+			m_memoryUsed[ref.m_memory] += int64_t(size) - int64_t(ref.m_storageSize);
+			ref.m_storageSize = size;
+			ref.m_numMips     = _ts.m_numMips - _mip;
+
+			m_textureResidentMemory -= _ts.m_residentSize;
+			m_textureResidentMemory += size;
+			_ts.m_residentSize = size;
+			_ts.m_residentMip  = _mip;
+		}
+
+		uint32_t textureStreamCommit(TextureHandle _handle, TextureStream& _ts, uint8_t _mip)
+		{
+			// Renderer texture is recreated with resident mips only, whole
+			// resident chain is uploaded again.
+			textureStreamResize(_handle, _ts, _mip);
+			++m_numTextureStream;
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::StreamTexture);
+			cmdbuf.write(_handle);
+			cmdbuf.write(textureStreamRef(_ts) );
+			cmdbuf.write(_ts.m_flags);
+			cmdbuf.write(_mip);
+
+			return _ts.m_residentSize;
+		}
+
+		void textureStreamUpdate()
+		{
+			// Over budget, drop finest resident mip of streaming textures.
+			for (HandleSet::const_iterator it = m_textureStreamSet.begin(), itEnd = m_textureStreamSet.end()
+				; it != itEnd && m_textureResidentMemory > m_textureStreamingBudget
+				; ++it
+				)
+			{
+				TextureHandle handle = { *it };
+				TextureStream& ts = *m_textureRef[handle.idx].m_stream;
+				if (ts.m_residentMip+1 < ts.m_numMips)
+				{
+					textureStreamCommit(handle, ts, ts.m_residentMip+1);
+				}
+			}
+
+			// Raise residency one mip per texture per frame while it fits
+			// into budget and per frame upload limit.
+			uint32_t upload = 0;
+			for (HandleSet::const_iterator it = m_textureStreamSet.begin(), itEnd = m_textureStreamSet.end(); it != itEnd; ++it)
+			{
+				TextureHandle handle = { *it };
+				TextureStream& ts = *m_textureRef[handle.idx].m_stream;
+				if (ts.m_targetMip < ts.m_residentMip)
+				{
+					const uint8_t  mip  = ts.m_residentMip-1;
+					const uint32_t size = textureStreamSize(ts, mip);
+
+					if (m_textureResidentMemory - ts.m_residentSize + size > m_textureStreamingBudget)
+					{
+						continue;
+					}
+
+					if (0 != upload
+					&&  upload + size > BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_SIZE)
+					{
+						break;
+					}
+
+					upload += textureStreamCommit(handle, ts, mip);
+				}
+			}
+
+			m_numTextureStreamed = m_numTextureStream;
+			m_numTextureStream   = 0;
 		}
 
 		BGFX_API_FUNC(uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip) )
@@ -3358,12 +4472,17 @@ namespace bgfx
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips)
 		{
-			const TextureRef& textureRef = m_textureRef[_handle.idx];
+			TextureRef& textureRef = m_textureRef[_handle.idx];
 			BX_CHECK(BackbufferRatio::Count != textureRef.m_bbRatio, "");
 
 			getTextureSizeFromRatio(BackbufferRatio::Enum(textureRef.m_bbRatio), _width, _height);
 			_numMips = calcNumMips(1 < _numMips, _width, _height);
 
+			TextureInfo ti;
+			calcTextureSize(ti, _width, _height, 1, false, 1 < _numMips, 1, TextureFormat::Enum(textureRef.m_format) );
+			m_memoryUsed[textureRef.m_memory] += int64_t(ti.storageSize) - int64_t(textureRef.m_storageSize);
+			textureRef.m_storageSize = ti.storageSize;
+
 			BX_TRACE("Resize %3d: %4dx%d %s"
 				, _handle.idx
 				, _width
@@ -3394,20 +4513,130 @@ namespace bgfx
 			++ref.m_refCount;
 		}
 
-		void textureDecRef(TextureHandle _handle)
+		// Returns true when last reference is released, and renderer
+		// texture should be destroyed.
+		bool textureRelease(TextureHandle _handle)
 		{
 			TextureRef& ref = m_textureRef[_handle.idx];
 			int32_t refs = --ref.m_refCount;
-			if (0 == refs)
+			if (0 != refs)
+			{
+				return false;
+			}
+
+			bool ok = m_textureHandle.destroy(_handle.idx); BX_UNUSED(ok);
+			BX_CHECK(ok, "Texture handle %d is already destroyed!", _handle.idx);
+			m_submit->free(_handle);
+
+			memoryFree(_handle);
+
+			if (NULL != ref.m_stream)
 			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-				BX_CHECK(ok, "Texture handle %d is already destroyed!", _handle.idx);
+				m_textureStreamSet.erase(_handle.idx);
+				m_textureResidentMemory -= ref.m_stream->m_residentSize;
+				textureStreamRelease(NULL, ref.m_stream);
+				ref.m_stream = NULL;
+			}
+
+			return true;
+		}
 
+		void textureDecRef(TextureHandle _handle)
+		{
+			if (textureRelease(_handle) )
+			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
 				cmdbuf.write(_handle);
 			}
 		}
 
+		BGFX_API_FUNC(void destroyResources(CommandBuffer::Enum _type, const uint16_t* _handles, uint16_t _num) )
+		{
+			if (0 == _num)
+			{
+				return;
+			}
+
+			// Handles are handles given to user, they are checked and queued
+			// for free individually, renderer resources are destroyed with
+			// single command.
+			const Memory* items = alloc(_num*sizeof(uint16_t) );
+			uint16_t* item = (uint16_t*)items->data;
+			uint16_t num = 0;
+
+			for (uint16_t ii = 0; ii < _num; ++ii)
+			{
+				switch (_type)
+				{
+				case CommandBuffer::DestroyIndexBuffer:
+					{
+						IndexBufferHandle handle = { m_indexBufferHandle.decode(_handles[ii]) };
+						if (m_indexBufferHandle.destroy(handle.idx) )
+						{
+							m_submit->free(handle);
+							memoryFree(handle);
+							item[num++] = handle.idx;
+						}
+						else
+						{
+							BX_WARN(false, "Index buffer handle %d is destroyed or stale!", _handles[ii]);
+						}
+					}
+					break;
+
+				case CommandBuffer::DestroyVertexBuffer:
+					{
+						VertexBufferHandle handle = { m_vertexBufferHandle.decode(_handles[ii]) };
+						if (m_vertexBufferHandle.destroy(handle.idx) )
+						{
+							m_submit->free(handle);
+							memoryFree(handle);
+							item[num++] = handle.idx;
+						}
+						else
+						{
+							BX_WARN(false, "Vertex buffer handle %d is destroyed or stale!", _handles[ii]);
+						}
+					}
+					break;
+
+				case CommandBuffer::DestroyTexture:
+					{
+						TextureHandle handle = { m_textureHandle.decode(_handles[ii]) };
+						if (isValid(handle)
+						&&  !m_textureRef[handle.idx].m_owned)
+						{
+							m_textureRef[handle.idx].m_owned = true;
+							if (textureRelease(handle) )
+							{
+								item[num++] = handle.idx;
+							}
+						}
+						else
+						{
+							BX_WARN(false, "Texture handle %d is destroyed or stale!", _handles[ii]);
+						}
+					}
+					break;
+
+				default:
+					BX_CHECK(false, "Invalid resource type %d.", _type);
+					break;
+				}
+			}
+
+			if (0 == num)
+			{
+				release(items);
+				return;
+			}
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyResources);
+			cmdbuf.write(uint8_t(_type) );
+			cmdbuf.write(num);
+			cmdbuf.write(items);
+		}
+
 		BGFX_API_FUNC(void updateTexture(
 			  TextureHandle _handle
 			, uint8_t _side
@@ -3549,8 +4778,13 @@ namespace bgfx
 		BGFX_API_FUNC(void destroyFrameBuffer(FrameBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyFrameBuffer", m_frameBufferHandle, _handle);
-			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-			BX_CHECK(ok, "Frame buffer handle %d is already destroyed!", _handle.idx);
+			if (!m_frameBufferHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Frame buffer handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
+			m_submit->free(_handle);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyFrameBuffer);
 			cmdbuf.write(_handle);
@@ -3581,7 +4815,7 @@ namespace bgfx
 			_num  = bx::uint16_max(1, _num);
 
 			uint16_t idx = m_uniformHashMap.find(bx::hashMurmur2A(_name) );
-			if (UniformHashMap::invalid != idx)
+			if (HandleHashMap::invalid != idx)
 			{
 				UniformHandle handle = { idx };
 				UniformRef& uniform = m_uniformRef[handle.idx];
@@ -3658,14 +4892,20 @@ namespace bgfx
 		{
 			BGFX_CHECK_HANDLE("destroyUniform", m_uniformHandle, _handle);
 
+			if (!m_uniformHandle.isAlive(_handle.idx) )
+			{
+				BX_WARN(false, "Uniform handle %d is already destroyed!", _handle.idx);
+				return;
+			}
+
 			UniformRef& uniform = m_uniformRef[_handle.idx];
 			BX_CHECK(uniform.m_refCount > 0, "Destroying already destroyed uniform %d.", _handle.idx);
 			int32_t refs = --uniform.m_refCount;
 
 			if (0 == refs)
 			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-				BX_CHECK(ok, "Uniform handle %d is already destroyed!", _handle.idx);
+				m_uniformHandle.destroy(_handle.idx);
+				m_submit->free(_handle);
 
 				uniform.m_name.clear();
 				m_uniformHashMap.removeByHandle(_handle.idx);
@@ -3711,6 +4951,11 @@ namespace bgfx
 		BGFX_API_FUNC(void destroyOcclusionQuery(OcclusionQueryHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE("destroyOcclusionQuery", m_occlusionQueryHandle, _handle);
+			if (!m_occlusionQueryHandle.destroy(_handle.idx) )
+			{
+				BX_WARN(false, "Occlusion query handle %d is already destroyed!", _handle.idx);
+				return;
+			}
 
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
@@ -4140,6 +5385,7 @@ namespace bgfx
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
 		void dumpViewStats();
+		void flushDynamicBufferUpdates();
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
 		void frameNoRenderWait();
@@ -4232,41 +5478,54 @@ namespace bgfx
 		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
 		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
 
-		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		ResourceArrayT<IndexBuffer>  m_indexBuffers;
+		ResourceArrayT<VertexBuffer> m_vertexBuffers;
 
-		DynamicIndexBuffer  m_dynamicIndexBuffers[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
-		DynamicVertexBuffer m_dynamicVertexBuffers[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
+		ResourceArrayT<DynamicIndexBuffer>  m_dynamicIndexBuffers;
+		ResourceArrayT<DynamicVertexBuffer> m_dynamicVertexBuffers;
 
 		uint16_t m_numFreeDynamicIndexBufferHandles;
 		uint16_t m_numFreeDynamicVertexBufferHandles;
 		uint16_t m_numFreeOcclusionQueryHandles;
-		DynamicIndexBufferHandle  m_freeDynamicIndexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
-		DynamicVertexBufferHandle m_freeDynamicVertexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
-		OcclusionQueryHandle      m_freeOcclusionQueryHandle[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+		ResourceArrayT<DynamicIndexBufferHandle>  m_freeDynamicIndexBufferHandle;
+		ResourceArrayT<DynamicVertexBufferHandle> m_freeDynamicVertexBufferHandle;
+		ResourceArrayT<OcclusionQueryHandle>      m_freeOcclusionQueryHandle;
+
+		uint32_t m_numDynamicBufferUpdatesQueued;
+		uint32_t m_dynamicBufferUpdateCount;
+		uint32_t m_dynamicBufferMergeCount;
+		uint32_t m_numDynamicBufferUpdates;
+		uint32_t m_numDynamicBufferUpdatesMerged;
+		DynamicBufferUpdate m_dynamicBufferUpdate[BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES];
+		DynamicBufferUpdate m_dynamicBufferUpdateRun[BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES];
+		uint64_t m_dynamicBufferUpdateKeys[BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES];
+		uint16_t m_dynamicBufferUpdateValues[BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES];
 
 		NonLocalAllocator m_dynIndexBufferAllocator;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS> m_dynamicIndexBufferHandle;
+		HandleAllocLimit m_dynamicIndexBufferHandle;
 		NonLocalAllocator m_dynVertexBufferAllocator;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferHandle;
+		HandleAllocLimit m_dynamicVertexBufferHandle;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_DECLS > m_vertexDeclHandle;
+		HandleAllocLimit m_indexBufferHandle;
+		HandleAllocLimit m_vertexDeclHandle;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_vertexBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_SHADERS> m_shaderHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_PROGRAMS> m_programHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_TEXTURES> m_textureHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		HandleAllocLimit m_vertexBufferHandle;
+		HandleAllocLimit m_shaderHandle;
+		HandleAllocLimit m_programHandle;
+		HandleAllocLimit m_textureHandle;
+		HandleAllocLimit m_frameBufferHandle;
+		HandleAllocLimit m_uniformHandle;
+		HandleAllocLimit m_occlusionQueryHandle;
 
 		struct ShaderRef
 		{
 			UniformHandle* m_uniforms;
 			uint32_t m_hash;
+			uint32_t m_binaryHash;
+			uint32_t m_size;
 			int16_t  m_refCount;
+			int16_t  m_userRefCount;
 			uint16_t m_num;
-			bool     m_owned;
 		};
 
 		struct ProgramRef
@@ -4284,12 +5543,33 @@ namespace bgfx
 			int16_t           m_refCount;
 		};
 
+		struct TextureStream
+		{
+			void*    m_data;
+			uint32_t m_size;
+			uint32_t m_flags;
+			int32_t  m_refCount;
+			uint32_t m_residentSize;
+			uint16_t m_width;
+			uint16_t m_height;
+			uint16_t m_depth;
+			uint16_t m_numLayers;
+			bool     m_cubeMap;
+			uint8_t  m_format;
+			uint8_t  m_numMips;
+			uint8_t  m_residentMip;
+			uint8_t  m_targetMip;
+		};
+
 		struct TextureRef
 		{
+			TextureStream* m_stream;
+			uint32_t m_storageSize;
 			int16_t m_refCount;
 			uint8_t m_bbRatio;
 			uint8_t m_format;
 			uint8_t m_numMips;
+			uint8_t m_memory;
 			bool    m_owned;
 		};
 
@@ -4306,19 +5586,19 @@ namespace bgfx
 		typedef stl::unordered_set<uint16_t> HandleSet;
 		HandleSet m_uniformSet;
 		HandleSet m_occlusionQuerySet;
+		HandleSet m_textureStreamSet;
 
-		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
-		UniformHashMap m_uniformHashMap;
-		UniformRef m_uniformRef[BGFX_CONFIG_MAX_UNIFORMS];
+		HandleHashMap m_uniformHashMap;
+		ResourceArrayT<UniformRef> m_uniformRef;
 
-		ShaderRef m_shaderRef[BGFX_CONFIG_MAX_SHADERS];
+		HandleHashMap m_shaderHashMap;
+		ResourceArrayT<ShaderRef> m_shaderRef;
 
-		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_PROGRAMS*2> ProgramHashMap;
-		ProgramHashMap m_programHashMap;
-		ProgramRef m_programRef[BGFX_CONFIG_MAX_PROGRAMS];
+		HandleHashMap m_programHashMap;
+		ResourceArrayT<ProgramRef> m_programRef;
 
-		TextureRef m_textureRef[BGFX_CONFIG_MAX_TEXTURES];
-		FrameBufferRef m_frameBufferRef[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<TextureRef> m_textureRef;
+		ResourceArrayT<FrameBufferRef> m_frameBufferRef;
 		VertexDeclRef m_declRef;
 
 		uint8_t m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
@@ -4354,6 +5634,15 @@ namespace bgfx
 		bool m_singleThreaded;
 		bool m_flipped;
 
+		uint64_t m_textureResidentMemory;
+		uint64_t m_textureStreamingBudget;
+		uint32_t m_numTextureStream;
+		uint32_t m_numTextureStreamed;
+
+		int64_t  m_memoryUsed[ResourceMemory::Count];
+		uint32_t m_transientVbUsed;
+		uint32_t m_transientIbUsed;
+
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
 	};
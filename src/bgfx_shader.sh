@@ -487,6 +487,30 @@ uniform mat4  u_modelViewProj;
 uniform vec4  u_alphaRef4;
 #define u_alphaRef u_alphaRef4.x
 
+// Per-draw data (BGFX_CAPS_DRAW_DATA). Declare it with DRAW_DATA_BUFFER and
+// read it with drawModel()/drawParams(). Draws batched by multi-draw can
+// then differ in transform and u_drawParams. On other shading languages the
+// same shader falls back to u_model[0] and u_drawParams uniform.
+#if BGFX_SHADER_TYPE_VERTEX && BGFX_SHADER_LANGUAGE_GLSL >= 120
+// Binding must match BGFX_CONFIG_DRAW_DATA_BINDING.
+#	define DRAW_DATA_BUFFER \
+			struct DrawData \
+			{ \
+				mat4 model; \
+				vec4 params; \
+			}; \
+			layout(std430, binding=15) readonly buffer u_drawDataBuffer \
+			{ \
+				DrawData u_drawData[]; \
+			}
+#	define drawModel()  u_drawData[gl_DrawIDARB].model
+#	define drawParams() u_drawData[gl_DrawIDARB].params
+#else
+#	define DRAW_DATA_BUFFER uniform vec4 u_drawParams
+#	define drawModel()  u_model[0]
+#	define drawParams() u_drawParams
+#endif // BGFX_SHADER_TYPE_VERTEX && BGFX_SHADER_LANGUAGE_GLSL >= 120
+
 #endif // __cplusplus
 
 #endif // BGFX_SHADER_H_HEADER_GUARD
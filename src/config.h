@@ -163,6 +163,13 @@
 #	define BGFX_CONFIG_DEBUG_OBJECT_NAME BGFX_CONFIG_DEBUG
 #endif // BGFX_CONFIG_DEBUG_OBJECT_NAME
 
+/// Enable allocation serial in bits above index of handles given to user,
+/// which detects stale handles whose index was reused. Handle values are
+/// plain indices when disabled.
+#ifndef BGFX_CONFIG_DEBUG_HANDLE_SERIAL
+#	define BGFX_CONFIG_DEBUG_HANDLE_SERIAL BGFX_CONFIG_DEBUG
+#endif // BGFX_CONFIG_DEBUG_HANDLE_SERIAL
+
 /// Enable Metal markers.
 #ifndef BGFX_CONFIG_DEBUG_MTL
 #	define BGFX_CONFIG_DEBUG_MTL BGFX_CONFIG_DEBUG
@@ -198,6 +205,14 @@
 #	define BGFX_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  BGFX_CONFIG_MAX_RECT_CACHE
 
+#ifndef BGFX_CONFIG_MAX_VAO_CACHE
+#	define BGFX_CONFIG_MAX_VAO_CACHE (4<<10)
+#endif // BGFX_CONFIG_MAX_VAO_CACHE
+
+#ifndef BGFX_CONFIG_MAX_SAMPLER_CACHE
+#	define BGFX_CONFIG_MAX_SAMPLER_CACHE 1024
+#endif // BGFX_CONFIG_MAX_SAMPLER_CACHE
+
 #ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH
 #	define BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH 32
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH
@@ -256,6 +271,12 @@
 #	define BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE (3<<20)
 #endif // BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE
 
+/// Maximum number of dynamic index and vertex buffer updates queued per
+/// frame before they are coalesced and submitted.
+#ifndef BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES
+#	define BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES (4<<10)
+#endif // BGFX_CONFIG_MAX_DYNAMIC_BUFFER_UPDATES
+
 #ifndef BGFX_CONFIG_MAX_SHADERS
 #	define BGFX_CONFIG_MAX_SHADERS 512
 #endif // BGFX_CONFIG_MAX_FRAGMENT_SHADERS
@@ -306,6 +327,32 @@
 
 #define BGFX_CONFIG_DRAW_INDIRECT_STRIDE 32
 
+#ifndef BGFX_CONFIG_MAX_MULTI_DRAW_BATCH
+#	define BGFX_CONFIG_MAX_MULTI_DRAW_BATCH 256
+#endif // BGFX_CONFIG_MAX_MULTI_DRAW_BATCH
+
+/// Shader storage buffer binding of per-draw data. It must match binding
+/// used by DRAW_DATA_BUFFER in bgfx_shader.sh, and programs reading draw
+/// data can't bind compute buffer to the same stage.
+#define BGFX_CONFIG_DRAW_DATA_BINDING 15
+
+/// Size of streaming uniform buffer used by OpenGL 3.1+/OpenGL ES 3.0
+/// renderer. Set to 0 to disable uniform buffer objects.
+#ifndef BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE
+#	define BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE (1<<20)
+#endif // BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE
+
+/// Default memory budget for resident mips of streaming textures.
+#ifndef BGFX_CONFIG_TEXTURE_STREAMING_BUDGET
+#	define BGFX_CONFIG_TEXTURE_STREAMING_BUDGET (UINT64_C(256)<<20)
+#endif // BGFX_CONFIG_TEXTURE_STREAMING_BUDGET
+
+/// Maximum number of bytes streaming textures re-upload per frame. At least
+/// one residency change is always issued per frame.
+#ifndef BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_SIZE
+#	define BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_SIZE (8<<20)
+#endif // BGFX_CONFIG_TEXTURE_STREAMING_UPLOAD_SIZE
+
 #ifndef BGFX_CONFIG_PROFILER_MICROPROFILE
 #	define BGFX_CONFIG_PROFILER_MICROPROFILE 0
 #endif // BGFX_CONFIG_PROFILER_MICROPROFILE
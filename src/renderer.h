@@ -305,6 +305,155 @@ namespace bgfx
 		uint16_t m_invViewProjCached;
 	};
 
+	struct StateTracker
+	{
+		struct Bind
+		{
+			enum Enum
+			{
+				Program,
+				Texture,
+				Buffer,
+				State,
+
+				Count
+			};
+		};
+
+		StateTracker()
+		{
+			invalidate();
+			bx::memSet(m_numFiltered, 0, sizeof(m_numFiltered) );
+		}
+
+		void invalidate()
+		{
+			m_bindMask    = 0;
+			m_bindHash    = 0;
+			m_program     = UINT32_MAX;
+			m_indexBuffer = UINT32_MAX;
+			m_stateValid  = false;
+		}
+
+		void invalidateProgram()
+		{
+			m_program = UINT32_MAX;
+		}
+
+		void invalidateBindings()
+		{
+			m_bindMask = 0;
+			m_bindHash = 0;
+		}
+
+		void invalidateBinding(uint8_t _stage)
+		{
+			m_bindMask &= ~(UINT32_C(1)<<_stage);
+			m_bindHash  = 0;
+		}
+
+		void invalidateIndexBuffer()
+		{
+			m_indexBuffer = UINT32_MAX;
+		}
+
+		bool setProgram(uint16_t _program)
+		{
+			if (m_program == _program)
+			{
+				++m_numFiltered[Bind::Program];
+				return false;
+			}
+
+			m_program = _program;
+			return true;
+		}
+
+		bool setBinding(uint8_t _stage, const Binding& _bind)
+		{
+			const uint32_t bit = UINT32_C(1)<<_stage;
+			Binding& current = m_bind[_stage];
+
+			if (0 != (m_bindMask & bit)
+			&&  current.m_idx == _bind.m_idx
+			&& (invalidHandle == _bind.m_idx
+			|| (current.m_type == _bind.m_type
+			&&  current.m_un.m_draw.m_textureFlags == _bind.m_un.m_draw.m_textureFlags) ) )
+			{
+				++m_numFiltered[Bind::Texture];
+				return false;
+			}
+
+			m_bindMask |= bit;
+			current = _bind;
+			return true;
+		}
+
+		bool setBindHash(uint32_t _hash)
+		{
+			if (0 != m_bindHash
+			&&  m_bindHash == _hash)
+			{
+				++m_numFiltered[Bind::Texture];
+				return false;
+			}
+
+			m_bindHash = _hash;
+			return true;
+		}
+
+		bool setIndexBuffer(IndexBufferHandle _handle)
+		{
+			if (m_indexBuffer == _handle.idx)
+			{
+				++m_numFiltered[Bind::Buffer];
+				return false;
+			}
+
+			m_indexBuffer = _handle.idx;
+			return true;
+		}
+
+		bool setState(uint64_t _stateFlags, uint64_t _stencil, uint32_t _rgba)
+		{
+			if (m_stateValid
+			&&  m_stateFlags == _stateFlags
+			&&  m_stencil    == _stencil
+			&&  m_rgba       == _rgba)
+			{
+				++m_numFiltered[Bind::State];
+				return false;
+			}
+
+			m_stateValid = true;
+			m_stateFlags = _stateFlags;
+			m_stencil    = _stencil;
+			m_rgba       = _rgba;
+			return true;
+		}
+
+		void getStats(Stats& _stats) const
+		{
+			_stats.numFilteredProgram = m_numFiltered[Bind::Program];
+			_stats.numFilteredTexture = m_numFiltered[Bind::Texture];
+			_stats.numFilteredBuffer  = m_numFiltered[Bind::Buffer];
+			_stats.numFilteredState   = m_numFiltered[Bind::State];
+		}
+
+		BX_STATIC_ASSERT(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS <= 32);
+
+		Binding  m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+		uint64_t m_stateFlags;
+		uint64_t m_stencil;
+		uint32_t m_rgba;
+		uint32_t m_bindMask;
+		uint32_t m_bindHash;
+		uint32_t m_program;
+		uint32_t m_indexBuffer;
+		uint32_t m_numFiltered[Bind::Count];
+		bool     m_stateValid;
+	};
+
 	template<typename Ty>
 	inline void release(Ty)
 	{
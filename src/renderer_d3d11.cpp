@@ -708,7 +708,6 @@ namespace bgfx { namespace d3d11
 			m_fbh.idx = invalidHandle;
 			bx::memSet(&m_adapterDesc, 0, sizeof(m_adapterDesc) );
 			bx::memSet(&m_scd, 0, sizeof(m_scd) );
-			bx::memSet(&m_windows, 0xff, sizeof(m_windows) );
 		}
 
 		~RendererContextD3D11()
@@ -743,7 +742,18 @@ namespace bgfx { namespace d3d11
 			}
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
+			const FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			m_windows.create(g_caps.limits.maxFrameBuffers);
+			m_windows.fill(invalid);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			m_ags = NULL;
@@ -1750,27 +1760,27 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 			invalidateCache();
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_shaders); ++ii)
+			for (uint32_t ii = 0; ii < m_shaders.getNum(); ++ii)
 			{
 				m_shaders[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].destroy();
 			}
@@ -2247,7 +2257,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 				DX_RELEASE(m_backBufferColor, 0);
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].preReset();
 			}
@@ -2320,7 +2330,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 			m_currentColor = m_backBufferColor;
 			m_currentDepthStencil = m_backBufferDepthStencil;
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].postReset();
 			}
@@ -3653,7 +3663,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		bool m_needPresent;
 		bool m_lost;
 		uint16_t m_numWindows;
-		FrameBufferHandle m_windows[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<FrameBufferHandle> m_windows;
 
 		ID3D11Device*        m_device;
 		ID3D11DeviceContext* m_deviceCtx;
@@ -3684,14 +3694,14 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		bool m_depthClamp;
 		bool m_wireframe;
 
-		IndexBufferD3D11 m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferD3D11 m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderD3D11 m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramD3D11 m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureD3D11 m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexDecl m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		FrameBufferD3D11 m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<IndexBufferD3D11> m_indexBuffers;
+		ResourceArrayT<VertexBufferD3D11> m_vertexBuffers;
+		ResourceArrayT<ShaderD3D11> m_shaders;
+		ResourceArrayT<ProgramD3D11> m_program;
+		ResourceArrayT<TextureD3D11> m_textures;
+		ResourceArrayT<VertexDecl> m_vertexDecls;
+		ResourceArrayT<FrameBufferD3D11> m_frameBuffers;
+		ResourceArrayT<void*> m_uniforms;
 		Matrix4 m_predefinedUniforms[PredefinedUniform::Count];
 		UniformRegistry m_uniformReg;
 
@@ -5495,8 +5505,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
-		RenderBind currentBind;
-		currentBind.clear();
+		StateTracker stateTracker;
 
 		_render->m_hmdInitialized = m_ovr.isInitialized();
 
@@ -5511,7 +5520,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		uint16_t programIdx = invalidHandle;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 
 		BlitState bs(_render);
 
@@ -5521,6 +5530,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		deviceCtx->IASetPrimitiveTopology(prim.m_type);
 
 		bool wasCompute = false;
+		bool resetState = false;
 		bool viewHasScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
@@ -5823,7 +5833,14 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					continue;
 				}
 
-				bool resetState = viewChanged || wasCompute;
+				// Reset is kept pending until draw that is not occlusion
+				// culled, so that first visible draw sets all state.
+				if (viewChanged
+				||  wasCompute)
+				{
+					resetState = true;
+					stateTracker.invalidate();
+				}
 
 				if (wasCompute)
 				{
@@ -5863,6 +5880,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 				if (resetState)
 				{
+					resetState = false;
 					wasCompute = false;
 
 					currentState.clear();
@@ -5872,8 +5890,6 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					currentState.m_stateFlags = newFlags;
 					currentState.m_stencil    = newStencil;
 
-					currentBind.clear();
-
 					setBlendState(newFlags);
 					setDepthStencilState(newFlags, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT) );
 
@@ -5926,6 +5942,12 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					setRasterizerState(newFlags, wireframe, scissorEnabled);
 				}
 
+				if (!stateTracker.setState(newFlags, newStencil, draw.m_rgba) )
+				{
+					changedFlags   = 0;
+					changedStencil = 0;
+				}
+
 				if (BGFX_D3D11_DEPTH_STENCIL_MASK & changedFlags)
 				{
 					setDepthStencilState(newFlags, newStencil);
@@ -5976,7 +5998,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
 				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
 
-				if (key.m_program != programIdx)
+				if (stateTracker.setProgram(key.m_program) )
 				{
 					programIdx = key.m_program;
 
@@ -6046,11 +6068,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 					{
 						const Binding& bind = renderBind.m_bind[stage];
-						Binding& current = currentBind.m_bind[stage];
-						if (current.m_idx != bind.m_idx
-						||  current.m_type != bind.m_type
-						||  current.m_un.m_draw.m_textureFlags != bind.m_un.m_draw.m_textureFlags
-						||  programChanged)
+						if (stateTracker.setBinding(stage, bind) )
 						{
 							if (invalidHandle != bind.m_idx)
 							{
@@ -6084,8 +6102,6 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 							++changes;
 						}
-
-						current = bind;
 					}
 
 					if (0 < changes)
@@ -6166,7 +6182,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 					}
 				}
 
-				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				if (stateTracker.setIndexBuffer(draw.m_indexBuffer) )
 				{
 					currentState.m_indexBuffer = draw.m_indexBuffer;
 
@@ -6401,6 +6417,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
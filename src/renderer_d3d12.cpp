@@ -543,7 +543,18 @@ namespace bgfx { namespace d3d12
 			setGraphicsDebuggerPresent(NULL != m_renderdocdll);
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
+			const FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			m_windows.create(g_caps.limits.maxFrameBuffers);
+			m_windows.fill(invalid);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 #if USE_D3D12_DYNAMIC_LIB
@@ -956,7 +967,7 @@ namespace bgfx { namespace d3d12
 				D3D12_DESCRIPTOR_HEAP_DESC rtvDescHeap;
 				rtvDescHeap.NumDescriptors = 0
 						+ BX_COUNTOF(m_backBufferColor)
-						+ BGFX_CONFIG_MAX_FRAME_BUFFERS*BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
+						+ g_caps.limits.maxFrameBuffers*BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
 						;
 				rtvDescHeap.Type     = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
 				rtvDescHeap.Flags    = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
@@ -969,7 +980,7 @@ namespace bgfx { namespace d3d12
 				D3D12_DESCRIPTOR_HEAP_DESC dsvDescHeap;
 				dsvDescHeap.NumDescriptors = 0
 						+ 1 // reserved for depth backbuffer.
-						+ BGFX_CONFIG_MAX_FRAME_BUFFERS
+						+ g_caps.limits.maxFrameBuffers
 						;
 				dsvDescHeap.Type     = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
 				dsvDescHeap.Flags    = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
@@ -982,7 +993,7 @@ namespace bgfx { namespace d3d12
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
 					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-							, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+							, g_caps.limits.maxTextures + g_caps.limits.maxShaders + BGFX_CONFIG_MAX_DRAW_CALLS
 							);
 				}
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
@@ -1250,22 +1261,22 @@ namespace bgfx { namespace d3d12
 
 			m_pipelineStateCache.invalidate();
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_shaders); ++ii)
+			for (uint32_t ii = 0; ii < m_shaders.getNum(); ++ii)
 			{
 				m_shaders[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].destroy();
 			}
@@ -1795,7 +1806,7 @@ namespace bgfx { namespace d3d12
 			}
 			DX_RELEASE(m_backBufferDepthStencil, 0);
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].preReset();
 			}
@@ -1856,7 +1867,7 @@ namespace bgfx { namespace d3d12
 				, m_dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart()
 				);
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].postReset();
 			}
@@ -2872,7 +2883,7 @@ data.NumQualityLevels = 0;
 
 		int64_t m_presentElapsed;
 		uint16_t m_numWindows;
-		FrameBufferHandle m_windows[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<FrameBufferHandle> m_windows;
 
 		ID3D12Device*       m_device;
 		TimerQueryD3D12     m_gpuTimer;
@@ -2909,14 +2920,14 @@ data.NumQualityLevels = 0;
 		uint32_t m_maxAnisotropy;
 		bool m_depthClamp;
 
-		BufferD3D12 m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferD3D12 m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderD3D12 m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramD3D12 m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureD3D12 m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexDecl m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		FrameBufferD3D12 m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<BufferD3D12> m_indexBuffers;
+		ResourceArrayT<VertexBufferD3D12> m_vertexBuffers;
+		ResourceArrayT<ShaderD3D12> m_shaders;
+		ResourceArrayT<ProgramD3D12> m_program;
+		ResourceArrayT<TextureD3D12> m_textures;
+		ResourceArrayT<VertexDecl> m_vertexDecls;
+		ResourceArrayT<FrameBufferD3D12> m_frameBuffers;
+		ResourceArrayT<void*> m_uniforms;
 		Matrix4 m_predefinedUniforms[PredefinedUniform::Count];
 		UniformRegistry m_uniformReg;
 
@@ -4732,7 +4743,7 @@ data.NumQualityLevels = 0;
 	void OcclusionQueryD3D12::init()
 	{
 		D3D12_QUERY_HEAP_DESC queryHeapDesc;
-		queryHeapDesc.Count    = BX_COUNTOF(m_handle);
+		queryHeapDesc.Count    = g_caps.limits.maxOcclusionQueries;
 		queryHeapDesc.NodeMask = 1;
 		queryHeapDesc.Type     = D3D12_QUERY_HEAP_TYPE_OCCLUSION;
 		DX_CHECK(s_renderD3D12->m_device->CreateQueryHeap(&queryHeapDesc
@@ -4740,7 +4751,7 @@ data.NumQualityLevels = 0;
 				, (void**)&m_queryHeap
 				) );
 
-		const uint32_t size = BX_COUNTOF(m_handle)*sizeof(uint64_t);
+		const uint32_t size = g_caps.limits.maxOcclusionQueries*sizeof(uint64_t);
 		m_readback = createCommittedResource(s_renderD3D12->m_device
 						, HeapProperty::ReadBack
 						, size
@@ -4946,9 +4957,12 @@ data.NumQualityLevels = 0;
 		bool     hasPredefined          = false;
 		bool     commandListChanged     = false;
 		ID3D12PipelineState* currentPso = NULL;
+		uint16_t currentDeclIdx         = invalidHandle;
+		uint8_t  currentNumInstanceData = 0;
+		StateTracker stateTracker;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 
 		BlitState bs(_render);
 
@@ -5232,24 +5246,8 @@ data.NumQualityLevels = 0;
 					continue;
 				}
 
-				const RenderDraw& draw = renderItem.draw;
-
-				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
-				if (isValid(draw.m_occlusionQuery)
-				&&  !hasOcclusionQuery
-				&&  !isVisible(_render, draw.m_occlusionQuery, 0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) ) )
-				{
-					continue;
-				}
-
-				const uint64_t newFlags = draw.m_stateFlags;
-				uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
-				currentState.m_stateFlags = newFlags;
-
-				const uint64_t newStencil = draw.m_stencil;
-				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
-				currentState.m_stencil = newStencil;
-
+				// Reset is kept pending until draw that is not occlusion
+				// culled, so that first visible draw sets all state.
 				if (viewChanged
 				||  wasCompute)
 				{
@@ -5270,6 +5268,24 @@ data.NumQualityLevels = 0;
 					commandListChanged = true;
 				}
 
+				const RenderDraw& draw = renderItem.draw;
+
+				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
+				if (isValid(draw.m_occlusionQuery)
+				&&  !hasOcclusionQuery
+				&&  !isVisible(_render, draw.m_occlusionQuery, 0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) ) )
+				{
+					continue;
+				}
+
+				const uint64_t newFlags = draw.m_stateFlags;
+				uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+				currentState.m_stateFlags = newFlags;
+
+				const uint64_t newStencil = draw.m_stencil;
+				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
+				currentState.m_stencil = newStencil;
+
 				if (commandListChanged)
 				{
 					commandListChanged = false;
@@ -5293,6 +5309,7 @@ data.NumQualityLevels = 0;
 					currentState.m_stencil    = newStencil;
 
 					currentBind.clear();
+					stateTracker.invalidate();
 
 					const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
@@ -5313,17 +5330,34 @@ data.NumQualityLevels = 0;
 					const VertexBufferD3D12& vb = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
 					uint16_t declIdx = !isValid(vb.m_decl) ? draw.m_stream[0].m_decl.idx : vb.m_decl.idx;
 
-					ID3D12PipelineState* pso =
-						getPipelineState(state
+					// Pipeline state lookup is skipped when nothing it depends
+					// on changed since previous draw.
+					const uint8_t numInstanceData = uint8_t(draw.m_instanceDataStride/16);
+					const bool stateChanged   = stateTracker.setState(state, draw.m_stencil, draw.m_rgba);
+					const bool programChanged = stateTracker.setProgram(key.m_program);
+
+					ID3D12PipelineState* pso = currentPso;
+					if (NULL == pso
+					||  stateChanged
+					||  programChanged
+					||  currentDeclIdx         != declIdx
+					||  currentNumInstanceData != numInstanceData)
+					{
+						currentDeclIdx         = declIdx;
+						currentNumInstanceData = numInstanceData;
+
+						pso = getPipelineState(state
 							, draw.m_stencil
 							, declIdx
 							, key.m_program
-							, uint8_t(draw.m_instanceDataStride/16)
+							, numInstanceData
 							);
+					}
 
 					uint16_t scissor = draw.m_scissor;
 					uint32_t bindHash = bx::hashMurmur2A(renderBind.m_bind, sizeof(renderBind.m_bind) );
-					if (currentBindHash != bindHash
+					const bool bindChanged = stateTracker.setBindHash(bindHash);
+					if (bindChanged
 					||  0 != changedStencil
 					|| (hasFactor && blendFactor != draw.m_rgba)
 					|| (0 != (BGFX_STATE_PT_MASK & changedFlags)
@@ -5335,7 +5369,7 @@ data.NumQualityLevels = 0;
 						m_batch.flush(m_commandList);
 					}
 
-					if (currentBindHash != bindHash)
+					if (bindChanged)
 					{
 						currentBindHash  = bindHash;
 
@@ -5604,6 +5638,7 @@ data.NumQualityLevels = 0;
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
@@ -413,7 +413,18 @@ namespace bgfx { namespace d3d9
 			ErrorState::Enum errorState = ErrorState::Default;
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
+			const FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			m_windows.create(g_caps.limits.maxFrameBuffers);
+			m_windows.fill(invalid);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			D3DFORMAT adapterFormat = D3DFMT_X8R8G8B8;
@@ -923,22 +934,22 @@ namespace bgfx { namespace d3d9
 		{
 			preReset();
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_shaders); ++ii)
+			for (uint32_t ii = 0; ii < m_shaders.getNum(); ++ii)
 			{
 				m_shaders[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].destroy();
 			}
@@ -1644,22 +1655,22 @@ namespace bgfx { namespace d3d9
 				m_occlusionQuery.preReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].preReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].preReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].preReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].preReset();
 			}
@@ -1684,22 +1695,22 @@ namespace bgfx { namespace d3d9
 
 			capturePostReset();
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].postReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].postReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].postReset();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].postReset();
 			}
@@ -2221,7 +2232,7 @@ namespace bgfx { namespace d3d9
 
 		bool m_needPresent;
 		uint16_t m_numWindows;
-		FrameBufferHandle m_windows[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<FrameBufferHandle> m_windows;
 
 		IDirect3DSurface9* m_backBufferColor;
 		IDirect3DSurface9* m_backBufferDepthStencil;
@@ -2250,15 +2261,15 @@ namespace bgfx { namespace d3d9
 
 		D3DFORMAT m_fmtDepth;
 
-		IndexBufferD3D9 m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferD3D9 m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderD3D9 m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramD3D9 m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureD3D9 m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexDecl m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		FrameBufferD3D9 m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<IndexBufferD3D9> m_indexBuffers;
+		ResourceArrayT<VertexBufferD3D9> m_vertexBuffers;
+		ResourceArrayT<ShaderD3D9> m_shaders;
+		ResourceArrayT<ProgramD3D9> m_program;
+		ResourceArrayT<TextureD3D9> m_textures;
+		ResourceArrayT<VertexDecl> m_vertexDecls;
+		ResourceArrayT<FrameBufferD3D9> m_frameBuffers;
 		UniformRegistry m_uniformReg;
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<void*> m_uniforms;
 
 		uint32_t m_samplerFlags[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 
@@ -3724,8 +3735,7 @@ namespace bgfx { namespace d3d9
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
-		RenderBind currentBind;
-		currentBind.clear();
+		StateTracker stateTracker;
 
 		ViewState viewState(_render, false);
 
@@ -3733,7 +3743,7 @@ namespace bgfx { namespace d3d9
 		uint16_t programIdx = invalidHandle;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 		uint32_t blendFactor = 0;
 
 		BlitState bs(_render);
@@ -3805,6 +3815,8 @@ namespace bgfx { namespace d3d9
 					currentState.m_stateFlags = newFlags;
 					currentState.m_stencil    = newStencil;
 
+					stateTracker.invalidate();
+
 					PIX_ENDEVENT();
 					PIX_BEGINEVENT(D3DCOLOR_VIEW, s_viewNameW[key.m_view]);
 					if (item > 0)
@@ -3890,6 +3902,12 @@ namespace bgfx { namespace d3d9
 					}
 				}
 
+				if (!stateTracker.setState(newFlags, newStencil, draw.m_rgba) )
+				{
+					changedFlags   = 0;
+					changedStencil = 0;
+				}
+
 				if (0 != changedStencil)
 				{
 					bool enable = 0 != newStencil;
@@ -4081,7 +4099,7 @@ namespace bgfx { namespace d3d9
 				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
 				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
 
-				if (key.m_program != programIdx)
+				if (stateTracker.setProgram(key.m_program) )
 				{
 					programIdx = key.m_program;
 
@@ -4127,11 +4145,8 @@ namespace bgfx { namespace d3d9
 					for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 					{
 						const Binding& bind = renderBind.m_bind[stage];
-						Binding& current = currentBind.m_bind[stage];
 
-						if (current.m_idx != bind.m_idx
-						||  current.m_un.m_draw.m_textureFlags != bind.m_un.m_draw.m_textureFlags
-						||  programChanged)
+						if (stateTracker.setBinding(stage, bind) )
 						{
 							if (invalidHandle != bind.m_idx)
 							{
@@ -4142,8 +4157,6 @@ namespace bgfx { namespace d3d9
 								DX_CHECK(device->SetTexture(stage, NULL) );
 							}
 						}
-
-						current = bind;
 					}
 				}
 
@@ -4225,7 +4238,7 @@ namespace bgfx { namespace d3d9
 					}
 				}
 
-				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				if (stateTracker.setIndexBuffer(draw.m_indexBuffer) )
 				{
 					currentState.m_indexBuffer = draw.m_indexBuffer;
 
@@ -4377,6 +4390,7 @@ namespace bgfx { namespace d3d9
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
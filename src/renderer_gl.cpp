@@ -86,6 +86,36 @@ namespace bgfx { namespace gl
 	};
 	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT == BX_COUNTOF(s_instanceDataName) );
 
+	static const char* s_uniformBlockName[] =
+	{
+		"bgfx_VertexUniforms",
+		"bgfx_FragmentUniforms",
+	};
+	BX_STATIC_ASSERT(ProgramGL::UniformBlock::Count == BX_COUNTOF(s_uniformBlockName) );
+
+	static const char* s_uniformBlockInstance[] =
+	{
+		"bgfx_vu",
+		"bgfx_fu",
+	};
+	BX_STATIC_ASSERT(ProgramGL::UniformBlock::Count == BX_COUNTOF(s_uniformBlockInstance) );
+
+	// Uniforms living in uniform block are addressed by block index and
+	// std140 byte offset, encoded in place of uniform location.
+	static const uint32_t s_uniformBlockLoc = UINT32_C(0x80000000);
+
+	inline uint32_t toUniformBlockLoc(uint32_t _block, uint32_t _offset)
+	{
+		return s_uniformBlockLoc | (_block<<24) | _offset;
+	}
+
+	inline bool isUniformBlockLoc(uint32_t _loc)
+	{
+		return UINT32_MAX != _loc
+			&& 0 != (_loc & s_uniformBlockLoc)
+			;
+	}
+
 	static const GLenum s_access[] =
 	{
 		GL_READ_ONLY,
@@ -496,6 +526,7 @@ namespace bgfx { namespace gl
 			ARB_sampler_objects,
 			ARB_seamless_cube_map,
 			ARB_shader_bit_encoding,
+			ARB_shader_draw_parameters,
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
@@ -709,6 +740,7 @@ namespace bgfx { namespace gl
 		{ "ARB_sampler_objects",                      BGFX_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_seamless_cube_map",                    BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_shader_bit_encoding",                  BGFX_CONFIG_RENDERER_OPENGL >= 33, true  },
+		{ "ARB_shader_draw_parameters",               BGFX_CONFIG_RENDERER_OPENGL >= 46, true  },
 		{ "ARB_shader_image_load_store",              BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
@@ -1433,6 +1465,8 @@ namespace bgfx { namespace gl
 	{
 		RendererContextGL()
 			: m_numWindows(1)
+			, m_numUniformBlockUpload(0)
+			, m_currentProgram(NULL)
 			, m_rtMsaa(false)
 			, m_fbDiscard(BGFX_CLEAR_NONE)
 			, m_capture(NULL)
@@ -1455,12 +1489,16 @@ namespace bgfx { namespace gl
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
+			, m_multiDrawSupport(false)
+			, m_drawDataSupport(false)
+			, m_uniformBufferSupport(false)
 			, m_flip(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
 			, m_msaaBackBufferFbo(0)
 		{
 			bx::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			bx::memSet(m_uniformBlockBound, 0xff, sizeof(m_uniformBlockBound) );
 		}
 
 		~RendererContextGL()
@@ -1472,7 +1510,18 @@ namespace bgfx { namespace gl
 			m_renderdocdll = loadRenderDoc();
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
+			const FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			m_windows.create(g_caps.limits.maxFrameBuffers);
+			m_windows.fill(invalid);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			setRenderContextSize(BGFX_DEFAULT_WIDTH, BGFX_DEFAULT_HEIGHT);
@@ -1965,6 +2014,42 @@ namespace bgfx { namespace gl
 				: 0
 				;
 
+			m_multiDrawSupport = false
+				|| s_extension[Extension::AMD_multi_draw_indirect].m_supported
+				|| s_extension[Extension::ARB_multi_draw_indirect].m_supported
+				|| s_extension[Extension::EXT_multi_draw_indirect].m_supported
+				;
+
+			if (m_multiDrawSupport
+			&&  s_extension[Extension::ARB_shader_draw_parameters      ].m_supported
+			&&  s_extension[Extension::ARB_shader_storage_buffer_object].m_supported
+			&&  s_extension[Extension::ARB_program_interface_query     ].m_supported)
+			{
+				GLint maxVertexBlocks = 0;
+				GLint maxBindings     = 0;
+				GL_CHECK(glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS,   &maxVertexBlocks) );
+				GL_CHECK(glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &maxBindings) );
+
+				m_drawDataSupport = true
+					&& 0 < maxVertexBlocks
+					&& BGFX_CONFIG_DRAW_DATA_BINDING < maxBindings
+					;
+
+				g_caps.supported |= m_drawDataSupport
+					? BGFX_CAPS_DRAW_DATA
+					: 0
+					;
+			}
+
+			m_uniformBufferSupport = true
+				&& 0 != BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE
+				&& (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30) || s_extension[Extension::ARB_uniform_buffer_object].m_supported)
+				&& (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30) || BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL >= 31) )
+				&& NULL != glGetUniformBlockIndex
+				&& NULL != glUniformBlockBinding
+				&& NULL != glGetActiveUniformsiv
+				;
+
 			if (NULL == glPolygonMode)
 			{
 				glPolygonMode = stubPolygonMode;
@@ -2232,6 +2317,26 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.create();
 			}
 
+			if (m_multiDrawSupport)
+			{
+				m_multiDraw.create();
+			}
+
+			if (m_drawDataSupport)
+			{
+				GLint align = 16;
+				GL_CHECK(glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &align) );
+				m_drawData.create(uint32_t(align) );
+			}
+
+			if (m_uniformBufferSupport)
+			{
+				GLint align = 16;
+				GL_CHECK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align) );
+				m_uniformRing.create(BGFX_CONFIG_UNIFORM_BUFFER_RING_SIZE, uint32_t(align) );
+				invalidateUniformBlocks();
+			}
+
 			// Init reserved part of view name.
 			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 			{
@@ -2273,6 +2378,21 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			if (m_multiDrawSupport)
+			{
+				m_multiDraw.destroy();
+			}
+
+			if (m_drawDataSupport)
+			{
+				m_drawData.destroy();
+			}
+
+			if (m_uniformBufferSupport)
+			{
+				m_uniformRing.destroy();
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -2645,17 +2765,19 @@ namespace bgfx { namespace gl
 			GL_CHECK(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE) );
 
 			ProgramGL& program = m_program[_blitter.m_program.idx];
+			m_currentProgram = &program;
 			GL_CHECK(glUseProgram(program.m_id) );
 			GL_CHECK(glUniform1i(program.m_sampler[0], 0) );
 
 			float proj[16];
 			bx::mtxOrtho(proj, 0.0f, (float)width, (float)height, 0.0f, 0.0f, 1000.0f);
 
-			GL_CHECK(glUniformMatrix4fv(program.m_predefined[0].m_loc
-				, 1
-				, GL_FALSE
+			setShaderUniform4x4f(0
+				, program.m_predefined[0].m_loc
 				, proj
-				) );
+				, 1
+				);
+			commitUniformBlocks(program);
 
 			GL_CHECK(glActiveTexture(GL_TEXTURE0) );
 			GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_textures[_blitter.m_texture.idx].m_id) );
@@ -2725,6 +2847,7 @@ namespace bgfx { namespace gl
 				| BGFX_RESET_MAXANISOTROPY
 				| BGFX_RESET_DEPTH_CLAMP
 				| BGFX_RESET_SUSPEND
+				| BGFX_RESET_MULTI_DRAW_BATCH
 				);
 
 			if (m_resolution.m_width            !=  _resolution.m_width
@@ -2751,7 +2874,7 @@ namespace bgfx { namespace gl
 						);
 				updateCapture();
 
-				for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+				for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 				{
 					m_frameBuffers[ii].postReset();
 				}
@@ -2779,6 +2902,12 @@ namespace bgfx { namespace gl
 
 		void setShaderUniform4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (isUniformBlockLoc(_regIndex) )
+			{
+				m_currentProgram->setUniform(_regIndex, UniformType::Vec4, _val, _numRegs);
+				return;
+			}
+
 			GL_CHECK(glUniform4fv(_regIndex
 				, _numRegs
 				, (const GLfloat*)_val
@@ -2787,6 +2916,12 @@ namespace bgfx { namespace gl
 
 		void setShaderUniform4x4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (isUniformBlockLoc(_regIndex) )
+			{
+				m_currentProgram->setUniform(_regIndex, UniformType::Mat4, _val, _numRegs);
+				return;
+			}
+
 			GL_CHECK(glUniformMatrix4fv(_regIndex
 				, _numRegs
 				, GL_FALSE
@@ -2794,6 +2929,54 @@ namespace bgfx { namespace gl
 				) );
 		}
 
+		void invalidateUniformBlocks()
+		{
+			bx::memSet(m_uniformBlockBound, 0xff, sizeof(m_uniformBlockBound) );
+		}
+
+		void commitUniformBlocks(ProgramGL& _program)
+		{
+			for (uint32_t ii = 0; ii < ProgramGL::UniformBlock::Count; ++ii)
+			{
+				UniformBlockGL& block = _program.m_uniformBlock[ii];
+
+				if (0 == block.m_size)
+				{
+					continue;
+				}
+
+				if (block.m_dirty
+				||  block.m_generation != m_uniformRing.m_generation)
+				{
+					const uint32_t generation = m_uniformRing.m_generation;
+					block.m_offset     = m_uniformRing.write(block.m_data, block.m_size);
+					block.m_generation = m_uniformRing.m_generation;
+					block.m_dirty      = false;
+					++m_numUniformBlockUpload;
+
+					if (generation != m_uniformRing.m_generation)
+					{
+						// Ring wrapped and was orphaned, blocks already
+						// committed for this program must be uploaded again.
+						invalidateUniformBlocks();
+						ii = UINT32_MAX;
+						continue;
+					}
+				}
+
+				if (m_uniformBlockBound[ii] != block.m_offset)
+				{
+					m_uniformBlockBound[ii] = block.m_offset;
+					GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER
+						, ii
+						, m_uniformRing.m_id
+						, block.m_offset
+						, block.m_size
+						) );
+				}
+			}
+		}
+
 		uint32_t setFrameBuffer(FrameBufferHandle _fbh, uint32_t _height, uint16_t _discard = BGFX_CLEAR_NONE, bool _msaa = true)
 		{
 			if (isValid(m_fbh)
@@ -3263,6 +3446,12 @@ namespace bgfx { namespace gl
 
 				uint32_t loc = _uniformBuffer.read();
 
+				if (isUniformBlockLoc(loc) )
+				{
+					m_currentProgram->setUniform(loc, type, data, num);
+					continue;
+				}
+
 #define CASE_IMPLEMENT_UNIFORM(_uniform, _glsuffix, _dxsuffix, _type) \
 		case UniformType::_uniform: \
 				{ \
@@ -3442,6 +3631,7 @@ namespace bgfx { namespace gl
 				GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
 
 				ProgramGL& program = m_program[_clearQuad.m_program[numMrt-1].idx];
+				m_currentProgram = &program;
 				GL_CHECK(glUseProgram(program.m_id) );
 				program.bindAttributesBegin();
 				program.bindAttributes(vertexDecl, 0);
@@ -3485,20 +3675,26 @@ namespace bgfx { namespace gl
 		void* m_renderdocdll;
 
 		uint16_t m_numWindows;
-		FrameBufferHandle m_windows[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-
-		IndexBufferGL m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferGL m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderGL m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramGL m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureGL m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexDecl m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		FrameBufferGL m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		ResourceArrayT<FrameBufferHandle> m_windows;
+
+		ResourceArrayT<IndexBufferGL> m_indexBuffers;
+		ResourceArrayT<VertexBufferGL> m_vertexBuffers;
+		ResourceArrayT<ShaderGL> m_shaders;
+		ResourceArrayT<ProgramGL> m_program;
+		ResourceArrayT<TextureGL> m_textures;
+		ResourceArrayT<VertexDecl> m_vertexDecls;
+		ResourceArrayT<FrameBufferGL> m_frameBuffers;
 		UniformRegistry m_uniformReg;
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<void*> m_uniforms;
 
 		TimerQueryGL m_gpuTimer;
 		OcclusionQueryGL m_occlusionQuery;
+		MultiDrawGL m_multiDraw;
+		DrawDataGL m_drawData;
+		UniformRingGL m_uniformRing;
+		uint32_t m_uniformBlockBound[ProgramGL::UniformBlock::Count];
+		uint32_t m_numUniformBlockUpload;
+		ProgramGL* m_currentProgram;
 
 		VaoStateCache m_vaoStateCache;
 		SamplerStateCache m_samplerStateCache;
@@ -3530,6 +3726,9 @@ namespace bgfx { namespace gl
 		bool m_occlusionQuerySupport;
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
+		bool m_multiDrawSupport;
+		bool m_drawDataSupport;
+		bool m_uniformBufferSupport;
 		bool m_flip;
 
 		uint64_t m_hash;
@@ -4069,6 +4268,18 @@ namespace bgfx { namespace gl
 		}
 		m_numPredefined = 0;
 
+		for (uint32_t ii = 0; ii < UniformBlock::Count; ++ii)
+		{
+			UniformBlockGL& ub = m_uniformBlock[ii];
+			if (NULL != ub.m_data)
+			{
+				BX_FREE(g_allocator, ub.m_data);
+			}
+			ub = UniformBlockGL();
+		}
+
+		m_drawData = false;
+
 		if (0 != m_id)
 		{
 			GL_CHECK(glUseProgram(0) );
@@ -4152,6 +4363,24 @@ namespace bgfx { namespace gl
 		m_numPredefined = 0;
 		m_numSamplers = 0;
 
+		const bool uniformBufferSupport = s_renderGL->m_uniformBufferSupport;
+		GLuint blockIndex[UniformBlock::Count];
+
+		for (uint32_t ii = 0; ii < UniformBlock::Count; ++ii)
+		{
+			blockIndex[ii] = GL_INVALID_INDEX;
+
+			if (uniformBufferSupport)
+			{
+				blockIndex[ii] = glGetUniformBlockIndex(m_id, s_uniformBlockName[ii]);
+				if (GL_INVALID_INDEX != blockIndex[ii])
+				{
+					BX_TRACE("Uniform block %s at binding %d.", s_uniformBlockName[ii], ii);
+					GL_CHECK(glUniformBlockBinding(m_id, blockIndex[ii], ii) );
+				}
+			}
+		}
+
 		BX_TRACE("Uniforms (%d):", activeUniforms);
 		for (int32_t ii = 0; ii < activeUniforms; ++ii)
 		{
@@ -4200,6 +4429,41 @@ namespace bgfx { namespace gl
 
 			num = bx::uint32_max(num, 1);
 
+			if (uniformBufferSupport
+			&&  -1 == loc)
+			{
+				GLuint index = GLuint(ii);
+				GLint  uniformBlock = -1;
+				GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &uniformBlock) );
+
+				for (uint32_t block = 0; block < UniformBlock::Count; ++block)
+				{
+					if (GL_INVALID_INDEX != blockIndex[block]
+					&&  GLuint(uniformBlock) == blockIndex[block])
+					{
+						GLint uniformOffset = 0;
+						GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_OFFSET, &uniformOffset) );
+
+						const uint32_t stride = GL_FLOAT_MAT4 == gltype ? 64
+							: GL_FLOAT_MAT3 == gltype ? 48
+							: 16
+							;
+						UniformBlockGL& ub = m_uniformBlock[block];
+						ub.m_size = bx::uint32_max(ub.m_size, uint32_t(uniformOffset) + stride*num);
+
+						loc = GLint(toUniformBlockLoc(block, uint32_t(uniformOffset) ) );
+
+						// Strip block name from "bgfx_VertexUniforms.u_name".
+						const char* member = bx::strFind(name, '.');
+						if (NULL != member)
+						{
+							bx::memMove(name, member+1, bx::strLen(member+1)+1);
+						}
+						break;
+					}
+				}
+			}
+
 			int offset = 0;
 			char* array = const_cast<char*>(bx::strFind(name, '[') );
 			if (NULL != array)
@@ -4317,6 +4581,20 @@ namespace bgfx { namespace gl
 			m_constantBuffer->finish();
 		}
 
+		for (uint32_t ii = 0; ii < UniformBlock::Count; ++ii)
+		{
+			UniformBlockGL& ub = m_uniformBlock[ii];
+			if (0 != ub.m_size)
+			{
+				ub.m_size = bx::strideAlign(ub.m_size, 16);
+				ub.m_data = (uint8_t*)BX_ALLOC(g_allocator, ub.m_size);
+				bx::memSet(ub.m_data, 0, ub.m_size);
+				ub.m_dirty = true;
+				ub.m_generation = UINT32_MAX;
+				BX_TRACE("Uniform block %s size %d.", s_uniformBlockName[ii], ub.m_size);
+			}
+		}
+
 		if (piqSupported)
 		{
 			struct VariableInfo
@@ -4353,6 +4631,12 @@ namespace bgfx { namespace gl
 					, 0 //vi.loc
 					);
 			}
+
+			m_drawData = true
+				&& s_renderGL->m_drawDataSupport
+				&& GL_INVALID_INDEX != glGetProgramResourceIndex(m_id, GL_SHADER_STORAGE_BLOCK, "u_drawDataBuffer")
+				;
+			BX_TRACE("Draw data: %s", m_drawData ? "true" : "false");
 		}
 
 		bx::memSet(m_attributes, 0xff, sizeof(m_attributes) );
@@ -4387,6 +4671,40 @@ namespace bgfx { namespace gl
 		m_instanceData[used] = 0xffff;
 	}
 
+	void ProgramGL::setUniform(uint32_t _loc, UniformType::Enum _type, const void* _data, uint32_t _num)
+	{
+		const uint32_t block  = (_loc>>24)&0x7f;
+		const uint32_t offset = _loc&0xffffff;
+
+		UniformBlockGL& ub = m_uniformBlock[block];
+		uint8_t* dst = &ub.m_data[offset];
+		const uint8_t* src = (const uint8_t*)_data;
+
+		if (UniformType::Mat3 == _type)
+		{
+			// std140 pads each mat3 column to vec4.
+			BX_CHECK(offset + _num*48 <= ub.m_size, "Uniform block overflow.");
+			for (uint32_t ii = 0, num = _num*3; ii < num; ++ii, dst += 16, src += 12)
+			{
+				if (0 != bx::memCmp(dst, src, 12) )
+				{
+					bx::memCopy(dst, src, 12);
+					ub.m_dirty = true;
+				}
+			}
+		}
+		else
+		{
+			const uint32_t size = g_uniformTypeSize[_type]*_num;
+			BX_CHECK(offset + size <= ub.m_size, "Uniform block overflow.");
+			if (0 != bx::memCmp(dst, src, size) )
+			{
+				bx::memCopy(dst, src, size);
+				ub.m_dirty = true;
+			}
+		}
+	}
+
 	void ProgramGL::bindAttributes(const VertexDecl& _vertexDecl, uint32_t _baseVertex)
 	{
 		for (uint32_t ii = 0, iiEnd = m_usedCount; ii < iiEnd; ++ii)
@@ -5369,6 +5687,126 @@ namespace bgfx { namespace gl
 		bx::memCopy(_str, _insert, len);
 	}
 
+	static bool isUniformBlockType(const char* _type)
+	{
+		return (0 == bx::strCmp(_type, "vec4", 4) || 0 == bx::strCmp(_type, "mat3", 4) || 0 == bx::strCmp(_type, "mat4", 4) )
+			&& (' ' == _type[4] || '\t' == _type[4])
+			;
+	}
+
+	static void writeUniformBlock(bx::WriterI* _writer, const char* _code, int32_t _codeLen, uint32_t _block)
+	{
+		struct Decl
+		{
+			const char* m_decl;
+			int32_t m_declLen;
+			const char* m_name;
+			int32_t m_nameLen;
+		};
+
+		Decl decl[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t num = 0;
+
+		// shaderc emits global declarations first. Move vec4/mat3/mat4
+		// uniforms from there into std140 block. Samplers and internal
+		// bgfx_* uniforms stay in default block.
+		const char* copy  = _code;
+		const char* parse = _code;
+
+		for (;;)
+		{
+			parse = bx::strws(parse);
+
+			if ('#' == *parse)
+			{
+				const char* eol = bx::strFind(parse, '\n');
+				if (NULL == eol)
+				{
+					break;
+				}
+
+				parse = eol + 1;
+				continue;
+			}
+
+			const char* eol = bx::strFind(parse, ';');
+			if (NULL == eol)
+			{
+				break;
+			}
+
+			const char* qualifier = parse;
+			const char* typen = bx::strws(bx::strword(parse) );
+
+			if (0 == bx::strCmp(qualifier, "attribute", 9)
+			||  0 == bx::strCmp(qualifier, "varying",   7)
+			||  0 == bx::strCmp(qualifier, "in",        2)
+			||  0 == bx::strCmp(qualifier, "out",       3)
+			   )
+			{
+				parse = eol + 1;
+				continue;
+			}
+
+			if (0 != bx::strCmp(qualifier, "uniform", 7) )
+			{
+				break;
+			}
+
+			const char* type = typen;
+			if (0 == bx::strCmp(type, "lowp", 4)
+			||  0 == bx::strCmp(type, "mediump", 7)
+			||  0 == bx::strCmp(type, "highp", 5) )
+			{
+				type = bx::strws(bx::strword(type) );
+			}
+
+			const char* name = bx::strws(bx::strword(type) );
+			const int32_t nameLen = int32_t(bx::strword(name) - name);
+
+			if (isUniformBlockType(type)
+			&&  0 != bx::strCmp(name, "bgfx_", 5)
+			&&  num < BX_COUNTOF(decl) )
+			{
+				Decl& dd = decl[num++];
+				dd.m_decl    = typen;
+				dd.m_declLen = int32_t(eol - typen);
+				dd.m_name    = name;
+				dd.m_nameLen = nameLen;
+
+				bx::write(_writer, copy, int32_t(qualifier - copy) );
+				copy = eol + 1;
+			}
+
+			parse = eol + 1;
+		}
+
+		bx::write(_writer, copy, int32_t(parse - copy) );
+
+		if (0 != num)
+		{
+			writeStringf(_writer, "layout(std140) uniform %s\n{\n", s_uniformBlockName[_block]);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				bx::write(_writer, "\t", 1);
+				bx::write(_writer, decl[ii].m_decl, decl[ii].m_declLen);
+				bx::write(_writer, ";\n", 2);
+			}
+
+			writeStringf(_writer, "} %s;\n", s_uniformBlockInstance[_block]);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				char name[256];
+				bx::strCopy(name, int32_t(bx::uint32_min(decl[ii].m_nameLen+1, BX_COUNTOF(name) ) ), decl[ii].m_name);
+				writeStringf(_writer, "#define %s %s.%s\n", name, s_uniformBlockInstance[_block], name);
+			}
+		}
+
+		bx::write(_writer, parse, int32_t(_codeLen - (parse - _code) ) );
+	}
+
 	void ShaderGL::create(Memory* _mem)
 	{
 		bx::MemoryReader reader(_mem->data, _mem->size);
@@ -5436,7 +5874,7 @@ namespace bgfx { namespace gl
 			if (GL_COMPUTE_SHADER != m_type)
 			{
 				int32_t codeLen = (int32_t)bx::strLen(code);
-				int32_t tempLen = codeLen + (4<<10);
+				int32_t tempLen = codeLen + (4<<10) + (s_renderGL->m_uniformBufferSupport ? codeLen : 0);
 				char* temp = (char*)alloca(tempLen);
 				bx::StaticMemoryBlockWriter writer(temp, tempLen);
 
@@ -5754,6 +6192,15 @@ namespace bgfx { namespace gl
 							  "precision mediump float;\n"
 							);
 					}
+					else if (s_renderGL->m_drawDataSupport
+						 &&  !!bx::findIdentifierMatch(code, "gl_DrawIDARB") )
+					{
+						// Draw data is shader storage buffer indexed by draw id.
+						writeString(&writer
+							, "#version 430\n"
+							  "#extension GL_ARB_shader_draw_parameters : require\n"
+							);
+					}
 					else
 					{
 						writeString(&writer, "#version 140\n");
@@ -5843,7 +6290,19 @@ namespace bgfx { namespace gl
 								);
 					}
 
-					bx::write(&writer, code, codeLen);
+					if (s_renderGL->m_uniformBufferSupport)
+					{
+						writeUniformBlock(&writer
+							, code
+							, codeLen
+							, GL_FRAGMENT_SHADER == m_type ? ProgramGL::UniformBlock::Fragment : ProgramGL::UniformBlock::Vertex
+							);
+					}
+					else
+					{
+						bx::write(&writer, code, codeLen);
+					}
+
 					bx::write(&writer, '\0');
 				}
 
@@ -6234,6 +6693,404 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	// Streaming buffer holds this many batches before it's orphaned.
+	static const uint32_t s_multiDrawBufferSize = 16*sizeof(MultiDrawGL::Command)*BGFX_CONFIG_MAX_MULTI_DRAW_BATCH;
+
+	void MultiDrawGL::create()
+	{
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		BX_CHECK(0 != m_id, "Failed to generate buffer id.");
+		GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id) );
+		GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER
+			, s_multiDrawBufferSize
+			, NULL
+			, GL_STREAM_DRAW
+			) );
+		GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0) );
+
+		m_offset = 0;
+		m_num    = 0;
+	}
+
+	void MultiDrawGL::destroy()
+	{
+		if (0 != m_id)
+		{
+			GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0) );
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+	}
+
+	uintptr_t MultiDrawGL::flush()
+	{
+		const uint32_t size = m_num*sizeof(Command);
+
+		GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id) );
+
+		if (m_offset + size > s_multiDrawBufferSize)
+		{
+			// orphan buffer...
+			GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER
+				, s_multiDrawBufferSize
+				, NULL
+				, GL_STREAM_DRAW
+				) );
+			m_offset = 0;
+		}
+
+		const uintptr_t offset = m_offset;
+		GL_CHECK(glBufferSubData(GL_DRAW_INDIRECT_BUFFER
+			, offset
+			, size
+			, m_cmd
+			) );
+
+		m_offset += size;
+		m_num     = 0;
+
+		return offset;
+	}
+
+	// Streaming buffer holds this many full batches before it's orphaned.
+	static const uint32_t s_drawDataBufferSize = 16*sizeof(DrawDataGL::Data)*BGFX_CONFIG_MAX_MULTI_DRAW_BATCH;
+
+	void DrawDataGL::create(uint32_t _align)
+	{
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		BX_CHECK(0 != m_id, "Failed to generate buffer id.");
+		GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id) );
+		GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER
+			, s_drawDataBufferSize
+			, NULL
+			, GL_STREAM_DRAW
+			) );
+		GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0) );
+
+		m_offset = 0;
+		m_align  = bx::uint32_max(_align, 16);
+		m_num    = 0;
+	}
+
+	void DrawDataGL::destroy()
+	{
+		if (0 != m_id)
+		{
+			GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0) );
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+	}
+
+	void DrawDataGL::flush()
+	{
+		const uint32_t size = m_num*sizeof(Data);
+
+		GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id) );
+
+		uint32_t offset = bx::strideAlign(m_offset, m_align);
+		if (offset + size > s_drawDataBufferSize)
+		{
+			// orphan buffer...
+			GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER
+				, s_drawDataBufferSize
+				, NULL
+				, GL_STREAM_DRAW
+				) );
+			offset = 0;
+		}
+
+		GL_CHECK(glBufferSubData(GL_SHADER_STORAGE_BUFFER
+			, offset
+			, size
+			, m_data
+			) );
+
+		GL_CHECK(glBindBufferRange(GL_SHADER_STORAGE_BUFFER
+			, BGFX_CONFIG_DRAW_DATA_BINDING
+			, m_id
+			, offset
+			, size
+			) );
+
+		m_offset = offset + size;
+		m_num    = 0;
+	}
+
+	void UniformRingGL::create(uint32_t _size, uint32_t _align)
+	{
+		m_size       = _size;
+		m_align      = bx::uint32_max(_align, 16);
+		m_offset     = 0;
+		m_generation = 0;
+
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		BX_CHECK(0 != m_id, "Failed to generate buffer id.");
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_id) );
+		GL_CHECK(glBufferData(GL_UNIFORM_BUFFER
+			, m_size
+			, NULL
+			, GL_STREAM_DRAW
+			) );
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+	}
+
+	void UniformRingGL::destroy()
+	{
+		if (0 != m_id)
+		{
+			GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+	}
+
+	uint32_t UniformRingGL::write(const void* _data, uint32_t _size)
+	{
+		BX_CHECK(_size <= m_size, "Uniform block is larger than uniform buffer ring.");
+
+		uint32_t offset = bx::strideAlign(m_offset, m_align);
+
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_id) );
+
+		if (offset + _size > m_size)
+		{
+			// orphan buffer...
+			GL_CHECK(glBufferData(GL_UNIFORM_BUFFER
+				, m_size
+				, NULL
+				, GL_STREAM_DRAW
+				) );
+			offset = 0;
+			++m_generation;
+		}
+
+		GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER
+			, offset
+			, _size
+			, _data
+			) );
+
+		m_offset = offset + _size;
+
+		return offset;
+	}
+
+	static bool hasModelUniforms(const ProgramGL& _program)
+	{
+		for (uint32_t ii = 0, num = _program.m_numPredefined; ii < num; ++ii)
+		{
+			switch (_program.m_predefined[ii].m_type&(~BGFX_UNIFORM_FRAGMENTBIT) )
+			{
+			case PredefinedUniform::Model:
+			case PredefinedUniform::ModelView:
+			case PredefinedUniform::ModelViewProj:
+				return true;
+
+			default:
+				break;
+			}
+		}
+
+		return false;
+	}
+
+	// Returns size of next uniform update in range, or 0 at the end of range.
+	// Updates of uniform _skip are stepped over.
+	static uint32_t nextUniformUpdate(UniformBuffer* _uniformBuffer, uint32_t& _pos, uint32_t _end, uint16_t _skip, const char*& _data)
+	{
+		while (_pos < _end)
+		{
+			_uniformBuffer->reset(_pos);
+			const uint32_t opcode = _uniformBuffer->read();
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			const uint32_t size = uint32_t(sizeof(opcode) ) + g_uniformTypeSize[type]*num;
+			_uniformBuffer->reset(_pos);
+			_data = _uniformBuffer->read(size);
+			_pos += size;
+
+			if (UniformType::Count <= type
+			||  loc != _skip)
+			{
+				return size;
+			}
+		}
+
+		return 0;
+	}
+
+	static bool isUniformRangeEqual(UniformBuffer* _uniformBuffer, const RenderDraw& _draw, const RenderDraw& _next, uint16_t _skip)
+	{
+		const uint32_t size = _next.m_constEnd - _next.m_constBegin;
+		if (0 == size)
+		{
+			// Nothing is updated, uniforms set by first draw remain.
+			return true;
+		}
+
+		if (invalidHandle == _skip)
+		{
+			if (size != _draw.m_constEnd - _draw.m_constBegin)
+			{
+				return false;
+			}
+
+			_uniformBuffer->reset(_draw.m_constBegin);
+			const char* data = _uniformBuffer->read(size);
+
+			_uniformBuffer->reset(_next.m_constBegin);
+			const char* next = _uniformBuffer->read(size);
+
+			return 0 == bx::memCmp(data, next, size);
+		}
+
+		// Skipped uniform is passed through draw data, all other updates must
+		// match updates of the first draw.
+		uint32_t drawPos = _draw.m_constBegin;
+		uint32_t nextPos = _next.m_constBegin;
+		const char* data = NULL;
+		const char* next = NULL;
+
+		uint32_t nextSize = nextUniformUpdate(_uniformBuffer, nextPos, _next.m_constEnd, _skip, next);
+		if (0 == nextSize)
+		{
+			return true;
+		}
+
+		for (;;)
+		{
+			const uint32_t dataSize = nextUniformUpdate(_uniformBuffer, drawPos, _draw.m_constEnd, _skip, data);
+			if (dataSize != nextSize)
+			{
+				return false;
+			}
+
+			if (0 == nextSize)
+			{
+				return true;
+			}
+
+			if (0 != bx::memCmp(data, next, nextSize) )
+			{
+				return false;
+			}
+
+			nextSize = nextUniformUpdate(_uniformBuffer, nextPos, _next.m_constEnd, _skip, next);
+		}
+	}
+
+	static void getDrawParams(UniformBuffer* _uniformBuffer, const RenderDraw& _draw, uint16_t _handle, float* _params)
+	{
+		_uniformBuffer->reset(_draw.m_constBegin);
+		while (_uniformBuffer->getPos() < _draw.m_constEnd)
+		{
+			const uint32_t opcode = _uniformBuffer->read();
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			const char* data = _uniformBuffer->read(g_uniformTypeSize[type]*num);
+			if (UniformType::Vec4 == type
+			&&  loc == _handle)
+			{
+				bx::memCopy(_params, copy ? data : *(const char**)data, 4*sizeof(float) );
+			}
+		}
+	}
+
+	static bool isMultiDrawCompatible(const RenderDraw& _draw, const RenderBind& _bind, const RenderDraw& _next, const RenderBind& _nextBind, int32_t& _baseVertex)
+	{
+		if (_draw.m_stateFlags             != _next.m_stateFlags
+		||  _draw.m_stencil                != _next.m_stencil
+		||  _draw.m_rgba                   != _next.m_rgba
+		||  _draw.m_scissor                != _next.m_scissor
+		||  _draw.m_submitFlags            != _next.m_submitFlags
+		||  _draw.m_streamMask             != _next.m_streamMask
+		||  _draw.m_indexBuffer.idx        != _next.m_indexBuffer.idx
+		||  _draw.m_instanceDataBuffer.idx != _next.m_instanceDataBuffer.idx
+		||  _draw.m_instanceDataOffset     != _next.m_instanceDataOffset
+		||  _draw.m_instanceDataStride     != _next.m_instanceDataStride
+		||  isValid(_next.m_indirectBuffer)
+		||  isValid(_next.m_occlusionQuery) )
+		{
+			return false;
+		}
+
+		for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const Binding& bind = _bind.m_bind[stage];
+			const Binding& next = _nextBind.m_bind[stage];
+			if (bind.m_idx != next.m_idx)
+			{
+				return false;
+			}
+
+			if (invalidHandle != bind.m_idx
+			&& (bind.m_type != next.m_type
+			||  bind.m_un.m_draw.m_textureFlags != next.m_un.m_draw.m_textureFlags) )
+			{
+				return false;
+			}
+		}
+
+		// All streams must be offset by the same number of vertices, which is then
+		// expressed as base vertex of indirect draw command.
+		int64_t baseVertex = INT64_MAX;
+		for (uint32_t idx = 0, streamMask = _next.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
+			)
+		{
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const Stream& stream = _draw.m_stream[idx];
+			const Stream& next   = _next.m_stream[idx];
+			if (stream.m_handle.idx != next.m_handle.idx
+			||  stream.m_decl.idx   != next.m_decl.idx
+			||  stream.m_startVertex > next.m_startVertex)
+			{
+				return false;
+			}
+
+			const int64_t delta = int64_t(next.m_startVertex) - int64_t(stream.m_startVertex);
+			if (INT64_MAX != baseVertex
+			&&  baseVertex != delta)
+			{
+				return false;
+			}
+
+			baseVertex = delta;
+		}
+
+		if (INT32_MAX < baseVertex)
+		{
+			return false;
+		}
+
+		_baseVertex = int32_t(baseVertex);
+		return true;
+	}
+
 	void RendererContextGL::submitBlit(BlitState& _bs, uint16_t _view)
 	{
 		if (m_blitSupported)
@@ -6333,8 +7190,7 @@ namespace bgfx { namespace gl
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
-		RenderBind currentBind;
-		currentBind.clear();
+		StateTracker stateTracker;
 
 		_render->m_hmdInitialized = m_ovr.isInitialized();
 
@@ -6345,7 +7201,7 @@ namespace bgfx { namespace gl
 		uint16_t programIdx = invalidHandle;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 
 		BlitState bs(_render);
 
@@ -6370,6 +7226,7 @@ namespace bgfx { namespace gl
 
 		GLuint currentVao = 0;
 		bool wasCompute = false;
+		bool resetState = false;
 		bool viewHasScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
@@ -6379,13 +7236,29 @@ namespace bgfx { namespace gl
 		const bool computeSupported = (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) && s_extension[Extension::ARB_compute_shader].m_supported)
 									|| BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 31)
 									;
+		const bool multiDrawBatch = m_multiDrawSupport
+			&& 0 != (_render->m_resolution.m_flags & BGFX_RESET_MULTI_DRAW_BATCH)
+			;
+
+		// Value of u_drawParams uniform is passed per draw with draw data,
+		// instead of breaking multi-draw run.
+		const UniformRegInfo* drawParamsInfo = m_drawDataSupport ? m_uniformReg.find("u_drawParams") : NULL;
+		const uint16_t drawParams = NULL != drawParamsInfo ? drawParamsInfo->m_handle.idx : uint16_t(invalidHandle);
 
 		uint32_t statsNumPrimsSubmitted[BX_COUNTOF(s_primInfo)] = {};
 		uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
 		uint32_t statsNumInstances[BX_COUNTOF(s_primInfo)] = {};
 		uint32_t statsNumIndices = 0;
+		uint32_t statsNumMultiDraw = 0;
+		uint32_t statsNumMultiDrawBatched = 0;
 		uint32_t statsKeyType[2] = {};
 
+		m_vaoStateCache.resetStats();
+		m_samplerStateCache.resetStats();
+
+		m_numUniformBlockUpload = 0;
+		invalidateUniformBlocks();
+
 		if (m_occlusionQuerySupport)
 		{
 			m_occlusionQuery.resolve(_render);
@@ -6547,6 +7420,7 @@ namespace bgfx { namespace gl
 						const RenderCompute& compute = renderItem.compute;
 
 						ProgramGL& program = m_program[key.m_program];
+						m_currentProgram = &program;
 						GL_CHECK(glUseProgram(program.m_id) );
 
 						GLbitfield barrier = 0;
@@ -6643,7 +7517,14 @@ namespace bgfx { namespace gl
 					continue;
 				}
 
-				bool resetState = viewChanged || wasCompute;
+				// Reset is kept pending until draw that is not occlusion
+				// culled, so that first visible draw sets all state.
+				if (viewChanged
+				||  wasCompute)
+				{
+					resetState = true;
+					stateTracker.invalidate();
+				}
 
 				if (wasCompute)
 				{
@@ -6677,14 +7558,14 @@ namespace bgfx { namespace gl
 
 				if (resetState)
 				{
+					resetState = false;
+
 					currentState.clear();
 					currentState.m_scissor = !draw.m_scissor;
 					changedFlags = BGFX_STATE_MASK;
 					changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
 					currentState.m_stateFlags = newFlags;
 					currentState.m_stencil    = newStencil;
-
-					currentBind.clear();
 				}
 
 				uint16_t scissor = draw.m_scissor;
@@ -6726,6 +7607,12 @@ namespace bgfx { namespace gl
 					}
 				}
 
+				if (!stateTracker.setState(newFlags, newStencil, draw.m_rgba) )
+				{
+					changedFlags   = 0;
+					changedStencil = 0;
+				}
+
 				if (0 != changedStencil)
 				{
 					if (0 != newStencil)
@@ -7011,13 +7898,14 @@ namespace bgfx { namespace gl
 				bool bindAttribs = false;
 				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
 
-				if (key.m_program != programIdx)
+				if (stateTracker.setProgram(key.m_program) )
 				{
 					programIdx = key.m_program;
 					GLuint id = invalidHandle == programIdx ? 0 : m_program[programIdx].m_id;
 
 					// Skip rendering if program index is valid, but program is invalid.
 					programIdx = 0 == id ? invalidHandle : programIdx;
+					m_currentProgram = invalidHandle == programIdx ? NULL : &m_program[programIdx];
 
 					GL_CHECK(glUseProgram(id) );
 					programChanged =
@@ -7036,16 +7924,13 @@ namespace bgfx { namespace gl
 					}
 
 					viewState.setPredefined<1>(this, view, eye, program, _render, draw);
+					commitUniformBlocks(program);
 
 					{
 						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 						{
 							const Binding& bind = renderBind.m_bind[stage];
-							Binding& current = currentBind.m_bind[stage];
-							if (current.m_idx != bind.m_idx
-							||  current.m_type != bind.m_type
-							||  current.m_un.m_draw.m_textureFlags != bind.m_un.m_draw.m_textureFlags
-							||  programChanged)
+							if (stateTracker.setBinding(uint8_t(stage), bind) )
 							{
 								if (invalidHandle != bind.m_idx)
 								{
@@ -7076,8 +7961,6 @@ namespace bgfx { namespace gl
 									}
 								}
 							}
-
-							current = bind;
 						}
 					}
 
@@ -7224,6 +8107,7 @@ namespace bgfx { namespace gl
 								currentState.m_stream[ii].m_handle.idx = invalidHandle;
 							}
 							currentState.m_indexBuffer.idx = invalidHandle;
+							stateTracker.invalidateIndexBuffer();
 							bindAttribs = true;
 							currentVao = 0;
 						}
@@ -7270,7 +8154,7 @@ namespace bgfx { namespace gl
 							bindAttribs = true;
 						}
 
-						if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+						if (stateTracker.setIndexBuffer(draw.m_indexBuffer) )
 						{
 							currentState.m_indexBuffer = draw.m_indexBuffer;
 
@@ -7360,6 +8244,18 @@ namespace bgfx { namespace gl
 						uint32_t numPrimsRendered  = 0;
 						uint32_t numDrawIndirect   = 0;
 
+						const bool drawData = program.m_drawData;
+						float params[4] = {};
+						if (drawData)
+						{
+							if (invalidHandle != drawParams)
+							{
+								bx::memCopy(params, m_uniforms[drawParams], sizeof(params) );
+							}
+
+							m_drawData.add(_render->m_matrixCache.m_cache[draw.m_matrix].un.val, params);
+						}
+
 						if (hasOcclusionQuery)
 						{
 							m_occlusionQuery.begin(_render, draw.m_occlusionQuery);
@@ -7367,6 +8263,12 @@ namespace bgfx { namespace gl
 
 						if (isValid(draw.m_indirectBuffer) )
 						{
+							if (drawData)
+							{
+								m_drawData.flush();
+								stateTracker.invalidateBinding(BGFX_CONFIG_DRAW_DATA_BINDING);
+							}
+
 							const VertexBufferGL& vb = m_vertexBuffers[draw.m_indirectBuffer.idx];
 							if (currentState.m_indirectBuffer.idx != draw.m_indirectBuffer.idx)
 							{
@@ -7428,7 +8330,97 @@ namespace bgfx { namespace gl
 									: GL_UNSIGNED_INT
 									;
 
-								if (UINT32_MAX == draw.m_numIndices)
+								if (multiDrawBatch
+								&&  !hasOcclusionQuery
+								&& (UINT32_MAX == draw.m_numIndices || prim.m_min <= draw.m_numIndices) )
+								{
+									const bool modelUniforms = hasModelUniforms(program);
+
+									for (; item < numItems && !m_multiDraw.isFull(); ++item)
+									{
+										SortKey nextKey;
+										if (nextKey.decode(_render->m_sortKeys[item], _render->m_viewRemap)
+										||  nextKey.m_view    != key.m_view
+										||  nextKey.m_program != key.m_program)
+										{
+											break;
+										}
+
+										const uint32_t nextIdx = _render->m_sortValues[item];
+										const RenderDraw& next = _render->m_renderItem[nextIdx].draw;
+
+										int32_t baseVertex;
+										if (!isMultiDrawCompatible(draw, renderBind, next, _render->m_renderItemBind[nextIdx], baseVertex)
+										||  (modelUniforms && (next.m_matrix != draw.m_matrix || next.m_num != draw.m_num) )
+										||  (UINT32_MAX != next.m_numIndices && prim.m_min > next.m_numIndices)
+										||  !isUniformRangeEqual(_render->m_uniformBuffer, draw, next, drawData ? drawParams : uint16_t(invalidHandle) ) )
+										{
+											break;
+										}
+
+										if (drawData)
+										{
+											if (invalidHandle != drawParams)
+											{
+												getDrawParams(_render->m_uniformBuffer, next, drawParams, params);
+											}
+
+											m_drawData.add(_render->m_matrixCache.m_cache[next.m_matrix].un.val, params);
+										}
+
+										if (0 == m_multiDraw.m_num)
+										{
+											const uint32_t drawNumIndices = UINT32_MAX == draw.m_numIndices ? ib.m_size/indexSize : draw.m_numIndices;
+											const uint32_t drawStartIndex = UINT32_MAX == draw.m_numIndices ? 0 : draw.m_startIndex;
+											m_multiDraw.add(drawNumIndices, draw.m_numInstances, drawStartIndex, 0);
+
+											numIndices        = drawNumIndices;
+											numPrimsSubmitted = drawNumIndices/prim.m_div - prim.m_sub;
+											numInstances      = draw.m_numInstances;
+											numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
+										}
+
+										const uint32_t nextNumIndices = UINT32_MAX == next.m_numIndices ? ib.m_size/indexSize : next.m_numIndices;
+										const uint32_t nextStartIndex = UINT32_MAX == next.m_numIndices ? 0 : next.m_startIndex;
+										m_multiDraw.add(nextNumIndices, next.m_numInstances, nextStartIndex, baseVertex);
+
+										const uint32_t nextNumPrims = nextNumIndices/prim.m_div - prim.m_sub;
+										numIndices        += nextNumIndices;
+										numPrimsSubmitted += nextNumPrims;
+										numInstances      += next.m_numInstances;
+										numPrimsRendered  += nextNumPrims*next.m_numInstances;
+
+										statsKeyType[0]++;
+									}
+
+									if (drawData
+									&&  invalidHandle != drawParams)
+									{
+										// Leave u_drawParams as last draw in run set it.
+										updateUniform(drawParams, params, sizeof(params) );
+									}
+								}
+
+								if (drawData)
+								{
+									m_drawData.flush();
+									stateTracker.invalidateBinding(BGFX_CONFIG_DRAW_DATA_BINDING);
+								}
+
+								if (0 != m_multiDraw.m_num)
+								{
+									const uint32_t numMultiDraw = m_multiDraw.m_num;
+									const uintptr_t args = m_multiDraw.flush();
+									GL_CHECK(glMultiDrawElementsIndirect(prim.m_type, indexFormat
+										, (void*)args
+										, numMultiDraw
+										, sizeof(MultiDrawGL::Command)
+										) );
+
+									statsNumMultiDraw++;
+									statsNumMultiDrawBatched += numMultiDraw;
+								}
+								else if (UINT32_MAX == draw.m_numIndices)
 								{
 									numIndices        = ib.m_size/indexSize;
 									numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
@@ -7459,6 +8451,12 @@ namespace bgfx { namespace gl
 							}
 							else
 							{
+								if (drawData)
+								{
+									m_drawData.flush();
+									stateTracker.invalidateBinding(BGFX_CONFIG_DRAW_DATA_BINDING);
+								}
+
 								numPrimsSubmitted = numVertices/prim.m_div - prim.m_sub;
 								numInstances = draw.m_numInstances;
 								numPrimsRendered = numPrimsSubmitted*draw.m_numInstances;
@@ -7557,6 +8555,13 @@ namespace bgfx { namespace gl
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
+		perfStats.numVaoCacheHit       = m_vaoStateCache.m_numHit;
+		perfStats.numVaoCacheMiss      = m_vaoStateCache.m_numMiss;
+		perfStats.numVaoCacheEvict     = m_vaoStateCache.m_numEvict;
+		perfStats.numSamplerCacheHit   = m_samplerStateCache.m_numHit;
+		perfStats.numSamplerCacheMiss  = m_samplerStateCache.m_numMiss;
+		perfStats.numSamplerCacheEvict = m_samplerStateCache.m_numEvict;
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
@@ -7634,16 +8639,37 @@ namespace bgfx { namespace gl
 				}
 
 				tvm.printf(10, pos++, 0x8e, "      Indices: %7d ", statsNumIndices);
+				if (multiDrawBatch)
+				{
+					tvm.printf(10, pos++, 0x8e, "   Multi-draw: %7d (batched draws: %7d) ", statsNumMultiDraw, statsNumMultiDrawBatched);
+				}
 				tvm.printf(10, pos++, 0x8e, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
+				if (m_uniformBufferSupport)
+				{
+					tvm.printf(10, pos++, 0x8e, " UBO uploads: %7d ", m_numUniformBlockUpload);
+				}
 				tvm.printf(10, pos++, 0x8e, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8e, "     DIB size: %7d ", _render->m_iboffset);
 
 				pos++;
-				tvm.printf(10, pos++, 0x8e, " State cache:     ");
-				tvm.printf(10, pos++, 0x8e, " VAO    | Sampler ");
-				tvm.printf(10, pos++, 0x8e, " %6d | %6d  "
+				tvm.printf(10, pos++, 0x8e, " State cache:        Count    Hit   Miss  Evict ");
+				tvm.printf(10, pos++, 0x8e, "   VAO          %6d %6d %6d %6d "
 					, m_vaoStateCache.getCount()
+					, perfStats.numVaoCacheHit
+					, perfStats.numVaoCacheMiss
+					, perfStats.numVaoCacheEvict
+					);
+				tvm.printf(10, pos++, 0x8e, "   Sampler      %6d %6d %6d %6d "
 					, m_samplerStateCache.getCount()
+					, perfStats.numSamplerCacheHit
+					, perfStats.numSamplerCacheMiss
+					, perfStats.numSamplerCacheEvict
+					);
+				tvm.printf(10, pos++, 0x8e, " Filtered: program %5d, texture %5d, buffer %5d, state %5d "
+					, perfStats.numFilteredProgram
+					, perfStats.numFilteredTexture
+					, perfStats.numFilteredBuffer
+					, perfStats.numFilteredState
 					);
 
 #if BGFX_CONFIG_RENDERER_OPENGL
@@ -712,6 +712,22 @@ typedef uint64_t GLuint64;
 #	define GL_SHADER_STORAGE_BUFFER 0x90D2
 #endif // GL_SHADER_STORAGE_BUFFER
 
+#ifndef GL_SHADER_STORAGE_BLOCK
+#	define GL_SHADER_STORAGE_BLOCK 0x92E6
+#endif // GL_SHADER_STORAGE_BLOCK
+
+#ifndef GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS
+#	define GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS 0x90D6
+#endif // GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS
+
+#ifndef GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS
+#	define GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS 0x90DD
+#endif // GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS
+
+#ifndef GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+#	define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
+#endif // GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+
 #ifndef GL_IMAGE_1D
 #	define GL_IMAGE_1D 0x904C
 #endif // GL_IMAGE_1D
@@ -911,6 +927,26 @@ typedef uint64_t GLuint64;
 #	define GL_DISPATCH_INDIRECT_BUFFER 0x90EE
 #endif // GL_DISPATCH_INDIRECT_BUFFER
 
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_UNIFORM_BLOCK_INDEX
+#	define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+#endif // GL_UNIFORM_BLOCK_INDEX
+
+#ifndef GL_UNIFORM_OFFSET
+#	define GL_UNIFORM_OFFSET 0x8A3B
+#endif // GL_UNIFORM_OFFSET
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
 #ifndef GL_MAX_NAME_LENGTH
 #	define GL_MAX_NAME_LENGTH 0x92F6
 #endif // GL_MAX_NAME_LENGTH
@@ -1000,14 +1036,32 @@ namespace bgfx { namespace gl
 	class VaoStateCache
 	{
 	public:
+		VaoStateCache()
+		{
+			resetStats();
+		}
+
 		GLuint add(uint32_t _hash)
 		{
 			invalidate(_hash);
 
+			uint16_t handle = m_alloc.alloc();
+			if (UINT16_MAX == handle)
+			{
+				evict(m_alloc.getBack() );
+				handle = m_alloc.alloc();
+				++m_numEvict;
+			}
+
+			BX_CHECK(UINT16_MAX != handle, "Failed to find handle.");
+
 			GLuint arrayId;
 			GL_CHECK(glGenVertexArrays(1, &arrayId) );
 
-			m_hashMap.insert(stl::make_pair(_hash, arrayId) );
+			Data& data = m_data[handle];
+			data.m_hash = _hash;
+			data.m_id   = arrayId;
+			m_hashMap.insert(stl::make_pair(_hash, handle) );
 
 			return arrayId;
 		}
@@ -1017,9 +1071,13 @@ namespace bgfx { namespace gl
 			HashMap::iterator it = m_hashMap.find(_hash);
 			if (it != m_hashMap.end() )
 			{
-				return it->second;
+				uint16_t handle = it->second;
+				m_alloc.touch(handle);
+				++m_numHit;
+				return m_data[handle].m_id;
 			}
 
+			++m_numMiss;
 			return UINT32_MAX;
 		}
 
@@ -1030,8 +1088,10 @@ namespace bgfx { namespace gl
 			HashMap::iterator it = m_hashMap.find(_hash);
 			if (it != m_hashMap.end() )
 			{
-				GL_CHECK(glDeleteVertexArrays(1, &it->second) );
+				uint16_t handle = it->second;
+				m_alloc.free(handle);
 				m_hashMap.erase(it);
+				GL_CHECK(glDeleteVertexArrays(1, &m_data[handle].m_id) );
 			}
 		}
 
@@ -1039,11 +1099,14 @@ namespace bgfx { namespace gl
 		{
 			GL_CHECK(glBindVertexArray(0) );
 
-			for (HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (uint16_t ii = 0, num = m_alloc.getNumHandles(); ii < num; ++ii)
 			{
-				GL_CHECK(glDeleteVertexArrays(1, &it->second) );
+				uint16_t handle = m_alloc.getHandleAt(ii);
+				GL_CHECK(glDeleteVertexArrays(1, &m_data[handle].m_id) );
 			}
+
 			m_hashMap.clear();
+			m_alloc.reset();
 		}
 
 		uint32_t getCount() const
@@ -1051,9 +1114,37 @@ namespace bgfx { namespace gl
 			return uint32_t(m_hashMap.size() );
 		}
 
+		void resetStats()
+		{
+			m_numHit   = 0;
+			m_numMiss  = 0;
+			m_numEvict = 0;
+		}
+
+		uint32_t m_numHit;
+		uint32_t m_numMiss;
+		uint32_t m_numEvict;
+
 	private:
-		typedef stl::unordered_map<uint32_t, GLuint> HashMap;
+		void evict(uint16_t _handle)
+		{
+			if (m_alloc.isValid(_handle) )
+			{
+				invalidate(m_data[_handle].m_hash);
+			}
+		}
+
+		typedef stl::unordered_map<uint32_t, uint16_t> HashMap;
 		HashMap m_hashMap;
+		bx::HandleAllocLruT<BGFX_CONFIG_MAX_VAO_CACHE> m_alloc;
+
+		struct Data
+		{
+			uint32_t m_hash;
+			GLuint   m_id;
+		};
+
+		Data m_data[BGFX_CONFIG_MAX_VAO_CACHE];
 	};
 
 	class VaoCacheRef
@@ -1081,14 +1172,32 @@ namespace bgfx { namespace gl
 	class SamplerStateCache
 	{
 	public:
+		SamplerStateCache()
+		{
+			resetStats();
+		}
+
 		GLuint add(uint32_t _hash)
 		{
 			invalidate(_hash);
 
+			uint16_t handle = m_alloc.alloc();
+			if (UINT16_MAX == handle)
+			{
+				evict(m_alloc.getBack() );
+				handle = m_alloc.alloc();
+				++m_numEvict;
+			}
+
+			BX_CHECK(UINT16_MAX != handle, "Failed to find handle.");
+
 			GLuint samplerId;
 			GL_CHECK(glGenSamplers(1, &samplerId) );
 
-			m_hashMap.insert(stl::make_pair(_hash, samplerId) );
+			Data& data = m_data[handle];
+			data.m_hash = _hash;
+			data.m_id   = samplerId;
+			m_hashMap.insert(stl::make_pair(_hash, handle) );
 
 			return samplerId;
 		}
@@ -1098,9 +1207,13 @@ namespace bgfx { namespace gl
 			HashMap::iterator it = m_hashMap.find(_hash);
 			if (it != m_hashMap.end() )
 			{
-				return it->second;
+				uint16_t handle = it->second;
+				m_alloc.touch(handle);
+				++m_numHit;
+				return m_data[handle].m_id;
 			}
 
+			++m_numMiss;
 			return UINT32_MAX;
 		}
 
@@ -1109,18 +1222,23 @@ namespace bgfx { namespace gl
 			HashMap::iterator it = m_hashMap.find(_hash);
 			if (it != m_hashMap.end() )
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
+				uint16_t handle = it->second;
+				m_alloc.free(handle);
 				m_hashMap.erase(it);
+				GL_CHECK(glDeleteSamplers(1, &m_data[handle].m_id) );
 			}
 		}
 
 		void invalidate()
 		{
-			for (HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (uint16_t ii = 0, num = m_alloc.getNumHandles(); ii < num; ++ii)
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
+				uint16_t handle = m_alloc.getHandleAt(ii);
+				GL_CHECK(glDeleteSamplers(1, &m_data[handle].m_id) );
 			}
+
 			m_hashMap.clear();
+			m_alloc.reset();
 		}
 
 		uint32_t getCount() const
@@ -1128,9 +1246,37 @@ namespace bgfx { namespace gl
 			return uint32_t(m_hashMap.size() );
 		}
 
+		void resetStats()
+		{
+			m_numHit   = 0;
+			m_numMiss  = 0;
+			m_numEvict = 0;
+		}
+
+		uint32_t m_numHit;
+		uint32_t m_numMiss;
+		uint32_t m_numEvict;
+
 	private:
-		typedef stl::unordered_map<uint32_t, GLuint> HashMap;
+		void evict(uint16_t _handle)
+		{
+			if (m_alloc.isValid(_handle) )
+			{
+				invalidate(m_data[_handle].m_hash);
+			}
+		}
+
+		typedef stl::unordered_map<uint32_t, uint16_t> HashMap;
 		HashMap m_hashMap;
+		bx::HandleAllocLruT<BGFX_CONFIG_MAX_SAMPLER_CACHE> m_alloc;
+
+		struct Data
+		{
+			uint32_t m_hash;
+			GLuint   m_id;
+		};
+
+		Data m_data[BGFX_CONFIG_MAX_SAMPLER_CACHE];
 	};
 
 	struct IndexBufferGL
@@ -1178,6 +1324,8 @@ namespace bgfx { namespace gl
 			m_vcref.add(_hash);
 		}
 
+		void setUniform(uint32_t _loc, UniformType::Enum _type, const void* _data, uint32_t _num);
+
 		GLuint m_id;
 		uint32_t m_size;
 		VaoCacheRef m_vcref;
@@ -1331,12 +1479,42 @@ namespace bgfx { namespace gl
 		Attachment m_attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
 	};
 
+	struct UniformBlockGL
+	{
+		UniformBlockGL()
+			: m_data(NULL)
+			, m_size(0)
+			, m_offset(0)
+			, m_generation(0)
+			, m_dirty(false)
+		{
+		}
+
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_offset;
+		uint32_t m_generation;
+		bool m_dirty;
+	};
+
 	struct ProgramGL
 	{
+		struct UniformBlock
+		{
+			enum Enum
+			{
+				Vertex,
+				Fragment,
+
+				Count
+			};
+		};
+
 		ProgramGL()
 			: m_id(0)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
+			, m_drawData(false)
 		{
 		}
 
@@ -1382,9 +1560,11 @@ namespace bgfx { namespace gl
 		uint8_t m_numSamplers;
 
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count*UniformBlock::Count];
 		uint8_t m_numPredefined;
+		UniformBlockGL m_uniformBlock[UniformBlock::Count];
 		VaoCacheRef m_vcref;
+		bool m_drawData; // Vertex shader reads per-draw data by gl_DrawIDARB.
 	};
 
 	struct TimerQueryGL
@@ -1517,6 +1697,111 @@ namespace bgfx { namespace gl
 		bx::RingBufferControl m_control;
 	};
 
+	struct MultiDrawGL
+	{
+		struct Command
+		{
+			uint32_t m_count;
+			uint32_t m_instanceCount;
+			uint32_t m_firstIndex;
+			int32_t  m_baseVertex;
+			uint32_t m_baseInstance;
+		};
+
+		MultiDrawGL()
+			: m_id(0)
+			, m_offset(0)
+			, m_num(0)
+		{
+		}
+
+		void create();
+		void destroy();
+		uintptr_t flush();
+
+		void add(uint32_t _numIndices, uint32_t _numInstances, uint32_t _startIndex, int32_t _baseVertex)
+		{
+			BX_CHECK(!isFull(), "Multi-draw batch is full.");
+
+			Command& cmd = m_cmd[m_num++];
+			cmd.m_count         = _numIndices;
+			cmd.m_instanceCount = _numInstances;
+			cmd.m_firstIndex    = _startIndex;
+			cmd.m_baseVertex    = _baseVertex;
+			cmd.m_baseInstance  = 0;
+		}
+
+		bool isFull() const
+		{
+			return BX_COUNTOF(m_cmd) == m_num;
+		}
+
+		GLuint m_id;
+		uint32_t m_offset;
+		uint32_t m_num;
+		Command m_cmd[BGFX_CONFIG_MAX_MULTI_DRAW_BATCH];
+	};
+
+	// Per-draw data read by vertex shader through gl_DrawIDARB, see
+	// DRAW_DATA_BUFFER in bgfx_shader.sh. Layout matches std430 DrawData.
+	struct DrawDataGL
+	{
+		struct Data
+		{
+			float m_model[16];
+			float m_params[4];
+		};
+
+		DrawDataGL()
+			: m_id(0)
+			, m_offset(0)
+			, m_align(16)
+			, m_num(0)
+		{
+		}
+
+		void create(uint32_t _align);
+		void destroy();
+		void flush();
+
+		void add(const float* _model, const float* _params)
+		{
+			BX_CHECK(BX_COUNTOF(m_data) > m_num, "Draw data batch is full.");
+
+			Data& data = m_data[m_num++];
+			bx::memCopy(data.m_model,  _model,  sizeof(data.m_model)  );
+			bx::memCopy(data.m_params, _params, sizeof(data.m_params) );
+		}
+
+		GLuint m_id;
+		uint32_t m_offset;
+		uint32_t m_align;
+		uint32_t m_num;
+		Data m_data[BGFX_CONFIG_MAX_MULTI_DRAW_BATCH];
+	};
+
+	struct UniformRingGL
+	{
+		UniformRingGL()
+			: m_id(0)
+			, m_size(0)
+			, m_offset(0)
+			, m_align(16)
+			, m_generation(0)
+		{
+		}
+
+		void create(uint32_t _size, uint32_t _align);
+		void destroy();
+		uint32_t write(const void* _data, uint32_t _size);
+
+		GLuint m_id;
+		uint32_t m_size;
+		uint32_t m_offset;
+		uint32_t m_align;
+		uint32_t m_generation;
+	};
+
 } /* namespace gl */ } // namespace bgfx
 
 #endif // BGFX_RENDERER_GL_H_HEADER_GUARD
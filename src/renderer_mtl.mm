@@ -370,7 +370,18 @@ namespace bgfx { namespace mtl
 			BX_TRACE("Init.");
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
+			const FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			m_windows.create(g_caps.limits.maxFrameBuffers);
+			m_windows.fill(invalid);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			if (NULL != NSClassFromString(@"MTKView") )
@@ -651,12 +662,12 @@ namespace bgfx { namespace mtl
 			m_occlusionQuery.postReset();
 			m_gpuTimer.shutdown();
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_shaders); ++ii)
+			for (uint32_t ii = 0; ii < m_shaders.getNum(); ++ii)
 			{
 				m_shaders[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].destroy();
 			}
@@ -1185,7 +1196,7 @@ namespace bgfx { namespace mtl
 				murmur.add( (uint32_t)sampleCount);
 				m_backBufferPixelFormatHash = murmur.end();
 
-				for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+				for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 				{
 					m_frameBuffers[ii].postReset();
 				}
@@ -1762,17 +1773,17 @@ namespace bgfx { namespace mtl
 		uint8_t  m_bufferIndex;
 
 		uint16_t          m_numWindows;
-		FrameBufferHandle m_windows[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-
-		IndexBufferMtl  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferMtl m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderMtl       m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramMtl      m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureMtl      m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		FrameBufferMtl  m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		VertexDecl      m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
+		ResourceArrayT<FrameBufferHandle> m_windows;
+
+		ResourceArrayT<IndexBufferMtl>  m_indexBuffers;
+		ResourceArrayT<VertexBufferMtl> m_vertexBuffers;
+		ResourceArrayT<ShaderMtl>       m_shaders;
+		ResourceArrayT<ProgramMtl>      m_program;
+		ResourceArrayT<TextureMtl>      m_textures;
+		ResourceArrayT<FrameBufferMtl>  m_frameBuffers;
+		ResourceArrayT<VertexDecl>      m_vertexDecls;
 		UniformRegistry m_uniformReg;
-		void*           m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<void*>           m_uniforms;
 
 		StateCacheT<DepthStencilState> m_depthStencilStateCache;
 		StateCacheT<SamplerState>      m_samplerStateCache;
@@ -3177,8 +3188,7 @@ namespace bgfx { namespace mtl
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
-		RenderBind currentBind;
-		currentBind.clear();
+		StateTracker stateTracker;
 
 		_render->m_hmdInitialized = false;
 
@@ -3192,7 +3202,7 @@ namespace bgfx { namespace mtl
 		uint16_t programIdx = invalidHandle;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 
 		BlitState bs(_render);
 
@@ -3204,6 +3214,7 @@ namespace bgfx { namespace mtl
 		RenderCommandEncoder rce;
 
 		bool wasCompute = false;
+		bool resetState = false;
 		bool viewHasScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
@@ -3450,7 +3461,14 @@ namespace bgfx { namespace mtl
 					}
 				}
 
-				bool resetState = viewChanged || wasCompute;
+				// Reset is kept pending until draw that is not occlusion
+				// culled, so that first visible draw sets all state.
+				if (viewChanged
+				||  wasCompute)
+				{
+					resetState = true;
+					stateTracker.invalidate();
+				}
 
 				if (wasCompute)
 				{
@@ -3482,6 +3500,8 @@ namespace bgfx { namespace mtl
 
 				if (resetState)
 				{
+					resetState = false;
+
 					currentState.clear();
 					currentState.m_scissor = !draw.m_scissor;
 					changedFlags = BGFX_STATE_MASK;
@@ -3489,8 +3509,6 @@ namespace bgfx { namespace mtl
 					currentState.m_stateFlags = newFlags;
 					currentState.m_stencil    = newStencil;
 
-					currentBind.clear();
-
 					programIdx = invalidHandle;
 					setDepthStencilState(newFlags, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT) );
 
@@ -3545,6 +3563,12 @@ namespace bgfx { namespace mtl
 					rce.setScissorRect(rc);
 				}
 
+				if (!stateTracker.setState(newFlags, newStencil, draw.m_rgba) )
+				{
+					changedFlags   = 0;
+					changedStencil = 0;
+				}
+
 				if ( (BGFX_STATE_DEPTH_WRITE|BGFX_STATE_DEPTH_TEST_MASK) & changedFlags
 				|| 0 != changedStencil)
 				{
@@ -3595,7 +3619,7 @@ namespace bgfx { namespace mtl
 				bool constantsChanged = draw.m_constBegin < draw.m_constEnd;
 				rendererUpdateUniforms(this, _render->m_uniformBuffer, draw.m_constBegin, draw.m_constEnd);
 
-				if (key.m_program != programIdx
+				if (stateTracker.setProgram(key.m_program)
 				|| (BGFX_STATE_BLEND_MASK|BGFX_STATE_BLEND_EQUATION_MASK|BGFX_STATE_ALPHA_WRITE|BGFX_STATE_RGB_WRITE|BGFX_STATE_BLEND_INDEPENDENT|BGFX_STATE_MSAA|BGFX_STATE_BLEND_ALPHA_TO_COVERAGE) & changedFlags
 				||  currentState.m_streamMask             != draw.m_streamMask
 				||  currentState.m_stream[0].m_handle.idx != draw.m_stream[0].m_handle.idx
@@ -3634,6 +3658,7 @@ namespace bgfx { namespace mtl
 						{
 							currentProgram = NULL;
 							programIdx = invalidHandle;
+							stateTracker.invalidateProgram();
 							continue;
 						}
 
@@ -3696,14 +3721,18 @@ namespace bgfx { namespace mtl
 						usedFragmentSamplerStages = program.m_usedFragmentSamplerStages;
 					}
 
+					// Texture is bound only to stages used by program, so
+					// program change requires all stages to be rebound.
+					if (programChanged)
+					{
+						stateTracker.invalidateBindings();
+					}
+
 					for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 					{
 						const Binding& bind = renderBind.m_bind[stage];
-						Binding& current = currentBind.m_bind[stage];
 
-						if (current.m_idx                      != bind.m_idx
-						||  current.m_un.m_draw.m_textureFlags != bind.m_un.m_draw.m_textureFlags
-						||  programChanged)
+						if (stateTracker.setBinding(stage, bind) )
 						{
 							if (invalidHandle != bind.m_idx)
 							{
@@ -3715,8 +3744,6 @@ namespace bgfx { namespace mtl
 									);
 							}
 						}
-
-						current = bind;
 					}
 				}
 
@@ -3891,6 +3918,7 @@ namespace bgfx { namespace mtl
 		perfStats.numDraw       = statsKeyType[0];
 		perfStats.numCompute    = statsKeyType[1];
 		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
 
 		rce.setTriangleFillMode(MTLTriangleFillModeFill);
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
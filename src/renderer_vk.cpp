@@ -726,7 +726,15 @@ VK_IMPORT_DEVICE
 			ErrorState::Enum errorState = ErrorState::Default;
 
 			m_fbh.idx = invalidHandle;
-			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_indexBuffers.create(g_caps.limits.maxIndexBuffers);
+			m_vertexBuffers.create(g_caps.limits.maxVertexBuffers);
+			m_shaders.create(g_caps.limits.maxShaders);
+			m_program.create(g_caps.limits.maxPrograms);
+			m_textures.create(g_caps.limits.maxTextures);
+			m_vertexDecls.create(g_caps.limits.maxVertexDecls);
+			m_frameBuffers.create(g_caps.limits.maxFrameBuffers);
+			m_uniforms.create(g_caps.limits.maxUniforms);
+			m_uniformReg.create(g_caps.limits.maxUniforms);
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			bool imported = true;
@@ -1833,27 +1841,27 @@ VK_IMPORT_DEVICE
 				m_scratchBuffer[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_frameBuffers.getNum(); ++ii)
 			{
 				m_frameBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_indexBuffers.getNum(); ++ii)
 			{
 				m_indexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffers); ++ii)
+			for (uint32_t ii = 0; ii < m_vertexBuffers.getNum(); ++ii)
 			{
 				m_vertexBuffers[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_shaders); ++ii)
+			for (uint32_t ii = 0; ii < m_shaders.getNum(); ++ii)
 			{
 				m_shaders[ii].destroy();
 			}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_textures); ++ii)
+			for (uint32_t ii = 0; ii < m_textures.getNum(); ++ii)
 			{
 				m_textures[ii].destroy();
 			}
@@ -3017,14 +3025,14 @@ VK_IMPORT_DEVICE
 		void* m_renderdocdll;
 		void* m_vulkan1dll;
 
-		IndexBufferVK m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferVK m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderVK m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramVK m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureVK m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexDecl m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		FrameBufferVK m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		ResourceArrayT<IndexBufferVK> m_indexBuffers;
+		ResourceArrayT<VertexBufferVK> m_vertexBuffers;
+		ResourceArrayT<ShaderVK> m_shaders;
+		ResourceArrayT<ProgramVK> m_program;
+		ResourceArrayT<TextureVK> m_textures;
+		ResourceArrayT<VertexDecl> m_vertexDecls;
+		ResourceArrayT<FrameBufferVK> m_frameBuffers;
+		ResourceArrayT<void*> m_uniforms;
 		Matrix4 m_predefinedUniforms[PredefinedUniform::Count];
 		UniformRegistry m_uniformReg;
 
@@ -3666,9 +3674,12 @@ VK_DESTROY
 		bool     hasPredefined          = false;
 		bool     commandListChanged     = false;
 		VkPipeline currentPipeline = VK_NULL_HANDLE;
+		uint16_t currentDeclIdx         = invalidHandle;
+		uint8_t  currentNumInstanceData = 0;
+		StateTracker stateTracker;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
-		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
+		FrameBufferHandle fbh = { reservedHandle };
 
 		BlitState bs(_render);
 
@@ -4057,6 +4068,8 @@ BX_UNUSED(currentSamplerStateIdx);
 					currentState.m_stateFlags = newFlags;
 					currentState.m_stencil    = newStencil;
 
+					stateTracker.invalidate();
+
 					const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
@@ -4074,17 +4087,34 @@ BX_UNUSED(currentSamplerStateIdx);
 					const VertexBufferVK& vb = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
 					uint16_t declIdx = !isValid(vb.m_decl) ? draw.m_stream[0].m_decl.idx : vb.m_decl.idx;
 
-					VkPipeline pipeline =
-						getPipeline(state
+					// Pipeline lookup is skipped when nothing it depends on
+					// changed since previous draw.
+					const uint8_t numInstanceData = uint8_t(draw.m_instanceDataStride/16);
+					const bool stateChanged   = stateTracker.setState(state, draw.m_stencil, draw.m_rgba);
+					const bool programChanged = stateTracker.setProgram(key.m_program);
+
+					VkPipeline pipeline = currentPipeline;
+					if (VK_NULL_HANDLE == pipeline
+					||  stateChanged
+					||  programChanged
+					||  currentDeclIdx         != declIdx
+					||  currentNumInstanceData != numInstanceData)
+					{
+						currentDeclIdx         = declIdx;
+						currentNumInstanceData = numInstanceData;
+
+						pipeline = getPipeline(state
 							, draw.m_stencil
 							, declIdx
 							, key.m_program
-							, uint8_t(draw.m_instanceDataStride/16)
+							, numInstanceData
 							);
+					}
 
 					uint16_t scissor = draw.m_scissor;
 					uint32_t bindHash = bx::hashMurmur2A(renderBind.m_bind, sizeof(renderBind.m_bind) );
-					if (currentBindHash != bindHash
+					const bool bindChanged = stateTracker.setBindHash(bindHash);
+					if (bindChanged
 					||  0 != changedStencil
 					|| (hasFactor && blendFactor != draw.m_rgba)
 					|| (0 != (BGFX_STATE_PT_MASK & changedFlags)
@@ -4390,6 +4420,7 @@ BX_UNUSED(presentMin, presentMax);
 //		perfStats.numDraw       = statsKeyType[0];
 //		perfStats.numCompute    = statsKeyType[1];
 //		perfStats.maxGpuLatency = maxGpuLatency;
+		stateTracker.getStats(perfStats);
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
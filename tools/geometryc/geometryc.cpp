@@ -4,6 +4,7 @@
  */
 
 #include <algorithm>
+#include <deque>
 #include <vector>
 #include <string>
 #include <stdio.h>
@@ -20,10 +21,16 @@ namespace stl = tinystl;
 
 #include <forsyth-too/forsythtriangleorderoptimizer.h>
 #include <ib-compress/indexbuffercompression.h>
+#include <ib-compress/indexbufferdecompression.h>
 
 #define BGFX_GEOMETRYC_VERSION_MAJOR 1
 #define BGFX_GEOMETRYC_VERSION_MINOR 0
 
+#define BGFX_GEOMETRYC_MAX_LODS 8
+
+#define BGFX_GEOMETRYC_MESHLET_MAX_VERTICES  64
+#define BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES 124
+
 #if 0
 #	define BX_TRACE(_format, ...) \
 		do { \
@@ -65,6 +72,7 @@ namespace stl = tinystl;
 #include <bx/uint32_t.h>
 #include <bx/fpumath.h>
 #include <bx/crtimpl.h>
+#include <bx/thread.h>
 
 #include "bounds.h"
 
@@ -111,6 +119,8 @@ struct Primitive
 	uint32_t m_startIndex;
 	uint32_t m_numVertices;
 	uint32_t m_numIndices;
+	uint8_t  m_lod;
+	float    m_lodError;
 	std::string m_name;
 };
 
@@ -119,9 +129,42 @@ typedef std::vector<Primitive> PrimitiveArray;
 static uint32_t s_obbSteps = 17;
 
 #define BGFX_CHUNK_MAGIC_VB  BX_MAKEFOURCC('V', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_VB32 BX_MAKEFOURCC('V', 'B', ' ', 0x2)
+#define BGFX_CHUNK_MAGIC_VBQ BX_MAKEFOURCC('V', 'B', ' ', 0x3)
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
+#define BGFX_CHUNK_MAGIC_IB32 BX_MAKEFOURCC('I', 'B', ' ', 0x1)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x0)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_PRIL BX_MAKEFOURCC('P', 'R', 'I', 0x1)
+#define BGFX_CHUNK_MAGIC_MLT BX_MAKEFOURCC('M', 'L', 'T', 0x0)
+
+#define BGFX_CHUNK_MAGIC_MSH BX_MAKEFOURCC('M', 'S', 'H', 0x1)
+#define BGFX_CHUNK_MAGIC_VBM BX_MAKEFOURCC('V', 'B', 'M', 0x0)
+#define BGFX_CHUNK_MAGIC_VBMQ BX_MAKEFOURCC('V', 'B', 'M', 0x1)
+#define BGFX_CHUNK_MAGIC_VBD BX_MAKEFOURCC('V', 'B', 'D', 0x0)
+#define BGFX_CHUNK_MAGIC_IBD BX_MAKEFOURCC('I', 'B', 'D', 0x0)
+
+#define BGFX_MESH_CHUNK_ALIGN 16
+
+struct MeshChunk
+{
+	uint32_t m_chunk;
+	uint32_t m_flags;
+	std::vector<uint8_t> m_data;
+};
+
+typedef std::vector<MeshChunk> MeshChunkArray;
+
+struct Meshlet
+{
+	Sphere   m_sphere;
+	float    m_coneAxis[3];
+	float    m_coneCutoff;
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+};
+
+typedef std::vector<Meshlet> MeshletArray;
 
 long int fsize(FILE* _file)
 {
@@ -132,252 +175,2556 @@ long int fsize(FILE* _file)
 	return size;
 }
 
-void triangleReorder(uint16_t* _indices, uint32_t _numIndices, uint32_t _numVertices, uint16_t _cacheSize)
+void triangleReorder(uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices, uint16_t _cacheSize)
 {
-	uint16_t* newIndexList = new uint16_t[_numIndices];
+	uint32_t* newIndexList = new uint32_t[_numIndices];
 	Forsyth::OptimizeFaces(_indices, _numIndices, _numVertices, newIndexList, _cacheSize);
-	memcpy(_indices, newIndexList, _numIndices*2);
+	memcpy(_indices, newIndexList, _numIndices*sizeof(uint32_t) );
 	delete [] newIndexList;
 }
 
-void triangleCompress(bx::WriterI* _writer, uint16_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
+struct VertexCacheStats
 {
-	uint32_t* vertexRemap = (uint32_t*)malloc(_numVertices*sizeof(uint32_t) );
+	uint32_t m_numTriangles;
+	uint32_t m_numVertices;
+	uint32_t m_numMisses;
+	uint32_t m_vertexSize;
+	uint32_t m_fetchSize;
+};
 
-	WriteBitstream writer;
-	CompressIndexBuffer(_indices, _numIndices/3, vertexRemap, _numVertices, IBCF_AUTO, writer);
-	writer.Finish();
-	printf( "uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
-		, _numIndices*2
-		, (uint32_t)writer.ByteSize()
-		, 100.0f - float(writer.ByteSize() ) / float(_numIndices*2)*100.0f
-		);
+#define BGFX_GEOMETRYC_FETCH_LINE_SIZE  64
+#define BGFX_GEOMETRYC_FETCH_CACHE_SIZE 64
 
-	BX_UNUSED(_vertexData, _stride);
-	uint8_t* outVertexData = (uint8_t*)malloc(_numVertices*_stride);
-	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+// Simulates FIFO post-transform cache, and vertex fetch through small cache
+// of fixed size lines. Fetch happens only on post-transform cache miss.
+template<typename IndexT>
+void analyzeVertexCache(VertexCacheStats& _stats
+		, const IndexT* _indices
+		, uint32_t _numIndices
+		, uint32_t _numVertices
+		, uint32_t _stride
+		, uint16_t _cacheSize
+		)
+{
+	const uint32_t numLines = (_numVertices*_stride + BGFX_GEOMETRYC_FETCH_LINE_SIZE - 1) / BGFX_GEOMETRYC_FETCH_LINE_SIZE;
+
+	std::vector<uint32_t> cache(_numVertices, 0);
+	std::vector<uint32_t> lines(numLines, 0);
+	std::vector<bool> used(_numVertices, false);
+
+	uint32_t time     = _cacheSize + 1;
+	uint32_t lineTime = BGFX_GEOMETRYC_FETCH_CACHE_SIZE + 1;
+
+	_stats.m_numTriangles = _numIndices/3;
+	_stats.m_numVertices  = 0;
+	_stats.m_numMisses    = 0;
+	_stats.m_vertexSize   = 0;
+	_stats.m_fetchSize    = 0;
+
+	for (uint32_t ii = 0; ii < _numIndices; ++ii)
 	{
-		uint32_t remap = vertexRemap[ii];
-		remap = UINT32_MAX == remap ? ii : remap;
-		memcpy(&outVertexData[remap*_stride], &_vertexData[ii*_stride], _stride);
-	}
-	memcpy(_vertexData, outVertexData, _numVertices*_stride);
-	free(outVertexData);
+		const uint32_t index = _indices[ii];
 
-	free(vertexRemap);
+		if (!used[index])
+		{
+			used[index] = true;
+			++_stats.m_numVertices;
+			_stats.m_vertexSize += _stride;
+		}
 
-	bx::write(_writer, writer.RawData(), (uint32_t)writer.ByteSize() );
+		if (time - cache[index] <= _cacheSize)
+		{
+			continue;
+		}
+
+		cache[index] = time++;
+		++_stats.m_numMisses;
+
+		const uint32_t first = (index*_stride) / BGFX_GEOMETRYC_FETCH_LINE_SIZE;
+		const uint32_t last  = (index*_stride + _stride - 1) / BGFX_GEOMETRYC_FETCH_LINE_SIZE;
+		for (uint32_t line = first; line <= last; ++line)
+		{
+			if (lineTime - lines[line] > BGFX_GEOMETRYC_FETCH_CACHE_SIZE)
+			{
+				lines[line] = lineTime++;
+				_stats.m_fetchSize += BGFX_GEOMETRYC_FETCH_LINE_SIZE;
+			}
+		}
+	}
 }
 
-void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexDecl _decl, const uint16_t* _indices, uint32_t _numIndices)
+struct TriangleCluster
 {
-	struct PosTexcoord
-	{
-		float m_x;
-		float m_y;
-		float m_z;
-		float m_pad0;
-		float m_u;
-		float m_v;
-		float m_pad1;
-		float m_pad2;
-	};
-
-	float* tangents = new float[6*_numVertices];
-	memset(tangents, 0, 6*_numVertices*sizeof(float) );
+	uint32_t m_start;
+	uint32_t m_num;
+	float    m_sort;
+};
 
-	PosTexcoord v0;
-	PosTexcoord v1;
-	PosTexcoord v2;
+struct TriangleClusterSort
+{
+	bool operator()(const TriangleCluster& _lhs, const TriangleCluster& _rhs) const
+	{
+		return _lhs.m_sort > _rhs.m_sort;
+	}
+};
 
-	for (uint32_t ii = 0, num = _numIndices/3; ii < num; ++ii)
+// Overdraw optimization based on:
+// Fast Triangle Reordering for Vertex Locality and Reduced Overdraw
+// https://web.archive.org/web/20170410064525/http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/tipsy.pdf
+//
+// Indices must be already vertex cache optimized. Triangle list is split
+// into clusters at points where cache is cold, and where cluster ACMR is
+// within _threshold of total ACMR. Clusters are then sorted so that the
+// ones facing away from the mesh center are drawn first.
+void triangleReorderOverdraw(uint32_t* _indices
+		, uint32_t _numIndices
+		, const float* _positions
+		, uint32_t _numVertices
+		, uint16_t _cacheSize
+		, float _threshold
+		)
+{
+	const uint32_t numTriangles = _numIndices/3;
+	if (2 > numTriangles)
 	{
-		const uint16_t* indices = &_indices[ii*3];
-		uint32_t i0 = indices[0];
-		uint32_t i1 = indices[1];
-		uint32_t i2 = indices[2];
+		return;
+	}
 
-		bgfx::vertexUnpack(&v0.m_x, bgfx::Attrib::Position, _decl, _vertices, i0);
-		bgfx::vertexUnpack(&v0.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i0);
+	std::vector<uint32_t> cache(_numVertices, 0);
+	uint32_t time = _cacheSize + 1;
 
-		bgfx::vertexUnpack(&v1.m_x, bgfx::Attrib::Position, _decl, _vertices, i1);
-		bgfx::vertexUnpack(&v1.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i1);
+	std::vector<uint32_t> misses(numTriangles);
+	std::vector<uint32_t> hardBoundaries;
+	uint32_t totalMisses = 0;
 
-		bgfx::vertexUnpack(&v2.m_x, bgfx::Attrib::Position, _decl, _vertices, i2);
-		bgfx::vertexUnpack(&v2.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i2);
+	for (uint32_t ii = 0; ii < numTriangles; ++ii)
+	{
+		uint32_t numMisses = 0;
+		for (uint32_t edge = 0; edge < 3; ++edge)
+		{
+			const uint32_t index = _indices[ii*3+edge];
+			if (time - cache[index] > _cacheSize)
+			{
+				cache[index] = time++;
+				++numMisses;
+			}
+		}
 
-		const float bax = v1.m_x - v0.m_x;
-		const float bay = v1.m_y - v0.m_y;
-		const float baz = v1.m_z - v0.m_z;
-		const float bau = v1.m_u - v0.m_u;
-		const float bav = v1.m_v - v0.m_v;
+		if (3 == numMisses)
+		{
+			hardBoundaries.push_back(ii);
+		}
 
-		const float cax = v2.m_x - v0.m_x;
-		const float cay = v2.m_y - v0.m_y;
-		const float caz = v2.m_z - v0.m_z;
-		const float cau = v2.m_u - v0.m_u;
-		const float cav = v2.m_v - v0.m_v;
+		misses[ii]   = numMisses;
+		totalMisses += numMisses;
+	}
+	hardBoundaries.push_back(numTriangles);
 
-		const float det = (bau * cav - bav * cau);
-		const float invDet = 1.0f / det;
+	const float acmrThreshold = _threshold * float(totalMisses) / float(numTriangles);
 
-		const float tx = (bax * cav - cax * bav) * invDet;
-		const float ty = (bay * cav - cay * bav) * invDet;
-		const float tz = (baz * cav - caz * bav) * invDet;
+	std::vector<TriangleCluster> clusters;
+	for (uint32_t hh = 0, start = 0; hh < hardBoundaries.size(); ++hh)
+	{
+		const uint32_t end = hardBoundaries[hh];
+		if (start == end)
+		{
+			continue;
+		}
 
-		const float bx = (cax * bau - bax * cau) * invDet;
-		const float by = (cay * bau - bay * cau) * invDet;
-		const float bz = (caz * bau - baz * cau) * invDet;
+		// Cache is reset at the start of each cluster, resimulate misses.
+		time += _cacheSize + 1;
 
-		for (uint32_t jj = 0; jj < 3; ++jj)
+		TriangleCluster cluster;
+		cluster.m_start = start;
+		uint32_t clusterMisses = 0;
+
+		for (uint32_t ii = start; ii < end; ++ii)
 		{
-			float* tanu = &tangents[indices[jj]*6];
-			float* tanv = &tanu[3];
-			tanu[0] += tx;
-			tanu[1] += ty;
-			tanu[2] += tz;
+			for (uint32_t edge = 0; edge < 3; ++edge)
+			{
+				const uint32_t index = _indices[ii*3+edge];
+				if (time - cache[index] > _cacheSize)
+				{
+					cache[index] = time++;
+					++clusterMisses;
+				}
+			}
 
-			tanv[0] += bx;
-			tanv[1] += by;
-			tanv[2] += bz;
+			const uint32_t num = ii - cluster.m_start + 1;
+			if (ii + 1 == end
+			||  float(clusterMisses) <= acmrThreshold * float(num) )
+			{
+				cluster.m_num = num;
+				clusters.push_back(cluster);
+
+				cluster.m_start = ii + 1;
+				clusterMisses = 0;
+				time += _cacheSize + 1;
+			}
 		}
+
+		start = end;
 	}
 
-	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+	if (2 > clusters.size() )
 	{
-		const float* tanu = &tangents[ii*6];
-		const float* tanv = &tangents[ii*6 + 3];
+		return;
+	}
 
-		float normal[4];
-		bgfx::vertexUnpack(normal, bgfx::Attrib::Normal, _decl, _vertices, ii);
-		float ndt = bx::vec3Dot(normal, tanu);
+	float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
 
-		float nxt[3];
-		bx::vec3Cross(nxt, normal, tanu);
+	std::vector<float> clusterData(clusters.size()*6);
 
-		float tmp[3];
-		tmp[0] = tanu[0] - normal[0] * ndt;
-		tmp[1] = tanu[1] - normal[1] * ndt;
-		tmp[2] = tanu[2] - normal[2] * ndt;
+	for (uint32_t cc = 0, numClusters = uint32_t(clusters.size() ); cc < numClusters; ++cc)
+	{
+		const TriangleCluster& cluster = clusters[cc];
 
-		float tangent[4];
-		bx::vec3Norm(tangent, tmp);
+		float center[3] = { 0.0f, 0.0f, 0.0f };
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+		float area = 0.0f;
 
-		tangent[3] = bx::vec3Dot(nxt, tanv) < 0.0f ? -1.0f : 1.0f;
-		bgfx::vertexPack(tangent, true, bgfx::Attrib::Tangent, _decl, _vertices, ii);
-	}
+		for (uint32_t ii = cluster.m_start, end = cluster.m_start + cluster.m_num; ii < end; ++ii)
+		{
+			const float* p0 = &_positions[_indices[ii*3+0]*3];
+			const float* p1 = &_positions[_indices[ii*3+1]*3];
+			const float* p2 = &_positions[_indices[ii*3+2]*3];
 
-	delete [] tangents;
-}
+			float e10[3];
+			float e20[3];
+			bx::vec3Sub(e10, p1, p0);
+			bx::vec3Sub(e20, p2, p0);
 
-void write(bx::WriterI* _writer, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
-{
-	Sphere maxSphere;
-	calcMaxBoundingSphere(maxSphere, _vertices, _numVertices, _stride);
+			float cross[3];
+			bx::vec3Cross(cross, e10, e20);
+			const float triArea = bx::vec3Length(cross);
 
-	Sphere minSphere;
-	calcMinBoundingSphere(minSphere, _vertices, _numVertices, _stride);
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				center[jj] += (p0[jj] + p1[jj] + p2[jj]) * triArea / 3.0f;
+				normal[jj] += cross[jj];
+			}
 
-	if (minSphere.m_radius > maxSphere.m_radius)
+			area += triArea;
+		}
+
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			meshCenter[jj] += center[jj];
+			center[jj] = 0.0f < area ? center[jj]/area : 0.0f;
+		}
+
+		meshArea += area;
+
+		float* data = &clusterData[cc*6];
+		bx::vec3Move(&data[0], center);
+		const float len = bx::vec3Length(normal);
+		bx::vec3Mul(&data[3], normal, 0.0f < len ? 1.0f/len : 0.0f);
+	}
+
+	if (0.0f < meshArea)
 	{
-		bx::write(_writer, maxSphere);
+		bx::vec3Mul(meshCenter, meshCenter, 1.0f/meshArea);
 	}
-	else
+
+	for (uint32_t cc = 0, numClusters = uint32_t(clusters.size() ); cc < numClusters; ++cc)
 	{
-		bx::write(_writer, minSphere);
+		const float* data = &clusterData[cc*6];
+		float dir[3];
+		bx::vec3Sub(dir, &data[0], meshCenter);
+		clusters[cc].m_sort = bx::vec3Dot(dir, &data[3]);
 	}
 
-	Aabb aabb;
-	toAabb(aabb, _vertices, _numVertices, _stride);
-	bx::write(_writer, aabb);
+	std::stable_sort(clusters.begin(), clusters.end(), TriangleClusterSort() );
 
-	Obb obb;
-	calcObb(obb, _vertices, _numVertices, _stride, s_obbSteps);
-	bx::write(_writer, obb);
+	std::vector<uint32_t> newIndices(_numIndices);
+	uint32_t* dst = &newIndices[0];
+	for (std::vector<TriangleCluster>::const_iterator it = clusters.begin(); it != clusters.end(); ++it)
+	{
+		memcpy(dst, &_indices[it->m_start*3], it->m_num*3*sizeof(uint32_t) );
+		dst += it->m_num*3;
+	}
+
+	memcpy(_indices, &newIndices[0], _numIndices*sizeof(uint32_t) );
 }
 
-void write(bx::WriterI* _writer
-		, const uint8_t* _vertices
-		, uint32_t _numVertices
-		, const bgfx::VertexDecl& _decl
-		, const uint16_t* _indices
-		, uint32_t _numIndices
-		, const uint8_t* _compressedIndices
-		, uint32_t _compressedSize
-		, const std::string& _material
-		, const PrimitiveArray& _primitives
-		)
+struct Quadric
 {
-	using namespace bx;
-	using namespace bgfx;
+	float m_a00;
+	float m_a11;
+	float m_a22;
+	float m_a01;
+	float m_a02;
+	float m_a12;
+	float m_b0;
+	float m_b1;
+	float m_b2;
+	float m_c;
+	float m_weight;
+};
 
-	uint32_t stride = _decl.getStride();
-	write(_writer, BGFX_CHUNK_MAGIC_VB);
-	write(_writer, _vertices, _numVertices, stride);
+void quadricAdd(Quadric& _result, const Quadric& _q)
+{
+	_result.m_a00 += _q.m_a00;
+	_result.m_a11 += _q.m_a11;
+	_result.m_a22 += _q.m_a22;
+	_result.m_a01 += _q.m_a01;
+	_result.m_a02 += _q.m_a02;
+	_result.m_a12 += _q.m_a12;
+	_result.m_b0  += _q.m_b0;
+	_result.m_b1  += _q.m_b1;
+	_result.m_b2  += _q.m_b2;
+	_result.m_c   += _q.m_c;
+	_result.m_weight += _q.m_weight;
+}
 
-	write(_writer, _decl);
+void quadricFromTriangle(Quadric& _result, const float* _p0, const float* _p1, const float* _p2)
+{
+	float e10[3];
+	float e20[3];
+	bx::vec3Sub(e10, _p1, _p0);
+	bx::vec3Sub(e20, _p2, _p0);
 
-	write(_writer, uint16_t(_numVertices) );
-	write(_writer, _vertices, _numVertices*stride);
+	float normal[3];
+	bx::vec3Cross(normal, e10, e20);
+	const float len = bx::vec3Length(normal);
+	const float area = len * 0.5f;
 
-	if (NULL != _compressedIndices)
-	{
-		write(_writer, BGFX_CHUNK_MAGIC_IBC);
-		write(_writer, _numIndices);
-		write(_writer, _compressedSize);
-		write(_writer, _compressedIndices, _compressedSize);
-	}
-	else
+	if (0.0f < len)
 	{
-		write(_writer, BGFX_CHUNK_MAGIC_IB);
-		write(_writer, _numIndices);
-		write(_writer, _indices, _numIndices*2);
+		bx::vec3Mul(normal, normal, 1.0f/len);
 	}
 
-	write(_writer, BGFX_CHUNK_MAGIC_PRI);
-	uint16_t nameLen = uint16_t(_material.size() );
-	write(_writer, nameLen);
-	write(_writer, _material.c_str(), nameLen);
-	write(_writer, uint16_t(_primitives.size() ) );
-	for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
-	{
-		const Primitive& prim = *primIt;
-		nameLen = uint16_t(prim.m_name.size() );
-		write(_writer, nameLen);
-		write(_writer, prim.m_name.c_str(), nameLen);
-		write(_writer, prim.m_startIndex);
-		write(_writer, prim.m_numIndices);
-		write(_writer, prim.m_startVertex);
-		write(_writer, prim.m_numVertices);
-		write(_writer, &_vertices[prim.m_startVertex*stride], prim.m_numVertices, stride);
-	}
+	const float dist = -bx::vec3Dot(normal, _p0);
+
+	_result.m_a00 = area * normal[0] * normal[0];
+	_result.m_a11 = area * normal[1] * normal[1];
+	_result.m_a22 = area * normal[2] * normal[2];
+	_result.m_a01 = area * normal[0] * normal[1];
+	_result.m_a02 = area * normal[0] * normal[2];
+	_result.m_a12 = area * normal[1] * normal[2];
+	_result.m_b0  = area * normal[0] * dist;
+	_result.m_b1  = area * normal[1] * dist;
+	_result.m_b2  = area * normal[2] * dist;
+	_result.m_c   = area * dist * dist;
+	_result.m_weight = area;
 }
 
-inline uint32_t rgbaToAbgr(uint8_t _r, uint8_t _g, uint8_t _b, uint8_t _a)
+// Returns distance from quadric planes, weighted by area.
+float quadricError(const Quadric& _q, const float* _pos)
 {
-	return (uint32_t(_r)<<0)
-		 | (uint32_t(_g)<<8)
-		 | (uint32_t(_b)<<16)
-		 | (uint32_t(_a)<<24)
-		 ;
+	const float xx = _pos[0];
+	const float yy = _pos[1];
+	const float zz = _pos[2];
+
+	const float error = 0.0f
+		+ _q.m_a00*xx*xx + _q.m_a11*yy*yy + _q.m_a22*zz*zz
+		+ 2.0f * (_q.m_a01*xx*yy + _q.m_a02*xx*zz + _q.m_a12*yy*zz)
+		+ 2.0f * (_q.m_b0*xx + _q.m_b1*yy + _q.m_b2*zz)
+		+ _q.m_c
+		;
+
+	return 0.0f < _q.m_weight
+		? bx::fsqrt(bx::fmax(error, 0.0f) / _q.m_weight)
+		: 0.0f
+		;
 }
 
-struct GroupSortByMaterial
+struct EdgeCollapse
 {
-	bool operator()(const Group& _lhs, const Group& _rhs)
+	uint32_t m_from;
+	uint32_t m_to;
+	float    m_error;
+};
+
+struct EdgeCollapseSort
+{
+	bool operator()(const EdgeCollapse& _lhs, const EdgeCollapse& _rhs) const
 	{
-		return _lhs.m_material < _rhs.m_material;
+		return _lhs.m_error < _rhs.m_error;
 	}
 };
 
-void help(const char* _error = NULL)
+struct PositionSort
 {
-	if (NULL != _error)
+	bool operator()(uint32_t _lhs, uint32_t _rhs) const
 	{
-		fprintf(stderr, "Error:\n%s\n\n", _error);
+		const float* lhs = &m_positions[_lhs*3];
+		const float* rhs = &m_positions[_rhs*3];
+		if (lhs[0] != rhs[0])
+		{
+			return lhs[0] < rhs[0];
+		}
+
+		if (lhs[1] != rhs[1])
+		{
+			return lhs[1] < rhs[1];
+		}
+
+		return lhs[2] < rhs[2];
 	}
 
-	fprintf(stderr
+	const float* m_positions;
+};
+
+inline bool hasFlipped(const float* _positions, const uint32_t* _tri, uint32_t _from, uint32_t _to)
+{
+	const float* pos[3];
+	const float* newPos[3];
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		pos[ii]    = &_positions[_tri[ii]*3];
+		newPos[ii] = &_positions[(_from == _tri[ii] ? _to : _tri[ii])*3];
+	}
+
+	float e10[3];
+	float e20[3];
+	float normal[3];
+	bx::vec3Sub(e10, pos[1], pos[0]);
+	bx::vec3Sub(e20, pos[2], pos[0]);
+	bx::vec3Cross(normal, e10, e20);
+
+	float newNormal[3];
+	bx::vec3Sub(e10, newPos[1], newPos[0]);
+	bx::vec3Sub(e20, newPos[2], newPos[0]);
+	bx::vec3Cross(newNormal, e10, e20);
+
+	return 0.0f >= bx::vec3Dot(normal, newNormal);
+}
+
+// Maps every wedge (vertex copy with its own attributes) of position _from
+// into wedge of position _to that shares triangle with it. Collapse is
+// rejected when wedge doesn't touch _to, or touches more than one wedge of
+// _to, since that would tear UV or normal seam. Returns largest attribute
+// difference between mapped wedges, or negative value when collapse is not
+// valid.
+float mapWedges(uint32_t* _map
+		, uint32_t _from
+		, uint32_t _to
+		, const uint32_t* _canonical
+		, const uint32_t* _wedgeOffset
+		, const uint32_t* _wedges
+		, const uint32_t* _indices
+		, const uint32_t* _triOffset
+		, const uint32_t* _triList
+		, const float* _attributes
+		, uint32_t _numAttributes
+		)
+{
+	float attribError = 0.0f;
+
+	for (uint32_t ww = _wedgeOffset[_from]; ww < _wedgeOffset[_from+1]; ++ww)
+	{
+		const uint32_t wedge = _wedges[ww];
+		uint32_t target = UINT32_MAX;
+
+		for (uint32_t tt = _triOffset[wedge]; tt < _triOffset[wedge+1]; ++tt)
+		{
+			const uint32_t* tri = &_indices[_triList[tt]*3];
+			for (uint32_t ii = 0; ii < 3; ++ii)
+			{
+				if (_to == _canonical[tri[ii] ])
+				{
+					if (UINT32_MAX != target
+					&&  target != tri[ii])
+					{
+						return -1.0f;
+					}
+
+					target = tri[ii];
+				}
+			}
+		}
+
+		_map[ww - _wedgeOffset[_from] ] = target;
+
+		if (_triOffset[wedge] == _triOffset[wedge+1])
+		{
+			// Wedge is not referenced anymore.
+			continue;
+		}
+
+		if (UINT32_MAX == target)
+		{
+			return -1.0f;
+		}
+
+		float dist = 0.0f;
+		for (uint32_t ii = 0; ii < _numAttributes; ++ii)
+		{
+			const float delta = _attributes[wedge*_numAttributes + ii] - _attributes[target*_numAttributes + ii];
+			dist += delta*delta;
+		}
+
+		attribError = bx::fmax(attribError, bx::fsqrt(dist) );
+	}
+
+	return attribError;
+}
+
+// Simplifies triangle list with quadric error metric edge collapse:
+// Surface Simplification Using Quadric Error Metrics
+// http://www.cs.cmu.edu/~garland/Papers/quadrics.pdf
+//
+// Vertices are never moved, position is collapsed into one of its
+// neighbors. Vertices sharing position (UV and normal seams) are collapsed
+// together, each wedge into wedge on the same side of the seam, so seams
+// can be simplified along their length but never torn. Collapse cost is
+// quadric error plus attribute difference of collapsed wedges scaled by
+// edge length, so that collapses changing UVs or normals are more
+// expensive. Vertices on open borders are never collapsed, so borders
+// between primitives are preserved. Returns number of indices written into
+// _dst, and maximum collapse error in _error.
+uint32_t simplify(uint32_t* _dst
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		, const float* _positions
+		, const float* _attributes
+		, uint32_t _numAttributes
+		, uint32_t _numVertices
+		, uint32_t _targetIndices
+		, float& _error
+		)
+{
+	_error = 0.0f;
+
+	std::vector<uint32_t> indices(_indices, _indices + _numIndices);
+
+	// Find vertices with the same position.
+	std::vector<uint32_t> sorted;
+	std::vector<bool> referenced(_numVertices, false);
+	for (uint32_t ii = 0; ii < _numIndices; ++ii)
+	{
+		if (!referenced[_indices[ii] ])
+		{
+			referenced[_indices[ii] ] = true;
+			sorted.push_back(_indices[ii]);
+		}
+	}
+
+	PositionSort positionSort;
+	positionSort.m_positions = _positions;
+	std::sort(sorted.begin(), sorted.end(), positionSort);
+
+	// Position is identified by its canonical vertex, wedges of position
+	// are stored in _wedges[wedgeOffset[canonical] .. wedgeOffset[canonical+1]).
+	std::vector<uint32_t> canonical(_numVertices);
+	std::vector<uint32_t> wedgeOffset(_numVertices+1, 0);
+	std::vector<uint32_t> wedges;
+	wedges.reserve(sorted.size() );
+
+	uint32_t maxWedges = 1;
+	for (uint32_t ii = 0, num = uint32_t(sorted.size() ); ii < num;)
+	{
+		uint32_t jj = ii + 1;
+		while (jj < num
+		&&    !positionSort(sorted[ii], sorted[jj]) )
+		{
+			++jj;
+		}
+
+		for (uint32_t kk = ii; kk < jj; ++kk)
+		{
+			canonical[sorted[kk] ] = sorted[ii];
+		}
+
+		wedgeOffset[sorted[ii]+1] = jj - ii;
+		maxWedges = bx::uint32_max(maxWedges, jj - ii);
+
+		ii = jj;
+	}
+
+	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+	{
+		wedgeOffset[ii+1] += wedgeOffset[ii];
+	}
+
+	wedges.resize(sorted.size() );
+	{
+		std::vector<uint32_t> fill(wedgeOffset.begin(), wedgeOffset.end()-1);
+		for (std::vector<uint32_t>::const_iterator it = sorted.begin(); it != sorted.end(); ++it)
+		{
+			wedges[fill[canonical[*it] ]++] = *it;
+		}
+	}
+
+	// Lock positions on open border edges.
+	std::vector<bool> locked(_numVertices, false);
+	std::vector<uint64_t> edges;
+	edges.reserve(_numIndices);
+	for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+	{
+		for (uint32_t edge = 0; edge < 3; ++edge)
+		{
+			const uint32_t v0 = canonical[_indices[ii + edge] ];
+			const uint32_t v1 = canonical[_indices[ii + (edge+1)%3] ];
+			edges.push_back( (uint64_t(v0)<<32) | v1);
+		}
+	}
+	std::sort(edges.begin(), edges.end() );
+
+	for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+	{
+		for (uint32_t edge = 0; edge < 3; ++edge)
+		{
+			const uint32_t c0 = canonical[_indices[ii + edge] ];
+			const uint32_t c1 = canonical[_indices[ii + (edge+1)%3] ];
+			const uint64_t reverse = (uint64_t(c1)<<32) | c0;
+			if (!std::binary_search(edges.begin(), edges.end(), reverse) )
+			{
+				locked[c0] = true;
+				locked[c1] = true;
+			}
+		}
+	}
+
+	// Quadrics are accumulated per position.
+	std::vector<Quadric> quadrics(_numVertices);
+	memset(&quadrics[0], 0, _numVertices*sizeof(Quadric) );
+	for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+	{
+		Quadric q;
+		quadricFromTriangle(q
+			, &_positions[_indices[ii+0]*3]
+			, &_positions[_indices[ii+1]*3]
+			, &_positions[_indices[ii+2]*3]
+			);
+
+		for (uint32_t edge = 0; edge < 3; ++edge)
+		{
+			quadricAdd(quadrics[canonical[_indices[ii+edge] ] ], q);
+		}
+	}
+
+	std::vector<uint32_t> triOffset(_numVertices+1);
+	std::vector<uint32_t> triList;
+	std::vector<EdgeCollapse> collapses;
+	std::vector<bool> busy(_numVertices);
+	std::vector<uint32_t> wedgeMap(maxWedges);
+
+	while (indices.size() > _targetIndices)
+	{
+		const uint32_t numIndices = uint32_t(indices.size() );
+
+		// Vertex to triangle adjacency.
+		std::fill(triOffset.begin(), triOffset.end(), 0);
+		for (uint32_t ii = 0; ii < numIndices; ++ii)
+		{
+			++triOffset[indices[ii]+1];
+		}
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			triOffset[ii+1] += triOffset[ii];
+		}
+
+		triList.resize(numIndices);
+		std::vector<uint32_t> fill(triOffset.begin(), triOffset.end()-1);
+		for (uint32_t ii = 0; ii < numIndices; ++ii)
+		{
+			triList[fill[indices[ii] ]++] = ii/3;
+		}
+
+		collapses.clear();
+		for (uint32_t ii = 0; ii < numIndices; ii += 3)
+		{
+			for (uint32_t edge = 0; edge < 3; ++edge)
+			{
+				const uint32_t c0 = canonical[indices[ii + edge] ];
+				const uint32_t c1 = canonical[indices[ii + (edge+1)%3] ];
+				if (c0 == c1)
+				{
+					continue;
+				}
+
+				float e10[3];
+				bx::vec3Sub(e10, &_positions[c1*3], &_positions[c0*3]);
+				const float length = bx::vec3Length(e10);
+
+				if (!locked[c0])
+				{
+					const float attribError = mapWedges(&wedgeMap[0], c0, c1, &canonical[0], &wedgeOffset[0], &wedges[0], &indices[0], &triOffset[0], &triList[0], _attributes, _numAttributes);
+					if (0.0f <= attribError)
+					{
+						EdgeCollapse collapse = { c0, c1, quadricError(quadrics[c0], &_positions[c1*3]) + attribError*length };
+						collapses.push_back(collapse);
+					}
+				}
+
+				if (!locked[c1])
+				{
+					const float attribError = mapWedges(&wedgeMap[0], c1, c0, &canonical[0], &wedgeOffset[0], &wedges[0], &indices[0], &triOffset[0], &triList[0], _attributes, _numAttributes);
+					if (0.0f <= attribError)
+					{
+						EdgeCollapse collapse = { c1, c0, quadricError(quadrics[c1], &_positions[c0*3]) + attribError*length };
+						collapses.push_back(collapse);
+					}
+				}
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), EdgeCollapseSort() );
+
+		// Each collapse removes about two triangles.
+		const uint32_t maxCollapses = (numIndices - _targetIndices)/6 + 1;
+		uint32_t numCollapses = 0;
+
+		std::fill(busy.begin(), busy.end(), false);
+
+		for (std::vector<EdgeCollapse>::const_iterator it = collapses.begin(); it != collapses.end() && numCollapses < maxCollapses; ++it)
+		{
+			const EdgeCollapse& collapse = *it;
+			const uint32_t from = collapse.m_from;
+			const uint32_t to   = collapse.m_to;
+
+			if (busy[from]
+			||  busy[to]
+			||  locked[from])
+			{
+				continue;
+			}
+
+			mapWedges(&wedgeMap[0], from, to, &canonical[0], &wedgeOffset[0], &wedges[0], &indices[0], &triOffset[0], &triList[0], _attributes, _numAttributes);
+
+			bool valid = true;
+			for (uint32_t ww = wedgeOffset[from]; ww < wedgeOffset[from+1] && valid; ++ww)
+			{
+				const uint32_t wedge = wedges[ww];
+				const uint32_t target = wedgeMap[ww - wedgeOffset[from] ];
+
+				for (uint32_t tt = triOffset[wedge]; tt < triOffset[wedge+1] && valid; ++tt)
+				{
+					const uint32_t* tri = &indices[triList[tt]*3];
+					if (target != tri[0]
+					&&  target != tri[1]
+					&&  target != tri[2])
+					{
+						valid = !hasFlipped(_positions, tri, wedge, target);
+					}
+				}
+			}
+
+			if (!valid)
+			{
+				continue;
+			}
+
+			// Neighborhood is modified, don't touch it in this pass.
+			for (uint32_t ww = wedgeOffset[from]; ww < wedgeOffset[from+1]; ++ww)
+			{
+				const uint32_t wedge = wedges[ww];
+				for (uint32_t tt = triOffset[wedge]; tt < triOffset[wedge+1]; ++tt)
+				{
+					const uint32_t* tri = &indices[triList[tt]*3];
+					busy[canonical[tri[0] ] ] = true;
+					busy[canonical[tri[1] ] ] = true;
+					busy[canonical[tri[2] ] ] = true;
+				}
+			}
+
+			for (uint32_t ww = wedgeOffset[from]; ww < wedgeOffset[from+1]; ++ww)
+			{
+				const uint32_t wedge = wedges[ww];
+				const uint32_t target = wedgeMap[ww - wedgeOffset[from] ];
+
+				for (uint32_t tt = triOffset[wedge]; tt < triOffset[wedge+1]; ++tt)
+				{
+					uint32_t* tri = &indices[triList[tt]*3];
+					for (uint32_t edge = 0; edge < 3; ++edge)
+					{
+						tri[edge] = wedge == tri[edge] ? target : tri[edge];
+					}
+				}
+			}
+
+			quadricAdd(quadrics[to], quadrics[from]);
+			locked[from] = true;
+
+			_error = bx::fmax(_error, collapse.m_error);
+			++numCollapses;
+		}
+
+		if (0 == numCollapses)
+		{
+			break;
+		}
+
+		// Remove degenerate triangles.
+		uint32_t num = 0;
+		for (uint32_t ii = 0; ii < numIndices; ii += 3)
+		{
+			const uint32_t i0 = indices[ii+0];
+			const uint32_t i1 = indices[ii+1];
+			const uint32_t i2 = indices[ii+2];
+			if (i0 != i1
+			&&  i0 != i2
+			&&  i1 != i2)
+			{
+				indices[num++] = i0;
+				indices[num++] = i1;
+				indices[num++] = i2;
+			}
+		}
+		indices.resize(num);
+	}
+
+	if (!indices.empty() )
+	{
+		memcpy(_dst, &indices[0], indices.size()*sizeof(uint32_t) );
+	}
+
+	return uint32_t(indices.size() );
+}
+
+// Renumbers vertices in order of first use by index buffer, so that vertex
+// fetch walks vertex buffer linearly. Vertices first referenced by primitive
+// stay within primitive's vertex range.
+void vertexFetchReorder(uint8_t* _vertices, uint32_t _numVertices, uint32_t _stride, uint32_t* _indices, uint32_t _numIndices)
+{
+	std::vector<uint32_t> remap(_numVertices, UINT32_MAX);
+	uint8_t* newVertices = new uint8_t[_numVertices*_stride];
+
+	uint32_t next = 0;
+	for (uint32_t ii = 0; ii < _numIndices; ++ii)
+	{
+		const uint32_t index = _indices[ii];
+		if (UINT32_MAX == remap[index])
+		{
+			remap[index] = next;
+			memcpy(&newVertices[next*_stride], &_vertices[index*_stride], _stride);
+			++next;
+		}
+
+		_indices[ii] = remap[index];
+	}
+
+	// Keep unreferenced vertices at the end.
+	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+	{
+		if (UINT32_MAX == remap[ii])
+		{
+			memcpy(&newVertices[next*_stride], &_vertices[ii*_stride], _stride);
+			++next;
+		}
+	}
+
+	memcpy(_vertices, newVertices, _numVertices*_stride);
+	delete [] newVertices;
+}
+
+/// Returns time spent decompressing written stream back, to verify it and
+/// to measure decompression speed of selected format.
+int64_t triangleCompress(bx::WriterI* _writer, uint16_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride, IndexBufferCompressionFormat _format)
+{
+	uint32_t* vertexRemap = (uint32_t*)malloc(_numVertices*sizeof(uint32_t) );
+
+	WriteBitstream writer;
+	CompressIndexBuffer(_indices, _numIndices/3, vertexRemap, _numVertices, _format, writer);
+	writer.Finish();
+
+	uint16_t* decompressed = (uint16_t*)malloc(_numIndices*sizeof(uint16_t) );
+
+	int64_t elapsed = -bx::getHPCounter();
+	ReadBitstream reader(writer.RawData(), writer.ByteSize() );
+	DecompressIndexBuffer(decompressed, _numIndices/3, reader);
+	elapsed += bx::getHPCounter();
+
+	// Decompressed triangles use remapped vertices, and can be rotated.
+	uint32_t numErrors = 0;
+	for (uint32_t ii = 0; ii < _numIndices; ii += 3)
+	{
+		const uint32_t i0 = vertexRemap[_indices[ii+0] ];
+		const uint32_t i1 = vertexRemap[_indices[ii+1] ];
+		const uint32_t i2 = vertexRemap[_indices[ii+2] ];
+		const uint16_t* tri = &decompressed[ii];
+
+		if ( (i0 != tri[0] || i1 != tri[1] || i2 != tri[2])
+		&&   (i0 != tri[1] || i1 != tri[2] || i2 != tri[0])
+		&&   (i0 != tri[2] || i1 != tri[0] || i2 != tri[1]) )
+		{
+			++numErrors;
+		}
+	}
+
+	free(decompressed);
+
+	printf( "uncompressed: %10d, compressed: %10d, ratio: %0.2f%%, decompress: %0.3f [ms] (%0.1f Mtri/s)\n"
+		, _numIndices*2
+		, (uint32_t)writer.ByteSize()
+		, 100.0f - float(writer.ByteSize() ) / float(_numIndices*2)*100.0f
+		, double(elapsed)*1000.0/bx::getHPFrequency()
+		, double(_numIndices/3)*bx::getHPFrequency()/double(bx::int64_max(elapsed, 1) )/1000000.0
+		);
+
+	if (0 != numErrors)
+	{
+		printf("Warning: %d triangles don't match after decompression!\n", numErrors);
+	}
+
+	BX_UNUSED(_vertexData, _stride);
+	uint8_t* outVertexData = (uint8_t*)malloc(_numVertices*_stride);
+	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+	{
+		uint32_t remap = vertexRemap[ii];
+		remap = UINT32_MAX == remap ? ii : remap;
+		memcpy(&outVertexData[remap*_stride], &_vertexData[ii*_stride], _stride);
+	}
+	memcpy(_vertexData, outVertexData, _numVertices*_stride);
+	free(outVertexData);
+
+	free(vertexRemap);
+
+	bx::write(_writer, writer.RawData(), (uint32_t)writer.ByteSize() );
+
+	return elapsed;
+}
+
+void calcTangents(void* _vertices, uint32_t _numVertices, bgfx::VertexDecl _decl, const uint32_t* _indices, uint32_t _numIndices)
+{
+	struct PosTexcoord
+	{
+		float m_x;
+		float m_y;
+		float m_z;
+		float m_pad0;
+		float m_u;
+		float m_v;
+		float m_pad1;
+		float m_pad2;
+	};
+
+	float* tangents = new float[6*_numVertices];
+	memset(tangents, 0, 6*_numVertices*sizeof(float) );
+
+	PosTexcoord v0;
+	PosTexcoord v1;
+	PosTexcoord v2;
+
+	for (uint32_t ii = 0, num = _numIndices/3; ii < num; ++ii)
+	{
+		const uint32_t* indices = &_indices[ii*3];
+		uint32_t i0 = indices[0];
+		uint32_t i1 = indices[1];
+		uint32_t i2 = indices[2];
+
+		bgfx::vertexUnpack(&v0.m_x, bgfx::Attrib::Position, _decl, _vertices, i0);
+		bgfx::vertexUnpack(&v0.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i0);
+
+		bgfx::vertexUnpack(&v1.m_x, bgfx::Attrib::Position, _decl, _vertices, i1);
+		bgfx::vertexUnpack(&v1.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i1);
+
+		bgfx::vertexUnpack(&v2.m_x, bgfx::Attrib::Position, _decl, _vertices, i2);
+		bgfx::vertexUnpack(&v2.m_u, bgfx::Attrib::TexCoord0, _decl, _vertices, i2);
+
+		const float bax = v1.m_x - v0.m_x;
+		const float bay = v1.m_y - v0.m_y;
+		const float baz = v1.m_z - v0.m_z;
+		const float bau = v1.m_u - v0.m_u;
+		const float bav = v1.m_v - v0.m_v;
+
+		const float cax = v2.m_x - v0.m_x;
+		const float cay = v2.m_y - v0.m_y;
+		const float caz = v2.m_z - v0.m_z;
+		const float cau = v2.m_u - v0.m_u;
+		const float cav = v2.m_v - v0.m_v;
+
+		const float det = (bau * cav - bav * cau);
+		const float invDet = 1.0f / det;
+
+		const float tx = (bax * cav - cax * bav) * invDet;
+		const float ty = (bay * cav - cay * bav) * invDet;
+		const float tz = (baz * cav - caz * bav) * invDet;
+
+		const float bx = (cax * bau - bax * cau) * invDet;
+		const float by = (cay * bau - bay * cau) * invDet;
+		const float bz = (caz * bau - baz * cau) * invDet;
+
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			float* tanu = &tangents[indices[jj]*6];
+			float* tanv = &tanu[3];
+			tanu[0] += tx;
+			tanu[1] += ty;
+			tanu[2] += tz;
+
+			tanv[0] += bx;
+			tanv[1] += by;
+			tanv[2] += bz;
+		}
+	}
+
+	for (uint32_t ii = 0; ii < _numVertices; ++ii)
+	{
+		const float* tanu = &tangents[ii*6];
+		const float* tanv = &tangents[ii*6 + 3];
+
+		float normal[4];
+		bgfx::vertexUnpack(normal, bgfx::Attrib::Normal, _decl, _vertices, ii);
+		float ndt = bx::vec3Dot(normal, tanu);
+
+		float nxt[3];
+		bx::vec3Cross(nxt, normal, tanu);
+
+		float tmp[3];
+		tmp[0] = tanu[0] - normal[0] * ndt;
+		tmp[1] = tanu[1] - normal[1] * ndt;
+		tmp[2] = tanu[2] - normal[2] * ndt;
+
+		float tangent[4];
+		bx::vec3Norm(tangent, tmp);
+
+		tangent[3] = bx::vec3Dot(nxt, tanv) < 0.0f ? -1.0f : 1.0f;
+		bgfx::vertexPack(tangent, true, bgfx::Attrib::Tangent, _decl, _vertices, ii);
+	}
+
+	delete [] tangents;
+}
+
+void write(bx::WriterI* _writer, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
+{
+	Sphere maxSphere;
+	calcMaxBoundingSphere(maxSphere, _vertices, _numVertices, _stride);
+
+	Sphere minSphere;
+	calcMinBoundingSphere(minSphere, _vertices, _numVertices, _stride);
+
+	if (minSphere.m_radius > maxSphere.m_radius)
+	{
+		bx::write(_writer, maxSphere);
+	}
+	else
+	{
+		bx::write(_writer, minSphere);
+	}
+
+	Aabb aabb;
+	toAabb(aabb, _vertices, _numVertices, _stride);
+	bx::write(_writer, aabb);
+
+	Obb obb;
+	calcObb(obb, _vertices, _numVertices, _stride, s_obbSteps);
+	bx::write(_writer, obb);
+}
+
+void writePrimitives(bx::WriterI* _writer
+		, const uint8_t* _vertices
+		, uint32_t _stride
+		, const std::string& _material
+		, const PrimitiveArray& _primitives
+		, bool _lod
+		)
+{
+	using namespace bx;
+
+	uint16_t nameLen = uint16_t(_material.size() );
+	write(_writer, nameLen);
+	write(_writer, _material.c_str(), nameLen);
+	write(_writer, uint16_t(_primitives.size() ) );
+	for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
+	{
+		const Primitive& prim = *primIt;
+		nameLen = uint16_t(prim.m_name.size() );
+		write(_writer, nameLen);
+		write(_writer, prim.m_name.c_str(), nameLen);
+		write(_writer, prim.m_startIndex);
+		write(_writer, prim.m_numIndices);
+		write(_writer, prim.m_startVertex);
+		write(_writer, prim.m_numVertices);
+		write(_writer, &_vertices[prim.m_startVertex*_stride], prim.m_numVertices, _stride);
+
+		if (_lod)
+		{
+			write(_writer, prim.m_lod);
+			write(_writer, prim.m_lodError);
+		}
+	}
+}
+
+void write(bx::WriterI* _writer, const MeshletArray& _meshlets)
+{
+	using namespace bx;
+
+	write(_writer, uint32_t(_meshlets.size() ) );
+	for (MeshletArray::const_iterator it = _meshlets.begin(); it != _meshlets.end(); ++it)
+	{
+		const Meshlet& meshlet = *it;
+		write(_writer, meshlet.m_sphere);
+		write(_writer, meshlet.m_coneAxis, sizeof(meshlet.m_coneAxis) );
+		write(_writer, meshlet.m_coneCutoff);
+		write(_writer, meshlet.m_startIndex);
+		write(_writer, meshlet.m_numIndices);
+	}
+}
+
+void write(bx::WriterI* _writer
+		, const uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexDecl& _decl
+		, const uint8_t* _outVertices
+		, const bgfx::VertexDecl& _outDecl
+		, const float* _dequant
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, const uint8_t* _compressedIndices
+		, uint32_t _compressedSize
+		, const MeshletArray& _meshlets
+		, const std::string& _material
+		, const PrimitiveArray& _primitives
+		, bool _lod
+		)
+{
+	using namespace bx;
+	using namespace bgfx;
+
+	const bool vb32 = _index32 || UINT16_MAX < _numVertices;
+
+	uint32_t stride = _decl.getStride();
+	if (NULL != _dequant)
+	{
+		write(_writer, BGFX_CHUNK_MAGIC_VBQ);
+	}
+	else
+	{
+		write(_writer, vb32 ? BGFX_CHUNK_MAGIC_VB32 : BGFX_CHUNK_MAGIC_VB);
+	}
+	write(_writer, _vertices, _numVertices, stride);
+
+	write(_writer, _outDecl);
+
+	if (NULL != _dequant)
+	{
+		write(_writer, _dequant, 6*sizeof(float) );
+		write(_writer, _numVertices);
+	}
+	else if (vb32)
+	{
+		write(_writer, _numVertices);
+	}
+	else
+	{
+		write(_writer, uint16_t(_numVertices) );
+	}
+	write(_writer, _outVertices, _numVertices*_outDecl.getStride() );
+
+	if (NULL != _compressedIndices)
+	{
+		write(_writer, BGFX_CHUNK_MAGIC_IBC);
+		write(_writer, _numIndices);
+		write(_writer, _compressedSize);
+		write(_writer, _compressedIndices, _compressedSize);
+	}
+	else
+	{
+		write(_writer, _index32 ? BGFX_CHUNK_MAGIC_IB32 : BGFX_CHUNK_MAGIC_IB);
+		write(_writer, _numIndices);
+		write(_writer, _indices, _numIndices*(_index32 ? 4 : 2) );
+	}
+
+	if (!_meshlets.empty() )
+	{
+		write(_writer, BGFX_CHUNK_MAGIC_MLT);
+		write(_writer, _meshlets);
+	}
+
+	write(_writer, _lod ? BGFX_CHUNK_MAGIC_PRIL : BGFX_CHUNK_MAGIC_PRI);
+	writePrimitives(_writer, _vertices, stride, _material, _primitives, _lod);
+}
+
+void addChunk(MeshChunkArray& _chunks, uint32_t _chunk, uint32_t _flags, const void* _data, uint32_t _size)
+{
+	MeshChunk chunk;
+	chunk.m_chunk = _chunk;
+	chunk.m_flags = _flags;
+	chunk.m_data.assign( (const uint8_t*)_data, (const uint8_t*)_data + _size);
+	_chunks.push_back(chunk);
+}
+
+void writeMapped(MeshChunkArray& _chunks
+		, const uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexDecl& _decl
+		, const uint8_t* _outVertices
+		, const bgfx::VertexDecl& _outDecl
+		, const float* _dequant
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, const MeshletArray& _meshlets
+		, const std::string& _material
+		, const PrimitiveArray& _primitives
+		, bool _lod
+		)
+{
+	using namespace bx;
+	using namespace bgfx;
+
+	uint32_t stride = _decl.getStride();
+
+	bx::CrtAllocator crtAllocator;
+
+	{
+		bx::MemoryBlock  memBlock(&crtAllocator);
+		bx::MemoryWriter memWriter(&memBlock);
+		write(&memWriter, _vertices, _numVertices, stride);
+		write(&memWriter, _outDecl);
+		write(&memWriter, _numVertices);
+		if (NULL != _dequant)
+		{
+			write(&memWriter, _dequant, 6*sizeof(float) );
+		}
+		addChunk(_chunks
+			, NULL != _dequant ? BGFX_CHUNK_MAGIC_VBMQ : BGFX_CHUNK_MAGIC_VBM
+			, 0
+			, memBlock.more()
+			, uint32_t(bx::seek(&memWriter) )
+			);
+	}
+
+	addChunk(_chunks, BGFX_CHUNK_MAGIC_VBD, 0, _outVertices, _numVertices*_outDecl.getStride() );
+	addChunk(_chunks
+		, BGFX_CHUNK_MAGIC_IBD
+		, _index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE
+		, _indices
+		, _numIndices*(_index32 ? 4 : 2)
+		);
+
+	if (!_meshlets.empty() )
+	{
+		bx::MemoryBlock  memBlock(&crtAllocator);
+		bx::MemoryWriter memWriter(&memBlock);
+		write(&memWriter, _meshlets);
+		addChunk(_chunks, BGFX_CHUNK_MAGIC_MLT, 0, memBlock.more(), uint32_t(bx::seek(&memWriter) ) );
+	}
+
+	{
+		bx::MemoryBlock  memBlock(&crtAllocator);
+		bx::MemoryWriter memWriter(&memBlock);
+		writePrimitives(&memWriter, _vertices, stride, _material, _primitives, _lod);
+		addChunk(_chunks
+			, _lod ? BGFX_CHUNK_MAGIC_PRIL : BGFX_CHUNK_MAGIC_PRI
+			, 0
+			, memBlock.more()
+			, uint32_t(bx::seek(&memWriter) )
+			);
+	}
+}
+
+void writeContainer(bx::WriterI* _writer, const MeshChunkArray& _chunks)
+{
+	using namespace bx;
+
+	const uint32_t numChunks = uint32_t(_chunks.size() );
+	write(_writer, BGFX_CHUNK_MAGIC_MSH);
+	write(_writer, numChunks);
+
+	uint32_t offset = sizeof(uint32_t)*2 + numChunks*sizeof(uint32_t)*4;
+	for (MeshChunkArray::const_iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		const uint32_t size = uint32_t(it->m_data.size() );
+		offset = bx::strideAlign(offset, BGFX_MESH_CHUNK_ALIGN);
+		write(_writer, it->m_chunk);
+		write(_writer, offset);
+		write(_writer, size);
+		write(_writer, it->m_flags);
+		offset += size;
+	}
+
+	static const uint8_t zero[BGFX_MESH_CHUNK_ALIGN] = {};
+	offset = sizeof(uint32_t)*2 + numChunks*sizeof(uint32_t)*4;
+	for (MeshChunkArray::const_iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		const uint32_t size = uint32_t(it->m_data.size() );
+		const uint32_t pad  = bx::strideAlign(offset, BGFX_MESH_CHUNK_ALIGN) - offset;
+		write(_writer, zero, pad);
+		if (0 < size)
+		{
+			write(_writer, &it->m_data[0], size);
+		}
+		offset += pad + size;
+	}
+}
+
+struct QuantizeError
+{
+	float    m_max;
+	double   m_sum;
+	uint32_t m_num;
+};
+
+struct MeshOutput
+{
+	bx::WriterI*   m_writer;
+	MeshChunkArray m_chunks;
+	bool     m_mapped;
+	bool     m_compress;
+	IndexBufferCompressionFormat m_compressFormat;
+	bool     m_index32;
+	bool     m_hasTangent;
+	bool     m_stats;
+	bool     m_meshlets;
+	float    m_overdraw;
+	uint16_t m_cacheSize;
+	uint32_t m_numLods;
+	float    m_lodRatio;
+	uint32_t m_numMeshes;
+	uint32_t m_numMeshlets;
+	int64_t  m_triReorderElapsed;
+	int64_t  m_lodElapsed;
+	int64_t  m_decompressElapsed;
+	VertexCacheStats m_total;
+
+	bgfx::VertexDecl m_outDecl;
+	bool     m_quantize;
+	uint32_t m_packPos;
+	uint32_t m_packNormal;
+	QuantizeError m_error[bgfx::Attrib::Count];
+};
+
+void printStats(const char* _name, const VertexCacheStats& _stats)
+{
+	printf("%-24s tri %7d, ACMR %.3f, ATVR %.3f, overfetch %.3f\n"
+		, _name
+		, _stats.m_numTriangles
+		, 0 < _stats.m_numTriangles ? float(_stats.m_numMisses)/float(_stats.m_numTriangles) : 0.0f
+		, 0 < _stats.m_numVertices  ? float(_stats.m_numMisses)/float(_stats.m_numVertices)  : 0.0f
+		, 0 < _stats.m_vertexSize   ? float(_stats.m_fetchSize)/float(_stats.m_vertexSize)   : 0.0f
+		);
+}
+
+inline uint32_t attribSize(bgfx::AttribType::Enum _type, uint8_t _num)
+{
+	switch (_type)
+	{
+	case bgfx::AttribType::Uint8:  return _num;
+	case bgfx::AttribType::Uint10: return 4;
+	case bgfx::AttribType::Int16:
+	case bgfx::AttribType::Half:   return _num*2;
+	default: break;
+	}
+
+	return _num*4;
+}
+
+inline void addError(QuantizeError& _error, float _value)
+{
+	_error.m_max  = bx::fmax(_error.m_max, _value);
+	_error.m_sum += _value;
+	++_error.m_num;
+}
+
+inline int16_t toSnorm16(float _value)
+{
+	return int16_t(bx::fround(bx::fclamp(_value, -1.0f, 1.0f) * 32767.0f) );
+}
+
+inline float fromSnorm16(int16_t _value)
+{
+	return bx::fmax(float(_value) / 32767.0f, -1.0f);
+}
+
+// Octahedral normal encoding:
+// A Survey of Efficient Representations for Independent Unit Vectors
+// http://jcgt.org/published/0003/02/01/
+void octEncode(float _result[2], const float _normal[3])
+{
+	const float len = bx::fabsolute(_normal[0]) + bx::fabsolute(_normal[1]) + bx::fabsolute(_normal[2]);
+	const float invLen = 0.0f < len ? 1.0f/len : 0.0f;
+	const float xx = _normal[0] * invLen;
+	const float yy = _normal[1] * invLen;
+
+	if (0.0f > _normal[2])
+	{
+		_result[0] = (1.0f - bx::fabsolute(yy) ) * bx::fsign(xx);
+		_result[1] = (1.0f - bx::fabsolute(xx) ) * bx::fsign(yy);
+	}
+	else
+	{
+		_result[0] = xx;
+		_result[1] = yy;
+	}
+}
+
+void octDecode(float _result[3], const float _oct[2])
+{
+	float tmp[3] =
+	{
+		_oct[0],
+		_oct[1],
+		1.0f - bx::fabsolute(_oct[0]) - bx::fabsolute(_oct[1]),
+	};
+
+	if (0.0f > tmp[2])
+	{
+		tmp[0] = (1.0f - bx::fabsolute(_oct[1]) ) * bx::fsign(_oct[0]);
+		tmp[1] = (1.0f - bx::fabsolute(_oct[0]) ) * bx::fsign(_oct[1]);
+	}
+
+	bx::vec3Norm(_result, tmp);
+}
+
+inline float angleError(const float _a[3], const float _b[3])
+{
+	float na[3];
+	float nb[3];
+	bx::vec3Norm(na, _a);
+	bx::vec3Norm(nb, _b);
+	return bx::facos(bx::fclamp(bx::vec3Dot(na, nb), -1.0f, 1.0f) ) * 180.0f / bx::pi;
+}
+
+// Converts vertices from full precision processing declaration into output
+// declaration. Positions are quantized relative to vertex buffer AABB, and
+// dequantization transform (scale, offset) is returned in _dequant.
+void quantizeVertices(MeshOutput& _out
+		, float _dequant[6]
+		, uint8_t* _dst
+		, const uint8_t* _src
+		, uint32_t _numVertices
+		, const bgfx::VertexDecl& _decl
+		)
+{
+	const bgfx::VertexDecl& outDecl = _out.m_outDecl;
+	const uint32_t srcStride = _decl.getStride();
+	const uint32_t dstStride = outDecl.getStride();
+
+	Aabb aabb;
+	toAabb(aabb, _src, _numVertices, srcStride);
+
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		_dequant[ii]   = bx::fmax( (aabb.m_max[ii] - aabb.m_min[ii]) * 0.5f, 1e-8f);
+		_dequant[ii+3] = (aabb.m_max[ii] + aabb.m_min[ii]) * 0.5f;
+	}
+
+	memset(_dst, 0, _numVertices*dstStride);
+
+	for (uint32_t vv = 0; vv < _numVertices; ++vv)
+	{
+		for (uint32_t attr = 0; attr < bgfx::Attrib::Count; ++attr)
+		{
+			const bgfx::Attrib::Enum attrib = bgfx::Attrib::Enum(attr);
+			if (!outDecl.has(attrib) )
+			{
+				continue;
+			}
+
+			float src[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			bgfx::vertexUnpack(src, attrib, _decl, _src, vv);
+
+			int16_t* packed = (int16_t*)&_dst[vv*dstStride + outDecl.getOffset(attrib)];
+			float decoded[4];
+
+			if (bgfx::Attrib::Position == attrib
+			&&  0 != _out.m_packPos)
+			{
+				for (uint32_t ii = 0; ii < 3; ++ii)
+				{
+					packed[ii]  = toSnorm16( (src[ii] - _dequant[ii+3]) / _dequant[ii]);
+					decoded[ii] = fromSnorm16(packed[ii]) * _dequant[ii] + _dequant[ii+3];
+				}
+				packed[3] = INT16_MAX;
+
+				float diff[3];
+				bx::vec3Sub(diff, decoded, src);
+				addError(_out.m_error[attr], bx::vec3Length(diff) );
+				continue;
+			}
+
+			if ( (bgfx::Attrib::Normal == attrib || bgfx::Attrib::Tangent == attrib)
+			&&  2 == _out.m_packNormal)
+			{
+				float oct[2];
+				octEncode(oct, src);
+				packed[0] = toSnorm16(oct[0]);
+				packed[1] = toSnorm16(oct[1]);
+
+				if (bgfx::Attrib::Tangent == attrib)
+				{
+					packed[2] = toSnorm16(src[3]);
+				}
+
+				oct[0] = fromSnorm16(packed[0]);
+				oct[1] = fromSnorm16(packed[1]);
+				octDecode(decoded, oct);
+				addError(_out.m_error[attr], angleError(decoded, src) );
+				continue;
+			}
+
+			uint8_t num;
+			bgfx::AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_decl.decode(attrib, num, type, normalized, asInt);
+
+			uint8_t outNum;
+			bgfx::AttribType::Enum outType;
+			outDecl.decode(attrib, outNum, outType, normalized, asInt);
+
+			if (type == outType)
+			{
+				memcpy(packed, &_src[vv*srcStride + _decl.getOffset(attrib)], attribSize(type, num) );
+				continue;
+			}
+
+			bgfx::vertexPack(src, true, attrib, outDecl, _dst, vv);
+			bgfx::vertexUnpack(decoded, attrib, outDecl, _dst, vv);
+
+			if (bgfx::Attrib::Normal == attrib
+			||  bgfx::Attrib::Tangent == attrib)
+			{
+				addError(_out.m_error[attr], angleError(decoded, src) );
+			}
+			else
+			{
+				float error = 0.0f;
+				for (uint32_t ii = 0; ii < outNum; ++ii)
+				{
+					error = bx::fmax(error, bx::fabsolute(decoded[ii] - src[ii]) );
+				}
+				addError(_out.m_error[attr], error);
+			}
+		}
+	}
+}
+
+inline uint32_t meshletNewVertices(uint32_t _result[3], const uint32_t* _unique, uint32_t _numUnique, const uint32_t _tri[3])
+{
+	uint32_t num = 0;
+	for (uint32_t edge = 0; edge < 3; ++edge)
+	{
+		bool found = false;
+		for (uint32_t jj = 0; jj < _numUnique && !found; ++jj)
+		{
+			found = _tri[edge] == _unique[jj];
+		}
+
+		for (uint32_t jj = 0; jj < num && !found; ++jj)
+		{
+			found = _tri[edge] == _result[jj];
+		}
+
+		if (!found)
+		{
+			_result[num++] = _tri[edge];
+		}
+	}
+
+	return num;
+}
+
+void meshletBounds(Meshlet& _meshlet, const float* _positions, uint32_t _numVertices, const float* _normals, uint32_t _numTriangles)
+{
+	Sphere maxSphere;
+	calcMaxBoundingSphere(maxSphere, _positions, _numVertices, 3*sizeof(float) );
+
+	Sphere minSphere;
+	calcMinBoundingSphere(minSphere, _positions, _numVertices, 3*sizeof(float) );
+
+	_meshlet.m_sphere = minSphere.m_radius > maxSphere.m_radius ? maxSphere : minSphere;
+
+	float axis[3] = { 0.0f, 0.0f, 0.0f };
+	for (uint32_t ii = 0; ii < _numTriangles; ++ii)
+	{
+		bx::vec3Add(axis, axis, &_normals[ii*3]);
+	}
+
+	const float len = bx::vec3Length(axis);
+	bx::vec3Mul(_meshlet.m_coneAxis, axis, 0.0f < len ? 1.0f/len : 0.0f);
+
+	float minDot = 1.0f;
+	for (uint32_t ii = 0; ii < _numTriangles; ++ii)
+	{
+		minDot = bx::fmin(minDot, bx::vec3Dot(_meshlet.m_coneAxis, &_normals[ii*3]) );
+	}
+
+	// Cutoff is sine of cone half angle. Clusters with cone wider than
+	// ~85 degrees are never culled.
+	_meshlet.m_coneCutoff = 0.1f >= minDot ? 1.0f : bx::fsqrt(1.0f - minDot*minDot);
+}
+
+// Partitions triangle list into clusters of contiguous index ranges, in
+// existing (vertex cache optimized) triangle order. Each cluster gets
+// bounding sphere, and normal cone used for backface cluster culling.
+template<typename IndexT>
+void buildMeshlets(MeshletArray& _meshlets
+		, const IndexT* _indices
+		, uint32_t _startIndex
+		, uint32_t _numIndices
+		, const uint8_t* _vertices
+		, const bgfx::VertexDecl& _decl
+		)
+{
+	uint32_t unique[BGFX_GEOMETRYC_MESHLET_MAX_VERTICES];
+	float positions[BGFX_GEOMETRYC_MESHLET_MAX_VERTICES*3];
+	float normals[BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES*3];
+	uint32_t numUnique = 0;
+	uint32_t numTriangles = 0;
+
+	Meshlet meshlet;
+	meshlet.m_startIndex = _startIndex;
+
+	for (uint32_t ii = _startIndex, end = _startIndex + _numIndices; ii < end; ii += 3)
+	{
+		const uint32_t tri[3] = { _indices[ii], _indices[ii+1], _indices[ii+2] };
+
+		uint32_t newIndices[3];
+		uint32_t numNew = meshletNewVertices(newIndices, unique, numUnique, tri);
+
+		if (numUnique + numNew > BGFX_GEOMETRYC_MESHLET_MAX_VERTICES
+		||  numTriangles + 1   > BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES)
+		{
+			meshletBounds(meshlet, positions, numUnique, normals, numTriangles);
+			meshlet.m_numIndices = ii - meshlet.m_startIndex;
+			_meshlets.push_back(meshlet);
+
+			meshlet.m_startIndex = ii;
+			numUnique    = 0;
+			numTriangles = 0;
+			numNew = meshletNewVertices(newIndices, unique, numUnique, tri);
+		}
+
+		for (uint32_t jj = 0; jj < numNew; ++jj)
+		{
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, _decl, _vertices, newIndices[jj]);
+			bx::vec3Move(&positions[numUnique*3], pos);
+			unique[numUnique++] = newIndices[jj];
+		}
+
+		float pos[3][4];
+		for (uint32_t edge = 0; edge < 3; ++edge)
+		{
+			bgfx::vertexUnpack(pos[edge], bgfx::Attrib::Position, _decl, _vertices, tri[edge]);
+		}
+
+		float e10[3];
+		float e20[3];
+		float normal[3];
+		bx::vec3Sub(e10, pos[1], pos[0]);
+		bx::vec3Sub(e20, pos[2], pos[0]);
+		bx::vec3Cross(normal, e10, e20);
+
+		const float normalLen = bx::vec3Length(normal);
+		bx::vec3Mul(&normals[numTriangles*3], normal, 0.0f < normalLen ? 1.0f/normalLen : 0.0f);
+		++numTriangles;
+	}
+
+	if (0 < numTriangles)
+	{
+		meshletBounds(meshlet, positions, numUnique, normals, numTriangles);
+		meshlet.m_numIndices = _startIndex + _numIndices - meshlet.m_startIndex;
+		_meshlets.push_back(meshlet);
+	}
+}
+
+void writeMeshData(MeshOutput& _out
+		, uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexDecl& _decl
+		, void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, const std::string& _material
+		, const PrimitiveArray& _primitives
+		)
+{
+	const uint32_t stride    = _decl.getStride();
+	const uint32_t outStride = _out.m_outDecl.getStride();
+
+	for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
+	{
+		const Primitive& prim = *primIt;
+
+		VertexCacheStats stats;
+		if (_index32)
+		{
+			analyzeVertexCache(stats, (const uint32_t*)_indices + prim.m_startIndex, prim.m_numIndices, _numVertices, outStride, _out.m_cacheSize);
+		}
+		else
+		{
+			analyzeVertexCache(stats, (const uint16_t*)_indices + prim.m_startIndex, prim.m_numIndices, _numVertices, outStride, _out.m_cacheSize);
+		}
+
+		if (_out.m_stats)
+		{
+			printStats(prim.m_name.c_str(), stats);
+		}
+
+		_out.m_total.m_numTriangles += stats.m_numTriangles;
+		_out.m_total.m_numVertices  += stats.m_numVertices;
+		_out.m_total.m_numMisses    += stats.m_numMisses;
+		_out.m_total.m_vertexSize   += stats.m_vertexSize;
+		_out.m_total.m_fetchSize    += stats.m_fetchSize;
+	}
+
+	bx::CrtAllocator crtAllocator;
+	bx::MemoryBlock  memBlock(&crtAllocator);
+	uint32_t compressedSize = 0;
+
+	if (_out.m_compress
+	&&  !_index32)
+	{
+		bx::MemoryWriter memWriter(&memBlock);
+		for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
+		{
+			const Primitive& prim = *primIt;
+			_out.m_decompressElapsed += triangleCompress(&memWriter
+				, (uint16_t*)_indices + prim.m_startIndex
+				, prim.m_numIndices
+				, _vertices + prim.m_startVertex
+				, _numVertices
+				, uint16_t(stride)
+				, _out.m_compressFormat
+				);
+		}
+		compressedSize = uint32_t(bx::seek(&memWriter) );
+	}
+
+	const uint8_t* outVertices = _vertices;
+	uint8_t* quantized = NULL;
+	float dequant[6];
+
+	if (_out.m_quantize)
+	{
+		quantized = new uint8_t[_numVertices*outStride];
+		quantizeVertices(_out, dequant, quantized, _vertices, _numVertices, _decl);
+		outVertices = quantized;
+	}
+
+	const float* outDequant = 0 != _out.m_packPos ? dequant : NULL;
+
+	MeshletArray meshlets;
+	if (_out.m_meshlets)
+	{
+		for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
+		{
+			const Primitive& prim = *primIt;
+			if (0 != prim.m_lod)
+			{
+				continue;
+			}
+
+			if (_index32)
+			{
+				buildMeshlets(meshlets, (const uint32_t*)_indices, prim.m_startIndex, prim.m_numIndices, _vertices, _decl);
+			}
+			else
+			{
+				buildMeshlets(meshlets, (const uint16_t*)_indices, prim.m_startIndex, prim.m_numIndices, _vertices, _decl);
+			}
+		}
+
+		_out.m_numMeshlets += uint32_t(meshlets.size() );
+	}
+
+	if (_out.m_mapped)
+	{
+		writeMapped(_out.m_chunks
+			, _vertices
+			, _numVertices
+			, _decl
+			, outVertices
+			, _out.m_outDecl
+			, outDequant
+			, _indices
+			, _numIndices
+			, _index32
+			, meshlets
+			, _material
+			, _primitives
+			, 0 < _out.m_numLods
+			);
+	}
+	else
+	{
+		write(_out.m_writer
+			, _vertices
+			, _numVertices
+			, _decl
+			, outVertices
+			, _out.m_outDecl
+			, outDequant
+			, _indices
+			, _numIndices
+			, _index32
+			, 0 != compressedSize ? (uint8_t*)memBlock.more() : NULL
+			, compressedSize
+			, meshlets
+			, _material
+			, _primitives
+			, 0 < _out.m_numLods
+			);
+	}
+
+	delete [] quantized;
+
+	++_out.m_numMeshes;
+}
+
+// Sets primitive vertex range to range referenced by its indices. LOD
+// primitives reuse vertices of the base primitive, so range of vertices
+// added by the primitive is not usable.
+void calcVertexRange(Primitive& _prim, const uint16_t* _indices)
+{
+	uint32_t minIndex = UINT32_MAX;
+	uint32_t maxIndex = 0;
+	for (uint32_t ii = _prim.m_startIndex, end = _prim.m_startIndex + _prim.m_numIndices; ii < end; ++ii)
+	{
+		minIndex = bx::uint32_min(minIndex, _indices[ii]);
+		maxIndex = bx::uint32_max(maxIndex, _indices[ii]);
+	}
+
+	_prim.m_startVertex = minIndex;
+	_prim.m_numVertices = maxIndex - minIndex + 1;
+}
+
+void writeMesh(MeshOutput& _out
+		, uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexDecl& _decl
+		, uint32_t* _indices
+		, uint32_t _numIndices
+		, const std::string& _material
+		, const PrimitiveArray& _primitives
+		)
+{
+	if (_out.m_hasTangent)
+	{
+		calcTangents(_vertices, _numVertices, _decl, _indices, _numIndices);
+	}
+
+	float* positions = NULL;
+	if (0.0f < _out.m_overdraw
+	||  0 < _out.m_numLods)
+	{
+		positions = new float[_numVertices*3];
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, _decl, _vertices, ii);
+			bx::vec3Move(&positions[ii*3], pos);
+		}
+	}
+
+	// Attributes used by simplification cost, normal and UV.
+	std::vector<float> attributes;
+	uint32_t numAttributes = 0;
+	if (0 < _out.m_numLods)
+	{
+		const bool hasNormal   = _decl.has(bgfx::Attrib::Normal);
+		const bool hasTexcoord = _decl.has(bgfx::Attrib::TexCoord0);
+		numAttributes = (hasNormal ? 3 : 0) + (hasTexcoord ? 2 : 0);
+		attributes.resize(_numVertices*numAttributes + 1);
+
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float* dst = &attributes[ii*numAttributes];
+			float attr[4];
+
+			if (hasNormal)
+			{
+				bgfx::vertexUnpack(attr, bgfx::Attrib::Normal, _decl, _vertices, ii);
+				bx::vec3Move(dst, attr);
+				dst += 3;
+			}
+
+			if (hasTexcoord)
+			{
+				bgfx::vertexUnpack(attr, bgfx::Attrib::TexCoord0, _decl, _vertices, ii);
+				dst[0] = attr[0];
+				dst[1] = attr[1];
+			}
+		}
+	}
+
+	PrimitiveArray primitives(_primitives);
+	std::vector<uint32_t> lodIndices;
+	uint32_t* indices = _indices;
+	uint32_t numIndices = _numIndices;
+
+	if (0 < _out.m_numLods)
+	{
+		_out.m_lodElapsed -= bx::getHPCounter();
+
+		// LOD primitives are appended after all primitives of the previous
+		// LOD, so that each LOD is a contiguous range of index buffer. Each
+		// LOD is simplified from the previous one.
+		lodIndices.assign(_indices, _indices + _numIndices);
+		lodIndices.resize(_numIndices * (_out.m_numLods+1) );
+
+		const uint32_t numPrims = uint32_t(_primitives.size() );
+		for (uint32_t lod = 1; lod <= _out.m_numLods; ++lod)
+		{
+			for (uint32_t ii = 0; ii < numPrims; ++ii)
+			{
+				const Primitive prim = primitives[(lod-1)*numPrims + ii];
+				const uint32_t target = uint32_t(float(_primitives[ii].m_numIndices/3) * bx::fpow(_out.m_lodRatio, float(lod) ) )*3;
+
+				float error;
+				Primitive lodPrim = prim;
+				lodPrim.m_lod        = uint8_t(lod);
+				lodPrim.m_startIndex = numIndices;
+				lodPrim.m_numIndices = simplify(&lodIndices[numIndices]
+					, &lodIndices[prim.m_startIndex]
+					, prim.m_numIndices
+					, positions
+					, &attributes[0]
+					, numAttributes
+					, _numVertices
+					, target
+					, error
+					);
+				lodPrim.m_lodError = prim.m_lodError + error;
+
+				numIndices += lodPrim.m_numIndices;
+				primitives.push_back(lodPrim);
+			}
+
+			uint32_t numLodIndices = 0;
+			float lodError = 0.0f;
+			for (uint32_t ii = 0; ii < numPrims; ++ii)
+			{
+				const Primitive& prim = primitives[lod*numPrims + ii];
+				numLodIndices += prim.m_numIndices;
+				lodError = bx::fmax(lodError, prim.m_lodError);
+			}
+
+			printf("lod %d: tri %7d (%5.1f%%), error %f\n"
+				, lod
+				, numLodIndices/3
+				, 100.0f * float(numLodIndices) / float(bx::uint32_max(_numIndices, 1) )
+				, lodError
+				);
+		}
+
+		lodIndices.resize(numIndices);
+		indices = &lodIndices[0];
+
+		_out.m_lodElapsed += bx::getHPCounter();
+	}
+
+	_out.m_triReorderElapsed -= bx::getHPCounter();
+	for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
+	{
+		const Primitive& prim = *primIt;
+		triangleReorder(indices + prim.m_startIndex, prim.m_numIndices, _numVertices, _out.m_cacheSize);
+	}
+
+	if (0.0f < _out.m_overdraw)
+	{
+		for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
+		{
+			const Primitive& prim = *primIt;
+			triangleReorderOverdraw(indices + prim.m_startIndex
+				, prim.m_numIndices
+				, positions
+				, _numVertices
+				, _out.m_cacheSize
+				, _out.m_overdraw
+				);
+		}
+	}
+
+	delete [] positions;
+
+	vertexFetchReorder(_vertices, _numVertices, _decl.getStride(), indices, numIndices);
+	_out.m_triReorderElapsed += bx::getHPCounter();
+
+	if (_out.m_index32)
+	{
+		writeMeshData(_out, _vertices, _numVertices, _decl, indices, numIndices, true, _material, primitives);
+		return;
+	}
+
+	// Vertex count of 16-bit VB chunk is stored as uint16_t.
+	const uint32_t maxVertices = UINT16_MAX;
+	uint16_t* subIndices = new uint16_t[numIndices];
+
+	if (_numVertices <= maxVertices)
+	{
+		for (uint32_t ii = 0; ii < numIndices; ++ii)
+		{
+			subIndices[ii] = uint16_t(indices[ii]);
+		}
+
+		writeMeshData(_out, _vertices, _numVertices, _decl, subIndices, numIndices, false, _material, primitives);
+		delete [] subIndices;
+		return;
+	}
+
+	// Split into sub-meshes addressable with 16-bit indices. Triangles are
+	// walked in vertex cache optimized order, so each sub-mesh keeps
+	// locality of optimized mesh.
+	const uint32_t stride = _decl.getStride();
+	uint8_t* subVertices = new uint8_t[maxVertices*stride];
+	std::vector<uint32_t> remap(_numVertices, UINT32_MAX);
+	std::vector<uint32_t> used;
+	used.reserve(maxVertices);
+
+	uint32_t numSubVertices = 0;
+	uint32_t numSubIndices  = 0;
+	PrimitiveArray subPrimitives;
+
+	for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
+	{
+		const Primitive& prim = *primIt;
+
+		Primitive subPrim;
+		subPrim.m_name        = prim.m_name;
+		subPrim.m_lod         = prim.m_lod;
+		subPrim.m_lodError    = prim.m_lodError;
+		subPrim.m_startIndex  = numSubIndices;
+
+		for (uint32_t ii = prim.m_startIndex, end = prim.m_startIndex + prim.m_numIndices; ii < end; ii += 3)
+		{
+			const uint32_t* tri = &indices[ii];
+			const uint32_t numNew = 0
+				+ (UINT32_MAX == remap[tri[0] ] )
+				+ (UINT32_MAX == remap[tri[1] ] && tri[1] != tri[0])
+				+ (UINT32_MAX == remap[tri[2] ] && tri[2] != tri[0] && tri[2] != tri[1])
+				;
+
+			if (numSubVertices + numNew > maxVertices)
+			{
+				subPrim.m_numIndices = numSubIndices - subPrim.m_startIndex;
+				if (0 < subPrim.m_numIndices)
+				{
+					calcVertexRange(subPrim, subIndices);
+					subPrimitives.push_back(subPrim);
+				}
+
+				writeMeshData(_out, subVertices, numSubVertices, _decl, subIndices, numSubIndices, false, _material, subPrimitives);
+				subPrimitives.clear();
+
+				for (std::vector<uint32_t>::const_iterator it = used.begin(); it != used.end(); ++it)
+				{
+					remap[*it] = UINT32_MAX;
+				}
+				used.clear();
+
+				numSubVertices = 0;
+				numSubIndices  = 0;
+				subPrim.m_startIndex = 0;
+			}
+
+			for (uint32_t edge = 0; edge < 3; ++edge)
+			{
+				const uint32_t index = tri[edge];
+				if (UINT32_MAX == remap[index])
+				{
+					remap[index] = numSubVertices;
+					memcpy(&subVertices[numSubVertices*stride], &_vertices[index*stride], stride);
+					used.push_back(index);
+					++numSubVertices;
+				}
+
+				subIndices[numSubIndices++] = uint16_t(remap[index]);
+			}
+		}
+
+		subPrim.m_numIndices = numSubIndices - subPrim.m_startIndex;
+		if (0 < subPrim.m_numIndices)
+		{
+			calcVertexRange(subPrim, subIndices);
+			subPrimitives.push_back(subPrim);
+		}
+	}
+
+	if (0 < numSubIndices)
+	{
+		writeMeshData(_out, subVertices, numSubVertices, _decl, subIndices, numSubIndices, false, _material, subPrimitives);
+	}
+
+	delete [] subVertices;
+	delete [] subIndices;
+}
+
+inline uint32_t rgbaToAbgr(uint8_t _r, uint8_t _g, uint8_t _b, uint8_t _a)
+{
+	return (uint32_t(_r)<<0)
+		 | (uint32_t(_g)<<8)
+		 | (uint32_t(_b)<<16)
+		 | (uint32_t(_a)<<24)
+		 ;
+}
+
+struct GroupSortByMaterial
+{
+	bool operator()(const Group& _lhs, const Group& _rhs)
+	{
+		return _lhs.m_material < _rhs.m_material;
+	}
+};
+
+// Size of block in which OBJ file is read and parsed.
+#define OBJ_BLOCK_SIZE (64<<20)
+
+#define OBJ_RELATIVE_POSITION UINT8_C(0x01)
+#define OBJ_RELATIVE_TEXCOORD UINT8_C(0x02)
+#define OBJ_RELATIVE_NORMAL   UINT8_C(0x04)
+
+struct ObjEvent
+{
+	enum Enum
+	{
+		Vertex,
+		Group,
+		Material,
+	};
+
+	Enum        m_type;
+	uint32_t    m_triangle;
+	std::string m_name;
+};
+
+typedef std::vector<ObjEvent> ObjEventArray;
+
+// Part of OBJ file split on line boundary. Chunks are parsed in parallel,
+// face indices are chunk local until merge adds position/texcoord/normal
+// counts of preceding chunks to relative (negative) indices.
+struct ObjChunk
+{
+	char*    m_data;
+	float    m_scale;
+	bool     m_ccw;
+	bool     m_hasBc;
+
+	Vector3Array m_positions;
+	Vector3Array m_normals;
+	Vector3Array m_texcoords;
+
+	std::vector<Index3>   m_vertices;
+	std::vector<uint8_t>  m_relative;
+	std::vector<uint64_t> m_hashes;
+
+	// Vertex indices grouped by index map partition they hash into.
+	std::vector<std::vector<uint32_t> > m_partitions;
+
+	TriangleArray m_triangles;
+	ObjEventArray m_events;
+
+	uint32_t m_numLines;
+	uint32_t m_numParamVertices;
+
+	uint32_t m_basePosition;
+	uint32_t m_baseNormal;
+	uint32_t m_baseTexcoord;
+	uint32_t m_baseTriangle;
+};
+
+// Chunks must not move when more are added while reading next block.
+typedef std::deque<ObjChunk> ObjChunkArray;
+
+typedef std::vector<Index3Map> Index3MapArray;
+
+inline Index3Map& findIndexMap(Index3MapArray& _indexMaps, uint64_t _hash)
+{
+	return _indexMaps[_hash % _indexMaps.size()];
+}
+
+typedef void (*ParallelFn)(void* _userData, uint32_t _idx);
+
+struct ParallelTask
+{
+	ParallelFn m_fn;
+	void*      m_userData;
+	uint32_t   m_idx;
+};
+
+static int32_t parallelThread(void* _userData)
+{
+	ParallelTask* task = (ParallelTask*)_userData;
+	task->m_fn(task->m_userData, task->m_idx);
+	return EXIT_SUCCESS;
+}
+
+void parallelFor(uint32_t _num, ParallelFn _fn, void* _userData)
+{
+	std::vector<ParallelTask> tasks(_num);
+	bx::Thread* threads = new bx::Thread[_num];
+
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		tasks[ii].m_fn       = _fn;
+		tasks[ii].m_userData = _userData;
+		tasks[ii].m_idx      = ii;
+
+		if (0 != ii)
+		{
+			threads[ii].init(parallelThread, &tasks[ii]);
+		}
+	}
+
+	parallelThread(&tasks[0]);
+
+	for (uint32_t ii = 1; ii < _num; ++ii)
+	{
+		threads[ii].shutdown();
+	}
+
+	delete [] threads;
+}
+
+struct ObjParse
+{
+	ObjChunkArray* m_chunks;
+	uint32_t       m_first;
+};
+
+void parseObjChunk(void* _userData, uint32_t _idx)
+{
+	ObjParse& parse = *(ObjParse*)_userData;
+	ObjChunk& chunk = (*parse.m_chunks)[parse.m_first + _idx];
+
+	uint32_t lastVertexEvent = UINT32_MAX;
+
+	char commandLine[2048];
+	int argc;
+	char* argv[64];
+	const char* next = chunk.m_data;
+	while ('\0' != *next)
+	{
+		uint32_t len = sizeof(commandLine);
+		next = bx::tokenizeCommandLine(next, commandLine, len, argc, argv, BX_COUNTOF(argv), '\n');
+		if (0 < argc)
+		{
+			if (0 == strcmp(argv[0], "f") )
+			{
+				Triangle triangle;
+				memset(&triangle, 0, sizeof(Triangle) );
+
+				const int numNormals   = (int)chunk.m_normals.size();
+				const int numTexcoords = (int)chunk.m_texcoords.size();
+				const int numPositions = (int)chunk.m_positions.size();
+				for (uint32_t edge = 0, numEdges = argc-1; edge < numEdges; ++edge)
+				{
+					Index3 index;
+					index.m_texcoord = -1;
+					index.m_normal = -1;
+					index.m_vertexIndex = -1;
+					if (chunk.m_hasBc)
+					{
+						index.m_vbc = edge < 3 ? edge : (1+(edge+1) )&1;
+					}
+					else
+					{
+						index.m_vbc = 0;
+					}
+
+					uint8_t relative = 0;
+
+					const char* vertex   = argv[edge+1];
+					char* texcoord = const_cast<char*>(bx::strFind(vertex, '/') );
+					if (NULL != texcoord)
+					{
+						*texcoord++ = '\0';
+
+						char* normal = const_cast<char*>(bx::strFind(texcoord, '/') );
+						if (NULL != normal)
+						{
+							*normal++ = '\0';
+							const int nn = atoi(normal);
+							relative |= nn < 0 ? OBJ_RELATIVE_NORMAL : 0;
+							index.m_normal = (nn < 0) ? nn+numNormals : nn-1;
+						}
+
+						// https://en.wikipedia.org/wiki/Wavefront_.obj_file#Vertex_Normal_Indices_Without_Texture_Coordinate_Indices
+						if(*texcoord != '\0')
+						{
+							const int tex = atoi(texcoord);
+							relative |= tex < 0 ? OBJ_RELATIVE_TEXCOORD : 0;
+							index.m_texcoord = (tex < 0) ? tex+numTexcoords : tex-1;
+						}
+					}
+
+					const int pos = atoi(vertex);
+					relative |= pos < 0 ? OBJ_RELATIVE_POSITION : 0;
+					index.m_position = (pos < 0) ? pos+numPositions : pos-1;
+
+					const uint64_t vertexIdx = chunk.m_vertices.size();
+					chunk.m_vertices.push_back(index);
+					chunk.m_relative.push_back(relative);
+
+					switch (edge)
+					{
+					case 0:
+					case 1:
+					case 2:
+						triangle.m_index[edge] = vertexIdx;
+						if (2 == edge)
+						{
+							if (chunk.m_ccw)
+							{
+								std::swap(triangle.m_index[1], triangle.m_index[2]);
+							}
+							chunk.m_triangles.push_back(triangle);
+						}
+						break;
+
+					default:
+						if (chunk.m_ccw)
+						{
+							triangle.m_index[2] = triangle.m_index[1];
+							triangle.m_index[1] = vertexIdx;
+						}
+						else
+						{
+							triangle.m_index[1] = triangle.m_index[2];
+							triangle.m_index[2] = vertexIdx;
+						}
+						chunk.m_triangles.push_back(triangle);
+						break;
+					}
+				}
+			}
+			else if (0 == strcmp(argv[0], "g") )
+			{
+				EXPECT(1 < argc);
+
+				ObjEvent event;
+				event.m_type     = ObjEvent::Group;
+				event.m_triangle = uint32_t(chunk.m_triangles.size() );
+				event.m_name     = argv[1];
+				chunk.m_events.push_back(event);
+			}
+			else if (*argv[0] == 'v')
+			{
+				// Vertex closes current group only if faces were added since
+				// previous vertex, only first one needs to be recorded.
+				const uint32_t numTriangles = uint32_t(chunk.m_triangles.size() );
+				if (lastVertexEvent != numTriangles)
+				{
+					lastVertexEvent = numTriangles;
+
+					ObjEvent event;
+					event.m_type     = ObjEvent::Vertex;
+					event.m_triangle = numTriangles;
+					chunk.m_events.push_back(event);
+				}
+
+				if (0 == strcmp(argv[0], "vn") )
+				{
+					Vector3 normal;
+					normal.x = (float)atof(argv[1]);
+					normal.y = (float)atof(argv[2]);
+					normal.z = (float)atof(argv[3]);
+
+					chunk.m_normals.push_back(normal);
+				}
+				else if (0 == strcmp(argv[0], "vp") )
+				{
+					++chunk.m_numParamVertices;
+				}
+				else if (0 == strcmp(argv[0], "vt") )
+				{
+					Vector3 texcoord;
+					texcoord.x = (float)atof(argv[1]);
+					texcoord.y = 0.0f;
+					texcoord.z = 0.0f;
+					switch (argc)
+					{
+					case 4:
+						texcoord.z = (float)atof(argv[3]);
+						// fallthrough
+					case 3:
+						texcoord.y = (float)atof(argv[2]);
+						break;
+
+					default:
+						break;
+					}
+
+					chunk.m_texcoords.push_back(texcoord);
+				}
+				else
+				{
+					float px = (float)atof(argv[1]);
+					float py = (float)atof(argv[2]);
+					float pz = (float)atof(argv[3]);
+					float pw = 1.0f;
+					if (argc > 4)
+					{
+						pw = (float)atof(argv[4]);
+					}
+
+					float invW = chunk.m_scale/pw;
+					px *= invW;
+					py *= invW;
+					pz *= invW;
+
+					Vector3 pos;
+					pos.x = px;
+					pos.y = py;
+					pos.z = pz;
+
+					chunk.m_positions.push_back(pos);
+				}
+			}
+			else if (0 == strcmp(argv[0], "usemtl") )
+			{
+				ObjEvent event;
+				event.m_type     = ObjEvent::Material;
+				event.m_triangle = uint32_t(chunk.m_triangles.size() );
+				event.m_name     = argv[1];
+				chunk.m_events.push_back(event);
+			}
+// unsupported tags
+// 				else if (0 == strcmp(argv[0], "mtllib") )
+// 				{
+// 				}
+// 				else if (0 == strcmp(argv[0], "o") )
+// 				{
+// 				}
+// 				else if (0 == strcmp(argv[0], "s") )
+// 				{
+// 				}
+		}
+
+		++chunk.m_numLines;
+	}
+}
+
+// Splits block on line boundaries into one chunk per thread, and parses
+// chunks in parallel. Block must be zero terminated.
+void parseObjBlock(ObjChunkArray& _chunks, char* _data, uint32_t _size, uint32_t _numThreads, float _scale, bool _ccw, bool _hasBc)
+{
+	ObjParse parse;
+	parse.m_chunks = &_chunks;
+	parse.m_first  = uint32_t(_chunks.size() );
+
+	_chunks.resize(parse.m_first + _numThreads);
+
+	for (uint32_t ii = 0, start = 0; ii < _numThreads; ++ii)
+	{
+		ObjChunk& chunk = _chunks[parse.m_first + ii];
+		chunk.m_scale = _scale;
+		chunk.m_ccw   = _ccw;
+		chunk.m_hasBc = _hasBc;
+		chunk.m_numLines = 0;
+		chunk.m_numParamVertices = 0;
+		chunk.m_data  = &_data[start];
+
+		uint32_t end = ii+1 == _numThreads
+			? _size
+			: bx::uint32_max(start, uint32_t(uint64_t(_size)*(ii+1)/_numThreads) )
+			;
+		while (end < _size
+		&&     '\n' != _data[end])
+		{
+			++end;
+		}
+
+		if (end < _size)
+		{
+			_data[end] = '\0';
+			start = end+1;
+		}
+		else
+		{
+			start = _size;
+		}
+	}
+
+	parallelFor(_numThreads, parseObjChunk, &parse);
+}
+
+struct ObjResolve
+{
+	ObjChunkArray* m_chunks;
+	TriangleArray* m_triangles;
+	uint32_t       m_numThreads;
+};
+
+// Thread resolves every m_numThreads-th chunk, and buckets chunk vertices by
+// index map partition, so that dedup doesn't need to scan all vertices per
+// partition.
+void resolveObjChunk(void* _userData, uint32_t _idx)
+{
+	ObjResolve& resolve = *(ObjResolve*)_userData;
+	const uint32_t numChunks     = uint32_t(resolve.m_chunks->size() );
+	const uint32_t numPartitions = resolve.m_numThreads;
+
+	for (uint32_t chunkIdx = _idx; chunkIdx < numChunks; chunkIdx += resolve.m_numThreads)
+	{
+		ObjChunk& chunk = (*resolve.m_chunks)[chunkIdx];
+
+		chunk.m_hashes.resize(chunk.m_vertices.size() );
+		chunk.m_partitions.resize(numPartitions);
+		for (uint32_t ii = 0, num = uint32_t(chunk.m_vertices.size() ); ii < num; ++ii)
+		{
+			Index3& index = chunk.m_vertices[ii];
+			const uint8_t relative = chunk.m_relative[ii];
+			index.m_position += 0 != (relative & OBJ_RELATIVE_POSITION) ? int32_t(chunk.m_basePosition) : 0;
+			index.m_texcoord += 0 != (relative & OBJ_RELATIVE_TEXCOORD) ? int32_t(chunk.m_baseTexcoord) : 0;
+			index.m_normal   += 0 != (relative & OBJ_RELATIVE_NORMAL)   ? int32_t(chunk.m_baseNormal)   : 0;
+
+			uint64_t hash0 = index.m_position;
+			uint64_t hash1 = uint64_t(index.m_texcoord)<<20;
+			uint64_t hash2 = uint64_t(index.m_normal)<<40;
+			uint64_t hash3 = uint64_t(index.m_vbc)<<60;
+			const uint64_t hash = hash0^hash1^hash2^hash3;
+			chunk.m_hashes[ii] = hash;
+			chunk.m_partitions[hash % numPartitions].push_back(ii);
+		}
+
+		std::vector<uint8_t>().swap(chunk.m_relative);
+
+		Triangle* triangles = &(*resolve.m_triangles)[chunk.m_baseTriangle];
+		for (uint32_t ii = 0, num = uint32_t(chunk.m_triangles.size() ); ii < num; ++ii)
+		{
+			const Triangle& triangle = chunk.m_triangles[ii];
+			triangles[ii].m_index[0] = chunk.m_hashes[triangle.m_index[0] ];
+			triangles[ii].m_index[1] = chunk.m_hashes[triangle.m_index[1] ];
+			triangles[ii].m_index[2] = chunk.m_hashes[triangle.m_index[2] ];
+		}
+	}
+}
+
+struct ObjDedup
+{
+	ObjChunkArray*  m_chunks;
+	Index3MapArray* m_indexMaps;
+};
+
+// Each thread owns one partition of index map, and inserts only vertices
+// bucketed into it by resolve.
+void dedupObjVertices(void* _userData, uint32_t _idx)
+{
+	ObjDedup& dedup = *(ObjDedup*)_userData;
+	Index3Map& indexMap = (*dedup.m_indexMaps)[_idx];
+
+	for (ObjChunkArray::const_iterator it = dedup.m_chunks->begin(), itEnd = dedup.m_chunks->end(); it != itEnd; ++it)
+	{
+		const ObjChunk& chunk = *it;
+		const std::vector<uint32_t>& partition = chunk.m_partitions[_idx];
+		for (uint32_t jj = 0, num = uint32_t(partition.size() ); jj < num; ++jj)
+		{
+			const uint32_t ii = partition[jj];
+			const uint64_t hash = chunk.m_hashes[ii];
+			const Index3& index = chunk.m_vertices[ii];
+			stl::pair<Index3Map::iterator, bool> result = indexMap.insert(stl::make_pair(hash, index) );
+			if (!result.second)
+			{
+				Index3& oldIndex = result.first->second;
+				BX_UNUSED(oldIndex);
+				BX_CHECK(oldIndex.m_position == index.m_position
+					&& oldIndex.m_texcoord == index.m_texcoord
+					&& oldIndex.m_normal == index.m_normal
+					, "Hash collision!"
+					);
+			}
+		}
+	}
+}
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		fprintf(stderr, "Error:\n%s\n\n", _error);
+	}
+
+	fprintf(stderr
 		, "geometryc, bgfx geometry compiler tool, version %d.%d.%d.\n"
 		  "Copyright 2011-2017 Branimir Karadzic. All rights reserved.\n"
 		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
@@ -405,15 +2752,40 @@ void help(const char* _error = NULL)
 		  "      --obb <num>          Number of steps for calculating oriented bounding box.\n"
 		  "           Default value is 17. Less steps less precise OBB is.\n"
 		  "           More steps slower calculation.\n"
+		  "      --packpos <num>      Position packing.\n"
+		  "           0 - unpacked 12 bytes (default).\n"
+		  "           1 - 16-bit normalized relative to mesh AABB, 8 bytes. Dequantization\n"
+		  "               scale and offset are stored in vertex buffer chunk.\n"
 		  "      --packnormal <num>   Normal packing.\n"
 		  "           0 - unpacked 12 bytes (default).\n"
 		  "           1 - packed 4 bytes.\n"
+		  "           2 - 16-bit octahedral 4 bytes (tangent 8 bytes, z is handedness).\n"
 		  "      --packuv <num>       Texture coordinate packing.\n"
 		  "           0 - unpacked 8 bytes (default).\n"
-		  "           1 - packed 4 bytes.\n"
+		  "           1 - packed 4 bytes (half float).\n"
 		  "      --tangent            Calculate tangent vectors (packing mode is the same as normal).\n"
 		  "      --barycentric        Adds barycentric vertex attribute (packed in bgfx::Attrib::Color1).\n"
 		  "  -c, --compress           Compress indices.\n"
+		  "      --compressformat <num> Index compression format.\n"
+		  "           0 - auto, per triangle unless mesh has degenerate triangles (default).\n"
+		  "           1 - per index, handles degenerate triangles, slower to decompress.\n"
+		  "           2 - per triangle, better ratio and faster to decompress.\n"
+		  "  -j, --threads <num>      Number of threads used for parsing (default 4).\n"
+		  "      --cachesize <num>    Post-transform vertex cache size used for optimization (default 32).\n"
+		  "      --overdraw <num>     Reorder triangle clusters to reduce overdraw, allowing vertex\n"
+		  "           cache ACMR to degrade by given factor (e.g. 1.05).\n"
+		  "      --stats              Print vertex cache and vertex fetch statistics per primitive.\n"
+		  "      --lod <num>          Number of simplified LODs generated for each primitive (default 0,\n"
+		  "           max 7). LODs are stored as additional primitives with error metric\n"
+		  "           (index compression is ignored).\n"
+		  "      --lodratio <num>     Triangle count ratio between successive LODs (default 0.5).\n"
+		  "      --meshlets           Partition primitives into clusters of up to 64 vertices and\n"
+		  "           124 triangles with bounding sphere and normal cone for culling\n"
+		  "           (index compression is ignored).\n"
+		  "      --index32            Write 32-bit indices instead of splitting meshes into\n"
+		  "           sub-meshes addressable with 16-bit indices (index compression is ignored).\n"
+		  "  -m, --mapped             Write memory mappable mesh container with aligned vertex\n"
+		  "           and index data (index compression is ignored).\n"
 
 		  "\n"
 		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
@@ -462,7 +2834,24 @@ int main(int _argc, const char* _argv[])
 		scale = (float)atof(scaleArg);
 	}
 
-	bool compress = cmdLine.hasArg('c', "compress");
+	uint32_t numLods = 0;
+	cmdLine.hasArg(numLods, '\0', "lod");
+	numLods = bx::uint32_min(numLods, BGFX_GEOMETRYC_MAX_LODS-1);
+
+	float lodRatio = 0.5f;
+	const char* lodRatioArg = cmdLine.findOption("lodratio");
+	if (NULL != lodRatioArg)
+	{
+		lodRatio = bx::fclamp( (float)atof(lodRatioArg), 0.01f, 0.99f);
+	}
+
+	bool mapped   = cmdLine.hasArg('m', "mapped");
+	bool index32  = cmdLine.hasArg("index32");
+	bool meshlets = cmdLine.hasArg("meshlets");
+	bool compress = cmdLine.hasArg('c', "compress") && !mapped && !index32 && 0 == numLods && !meshlets;
+
+	uint32_t compressFormat = 0;
+	cmdLine.hasArg(compressFormat, '\0', "compressformat");
 
 	cmdLine.hasArg(s_obbSteps, '\0', "obb");
 	s_obbSteps = bx::uint32_min(bx::uint32_max(s_obbSteps, 1), 90);
@@ -473,11 +2862,31 @@ int main(int _argc, const char* _argv[])
 	uint32_t packUv = 0;
 	cmdLine.hasArg(packUv, '\0', "packuv");
 
+	uint32_t packPos = 0;
+	cmdLine.hasArg(packPos, '\0', "packpos");
+
 	bool ccw = cmdLine.hasArg("ccw");
 	bool flipV = cmdLine.hasArg("flipv");
 	bool hasTangent = cmdLine.hasArg("tangent");
 	bool hasBc = cmdLine.hasArg("barycentric");
 
+	uint32_t numThreads = 4;
+	cmdLine.hasArg(numThreads, 'j', "threads");
+	numThreads = bx::uint32_min(bx::uint32_max(numThreads, 1), 64);
+
+	uint32_t cacheSize = 32;
+	cmdLine.hasArg(cacheSize, '\0', "cachesize");
+	cacheSize = bx::uint32_min(bx::uint32_max(cacheSize, 4), 64);
+
+	float overdraw = 0.0f;
+	const char* overdrawArg = cmdLine.findOption("overdraw");
+	if (NULL != overdrawArg)
+	{
+		overdraw = bx::fmax( (float)atof(overdrawArg), 1.0f);
+	}
+
+	bool stats = cmdLine.hasArg("stats");
+
 	FILE* file = fopen(filePath, "r");
 	if (NULL == file)
 	{
@@ -486,254 +2895,159 @@ int main(int _argc, const char* _argv[])
 	}
 
 	int64_t parseElapsed = -bx::getHPCounter();
-	int64_t triReorderElapsed = 0;
-
-	uint32_t size = (uint32_t)fsize(file);
-	char* data = new char[size+1];
-	size = (uint32_t)fread(data, 1, size, file);
-	data[size] = '\0';
-	fclose(file);
 
 	// https://en.wikipedia.org/wiki/Wavefront_.obj_file
 
-	Vector3Array positions;
-	Vector3Array normals;
-	Vector3Array texcoords;
-	Index3Map indexMap;
-	TriangleArray triangles;
-	GroupArray groups;
-
-	uint32_t num = 0;
+	// File is read in bounded blocks. Each block is cut after its last
+	// complete line, and the remainder is carried over to next block.
+	ObjChunkArray chunks;
 
-	Group group;
-	group.m_startTriangle = 0;
-	group.m_numTriangles = 0;
+	uint32_t blockSize = OBJ_BLOCK_SIZE;
+	char* data = new char[blockSize+1];
+	uint32_t carry = 0;
 
-	char commandLine[2048];
-	uint32_t len = sizeof(commandLine);
-	int argc;
-	char* argv[64];
-	const char* next = data;
-	do
+	for (bool eof = false; !eof;)
 	{
-		next = bx::tokenizeCommandLine(next, commandLine, len, argc, argv, BX_COUNTOF(argv), '\n');
-		if (0 < argc)
+		const uint32_t read = uint32_t(fread(&data[carry], 1, blockSize-carry, file) );
+		const uint32_t size = carry + read;
+		eof = 0 != feof(file);
+
+		if (0 == size)
+		{
+			break;
+		}
+
+		uint32_t end = size;
+		if (!eof)
 		{
-			if (0 == strcmp(argv[0], "#") )
+			while (0 < end
+			&&     '\n' != data[end-1])
 			{
-				if (2 < argc
-				&&  0 == strcmp(argv[2], "polygons") )
-				{
-				}
+				--end;
 			}
-			else if (0 == strcmp(argv[0], "f") )
-			{
-				Triangle triangle;
-				memset(&triangle, 0, sizeof(Triangle) );
 
-				const int numNormals   = (int)normals.size();
-				const int numTexcoords = (int)texcoords.size();
-				const int numPositions = (int)positions.size();
-				for (uint32_t edge = 0, numEdges = argc-1; edge < numEdges; ++edge)
-				{
-					Index3 index;
-					index.m_texcoord = -1;
-					index.m_normal = -1;
-					index.m_vertexIndex = -1;
-					if (hasBc)
-					{
-						index.m_vbc = edge < 3 ? edge : (1+(edge+1) )&1;
-					}
-					else
-					{
-						index.m_vbc = 0;
-					}
+			if (0 == end)
+			{
+				// Single line doesn't fit into block.
+				char* temp = new char[blockSize*2+1];
+				memcpy(temp, data, size);
+				delete [] data;
+				data      = temp;
+				carry     = size;
+				blockSize = blockSize*2;
+				continue;
+			}
+		}
 
-					const char* vertex   = argv[edge+1];
-					char* texcoord = const_cast<char*>(bx::strFind(vertex, '/') );
-					if (NULL != texcoord)
-					{
-						*texcoord++ = '\0';
+		// Line feed at the end of block is replaced with terminator.
+		const uint32_t blockEnd = eof ? size : end-1;
+		data[blockEnd] = '\0';
 
-						char* normal = const_cast<char*>(bx::strFind(texcoord, '/') );
-						if (NULL != normal)
-						{
-							*normal++ = '\0';
-							const int nn = atoi(normal);
-							index.m_normal = (nn < 0) ? nn+numNormals : nn-1;
-						}
+		parseObjBlock(chunks, data, blockEnd, numThreads, scale, ccw, hasBc);
 
-						// https://en.wikipedia.org/wiki/Wavefront_.obj_file#Vertex_Normal_Indices_Without_Texture_Coordinate_Indices
-						if(*texcoord != '\0')
-						{
-							const int tex = atoi(texcoord);
-							index.m_texcoord = (tex < 0) ? tex+numTexcoords : tex-1;
-						}
-					}
+		carry = size - end;
+		memmove(data, &data[end], carry);
+	}
 
-					const int pos = atoi(vertex);
-					index.m_position = (pos < 0) ? pos+numPositions : pos-1;
+	delete [] data;
+	fclose(file);
 
-					uint64_t hash0 = index.m_position;
-					uint64_t hash1 = uint64_t(index.m_texcoord)<<20;
-					uint64_t hash2 = uint64_t(index.m_normal)<<40;
-					uint64_t hash3 = uint64_t(index.m_vbc)<<60;
-					uint64_t hash = hash0^hash1^hash2^hash3;
+	int64_t now = bx::getHPCounter();
+	parseElapsed += now;
+	int64_t mergeElapsed = -now;
 
-					stl::pair<Index3Map::iterator, bool> result = indexMap.insert(stl::make_pair(hash, index) );
-					if (!result.second)
-					{
-						Index3& oldIndex = result.first->second;
-						BX_UNUSED(oldIndex);
-						BX_CHECK(oldIndex.m_position == index.m_position
-							&& oldIndex.m_texcoord == index.m_texcoord
-							&& oldIndex.m_normal == index.m_normal
-							, "Hash collision!"
-							);
-					}
+	Vector3Array positions;
+	Vector3Array normals;
+	Vector3Array texcoords;
+	TriangleArray triangles;
+	GroupArray groups;
 
-					switch (edge)
-					{
-					case 0:
-					case 1:
-					case 2:
-						triangle.m_index[edge] = hash;
-						if (2 == edge)
-						{
-							if (ccw)
-							{
-								std::swap(triangle.m_index[1], triangle.m_index[2]);
-							}
-							triangles.push_back(triangle);
-						}
-						break;
+	uint32_t num = 0;
+	uint32_t numParamVertices = 0;
+	uint32_t numTriangles = 0;
 
-					default:
-						if (ccw)
-						{
-							triangle.m_index[2] = triangle.m_index[1];
-							triangle.m_index[1] = hash;
-						}
-						else
-						{
-							triangle.m_index[1] = triangle.m_index[2];
-							triangle.m_index[2] = hash;
-						}
-						triangles.push_back(triangle);
-						break;
-					}
-				}
-			}
-			else if (0 == strcmp(argv[0], "g") )
-			{
-				EXPECT(1 < argc);
-				group.m_name = argv[1];
-			}
-			else if (*argv[0] == 'v')
-			{
-				group.m_numTriangles = (uint32_t)(triangles.size() ) - group.m_startTriangle;
-				if (0 < group.m_numTriangles)
-				{
-					groups.push_back(group);
-					group.m_startTriangle = (uint32_t)(triangles.size() );
-					group.m_numTriangles = 0;
-				}
+	for (ObjChunkArray::iterator it = chunks.begin(), itEnd = chunks.end(); it != itEnd; ++it)
+	{
+		ObjChunk& chunk = *it;
+		chunk.m_basePosition = uint32_t(positions.size() );
+		chunk.m_baseNormal   = uint32_t(normals.size() );
+		chunk.m_baseTexcoord = uint32_t(texcoords.size() );
+		chunk.m_baseTriangle = numTriangles;
+
+		positions.insert(positions.end(), chunk.m_positions.begin(), chunk.m_positions.end() );
+		normals.insert(normals.end(), chunk.m_normals.begin(), chunk.m_normals.end() );
+		texcoords.insert(texcoords.end(), chunk.m_texcoords.begin(), chunk.m_texcoords.end() );
+		Vector3Array().swap(chunk.m_positions);
+		Vector3Array().swap(chunk.m_normals);
+		Vector3Array().swap(chunk.m_texcoords);
+
+		numTriangles     += uint32_t(chunk.m_triangles.size() );
+		num              += chunk.m_numLines;
+		numParamVertices += chunk.m_numParamVertices;
+	}
 
-				if (0 == strcmp(argv[0], "vn") )
-				{
-					Vector3 normal;
-					normal.x = (float)atof(argv[1]);
-					normal.y = (float)atof(argv[2]);
-					normal.z = (float)atof(argv[3]);
+	if (0 < numParamVertices)
+	{
+		printf("warning: 'parameter space vertices' are unsupported.\n");
+	}
 
-					normals.push_back(normal);
-				}
-				else if (0 == strcmp(argv[0], "vp") )
-				{
-					static bool once = true;
-					if (once)
-					{
-						once = false;
-						printf("warning: 'parameter space vertices' are unsupported.\n");
-					}
-				}
-				else if (0 == strcmp(argv[0], "vt") )
-				{
-					Vector3 texcoord;
-					texcoord.x = (float)atof(argv[1]);
-					texcoord.y = 0.0f;
-					texcoord.z = 0.0f;
-					switch (argc)
-					{
-					case 4:
-						texcoord.z = (float)atof(argv[3]);
-						// fallthrough
-					case 3:
-						texcoord.y = (float)atof(argv[2]);
-						break;
+	triangles.resize(numTriangles);
 
-					default:
-						break;
-					}
+	ObjResolve resolve;
+	resolve.m_chunks     = &chunks;
+	resolve.m_triangles  = &triangles;
+	resolve.m_numThreads = numThreads;
+	parallelFor(numThreads, resolveObjChunk, &resolve);
 
-					texcoords.push_back(texcoord);
-				}
-				else
-				{
-					float px = (float)atof(argv[1]);
-					float py = (float)atof(argv[2]);
-					float pz = (float)atof(argv[3]);
-					float pw = 1.0f;
-					if (argc > 4)
-					{
-						pw = (float)atof(argv[4]);
-					}
+	// Replay group and material changes in file order.
+	Group group;
+	group.m_startTriangle = 0;
+	group.m_numTriangles = 0;
 
-					float invW = scale/pw;
-					px *= invW;
-					py *= invW;
-					pz *= invW;
+	for (ObjChunkArray::iterator it = chunks.begin(), itEnd = chunks.end(); it != itEnd; ++it)
+	{
+		ObjChunk& chunk = *it;
+		for (ObjEventArray::const_iterator evIt = chunk.m_events.begin(), evItEnd = chunk.m_events.end(); evIt != evItEnd; ++evIt)
+		{
+			const ObjEvent& event = *evIt;
+			const uint32_t triangle = chunk.m_baseTriangle + event.m_triangle;
 
-					Vector3 pos;
-					pos.x = px;
-					pos.y = py;
-					pos.z = pz;
+			switch (event.m_type)
+			{
+			case ObjEvent::Group:
+				group.m_name = event.m_name;
+				break;
 
-					positions.push_back(pos);
+			case ObjEvent::Vertex:
+				group.m_numTriangles = triangle - group.m_startTriangle;
+				if (0 < group.m_numTriangles)
+				{
+					groups.push_back(group);
+					group.m_startTriangle = triangle;
+					group.m_numTriangles = 0;
 				}
-			}
-			else if (0 == strcmp(argv[0], "usemtl") )
-			{
-				std::string material(argv[1]);
+				break;
 
-				if (material != group.m_material)
+			case ObjEvent::Material:
+				if (event.m_name != group.m_material)
 				{
-					group.m_numTriangles = (uint32_t)(triangles.size() ) - group.m_startTriangle;
+					group.m_numTriangles = triangle - group.m_startTriangle;
 					if (0 < group.m_numTriangles)
 					{
 						groups.push_back(group);
-						group.m_startTriangle = (uint32_t)(triangles.size() );
+						group.m_startTriangle = triangle;
 						group.m_numTriangles = 0;
 					}
 				}
 
-				group.m_material = material;
+				group.m_material = event.m_name;
+				break;
 			}
-// unsupported tags
-// 				else if (0 == strcmp(argv[0], "mtllib") )
-// 				{
-// 				}
-// 				else if (0 == strcmp(argv[0], "o") )
-// 				{
-// 				}
-// 				else if (0 == strcmp(argv[0], "s") )
-// 				{
-// 				}
 		}
 
-		++num;
+		TriangleArray().swap(chunk.m_triangles);
+		ObjEventArray().swap(chunk.m_events);
 	}
-	while ('\0' != *next);
 
 	group.m_numTriangles = (uint32_t)(triangles.size() ) - group.m_startTriangle;
 	if (0 < group.m_numTriangles)
@@ -743,10 +3057,21 @@ int main(int _argc, const char* _argv[])
 		group.m_numTriangles = 0;
 	}
 
-	delete [] data;
+	now = bx::getHPCounter();
+	mergeElapsed += now;
+	int64_t dedupElapsed = -now;
 
-	int64_t now = bx::getHPCounter();
-	parseElapsed += now;
+	Index3MapArray indexMaps(numThreads);
+
+	ObjDedup dedup;
+	dedup.m_chunks    = &chunks;
+	dedup.m_indexMaps = &indexMaps;
+	parallelFor(numThreads, dedupObjVertices, &dedup);
+
+	ObjChunkArray().swap(chunks);
+
+	now = bx::getHPCounter();
+	dedupElapsed += now;
 	int64_t convertElapsed = -now;
 
 	std::sort(groups.begin(), groups.end(), GroupSortByMaterial() );
@@ -755,7 +3080,8 @@ int main(int _argc, const char* _argv[])
 	bool hasNormal;
 	bool hasTexcoord;
 	{
-		Index3Map::const_iterator it = indexMap.begin();
+		const uint64_t hash = triangles.begin()->m_index[0];
+		Index3Map::const_iterator it = findIndexMap(indexMaps, hash).find(hash);
 		hasNormal   = -1 != it->second.m_normal;
 		hasTexcoord = -1 != it->second.m_texcoord;
 
@@ -764,9 +3090,12 @@ int main(int _argc, const char* _argv[])
 		{
 			hasTexcoord = true;
 
-			for (Index3Map::iterator jt = indexMap.begin(), jtEnd = indexMap.end(); jt != jtEnd; ++jt)
+			for (Index3MapArray::iterator mapIt = indexMaps.begin(); mapIt != indexMaps.end(); ++mapIt)
 			{
-				jt->second.m_texcoord = jt->second.m_position;
+				for (Index3Map::iterator jt = mapIt->begin(), jtEnd = mapIt->end(); jt != jtEnd; ++jt)
+				{
+					jt->second.m_texcoord = jt->second.m_position;
+				}
 			}
 		}
 
@@ -775,38 +3104,61 @@ int main(int _argc, const char* _argv[])
 		{
 			hasNormal = true;
 
-			for (Index3Map::iterator jt = indexMap.begin(), jtEnd = indexMap.end(); jt != jtEnd; ++jt)
+			for (Index3MapArray::iterator mapIt = indexMaps.begin(); mapIt != indexMaps.end(); ++mapIt)
 			{
-				jt->second.m_normal = jt->second.m_position;
+				for (Index3Map::iterator jt = mapIt->begin(), jtEnd = mapIt->end(); jt != jtEnd; ++jt)
+				{
+					jt->second.m_normal = jt->second.m_position;
+				}
 			}
 		}
 	}
 
+	// Geometry is processed in full precision declaration, and converted
+	// into packed output declaration when written.
 	bgfx::VertexDecl decl;
+	bgfx::VertexDecl outDecl;
 	decl.begin();
+	outDecl.begin();
 	decl.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float);
 
+	switch (packPos)
+	{
+	default:
+	case 0:
+		outDecl.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float);
+		break;
+
+	case 1:
+		outDecl.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Int16, true, true);
+		break;
+	}
+
 	if (hasColor)
 	{
 		decl.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true);
+		outDecl.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true);
 	}
 
 	if (hasBc)
 	{
 		decl.add(bgfx::Attrib::Color1, 4, bgfx::AttribType::Uint8, true);
+		outDecl.add(bgfx::Attrib::Color1, 4, bgfx::AttribType::Uint8, true);
 	}
 
 	if (hasTexcoord)
 	{
+		decl.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float);
+
 		switch (packUv)
 		{
 		default:
 		case 0:
-			decl.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float);
+			outDecl.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float);
 			break;
 
 		case 1:
-			decl.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half);
+			outDecl.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half);
 			break;
 		}
 	}
@@ -815,37 +3167,51 @@ int main(int _argc, const char* _argv[])
 	{
 		hasTangent &= hasTexcoord;
 
+		decl.add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float);
+		if (hasTangent)
+		{
+			decl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Float);
+		}
+
 		switch (packNormal)
 		{
 		default:
 		case 0:
-			decl.add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float);
+			outDecl.add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float);
 			if (hasTangent)
 			{
-				decl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Float);
+				outDecl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Float);
 			}
 			break;
 
 		case 1:
-			decl.add(bgfx::Attrib::Normal, 4, bgfx::AttribType::Uint8, true, true);
+			outDecl.add(bgfx::Attrib::Normal, 4, bgfx::AttribType::Uint8, true, true);
 			if (hasTangent)
 			{
-				decl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Uint8, true, true);
+				outDecl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Uint8, true, true);
+			}
+			break;
+
+		case 2:
+			outDecl.add(bgfx::Attrib::Normal, 2, bgfx::AttribType::Int16, true, true);
+			if (hasTangent)
+			{
+				outDecl.add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Int16, true, true);
 			}
 			break;
 		}
 	}
 	decl.end();
+	outDecl.end();
 
 	uint32_t stride = decl.getStride();
 	uint8_t* vertexData = new uint8_t[triangles.size() * 3 * stride];
-	uint16_t* indexData = new uint16_t[triangles.size() * 3];
+	uint32_t* indexData = new uint32_t[triangles.size() * 3];
 	int32_t numVertices = 0;
 	int32_t numIndices = 0;
-	int32_t numPrimitives = 0;
 
 	uint8_t* vertices = vertexData;
-	uint16_t* indices = indexData;
+	uint32_t* indices = indexData;
 
 	std::string material = groups.begin()->m_material;
 
@@ -861,20 +3227,46 @@ int main(int _argc, const char* _argv[])
 	Primitive prim;
 	prim.m_startVertex = 0;
 	prim.m_startIndex  = 0;
+	prim.m_lod         = 0;
+	prim.m_lodError    = 0.0f;
 
 	uint32_t positionOffset = decl.getOffset(bgfx::Attrib::Position);
 	uint32_t color0Offset   = decl.getOffset(bgfx::Attrib::Color0);
 
-	bx::CrtAllocator crtAllocator;
-	bx::MemoryBlock  memBlock(&crtAllocator);
+	MeshOutput output;
+	output.m_writer     = &writer;
+	output.m_mapped     = mapped;
+	output.m_compress   = compress;
+	output.m_compressFormat = 1 == compressFormat ? IBCF_PER_INDICE_1
+		: 2 == compressFormat ? IBCF_PER_TRIANGLE_1
+		: IBCF_AUTO
+		;
+	output.m_index32    = index32;
+	output.m_hasTangent = hasTangent;
+	output.m_stats      = stats;
+	output.m_overdraw   = overdraw;
+	output.m_cacheSize  = uint16_t(cacheSize);
+	output.m_numLods    = numLods;
+	output.m_lodRatio   = lodRatio;
+	output.m_meshlets   = meshlets;
+	output.m_numMeshes  = 0;
+	output.m_numMeshlets = 0;
+	output.m_triReorderElapsed = 0;
+	output.m_lodElapsed = 0;
+	output.m_decompressElapsed = 0;
+	memset(&output.m_total, 0, sizeof(output.m_total) );
+	output.m_outDecl    = outDecl;
+	output.m_quantize   = 0 != packPos || 0 != packNormal || 0 != packUv;
+	output.m_packPos    = packPos;
+	output.m_packNormal = packNormal;
+	memset(output.m_error, 0, sizeof(output.m_error) );
 
 	uint32_t ii = 0;
 	for (GroupArray::const_iterator groupIt = groups.begin(); groupIt != groups.end(); ++groupIt, ++ii)
 	{
 		for (uint32_t tri = groupIt->m_startTriangle, end = tri + groupIt->m_numTriangles; tri < end; ++tri)
 		{
-			if (material != groupIt->m_material
-			||  65533 < numVertices)
+			if (material != groupIt->m_material)
 			{
 				prim.m_numVertices = numVertices - prim.m_startVertex;
 				prim.m_numIndices  = numIndices  - prim.m_startIndex;
@@ -883,47 +3275,23 @@ int main(int _argc, const char* _argv[])
 					primitives.push_back(prim);
 				}
 
-				if (hasTangent)
-				{
-					calcTangents(vertexData, uint16_t(numVertices), decl, indexData, numIndices);
-				}
-
-				bx::MemoryWriter memWriter(&memBlock);
-
-				triReorderElapsed -= bx::getHPCounter();
-				for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
-				{
-					const Primitive& prim1 = *primIt;
-					triangleReorder(indexData + prim1.m_startIndex, prim1.m_numIndices, numVertices, 32);
-					if (compress)
-					{
-						triangleCompress(&memWriter
-							, indexData  + prim1.m_startIndex
-							, prim1.m_numIndices
-							, vertexData + prim1.m_startVertex
-							, numVertices
-							, uint16_t(stride)
-							);
-					}
-				}
-				triReorderElapsed += bx::getHPCounter();
-
-				write(&writer
+				writeMesh(output
 					, vertexData
 					, numVertices
 					, decl
 					, indexData
 					, numIndices
-					, (uint8_t*)memBlock.more()
-					, memBlock.getSize()
 					, material
 					, primitives
 					);
 				primitives.clear();
 
-				for (Index3Map::iterator indexIt = indexMap.begin(); indexIt != indexMap.end(); ++indexIt)
+				for (Index3MapArray::iterator mapIt = indexMaps.begin(); mapIt != indexMaps.end(); ++mapIt)
 				{
-					indexIt->second.m_vertexIndex = -1;
+					for (Index3Map::iterator indexIt = mapIt->begin(); indexIt != mapIt->end(); ++indexIt)
+					{
+						indexIt->second.m_vertexIndex = -1;
+					}
 				}
 
 				vertices = vertexData;
@@ -932,7 +3300,6 @@ int main(int _argc, const char* _argv[])
 				numIndices = 0;
 				prim.m_startVertex = 0;
 				prim.m_startIndex = 0;
-				++numPrimitives;
 
 				material = groupIt->m_material;
 			}
@@ -941,7 +3308,7 @@ int main(int _argc, const char* _argv[])
 			for (uint32_t edge = 0; edge < 3; ++edge)
 			{
 				uint64_t hash = triangle.m_index[edge];
-				Index3& index = indexMap[hash];
+				Index3& index = findIndexMap(indexMaps, hash)[hash];
 				if (index.m_vertexIndex == -1)
 				{
 		 			index.m_vertexIndex = numVertices++;
@@ -989,7 +3356,7 @@ int main(int _argc, const char* _argv[])
 					vertices += stride;
 				}
 
-				*indices++ = (uint16_t)index.m_vertexIndex;
+				*indices++ = (uint32_t)index.m_vertexIndex;
 				++numIndices;
 			}
 		}
@@ -1014,44 +3381,47 @@ int main(int _argc, const char* _argv[])
 
 	if (0 < primitives.size() )
 	{
-		if (hasTangent)
-		{
-			calcTangents(vertexData, uint16_t(numVertices), decl, indexData, numIndices);
-		}
-
-		bx::MemoryWriter memWriter(&memBlock);
-
-		triReorderElapsed -= bx::getHPCounter();
-		for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
-		{
-			const Primitive& prim1 = *primIt;
-			triangleReorder(indexData + prim1.m_startIndex, prim1.m_numIndices, numVertices, 32);
-			if (compress)
-			{
-				triangleCompress(&memWriter
-					, indexData  + prim1.m_startIndex
-					, prim1.m_numIndices
-					, vertexData + prim1.m_startVertex
-					, numVertices
-					, uint16_t(stride)
-					);
-			}
-		}
-		triReorderElapsed += bx::getHPCounter();
-
-		write(&writer
+		writeMesh(output
 			, vertexData
 			, numVertices
 			, decl
 			, indexData
 			, numIndices
-			, (uint8_t*)memBlock.more()
-			, memBlock.getSize()
 			, material
 			, primitives
 			);
 	}
 
+	if (mapped)
+	{
+		writeContainer(&writer, output.m_chunks);
+	}
+
+	printStats("total", output.m_total);
+
+	if (meshlets)
+	{
+		printf("meshlets: %d\n", output.m_numMeshlets);
+	}
+
+	for (uint32_t attr = 0; attr < bgfx::Attrib::Count; ++attr)
+	{
+		const QuantizeError& error = output.m_error[attr];
+		if (0 < error.m_num)
+		{
+			const bool angle = bgfx::Attrib::Normal == attr || bgfx::Attrib::Tangent == attr;
+			printf("%-24s max error %f%s, avg %f%s\n"
+				, bgfx::getAttribName(bgfx::Attrib::Enum(attr) )
+				, error.m_max
+				, angle ? " [deg]" : ""
+				, error.m_sum / error.m_num
+				, angle ? " [deg]" : ""
+				);
+		}
+	}
+
+	printf("vertex size: %d -> %d\n", decl.getStride(), outDecl.getStride() );
+
 	printf("size: %d\n", uint32_t(bx::seek(&writer) ) );
 	bx::close(&writer);
 
@@ -1061,16 +3431,25 @@ int main(int _argc, const char* _argv[])
 	now = bx::getHPCounter();
 	convertElapsed += now;
 
-	printf("parse %f [s]\ntri reorder %f [s]\nconvert %f [s]\n# %d, g %d, p %d, v %d, i %d\n"
+	printf("parse %f [s] (%d threads)\nmerge %f [s]\ndedup %f [s]\nlod %f [s]\ntri reorder %f [s]\nconvert %f [s]\n# %d, g %d, p %d, v %d, i %d\n"
 		, double(parseElapsed)/bx::getHPFrequency()
-		, double(triReorderElapsed)/bx::getHPFrequency()
+		, numThreads
+		, double(mergeElapsed)/bx::getHPFrequency()
+		, double(dedupElapsed)/bx::getHPFrequency()
+		, double(output.m_lodElapsed)/bx::getHPFrequency()
+		, double(output.m_triReorderElapsed)/bx::getHPFrequency()
 		, double(convertElapsed)/bx::getHPFrequency()
 		, num
 		, uint32_t(groups.size() )
-		, numPrimitives
+		, output.m_numMeshes
 		, numVertices
 		, numIndices
 		);
 
+	if (compress)
+	{
+		printf("decompress %f [s]\n", double(output.m_decompressElapsed)/bx::getHPFrequency() );
+	}
+
 	return EXIT_SUCCESS;
 }
@@ -5,6 +5,10 @@
 
 #include "shaderc.h"
 #include <bx/commandline.h>
+#include <bx/cpu.h>
+#include <bx/mutex.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
 
 #define MAX_TAGS 256
 extern "C"
@@ -16,6 +20,18 @@ extern "C"
 #define BGFX_CHUNK_MAGIC_FSH BX_MAKEFOURCC('F', 'S', 'H', 0x4)
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', 0x4)
 
+// Shader permutation archive:
+//   uint32_t magic
+//   uint16_t numDefines, followed by numDefines x (uint16_t len, char[len])
+//   uint32_t numPermutations (1 << numDefines)
+//   uint32_t numShaders
+//   uint16_t shader index for each permutation
+//   numShaders x (uint32_t offset, uint32_t size), offset from start of data
+//   shader data (same as single shader binary)
+#define BGFX_CHUNK_MAGIC_SPA BX_MAKEFOURCC('S', 'P', 'A', 0x0)
+
+#define BGFX_SHADERC_MAX_PERMUTATION_DEFINES 12
+
 #define BGFX_SHADERC_VERSION_MAJOR 1
 #define BGFX_SHADERC_VERSION_MINOR 1
 
@@ -211,6 +227,41 @@ namespace bgfx
 		return len;
 	}
 
+	typedef std::vector<uint8_t> ShaderBinary;
+
+	class BufferWriter : public bx::CrtFileWriter
+	{
+	public:
+		BufferWriter(ShaderBinary& _buffer)
+			: m_buffer(_buffer)
+		{
+		}
+
+		virtual ~BufferWriter()
+		{
+		}
+
+		virtual bool open(const char* /*_filePath*/, bool /*_append*/, bx::Error* /*_err*/) BX_OVERRIDE
+		{
+			m_buffer.clear();
+			return true;
+		}
+
+		virtual void close() BX_OVERRIDE
+		{
+		}
+
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error*) BX_OVERRIDE
+		{
+			const uint8_t* data = (const uint8_t*)_data;
+			m_buffer.insert(m_buffer.end(), data, data+_size);
+			return _size;
+		}
+
+	private:
+		ShaderBinary& m_buffer;
+	};
+
 	class Bin2cWriter : public bx::CrtFileWriter
 	{
 	public:
@@ -447,6 +498,189 @@ namespace bgfx
 		}
 	}
 
+	typedef bool (*CompileFn)(bx::CommandLine& _cmdLine, uint32_t _version, const std::string& _code, bx::WriterI* _writer);
+
+	struct ShaderCache
+	{
+		ShaderCache()
+			: m_dir(NULL)
+			, m_hits(0)
+			, m_misses(0)
+			, m_tmp(0)
+		{
+		}
+
+		const char* m_dir;
+		uint32_t m_hits;
+		uint32_t m_misses;
+		uint32_t m_tmp;
+	};
+
+	static ShaderCache s_cache;
+
+	// Backend output of shaders compiled by this process, so that permutations
+	// or batch jobs with identical preprocessed source are compiled only once.
+	typedef std::unordered_map<uint64_t, ShaderBinary> ShaderBinaryMap;
+	static ShaderBinaryMap s_compiled;
+	static bx::Mutex s_compiledMutex;
+
+	// Backends lock it only around process global state, so that batch jobs
+	// compile in parallel, see shaderc.h.
+	bx::Mutex g_compilerMutex;
+
+	// Options which affect backend output for the same preprocessed source.
+	static const char* s_cacheFlags[] =
+	{
+		"debug",
+		"Werror",
+		"avoid-flow-control",
+		"no-preshader",
+		"partial-precision",
+		"prefer-flow-control",
+		"backwards-compatibility",
+	};
+
+	struct CacheKey
+	{
+		void begin()
+		{
+			m_lo.begin(0);
+			m_hi.begin(UINT32_C(0x9e3779b9) );
+		}
+
+		void add(const void* _data, int32_t _len)
+		{
+			m_lo.add(_data, _len);
+			m_hi.add(_data, _len);
+		}
+
+		void add(const char* _str)
+		{
+			// Include terminator, so that adjacent strings can't alias.
+			add(NULL == _str ? "" : _str, NULL == _str ? 1 : bx::strLen(_str)+1);
+		}
+
+		uint64_t end()
+		{
+			return (uint64_t(m_hi.end() ) << 32) | m_lo.end();
+		}
+
+		bx::HashMurmur2A m_lo;
+		bx::HashMurmur2A m_hi;
+	};
+
+	static uint64_t getCacheKey(bx::CommandLine& _cmdLine, uint32_t _version, const std::string& _code)
+	{
+		CacheKey key;
+		key.begin();
+
+		const uint32_t toolVersion[] = { BGFX_SHADERC_VERSION_MAJOR, BGFX_SHADERC_VERSION_MINOR, BGFX_API_VERSION, _version };
+		key.add(toolVersion, sizeof(toolVersion) );
+
+		key.add(_cmdLine.findOption('\0', "type") );
+		key.add(_cmdLine.findOption('\0', "platform") );
+		key.add(_cmdLine.findOption('p', "profile") );
+		key.add(_cmdLine.findOption('O') );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_cacheFlags); ++ii)
+		{
+			const uint8_t flag = _cmdLine.hasArg(s_cacheFlags[ii]);
+			key.add(&flag, sizeof(flag) );
+		}
+
+		key.add(_code.c_str(), int32_t(_code.size() ) );
+
+		return key.end();
+	}
+
+	// Compiles shader with backend compiler, unless the same preprocessed
+	// source was already compiled with the same options by this process, or
+	// when cache directory is set, by previous invocation.
+	static bool compileCached(CompileFn _fn, bx::CommandLine& _cmdLine, uint32_t _version, const std::string& _code, bx::WriterI* _writer)
+	{
+		// Disassembly is written next to output file by backend.
+		if (_cmdLine.hasArg('\0', "disasm") )
+		{
+			return _fn(_cmdLine, _version, _code, _writer);
+		}
+
+		const uint64_t key = getCacheKey(_cmdLine, _version, _code);
+
+		{
+			bx::MutexScope scope(s_compiledMutex);
+			ShaderBinaryMap::const_iterator it = s_compiled.find(key);
+			if (it != s_compiled.end() )
+			{
+				bx::write(_writer, it->second.data(), int32_t(it->second.size() ) );
+				bx::atomicInc(&s_cache.m_hits);
+				return true;
+			}
+		}
+
+		char filePath[1024];
+		filePath[0] = '\0';
+
+		if (NULL != s_cache.m_dir)
+		{
+			bx::snprintf(filePath, BX_COUNTOF(filePath), "%s/%08x%08x.bin"
+				, s_cache.m_dir
+				, uint32_t(key>>32)
+				, uint32_t(key)
+				);
+		}
+
+		bx::CrtFileReader reader;
+		if ('\0' != filePath[0]
+		&&  bx::open(&reader, filePath) )
+		{
+			ShaderBinary binary( (uint32_t)bx::getSize(&reader) );
+			binary.resize(bx::read(&reader, binary.data(), int32_t(binary.size() ) ) );
+			bx::close(&reader);
+
+			bx::write(_writer, binary.data(), int32_t(binary.size() ) );
+
+			{
+				bx::MutexScope scope(s_compiledMutex);
+				s_compiled[key].swap(binary);
+			}
+
+			bx::atomicInc(&s_cache.m_hits);
+			BX_TRACE("Cache hit: %s", filePath);
+			return true;
+		}
+
+		ShaderBinary binary;
+		BufferWriter writer(binary);
+
+		const bool compiled = _fn(_cmdLine, _version, _code, &writer);
+
+		bx::atomicInc(&s_cache.m_misses);
+
+		if (compiled)
+		{
+			bx::write(_writer, binary.data(), int32_t(binary.size() ) );
+
+			if ('\0' != filePath[0])
+			{
+				// Write to temporary file and rename it, so that other jobs
+				// never read partially written cache entry.
+				char tmpPath[1024];
+				bx::snprintf(tmpPath, BX_COUNTOF(tmpPath), "%s.%d.tmp", filePath, bx::atomicInc(&s_cache.m_tmp) );
+				writeFile(tmpPath, binary.data(), int32_t(binary.size() ) );
+
+				if (0 != rename(tmpPath, filePath) )
+				{
+					remove(tmpPath);
+				}
+			}
+
+			bx::MutexScope scope(s_compiledMutex);
+			s_compiled[key].swap(binary);
+		}
+
+		return compiled;
+	}
+
 	struct Preprocessor
 	{
 		Preprocessor(const char* _filePath, bool _essl)
@@ -762,6 +996,14 @@ namespace bgfx
 			  "      --type <type>             Shader type (vertex, fragment)\n"
 			  "      --varyingdef <file path>  Path to varying.def.sc file.\n"
 			  "      --verbose                 Verbose.\n"
+			  "      --cache <dir>             Reuse backend output from cache directory when preprocessed\n"
+			  "                                source and options match previously compiled shader.\n"
+			  "      --permutations <defines>  Compile all combinations of defines (semicolon separated, max 12)\n"
+			  "                                into single shader archive indexed by permutation bits.\n"
+			  "      --batch <file path>       Compile all shaders listed in manifest file in one process.\n"
+			  "                                Each line is shaderc command line (-f, -o, --define, -p, ...),\n"
+			  "                                empty lines and lines starting with # are ignored.\n"
+			  "  -j, --threads <num>           Number of threads used in batch mode (default 4).\n"
 
 			  "\n"
 			  "Options (DX9 and DX11 only):\n"
@@ -778,7 +1020,9 @@ namespace bgfx
 			);
 	}
 
-	int compileShader(int _argc, const char* _argv[])
+	/// When _output is not NULL, compiled shader is returned in memory, and
+	/// output file is not written.
+	int compileShader(int _argc, const char* _argv[], ShaderBinary* _output = NULL)
 	{
 		bx::CommandLine cmdLine(_argc, _argv);
 
@@ -799,7 +1043,10 @@ namespace bgfx
 			return EXIT_FAILURE;
 		}
 
-		g_verbose = cmdLine.hasArg("verbose");
+		if (cmdLine.hasArg("verbose") )
+		{
+			g_verbose = true;
+		}
 
 		const char* filePath = cmdLine.findOption('f');
 		if (NULL == filePath)
@@ -1241,7 +1488,11 @@ namespace bgfx
 			{
 				bx::CrtFileWriter* writer = NULL;
 
-				if (NULL != bin2c)
+				if (NULL != _output)
+				{
+					writer = new BufferWriter(*_output);
+				}
+				else if (NULL != bin2c)
 				{
 					writer = new Bin2cWriter(bin2c);
 				}
@@ -1285,11 +1536,11 @@ namespace bgfx
 				}
 				else if (0 != pssl)
 				{
-					compiled = compilePSSLShader(cmdLine, 0, input, writer);
+					compiled = compileCached(compilePSSLShader, cmdLine, 0, input, writer);
 				}
 				else
 				{
-					compiled = compileHLSLShader(cmdLine, d3d, input, writer);
+					compiled = compileCached(compileHLSLShader, cmdLine, d3d, input, writer);
 				}
 
 				bx::close(writer);
@@ -1402,7 +1653,11 @@ namespace bgfx
 						{
 							bx::CrtFileWriter* writer = NULL;
 
-							if (NULL != bin2c)
+							if (NULL != _output)
+							{
+								writer = new BufferWriter(*_output);
+							}
+							else if (NULL != bin2c)
 							{
 								writer = new Bin2cWriter(bin2c);
 							}
@@ -1445,20 +1700,20 @@ namespace bgfx
 
 								compiled = true;
 	#else
-								compiled = compileGLSLShader(cmdLine, essl, code, writer);
+								compiled = compileCached(compileGLSLShader, cmdLine, essl, code, writer);
 	#endif // 0
 							}
 							else if (0 != spirv)
 							{
-								compiled = compileSPIRVShader(cmdLine, 0, preprocessor.m_preprocessed, writer);
+								compiled = compileCached(compileSPIRVShader, cmdLine, 0, preprocessor.m_preprocessed, writer);
 							}
 							else if (0 != pssl)
 							{
-								compiled = compilePSSLShader(cmdLine, 0, preprocessor.m_preprocessed, writer);
+								compiled = compileCached(compilePSSLShader, cmdLine, 0, preprocessor.m_preprocessed, writer);
 							}
 							else
 							{
-								compiled = compileHLSLShader(cmdLine, d3d, preprocessor.m_preprocessed, writer);
+								compiled = compileCached(compileHLSLShader, cmdLine, d3d, preprocessor.m_preprocessed, writer);
 							}
 
 							bx::close(writer);
@@ -1883,7 +2138,11 @@ namespace bgfx
 						{
 							bx::CrtFileWriter* writer = NULL;
 
-							if (NULL != bin2c)
+							if (NULL != _output)
+							{
+								writer = new BufferWriter(*_output);
+							}
+							else if (NULL != bin2c)
 							{
 								writer = new Bin2cWriter(bin2c);
 							}
@@ -2119,15 +2378,35 @@ namespace bgfx
 
 								code += preprocessor.m_preprocessed;
 
-								compiled = compileGLSLShader(cmdLine
-									, metal ? BX_MAKEFOURCC('M', 'T', 'L', 0) : essl
-									, code
-									, writer
-									);
+								if (0 == essl
+								&&  0 == metal
+								&&  'v' == shaderType
+								&&  !!bx::findIdentifierMatch(input, "gl_DrawIDARB") )
+								{
+									// glsl-optimizer doesn't know shader storage buffers and
+									// draw parameters used by DRAW_DATA_BUFFER. Code is passed
+									// through, and renderer inserts required #version.
+									bx::write(writer, uint16_t(0) );
+
+									uint32_t shaderSize = (uint32_t)preprocessor.m_preprocessed.size();
+									bx::write(writer, shaderSize);
+									bx::write(writer, preprocessor.m_preprocessed.c_str(), shaderSize);
+									bx::write(writer, uint8_t(0) );
+
+									compiled = true;
+								}
+								else
+								{
+									compiled = compileCached(compileGLSLShader, cmdLine
+										, metal ? BX_MAKEFOURCC('M', 'T', 'L', 0) : essl
+										, code
+										, writer
+										);
+								}
 							}
 							else if (0 != spirv)
 							{
-								compiled = compileSPIRVShader(cmdLine
+								compiled = compileCached(compileSPIRVShader, cmdLine
 									, 0
 									, preprocessor.m_preprocessed
 									, writer
@@ -2135,7 +2414,7 @@ namespace bgfx
 							}
 							else if (0 != pssl)
 							{
-								compiled = compilePSSLShader(cmdLine
+								compiled = compileCached(compilePSSLShader, cmdLine
 									, 0
 									, preprocessor.m_preprocessed
 									, writer
@@ -2143,7 +2422,7 @@ namespace bgfx
 							}
 							else
 							{
-								compiled = compileHLSLShader(cmdLine
+								compiled = compileCached(compileHLSLShader, cmdLine
 									, d3d
 									, preprocessor.m_preprocessed
 									, writer
@@ -2180,15 +2459,328 @@ namespace bgfx
 			return EXIT_SUCCESS;
 		}
 
-		remove(outFilePath);
+		if (NULL == _output)
+		{
+			remove(outFilePath);
+		}
 
 		fprintf(stderr, "Failed to build shader.\n");
 		return EXIT_FAILURE;
 	}
 
+	int compilePermutations(int _argc, const char* _argv[], const char* _permutations)
+	{
+		std::vector<std::string> defines;
+		for (const char* str = bx::strws(_permutations); '\0' != *str; str = bx::strws(str) )
+		{
+			const char* eol = bx::strFind(str, ';');
+			if (NULL == eol)
+			{
+				eol = str + bx::strLen(str);
+			}
+
+			if (eol != str)
+			{
+				defines.push_back(std::string(str, eol) );
+			}
+
+			str = ';' == *eol ? eol+1 : eol;
+		}
+
+		if (BGFX_SHADERC_MAX_PERMUTATION_DEFINES < defines.size() )
+		{
+			help("Too many permutation defines.");
+			return EXIT_FAILURE;
+		}
+
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		const char* outFilePath = cmdLine.findOption('o');
+		if (NULL == outFilePath)
+		{
+			help("Output file name must be specified.");
+			return EXIT_FAILURE;
+		}
+
+		const char* baseDefines = cmdLine.findOption("define");
+
+		// --define is replaced for each permutation.
+		std::vector<const char*> args;
+		for (int ii = 0; ii < _argc; ++ii)
+		{
+			if (0 == bx::strCmp(_argv[ii], "--permutations")
+			||  0 == bx::strCmp(_argv[ii], "--define") )
+			{
+				++ii;
+				continue;
+			}
+
+			args.push_back(_argv[ii]);
+		}
+
+		typedef std::unordered_map<uint64_t, uint16_t> ShaderIndexMap;
+		ShaderIndexMap shaderIndex;
+		std::vector<ShaderBinary> shaders;
+
+		const uint32_t numPermutations = 1 << defines.size();
+		std::vector<uint16_t> index(numPermutations);
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		for (uint32_t perm = 0; perm < numPermutations; ++perm)
+		{
+			std::string define = NULL != baseDefines ? baseDefines : "";
+			for (uint32_t bit = 0, num = uint32_t(defines.size() ); bit < num; ++bit)
+			{
+				if (0 != (perm & (1<<bit) ) )
+				{
+					define += define.empty() ? "" : ";";
+					define += defines[bit];
+					define += "=1";
+				}
+			}
+
+			std::vector<const char*> argv(args);
+			argv.push_back("--define");
+			argv.push_back(define.c_str() );
+
+			// Identical preprocessed source is compiled by backend only once,
+			// see compileCached.
+			ShaderBinary binary;
+			if (EXIT_SUCCESS != compileShader(int(argv.size() ), argv.data(), &binary) )
+			{
+				fprintf(stderr, "Failed to build permutation %d (%s).\n", perm, define.c_str() );
+				return EXIT_FAILURE;
+			}
+
+			CacheKey key;
+			key.begin();
+			key.add(binary.data(), int32_t(binary.size() ) );
+			const uint64_t hash = key.end();
+
+			ShaderIndexMap::const_iterator it = shaderIndex.find(hash);
+			if (it != shaderIndex.end()
+			&&  shaders[it->second] == binary)
+			{
+				index[perm] = it->second;
+			}
+			else
+			{
+				index[perm] = uint16_t(shaders.size() );
+				shaderIndex.insert(std::make_pair(hash, index[perm]) );
+				shaders.push_back(binary);
+			}
+		}
+
+		bx::CrtFileWriter writer;
+		if (!bx::open(&writer, outFilePath) )
+		{
+			fprintf(stderr, "Unable to open output file '%s'.", outFilePath);
+			return EXIT_FAILURE;
+		}
+
+		bx::write(&writer, BGFX_CHUNK_MAGIC_SPA);
+
+		bx::write(&writer, uint16_t(defines.size() ) );
+		for (uint32_t ii = 0, num = uint32_t(defines.size() ); ii < num; ++ii)
+		{
+			const uint16_t len = uint16_t(defines[ii].size() );
+			bx::write(&writer, len);
+			bx::write(&writer, defines[ii].c_str(), len);
+		}
+
+		bx::write(&writer, numPermutations);
+		bx::write(&writer, uint32_t(shaders.size() ) );
+		bx::write(&writer, index.data(), int32_t(numPermutations*sizeof(uint16_t) ) );
+
+		uint32_t offset = 0;
+		for (uint32_t ii = 0, num = uint32_t(shaders.size() ); ii < num; ++ii)
+		{
+			const uint32_t size = uint32_t(shaders[ii].size() );
+			bx::write(&writer, offset);
+			bx::write(&writer, size);
+			offset += size;
+		}
+
+		for (uint32_t ii = 0, num = uint32_t(shaders.size() ); ii < num; ++ii)
+		{
+			bx::write(&writer, shaders[ii].data(), int32_t(shaders[ii].size() ) );
+		}
+
+		bx::close(&writer);
+
+		elapsed += bx::getHPCounter();
+
+		printf("permutations %d, shaders %d, size %d, backend compiles %d, %f [s]\n"
+			, numPermutations
+			, uint32_t(shaders.size() )
+			, offset
+			, s_cache.m_misses
+			, double(elapsed)/bx::getHPFrequency()
+			);
+
+		return EXIT_SUCCESS;
+	}
+
+	struct BatchJob
+	{
+		std::string m_line;
+		char  m_commandLine[4096];
+		char* m_argv[128];
+		int   m_argc;
+		int   m_result;
+	};
+
+	struct Batch
+	{
+		BatchJob* m_jobs;
+		uint32_t  m_num;
+		uint32_t  m_next;
+	};
+
+	static int32_t batchThread(void* _userData)
+	{
+		Batch* batch = (Batch*)_userData;
+
+		for (uint32_t idx = bx::atomicFetchAndAdd(&batch->m_next, 1u)
+			; idx < batch->m_num
+			; idx = bx::atomicFetchAndAdd(&batch->m_next, 1u)
+			)
+		{
+			BatchJob& job = batch->m_jobs[idx];
+
+			bx::CommandLine cmdLine(job.m_argc, (const char**)job.m_argv);
+			const char* permutations = cmdLine.findOption("permutations");
+
+			job.m_result = NULL != permutations
+				? compilePermutations(job.m_argc, (const char**)job.m_argv, permutations)
+				: compileShader(job.m_argc, (const char**)job.m_argv)
+				;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	int compileBatch(const char* _filePath, uint32_t _numThreads)
+	{
+		File manifest(_filePath);
+		if (NULL == manifest.getData() )
+		{
+			fprintf(stderr, "Unable to open batch file '%s'.\n", _filePath);
+			return EXIT_FAILURE;
+		}
+
+		std::vector<std::string> lines;
+		for (LineReader lr(manifest.getData() ); !lr.isEof();)
+		{
+			std::string line = lr.getLine();
+			const char* str = bx::strws(line.c_str() );
+			if ('\0' != *str
+			&&  '\r' != *str
+			&&  '\n' != *str
+			&&  '#'  != *str)
+			{
+				lines.push_back(str);
+			}
+		}
+
+		const uint32_t num = uint32_t(lines.size() );
+		BatchJob* jobs = new BatchJob[num];
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			BatchJob& job = jobs[ii];
+			job.m_line   = lines[ii];
+			job.m_argv[0] = const_cast<char*>("shaderc");
+			job.m_result = EXIT_FAILURE;
+
+			uint32_t len = sizeof(job.m_commandLine);
+			bx::tokenizeCommandLine(job.m_line.c_str()
+				, job.m_commandLine
+				, len
+				, job.m_argc
+				, &job.m_argv[1]
+				, BX_COUNTOF(job.m_argv)-1
+				, '\n'
+				);
+			job.m_argc += 1;
+		}
+
+		Batch batch;
+		batch.m_jobs = jobs;
+		batch.m_num  = num;
+		batch.m_next = 0;
+
+		_numThreads = bx::uint32_max(1, bx::uint32_min(_numThreads, num) );
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		// Backend compilers recurse deeply, worker threads get larger stack
+		// than default.
+		bx::Thread* threads = new bx::Thread[_numThreads];
+		for (uint32_t ii = 1; ii < _numThreads; ++ii)
+		{
+			threads[ii].init(batchThread, &batch, 16<<20, "shaderc - batch");
+		}
+
+		batchThread(&batch);
+
+		for (uint32_t ii = 1; ii < _numThreads; ++ii)
+		{
+			threads[ii].shutdown();
+		}
+
+		delete [] threads;
+
+		elapsed += bx::getHPCounter();
+
+		uint32_t numFailed = 0;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			if (EXIT_SUCCESS != jobs[ii].m_result)
+			{
+				fprintf(stderr, "Failed: %s\n", jobs[ii].m_line.c_str() );
+				++numFailed;
+			}
+		}
+
+		delete [] jobs;
+
+		printf("shaders %d, failed %d, cache hits %d, misses %d, threads %d, %f [s]\n"
+			, num
+			, numFailed
+			, s_cache.m_hits
+			, s_cache.m_misses
+			, _numThreads
+			, double(elapsed)/bx::getHPFrequency()
+			);
+
+		return 0 == numFailed ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 } // namespace bgfx
 
 int main(int _argc, const char* _argv[])
 {
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	bgfx::g_verbose = cmdLine.hasArg("verbose");
+	bgfx::s_cache.m_dir = cmdLine.findOption("cache");
+
+	const char* batch = cmdLine.findOption("batch");
+	if (NULL != batch)
+	{
+		uint32_t numThreads = 4;
+		cmdLine.hasArg(numThreads, 'j', "threads");
+
+		return bgfx::compileBatch(batch, numThreads);
+	}
+
+	const char* permutations = cmdLine.findOption("permutations");
+	if (NULL != permutations)
+	{
+		return bgfx::compilePermutations(_argc, _argv, permutations);
+	}
+
 	return bgfx::compileShader(_argc, _argv);
 }
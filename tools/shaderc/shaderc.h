@@ -62,12 +62,17 @@ namespace bgfx
 #include <bx/string.h>
 #include <bx/hash.h>
 #include <bx/crtimpl.h>
+#include <bx/mutex.h>
 #include "../../src/vertexdecl.h"
 
 namespace bgfx
 {
 	extern bool g_verbose;
 
+	// Guards backend compiler process global state (glsl-optimizer type
+	// tables, glslang process init/finalize, D3DCompiler DLL loading).
+	extern bx::Mutex g_compilerMutex;
+
 	class LineReader
 	{
 	public:
@@ -35,6 +35,10 @@ namespace bgfx { namespace glsl
 			break;
 		}
 
+		// glslopt_cleanup releases type tables shared by all contexts, so
+		// glsl-optimizer is used by one job at the time.
+		bx::MutexScope scope(g_compilerMutex);
+
 		glslopt_ctx* ctx = glslopt_initialize(target);
 
 		glslopt_shader* shader = glslopt_optimize(ctx, type, _code.c_str(), 0);
@@ -552,7 +552,10 @@ namespace bgfx { namespace hlsl
 			return false;
 		}
 
-		s_compiler = load();
+		{
+			bx::MutexScope scope(g_compilerMutex);
+			s_compiler = load();
+		}
 
 		bool result = false;
 		bool debug = _cmdLine.hasArg('\0', "debug");
@@ -791,7 +794,12 @@ namespace bgfx { namespace hlsl
 
 	error:
 		code->Release();
-		unload();
+
+		{
+			bx::MutexScope scope(g_compilerMutex);
+			unload();
+		}
+
 		return result;
 	}
 
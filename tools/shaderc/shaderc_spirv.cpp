@@ -563,7 +563,10 @@ namespace bgfx { namespace spirv
 			return false;
 		}
 
-		glslang::InitializeProcess();
+		{
+			bx::MutexScope scope(g_compilerMutex);
+			glslang::InitializeProcess();
+		}
 
 		glslang::TProgram* program = new glslang::TProgram;
 
@@ -767,7 +770,10 @@ namespace bgfx { namespace spirv
 		delete program;
 		delete shader;
 
-		glslang::FinalizeProcess();
+		{
+			bx::MutexScope scope(g_compilerMutex);
+			glslang::FinalizeProcess();
+		}
 
 		return compiled && linked && validated && optimized;
 	}